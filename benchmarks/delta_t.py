@@ -0,0 +1,76 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Compares loading deltat.data with the Python parser the C loader replaced against the C loader, then times Delta T
+looked up over a batch of times inside the table, the same times in order and times centuries either side of the
+table that are extrapolated with the polynomial model.
+
+    python benchmarks/delta_t.py [ntimes]
+
+Each batch is looked up in one call into C, so the cost per lookup is not hidden behind the Python call overhead.
+"""
+import random
+import sys
+import timeit
+from array import array
+from datetime import datetime, timezone
+
+from toluene.time.delta_t import DeltaTTable
+from toluene.util.file import datadir
+
+
+def load_with_python(path: str) -> DeltaTTable:
+    records = array('d')
+    with open(path, 'r') as file:
+        for line in file:
+            timestamp = datetime(int(line[1:5]), int(line[6:8]), int(line[9:11]), tzinfo=timezone.utc).timestamp()
+            records.extend((timestamp, float(line[12:])))
+    table = DeltaTTable()
+    table.add_records(records)
+    return table
+
+
+def main(ntimes: int = 1000000):
+    path = datadir + '/deltat.data'
+    for name, load in (('python', lambda: load_with_python(path)), ('native', lambda: DeltaTTable(path))):
+        seconds = min(timeit.repeat(load, number=10, repeat=3)) / 10
+        print('load     %-12s %10.1f us' % (name, seconds * 1e6))
+
+    table = DeltaTTable(path)
+    year = 365.2425 * 86400.0
+    start = datetime(1973, 2, 1, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+    end = datetime(2023, 10, 1, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+    times = array('d', [random.uniform(start, end) for _ in range(ntimes)])
+    outside = array('d', [random.choice((start - 500.0 * year, end)) + random.uniform(0.0, 500.0 * year)
+                          for _ in range(ntimes)])
+    out = array('d', bytes(ntimes * 8))
+
+    for name, values in (('random', times), ('ordered', array('d', sorted(times))), ('extrapolated', outside)):
+        seconds = min(timeit.repeat(lambda: table.lookup(values, out), number=1, repeat=3))
+        print('lookup   %-12s %10.1f ns/lookup' % (name, seconds / ntimes * 1e9))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 1000000)
@@ -0,0 +1,80 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Compares building an Earth Model from the packaged source files against loading it from a snapshot written by
+EarthModel.save and attaching to the snapshot with EarthModel.attach, the start up cost of every worker process. On
+Linux it also reports the private memory each way adds to a freshly spawned worker, read from
+/proc/self/smaps_rollup, the memory that is not shared with the other workers.
+
+    python benchmarks/earth_model.py [repeat]
+"""
+import multiprocessing
+import os
+import sys
+import tempfile
+import timeit
+
+from toluene.models.earth.model import EarthModel
+
+
+def private_memory() -> int:
+    with open('/proc/self/smaps_rollup') as file:
+        return sum(int(line.split()[1]) for line in file if line.startswith(('Private_Clean', 'Private_Dirty')))
+
+
+def worker(how: str, path: str) -> int:
+    from toluene.coordinates.reference_frame import ReferenceFrame
+    from toluene.coordinates.state_vector import StateVector
+
+    before = private_memory()
+    model = {'build': EarthModel, 'load': EarthModel.load, 'attach': EarthModel.attach}[how](
+        *(() if how == 'build' else (path,)))
+    StateVector(7000000.0, 0.0, 0.0, time=1.7e9,
+                frame=ReferenceFrame.InternationalTerrestrialReferenceFrame).get_gcrs(model)
+    return private_memory() - before
+
+
+def main(repeat: int = 5):
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, 'earth.model')
+        EarthModel().save(path)
+
+        built = min(timeit.repeat(EarthModel, number=1, repeat=repeat))
+        loaded = min(timeit.repeat(lambda: EarthModel.load(path), number=1, repeat=repeat))
+        attached = min(timeit.repeat(lambda: EarthModel.attach(path), number=1, repeat=repeat))
+
+        print('snapshot %10.1f MB' % (os.path.getsize(path) / 1e6))
+        print('build    %10.1f ms' % (built * 1e3))
+        print('load     %10.1f ms' % (loaded * 1e3))
+        print('attach   %10.1f ms' % (attached * 1e3))
+
+        if os.path.exists('/proc/self/smaps_rollup'):
+            with multiprocessing.get_context('spawn').Pool(1, maxtasksperchild=1) as pool:
+                for how in ('build', 'load', 'attach'):
+                    print('%-8s %10.1f MB private per worker' % (how, pool.apply(worker, (how, path)) / 1e3))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 5)
@@ -0,0 +1,62 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Compares the indexed Earth Orientation Parameters lookup, which computes the record's slot from the time, against the
+binary search over the table, for each interpolation between the daily records, then the indexed lookup against the
+cursor the frame transforms share across a time ordered stream of epochs.
+
+    python benchmarks/earth_orientation.py [ntimes]
+
+Times are spread over the finals2000A.all span and looked up in one call into C, so the cost per lookup is not hidden
+behind the Python call overhead.
+"""
+import random
+import sys
+import timeit
+from array import array
+from datetime import datetime, timezone
+
+from toluene.models.earth.earth_orientation_table import EarthOrientationTable, EOPInterpolation
+from toluene.util.file import datadir
+
+
+def main(ntimes: int = 1000000):
+    table = EarthOrientationTable(datadir + '/finals2000A.all')
+    start = datetime(1973, 1, 2, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+    end = datetime(2024, 1, 1, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+    times = array('d', [random.uniform(start, end) for _ in range(ntimes)])
+    ordered = array('d', sorted(times))
+    out = array('d', bytes(ntimes * 4 * 8))
+
+    for interpolation in EOPInterpolation:
+        for name, values, search, cursor in (('search', times, True, False), ('indexed', times, False, False),
+                                             ('ordered', ordered, False, False), ('cursor', ordered, False, True)):
+            seconds = min(timeit.repeat(lambda: table.interpolate(values, out, interpolation, search, cursor),
+                                        number=1, repeat=3))
+            print('%-8s %-8s %10.1f ns/lookup' % (interpolation.name, name, seconds / ntimes * 1e9))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 1000000)
@@ -0,0 +1,75 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Times the ITRF to geodetic conversion of a batch of positions spread from the surface to GEO, on each kernel of the
+double precision batch the CPU supports against the long double conversion of a StateVectorArray.
+
+    python benchmarks/geodetic.py [npoints]
+
+Everything runs on one thread so the kernels are compared rather than the thread pool.
+"""
+import random
+import sys
+import timeit
+from array import array
+
+import toluene
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector, StateVectorArray
+from toluene.coordinates import transform
+from toluene.models.earth.model import EarthModel
+
+
+def main(npoints: int = 1000000):
+    model = EarthModel()
+    toluene.set_num_threads(1)
+
+    geodetic = [(random.uniform(-90.0, 90.0), random.uniform(-180.0, 180.0), random.uniform(-10000.0, 35786000.0))
+                for _ in range(1000)]
+    rows = [StateVector(*point, frame=ReferenceFrame.GeodeticReferenceFrame).get_itrs(model).position
+            for point in geodetic]
+    positions = array('d', [value for idx in range(npoints) for value in rows[idx % len(rows)]])
+    out = array('d', bytes(len(positions) * 8))
+
+    states = StateVectorArray([StateVector(*rows[idx % len(rows)],
+                                           frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                               for idx in range(npoints // 10)])
+    seconds = min(timeit.repeat(lambda: states.get_geodetic(model), number=1, repeat=3))
+    print('StateVectorArray %-10s %10.1f ns/point' % (toluene.precision, seconds / len(states) * 1e9))
+
+    selected, supported = transform.get_geodetic_kernel()
+    for kernel in transform.GeodeticKernel:
+        if kernel > supported:
+            continue
+        transform.set_geodetic_kernel(kernel)
+        seconds = min(timeit.repeat(lambda: transform.itrf_to_geodetic_position(positions, model, out), number=1,
+                                    repeat=3))
+        print('batch %-21s %10.1f ns/point' % (kernel.name, seconds / npoints * 1e9))
+    transform.set_geodetic_kernel(selected)
+    toluene.set_num_threads(0)
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 1000000)
@@ -0,0 +1,149 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Reports the accuracy and speed of each geodetic algorithm. Positions are spread over latitude at heights from 10 km
+below the ellipsoid to GEO, and each algorithm's latitude and height are compared against Bowring's method iterated to
+convergence in 40 digit decimal arithmetic on the same double precision positions. Both the double precision batch and
+the StateVectorArray conversion in the build's precision are measured.
+
+    python benchmarks/geodetic_algorithms.py [npoints]
+
+Timings run on one thread so the algorithms are compared rather than the thread pool.
+"""
+import sys
+import timeit
+from array import array
+from decimal import Decimal, localcontext
+
+import toluene
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector, StateVectorArray
+from toluene.coordinates import transform
+from toluene.models.earth.ellipsoid import GeodeticAlgorithm
+from toluene.models.earth.model import EarthModel, default_ellipsoid
+
+heights = (-10000.0, 0.0, 10000.0, 400000.0, 2000000.0, 20200000.0, 35786000.0)
+latitudes = [-89.99 + 179.98 * idx / 120 for idx in range(121)]
+digits = 40
+
+
+def decimal_atan(x: Decimal) -> Decimal:
+    # Halving the angle five times takes it below 0.05 where the series converges in a few dozen terms.
+    for _ in range(5):
+        x = x / (1 + (1 + x * x).sqrt())
+    term, total, power, n = x, x, x, 1
+    while abs(term) > Decimal(10) ** -(digits + 2):
+        power *= -x * x
+        n += 2
+        term = power / n
+        total += term
+    return total * 32
+
+
+def reference(position) -> (Decimal, Decimal):
+    # Bowring's method converges on the latitude for positions outside the evolute, iterated until it stops moving.
+    a, b = Decimal(default_ellipsoid[0]), Decimal(default_ellipsoid[1])
+    e_2 = (a * a - b * b) / (a * a)
+    e_r2 = (a * a - b * b) / (b * b)
+    x, y, z = (Decimal(value) for value in position)
+    p = (x * x + y * y).sqrt()
+    s, c, tangent = a * z, b * p, None
+    for _ in range(100):
+        norm = (s * s + c * c).sqrt()
+        n = z + e_r2 * b * (s / norm) ** 3
+        d = p - e_2 * a * (c / norm) ** 3
+        if tangent is not None and abs(n / d - tangent) <= Decimal(10) ** -digits * (1 + abs(tangent)):
+            break
+        tangent, s, c = n / d, b * n, a * d
+    height = (p * d + z * n - (a * a * d * d + b * b * n * n).sqrt()) / (n * n + d * d).sqrt()
+    return decimal_atan(n / d) * 180 / (decimal_atan(Decimal(1)) * 4), height
+
+
+def errors(geodetic, expected):
+    latitude = max(abs(Decimal(row[0]) - truth[0]) for row, truth in zip(geodetic, expected))
+    height = max(abs(Decimal(row[2]) - truth[1]) for row, truth in zip(geodetic, expected))
+    return float(latitude), float(height)
+
+
+def main(npoints: int = 1000000):
+    model = EarthModel()
+    toluene.set_num_threads(1)
+
+    bands = []
+    with localcontext() as context:
+        context.prec = digits + 5
+        for height in heights:
+            rows = [StateVector(latitude, 30.0 + latitude, height,
+                                frame=ReferenceFrame.GeodeticReferenceFrame).get_itrs(model).position
+                    for latitude in latitudes]
+            bands.append((height, rows, [reference(row) for row in rows]))
+
+        print('Maximum latitude error in degrees and height error in meters against the reference')
+        print('%-10s %-9s' % ('algorithm', 'path') + ''.join('%22s' % ('%.0f km' % (height / 1000.0))
+                                                          for height in heights))
+        for algorithm in GeodeticAlgorithm:
+            model.set_geodetic_algorithm(algorithm)
+            batch, states = '', ''
+            for height, rows, expected in bands:
+                flat = array('d', [value for row in rows for value in row])
+                out = transform.itrf_to_geodetic_position(flat, model)
+                batch += '%11.1e %9.1e' % errors([out[idx:idx + 3] for idx in range(0, len(out), 3)], expected)
+                itrs = StateVectorArray([StateVector(*row, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                                         for row in rows])
+                states += '%11.1e %9.1e' % errors(itrs.get_geodetic(model).position.tolist(), expected)
+            print('%-10s %-9s' % (algorithm.name, 'batch') + batch)
+            print('%-10s %-9s' % (algorithm.name, toluene.precision) + states)
+
+    rows = [row for _, band_rows, _ in bands for row in band_rows]
+    positions = array('d', [value for idx in range(npoints) for value in rows[idx % len(rows)]])
+    out = array('d', bytes(len(positions) * 8))
+    states = StateVectorArray([StateVector(*rows[idx % len(rows)],
+                                           frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                               for idx in range(npoints // 10)])
+    selected, supported = transform.get_geodetic_kernel()
+
+    print()
+    print('Throughput in ns/point')
+    print('%-10s' % 'algorithm' + ''.join('%12s' % kernel.name for kernel in transform.GeodeticKernel
+                                          if kernel <= supported) + '%12s' % toluene.precision)
+    for algorithm in GeodeticAlgorithm:
+        line = '%-10s' % algorithm.name
+        for kernel in transform.GeodeticKernel:
+            if kernel > supported:
+                continue
+            transform.set_geodetic_kernel(kernel)
+            seconds = min(timeit.repeat(lambda: transform.itrf_to_geodetic_position(positions, model, out, algorithm),
+                                        number=1, repeat=3))
+            line += '%12.1f' % (seconds / npoints * 1e9)
+        model.set_geodetic_algorithm(algorithm)
+        seconds = min(timeit.repeat(lambda: states.get_geodetic(model), number=1, repeat=3))
+        print(line + '%12.1f' % (seconds / len(states) * 1e9))
+    transform.set_geodetic_kernel(selected)
+    model.set_geodetic_algorithm(GeodeticAlgorithm.ClosedForm)
+    toluene.set_num_threads(0)
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 1000000)
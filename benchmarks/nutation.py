@@ -0,0 +1,77 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Compares the nutation strategies for speed and accuracy against the Extended strategy, the original term by term long
+double evaluation.
+
+    python benchmarks/nutation.py [nepochs]
+
+The nutation series is timed for each strategy through the nutation extension. The equation of origins is timed with
+its direct and recurrence evaluation through the transform extension. Errors are the largest absolute difference from
+the Extended strategy over epochs spread across 1950 to 2050, in arcseconds.
+"""
+import sys
+import timeit
+
+import yaml
+
+from toluene.models.earth.nutation import NutationSeries, NutationStrategy, get_nutation_kernel
+from toluene.util.file import configdir
+from toluene_extensions.coordinates import transform
+
+J2000 = 946728000.0
+JULIAN_CENTURY = 3155760000.0
+
+
+def main(nepochs: int = 2000):
+    with open(configdir + '/nutation.yml') as f:
+        series = NutationSeries(yaml.safe_load(f)['nutation']['series'])
+    epochs = [J2000 - JULIAN_CENTURY / 2 + idx * JULIAN_CENTURY / nepochs for idx in range(nepochs)]
+
+    series.set_strategy(NutationStrategy.Extended)
+    reference = [series.values(t) for t in epochs]
+
+    print('nutation series, %d terms, %s kernel' % (series.terms, get_nutation_kernel()[0].name))
+    for strategy in NutationStrategy:
+        series.set_strategy(strategy)
+        values = [series.values(t) for t in epochs]
+        error = max(abs(a - b) for row, expected in zip(values, reference) for a, b in zip(row, expected))
+        seconds = min(timeit.repeat(lambda: [series.values(t) for t in epochs], number=1, repeat=3))
+        print('  %-12s %10.3f us/epoch  max error %.3e arcsec' % (strategy.name, seconds / nepochs * 1e6, error))
+
+    print('equation of origins, 34 terms')
+    nutation = reference
+    reference = [transform.equation_of_origins(t, row[0], row[2], int(NutationStrategy.Extended))
+                 for t, row in zip(epochs, nutation)]
+    for strategy in (NutationStrategy.Extended, NutationStrategy.Recurrence):
+        values = [transform.equation_of_origins(t, row[0], row[2], int(strategy)) for t, row in zip(epochs, nutation)]
+        seconds = min(timeit.repeat(lambda: [transform.equation_of_origins(t, row[0], row[2], int(strategy))
+                                             for t, row in zip(epochs, nutation)], number=1, repeat=3))
+        error = max(abs(a - b) for a, b in zip(values, reference))
+        print('  %-12s %10.3f us/epoch  max error %.3e arcsec' % (strategy.name, seconds / nepochs * 1e6, error))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 2000)
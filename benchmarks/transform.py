@@ -0,0 +1,127 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+"""
+Times the ITRF to GCRF conversion through the C extension directly so the Python wrapper does not dominate.
+
+    python benchmarks/transform.py [npoints]
+
+Reports the cost per state for distinct epochs, where every state composes its own frame rotation, and for states
+sharing an epoch, where the rotation is composed once and each vector costs a single matrix product, then both again
+converting only the position, and again on the shared epoch writing into one output StateVector. The batched entry point and a StateVectorArray, converted to a
+new array and in place, are timed to show the per vector cost without the Python call overhead. Distinct epochs are
+timed again with a nutation ephemeris fit over the span in place of the full nutation series. Last the batched entry
+point is timed on distinct epochs across thread pools of one thread up to one per processor. Before the transforms,
+constructing a StateVector and reading its position are timed for the extension type and the
+toluene.coordinates.state_vector.StateVector subclass.
+"""
+import os
+import sys
+from array import array
+import timeit
+from datetime import datetime, timezone
+
+import toluene
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector
+from toluene.models.earth.model import EarthModel
+from toluene_extensions.coordinates import state_vector, transform
+
+
+def main(npoints: int = 20000):
+    model = EarthModel()
+    start = datetime(2023, 11, 20, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+    frame = int(ReferenceFrame.InternationalTerrestrialReferenceFrame)
+
+    for name, cls in (('extension type', state_vector.StateVector), ('subclass', StateVector)):
+        seconds = min(timeit.repeat(lambda: cls(-2850075.29, 4655695.79, 3287765.22, time=start, frame=frame),
+                                    number=npoints, repeat=3))
+        print('StateVector() %-15s %10.3f us/state' % (name, seconds / npoints * 1e6))
+        point = cls(-2850075.29, 4655695.79, 3287765.22, time=start, frame=frame)
+        seconds = min(timeit.repeat(lambda: point.position, number=npoints, repeat=3))
+        print('.position %-19s %10.3f us/state' % (name, seconds / npoints * 1e6))
+
+    distinct = [state_vector.new_StateVector(-2850075.29, 4655695.79, 3287765.22, 1.0, 2.0, 3.0, 0.1, 0.2, 0.3,
+                                             start + idx * 0.5, frame) for idx in range(npoints)]
+    shared = [state_vector.new_StateVector(-2850075.29, 4655695.79, 3287765.22, 1.0, 2.0, 3.0, 0.1, 0.2, 0.3,
+                                           start, frame) for idx in range(npoints)]
+
+    for name, points in (('distinct epochs', distinct), ('shared epoch', shared)):
+        seconds = min(timeit.repeat(lambda: [transform.itrf_to_gcrf(point, model.capsule) for point in points],
+                                    number=1, repeat=3))
+        print('itrf_to_gcrf %-16s %10.3f us/state' % (name, seconds / npoints * 1e6))
+
+    for name, points in (('distinct epochs', distinct), ('shared epoch', shared)):
+        model.clear_rotation_cache()
+        seconds = min(timeit.repeat(lambda: [transform.itrf_to_gcrf_position(point, model.capsule)
+                                             for point in points], number=1, repeat=3))
+        print('itrf_to_gcrf_position %-7s %10.3f us/state' % (name.split()[0], seconds / npoints * 1e6))
+
+    out = state_vector.StateVector(0.0, 0.0)
+    seconds = min(timeit.repeat(lambda: [transform.itrf_to_gcrf(point, model.capsule, out) for point in shared],
+                                number=1, repeat=3))
+    print('itrf_to_gcrf %-16s %10.3f us/state' % ('into output', seconds / npoints * 1e6))
+
+    model.fit_nutation_ephemeris(start, start + npoints * 0.5)
+    seconds = min(timeit.repeat(lambda: [transform.itrf_to_gcrf(point, model.capsule) for point in distinct],
+                                number=1, repeat=3))
+    print('itrf_to_gcrf %-16s %10.3f us/state' % ('ephemeris', seconds / npoints * 1e6))
+    model.set_nutation_ephemeris(None)
+
+    states = array('d', [-2850075.29, 4655695.79, 3287765.22, 1.0, 2.0, 3.0, 0.1, 0.2, 0.3] * npoints)
+    times = array('d', [start] * npoints)
+    out = array('d', bytes(len(states) * 8))
+    seconds = min(timeit.repeat(lambda: transform.itrf_to_gcrf_batch(states, times, model.capsule, out),
+                                number=1, repeat=3))
+    print('itrf_to_gcrf_batch %-10s %10.3f us/state' % ('shared epoch', seconds / npoints * 1e6))
+    positions = array('d', [-2850075.29, 4655695.79, 3287765.22] * npoints)
+    seconds = min(timeit.repeat(lambda: transform.itrf_to_gcrf_position_batch(positions, times, model.capsule,
+                                                                              positions), number=1, repeat=3))
+    print('itrf_to_gcrf_position_batch %10.3f us/state' % (seconds / npoints * 1e6))
+
+    for name, points in (('distinct epochs', distinct), ('shared epoch', shared)):
+        columns = state_vector.StateVectorArray(points)
+        model.clear_rotation_cache()
+        seconds = min(timeit.repeat(lambda: transform.itrf_to_gcrf(columns, model.capsule), number=1, repeat=3))
+        print('StateVectorArray %-12s %10.3f us/state' % (name, seconds / npoints * 1e6))
+        seconds = min(timeit.repeat(lambda: transform.itrf_to_gcrf(columns, model.capsule, columns), number=1,
+                                    repeat=1))
+        print('StateVectorArray %-12s %10.3f us/state' % ('in place', seconds / npoints * 1e6))
+
+    times = array('d', [start + idx * 0.5 for idx in range(npoints)])
+    nthreads = 1
+    while True:
+        toluene.set_num_threads(nthreads)
+        model.clear_rotation_cache()
+        seconds = min(timeit.repeat(lambda: transform.itrf_to_gcrf_batch(states, times, model.capsule, out),
+                                    number=1, repeat=3))
+        print('itrf_to_gcrf_batch %-10s %10.3f us/state' % ('%d threads' % nthreads, seconds / npoints * 1e6))
+        if nthreads >= (os.cpu_count() or 1):
+            break
+        nthreads = min(nthreads * 2, os.cpu_count())
+    toluene.set_num_threads(0)
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 20000)
@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __COORDINATES_GEODETIC_KERNEL_H__
+#define __COORDINATES_GEODETIC_KERNEL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "models/earth/ellipsoid.h"
+
+/** @enum
+ *  @brief Instruction sets the double precision ITRS to geodetic kernel can run on.
+ */
+typedef enum {
+    ScalarGeodeticKernel = 1,
+    AVX2GeodeticKernel   = 2,
+    AVX512GeodeticKernel = 3
+} GeodeticKernel;
+
+
+#ifdef __compile_coordinates_geodetic_kernel__
+
+/**
+ * @brief Convert rows of ITRS positions to geodetic coordinates in double precision with one of the algorithms of
+ * itrf_to_geodetic_state_vector, four or eight rows at a time on the widest kernel the CPU supports.
+ *
+ * @param a The semi-major axis of the ellipsoid in meters.
+ * @param b The semi-minor axis of the ellipsoid in meters.
+ * @param algorithm The algorithm the positions are inverted onto the ellipsoid with.
+ * @param positions N rows of x, y, z in meters.
+ * @param geodetic N rows receiving latitude and longitude in degrees and height in meters, may be positions itself.
+ * @param n The number of rows.
+ */
+void geodetic_kernel_convert(double a, double b, GeodeticAlgorithm algorithm, const double* positions,
+    double* geodetic, long long n);
+
+/**
+ * @brief Get the kernel geodetic coordinates are currently computed with.
+ */
+GeodeticKernel geodetic_kernel(void);
+
+/**
+ * @brief Get the best kernel the CPU supports.
+ */
+GeodeticKernel geodetic_kernel_supported(void);
+
+/**
+ * @brief Force the kernel geodetic coordinates are computed with, used to compare kernels against one another.
+ *
+ * @return 0 on success and -1 if the CPU does not support the kernel.
+ */
+int set_geodetic_kernel(GeodeticKernel kernel);
+
+#endif /* __compile_coordinates_geodetic_kernel__ */
+
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __COORDINATES_GEODETIC_KERNEL_H__ */
@@ -37,24 +37,237 @@ typedef struct {
     Vec3 r;
     Vec3 v;
     Vec3 a;
-    long double time;
+    Real time;
     ReferenceFrame frame;
 } StateVector;
 
+/** @struct
+ * @brief The Python StateVector object, the state vector is stored inline so no second allocation is needed.
+ *
+ * @var StateVectorObject::state_vector
+ * Member 'state_vector' is the StateVector this object holds.
+ */
+typedef struct {
+    PyObject_HEAD
+    StateVector state_vector;
+} StateVectorObject;
+
+/** @struct
+ * @brief The Python StateVectorArray object, the states are stored as contiguous columns of doubles.
+ *
+ * @var StateVectorArrayObject::size
+ * Member 'size' is the number of states.
+ * @var StateVectorArrayObject::r
+ * Member 'r' is the size x 3 position column.
+ * @var StateVectorArrayObject::v
+ * Member 'v' is the size x 3 velocity column.
+ * @var StateVectorArrayObject::a
+ * Member 'a' is the size x 3 acceleration column.
+ * @var StateVectorArrayObject::time
+ * Member 'time' is the time column.
+ * @var StateVectorArrayObject::frame
+ * Member 'frame' is the reference frame column.
+ * @var StateVectorArrayObject::item_type
+ * Member 'item_type' is the StateVector type indexing the array returns.
+ */
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t size;
+    double* r;
+    double* v;
+    double* a;
+    double* time;
+    int* frame;
+    PyTypeObject* item_type;
+} StateVectorArrayObject;
+
+/** @struct
+ * @brief A column of a StateVectorArray exposed through the buffer protocol.
+ *
+ * @var StateVectorColumnObject::array
+ * Member 'array' is the StateVectorArray owning the column, kept alive while the column is.
+ * @var StateVectorColumnObject::column
+ * Member 'column' is the StateVectorColumn the object exposes.
+ * @var StateVectorColumnObject::shape
+ * Member 'shape' is the shape handed to the buffer consumers.
+ * @var StateVectorColumnObject::strides
+ * Member 'strides' is the strides handed to the buffer consumers.
+ */
+typedef struct {
+    PyObject_HEAD
+    StateVectorArrayObject* array;
+    int column;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+} StateVectorColumnObject;
+
+/** @enum
+ * @brief The columns of a StateVectorArray.
+ */
+typedef enum {
+    PositionColumn     = 1,
+    VelocityColumn     = 2,
+    AccelerationColumn = 3,
+    TimeColumn         = 4,
+    FrameColumn        = 5
+} StateVectorColumn;
+
+/** @struct
+ * @brief The StateVector type exported to the other extensions through the _C_API capsule.
+ *
+ * @var StateVectorAPI::type
+ * Member 'type' is the StateVector type, Python subclasses of it are accepted as well.
+ * @var StateVectorAPI::real_size
+ * Member 'real_size' is the sizeof(Real) the StateVector extension was built with.
+ * @var StateVectorAPI::new_object
+ * Member 'new_object' allocates a zeroed StateVector object of the given type, reusing freed objects when it can.
+ * @var StateVectorAPI::array_type
+ * Member 'array_type' is the StateVectorArray type, Python subclasses of it are accepted as well.
+ * @var StateVectorAPI::new_array
+ * Member 'new_array' allocates a zeroed StateVectorArray object of the given type and size.
+ */
+typedef struct {
+    PyTypeObject* type;
+    int real_size;
+    StateVectorObject* (*new_object)(PyTypeObject* type);
+    PyTypeObject* array_type;
+    StateVectorArrayObject* (*new_array)(PyTypeObject* type, Py_ssize_t size);
+} StateVectorAPI;
+
+#ifdef TOLUENE_DOUBLE_PRECISION
+#define STATE_VECTOR_API_CAPSULE "toluene_extensions_fast.coordinates.state_vector._C_API"
+#else
+#define STATE_VECTOR_API_CAPSULE "toluene_extensions.coordinates.state_vector._C_API"
+#endif /* TOLUENE_DOUBLE_PRECISION */
+
+/**
+ * @brief Imports the StateVector API, called from the module init of the extensions working with StateVectors.
+ *
+ * @return The API or NULL with a Python exception set.
+ */
+static inline StateVectorAPI* import_state_vector_api(void) {
+
+    StateVectorAPI* api = (StateVectorAPI*)PyCapsule_Import(STATE_VECTOR_API_CAPSULE, 0);
+
+    if(api && api->real_size != (int)sizeof(Real)) {
+        PyErr_SetString(PyExc_ImportError, "The StateVector extension was built with a different precision.");
+        return NULL;
+    }
+
+    return api;
+}
+
+/**
+ * @brief Checks an object is a StateVector and gets the state vector it holds.
+ *
+ * @param api The StateVector API.
+ * @param obj The object to check.
+ * @param function The name of the calling function used in the error message.
+ * @return The state vector or NULL with a Python exception set.
+ */
+static inline StateVector* state_vector_from_object(StateVectorAPI* api, PyObject* obj, const char* function) {
+
+    if(!PyObject_TypeCheck(obj, api->type)) {
+        PyErr_Format(PyExc_TypeError, "%s() was expecting a StateVector.", function);
+        return NULL;
+    }
+
+    return &((StateVectorObject*)obj)->state_vector;
+}
+
+
+/**
+ * @brief Reads state i of a StateVectorArray.
+ */
+static inline void state_vector_array_get(const StateVectorArrayObject* array, Py_ssize_t i,
+    StateVector* state_vector) {
+
+    state_vector->r.x = array->r[3 * i];
+    state_vector->r.y = array->r[3 * i + 1];
+    state_vector->r.z = array->r[3 * i + 2];
+    state_vector->v.x = array->v[3 * i];
+    state_vector->v.y = array->v[3 * i + 1];
+    state_vector->v.z = array->v[3 * i + 2];
+    state_vector->a.x = array->a[3 * i];
+    state_vector->a.y = array->a[3 * i + 1];
+    state_vector->a.z = array->a[3 * i + 2];
+    state_vector->time = array->time[i];
+    state_vector->frame = (ReferenceFrame)array->frame[i];
+}
+
+/**
+ * @brief Writes state i of a StateVectorArray.
+ */
+static inline void state_vector_array_set(StateVectorArrayObject* array, Py_ssize_t i,
+    const StateVector* state_vector) {
+
+    array->r[3 * i] = (double)state_vector->r.x;
+    array->r[3 * i + 1] = (double)state_vector->r.y;
+    array->r[3 * i + 2] = (double)state_vector->r.z;
+    array->v[3 * i] = (double)state_vector->v.x;
+    array->v[3 * i + 1] = (double)state_vector->v.y;
+    array->v[3 * i + 2] = (double)state_vector->v.z;
+    array->a[3 * i] = (double)state_vector->a.x;
+    array->a[3 * i + 1] = (double)state_vector->a.y;
+    array->a[3 * i + 2] = (double)state_vector->a.z;
+    array->time[i] = (double)state_vector->time;
+    array->frame[i] = (int)state_vector->frame;
+}
+
 
 #ifdef __compile_coordinates_state_vector__
 
 /**
- * @brief Creates a new StateVector object and makes it available to Python
+ * @brief Allocates a zeroed StateVector object, taking it from the free list when the type allows it.
+ *
+ * @param type The StateVector type or a subclass of it.
+ * @return The new object or NULL with a Python exception set.
+ */
+static StateVectorObject* new_StateVectorObject(PyTypeObject* type);
+
+/**
+ * @brief Returns the StateVector object to the free list or releases it.
+ */
+static void StateVector_dealloc(PyObject* self);
+
+/**
+ * @brief Creates a StateVector when a subclass is called, keyword arguments are parsed by name.
  */
-static PyObject* new_StateVector(PyObject* self, PyObject* args);
+static PyObject* StateVector_new(PyTypeObject* type, PyObject* args, PyObject* kwds);
 
 /**
- * @brief Deletes the StateVector object
+ * @brief Creates a StateVector when the type itself is called, without building an argument tuple.
+ */
+static PyObject* StateVector_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf, PyObject* kwnames);
+
+/**
+ * @brief Gives subclasses that leave construction to StateVector the vectorcall constructor as well.
+ */
+static PyObject* StateVector_init_subclass(PyObject* cls, PyObject* ignored);
+
+/**
+ * @brief Allocates a StateVectorArray of the given type with zeroed columns.
  *
- * @param obj The StateVector object
+ * @param type The StateVectorArray type or a subclass of it.
+ * @param size The number of states.
+ * @return The new object or NULL with a Python exception set.
+ */
+static StateVectorArrayObject* new_StateVectorArrayObject(PyTypeObject* type, Py_ssize_t size);
+
+/**
+ * @brief Creates a StateVectorArray from a size or from a sequence of StateVectors.
+ */
+static PyObject* StateVectorArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds);
+
+/**
+ * @brief Releases the columns of the StateVectorArray.
+ */
+static void StateVectorArray_dealloc(PyObject* self);
+
+/**
+ * @brief Creates a new StateVector object and makes it available to Python
  */
-void delete_StateVector(PyObject* obj);
+static PyObject* new_StateVector(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
 
 /**
  * @brief Sets the position vector.
@@ -84,27 +297,27 @@ static PyObject* set_frame(PyObject* self, PyObject* args);
 /**
  * @brief Gets the position vector.
  */
-static PyObject* get_position(PyObject* self, PyObject* args);
+static PyObject* get_position(PyObject* self, PyObject* obj);
 
 /**
  * @brief Gets the velocity vector.
  */
-static PyObject* get_velocity(PyObject* self, PyObject* args);
+static PyObject* get_velocity(PyObject* self, PyObject* obj);
 
 /**
  * @brief Gets the acceleration vector.
  */
-static PyObject* get_acceleration(PyObject* self, PyObject* args);
+static PyObject* get_acceleration(PyObject* self, PyObject* obj);
 
 /**
  * @brief Gets the timestamp.
  */
-static PyObject* get_time(PyObject* self, PyObject* args);
+static PyObject* get_time(PyObject* self, PyObject* obj);
 
 /**
  * @brief Gets the reference frame.
  */
-static PyObject* get_frame(PyObject* self, PyObject* args);
+static PyObject* get_frame(PyObject* self, PyObject* obj);
 
 #endif /* __compile_coordinates_state_vector__ */
 
@@ -28,25 +28,224 @@
 extern "C" {
 #endif /* __cplusplus */
 
+#include "coordinates/state_vector.h"
+#include "models/earth/earth.h"
+
+/**
+ * @brief Converts an itrf state vector to the equivalent gcrf state vector.
+ *
+ * @param state_vector The itrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void itrf_to_gcrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts a gcrf state vector to the equivalent itrf state vector.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The itrf state vector. May not alias state_vector.
+ */
+void gcrf_to_itrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts an itrf state vector to the equivalent geodetic state vector with the model's geodetic algorithm.
+ *
+ * @param state_vector The itrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Unused, the geodetic conversions need no table lookups.
+ * @param retval The geodetic state vector, latitude and longitude in degrees and height in meters. May not alias
+ * state_vector.
+ */
+void itrf_to_geodetic_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts a geodetic state vector to the equivalent itrf state vector.
+ *
+ * @param state_vector The geodetic state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Unused, the geodetic conversions need no table lookups.
+ * @param retval The itrf state vector. May not alias state_vector.
+ */
+void geodetic_to_itrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts a gcrf state vector to the equivalent geodetic state vector, through an itrf state on the stack.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The geodetic state vector. May not alias state_vector.
+ */
+void gcrf_to_geodetic_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts a geodetic state vector to the equivalent gcrf state vector, through an itrf state on the stack.
+ *
+ * @param state_vector The geodetic state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void geodetic_to_gcrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts only the position of an itrf state vector to gcrf, skipping the rate of Earth rotation and the
+ * velocity and acceleration terms. The velocity and acceleration of the result are zero.
+ *
+ * @param state_vector The itrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void itrf_to_gcrf_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts only the position of a gcrf state vector to itrf, skipping the rate of Earth rotation and the
+ * velocity and acceleration terms. The velocity and acceleration of the result are zero.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The itrf state vector. May not alias state_vector.
+ */
+void gcrf_to_itrf_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts only the position of a gcrf state vector to geodetic. The velocity and acceleration of the result
+ * are zero.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The geodetic state vector. May not alias state_vector.
+ */
+void gcrf_to_geodetic_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
+/**
+ * @brief Converts only the position of a geodetic state vector to gcrf. The velocity and acceleration of the result
+ * are zero.
+ *
+ * @param state_vector The geodetic state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void geodetic_to_gcrf_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval);
+
 /**
  * @brief Converts itrf coordinates to the equivalent gcrf coordinates.
  */
-static PyObject* itrf_to_gcrf(PyObject* self, PyObject* args);
+static PyObject* itrf_to_gcrf(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
 
 /**
  * @brief Converts gcrf coordinates to the equivalent itrf coordinates.
  */
-static PyObject* gcrf_to_itrf(PyObject* self, PyObject* args);
+static PyObject* gcrf_to_itrf(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts a batch of itrf coordinates to the equivalent gcrf coordinates.
+ */
+static PyObject* itrf_to_gcrf_batch(PyObject* self, PyObject* args);
+
+/**
+ * @brief Converts a batch of gcrf coordinates to the equivalent itrf coordinates.
+ */
+static PyObject* gcrf_to_itrf_batch(PyObject* self, PyObject* args);
+
+/**
+ * @brief Evaluates the equation of origins with the given nutation strategy, used to compare the strategies.
+ */
+static PyObject* equation_of_origins_of_date(PyObject* self, PyObject* args);
 
 /**
  * @brief Converts itrf coordinates to the equivalent geodetic coordinates.
  */
-static PyObject* itrf_to_geodetic(PyObject* self, PyObject* args);
+static PyObject* itrf_to_geodetic(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
 
 /**
  * @brief Converts geodetic coordinates to the equivalent itrf coordinates.
  */
-static PyObject* geodetic_to_itrf(PyObject* self, PyObject* args);
+static PyObject* geodetic_to_itrf(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts gcrf coordinates to the equivalent geodetic coordinates.
+ */
+static PyObject* gcrf_to_geodetic(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts geodetic coordinates to the equivalent gcrf coordinates.
+ */
+static PyObject* geodetic_to_gcrf(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts a batch of itrf positions to the equivalent gcrf positions.
+ */
+static PyObject* itrf_to_gcrf_position_batch(PyObject* self, PyObject* args);
+
+/**
+ * @brief Converts a batch of gcrf positions to the equivalent itrf positions.
+ */
+static PyObject* gcrf_to_itrf_position_batch(PyObject* self, PyObject* args);
+
+/**
+ * @brief Converts a batch of itrf positions to geodetic coordinates with the double precision SIMD kernel, using the
+ * given geodetic algorithm or the model's when passed 0.
+ */
+static PyObject* itrf_to_geodetic_position_batch(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the double precision geodetic kernel in use and the best kernel the CPU supports.
+ */
+static PyObject* get_geodetic_kernel(PyObject* self, PyObject* args);
+
+/**
+ * @brief Force the double precision geodetic kernel batches are converted with.
+ */
+static PyObject* transform_set_geodetic_kernel(PyObject* self, PyObject* args);
+
+/**
+ * @brief Converts only the position of itrf coordinates to gcrf.
+ */
+static PyObject* itrf_to_gcrf_position(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts only the position of gcrf coordinates to itrf.
+ */
+static PyObject* gcrf_to_itrf_position(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts only the position of gcrf coordinates to geodetic.
+ */
+static PyObject* gcrf_to_geodetic_position(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Converts only the position of geodetic coordinates to gcrf.
+ */
+static PyObject* geodetic_to_gcrf_position(PyObject* self, PyObject* const* args, Py_ssize_t nargs);
+
+/**
+ * @brief Set the number of threads batched transforms are split across, 0 for one per online processor.
+ */
+static PyObject* set_num_threads(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the number of threads batched transforms are split across.
+ */
+static PyObject* get_num_threads(PyObject* self, PyObject* args);
 
 
 #ifdef __cplusplus
@@ -28,9 +28,11 @@
 extern "C" {
 #endif
 
-extern const long double ARCSECONDS_TO_RADIANS;
+#include "math/real.h"
 
-extern const long double ASTRO_UNIT_TO_METERS;
+extern const Real ARCSECONDS_TO_RADIANS;
+
+extern const Real ASTRO_UNIT_TO_METERS;
 
 #ifdef __cplusplus
 }   /* extern "C" */
@@ -28,6 +28,8 @@
 extern "C" {
 #endif /* __cplusplus */
 
+#include "math/real.h"
+
 /** @struct
  *  @brief A 3D vector
  *  @var Vec3::x
@@ -38,7 +40,7 @@ extern "C" {
  *  Member 'z' is the z component of the vector
  */
 typedef struct {
-    long double x, y, z;
+    Real x, y, z;
 } Vec3;
 
 /**
@@ -64,9 +66,9 @@ typedef struct {
  * Member 'w33' is the 3rd row, 3rd column element of the matrix
  */
 typedef struct {
-    long double w11, w12, w13;
-    long double w21, w22, w23;
-    long double w31, w32, w33;
+    Real w11, w12, w13;
+    Real w21, w22, w23;
+    Real w31, w32, w33;
 } Mat3;
 
 
@@ -88,6 +90,14 @@ void dot_product(Mat3* matrix, Vec3* vector, Vec3* product);
  */
 void dot_product_transpose(Mat3* matrix, Vec3* vector, Vec3* product);
 
+/**
+ * @brief Computes the product of two matrices
+ * @param left The left matrix
+ * @param right The right matrix
+ * @param product The matrix product left * right. May not alias either operand.
+ */
+void matrix_product(Mat3* left, Mat3* right, Mat3* product);
+
 /**
  * @brief Computes the cross product of two vectors
  * @param vector1 The first vector
@@ -107,7 +117,7 @@ void normalize(Vec3* vector);
  * @param vector The vector
  * @param mag The magnitude of the vector
  */
-void magnitude(Vec3* vector, long double* mag);
+void magnitude(Vec3* vector, Real* mag);
 
 
 #endif /* __compile_math_linear_algebra__ */
@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __MATH_REAL_H__
+#define __MATH_REAL_H__
+
+#if defined(_WIN32) || defined(WIN32)       /* _Win32 is usually defined by compilers targeting 32 or 64 bit Windows
+                                            systems */
+
+#define _USE_MATH_DEFINES
+
+#endif /* _WIN32 */
+
+/* The math functions are type generic so each call runs at the precision of its arguments in either build. */
+#include <tgmath.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief The floating point type of every vector, matrix, state and model field in the C core.
+ *
+ * The extended build keeps long double. Building with TOLUENE_DOUBLE_PRECISION gives the fast build, which trades the
+ * x87 registers for SSE/AVX doubles that the compiler can vectorize and halves the memory held by the models.
+ */
+#ifdef TOLUENE_DOUBLE_PRECISION
+typedef double Real;
+#else
+typedef long double Real;
+#endif /* TOLUENE_DOUBLE_PRECISION */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+
+#endif /* __MATH_REAL_H__ */
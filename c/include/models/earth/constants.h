@@ -28,23 +28,25 @@
 extern "C" {
 #endif
 
-extern const long double MEAN_OBLIQUITY_EARTH[6];
+#include "math/real.h"
 
-extern const long double GENERAL_PRECESSION_LONGITUDE[3];
-extern const long double PRECESSION_EQUATOR[6];
-extern const long double OBLIQUITY_MEAN_EQUATOR[6];
-extern const long double PRECESSION_ECLIPTIC_MEAN_EQUATOR[6];
+extern const Real MEAN_OBLIQUITY_EARTH[6];
 
-extern const long double ICRS_X_POLE_OFFSET;
-extern const long double ICRS_Y_POLE_OFFSET;
-extern const long double ICRS_RIGHT_ASCENSION_OFFSET;
+extern const Real GENERAL_PRECESSION_LONGITUDE[3];
+extern const Real PRECESSION_EQUATOR[6];
+extern const Real OBLIQUITY_MEAN_EQUATOR[6];
+extern const Real PRECESSION_ECLIPTIC_MEAN_EQUATOR[6];
 
-extern const long double GMST_FUNCTION_JULIAN_DU[6];
-extern const long double ERA_DUT1[2];
-extern const long double EQUATION_OF_ORIGINS[544];
+extern const Real ICRS_X_POLE_OFFSET;
+extern const Real ICRS_Y_POLE_OFFSET;
+extern const Real ICRS_RIGHT_ASCENSION_OFFSET;
 
-extern const long double CHANDLER_WOBBLE;
-extern const long double ANNUAL_WOBBLE;
+extern const Real GMST_FUNCTION_JULIAN_DU[6];
+extern const Real ERA_DUT1[2];
+extern const Real EQUATION_OF_ORIGINS[544];
+
+extern const Real CHANDLER_WOBBLE;
+extern const Real ANNUAL_WOBBLE;
 
 #ifdef __cplusplus
 }   /* extern "C" */
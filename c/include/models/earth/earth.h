@@ -28,27 +28,113 @@
 extern "C" {
 #endif
 
+#include "math/linear_algebra.h"
 #include "models/earth/earth_orientation_parameters.h"
 #include "models/earth/ellipsoid.h"
 #include "models/earth/geoid.h"
 #include "models/earth/nutation.h"
 #include "time/delta_t.h"
+#include "util/mapped_file.h"
+#include "util/rcu.h"
+#include "util/thread_pool.h"
+
+/** @struct
+ * @brief The composed rotation between the ITRF and the GCRF at a single epoch.
+ * @var FrameRotation::timestamp
+ * Member 'timestamp' is the epoch the rotation was computed for.
+ * @var FrameRotation::matrix
+ * Member 'matrix' is the fully composed GCRF to ITRF rotation, wobble * earth rotation * nutation * precession * bias.
+ * @var FrameRotation::derivative
+ * Member 'derivative' is the time derivative of 'matrix' due to Earth rotation in 1/s.
+ * @var FrameRotation::second_derivative
+ * Member 'second_derivative' is the second time derivative of 'matrix' due to Earth rotation in 1/s^2.
+ * @var FrameRotation::rate
+ * Member 'rate' is the rate of Earth rotation in rad/s.
+ * @var FrameRotation::valid
+ * Member 'valid' is non-zero once the entry holds a computed rotation.
+ * @var FrameRotation::derivatives
+ * Member 'derivatives' is non-zero if 'derivative', 'second_derivative' and 'rate' were computed along with 'matrix'.
+ * @var FrameRotation::version
+ * Member 'version' is the version of the Earth Orientation Parameters the rotation was computed with.
+ */
+typedef struct {
+    Real timestamp;
+    Mat3 matrix;
+    Mat3 derivative;
+    Mat3 second_derivative;
+    Real rate;
+    int valid;
+    int derivatives;
+    long version;
+} FrameRotation;
+
+/** @struct
+ * @brief A direct mapped cache of frame rotations keyed by epoch.
+ * @var FrameRotationCache::nentries
+ * Member 'nentries' is the number of slots in the cache. A cache with no slots is disabled.
+ * @var FrameRotationCache::entries
+ * Member 'entries' is the array of cached rotations.
+ * @var FrameRotationCache::hits
+ * Member 'hits' is the number of lookups answered from the cache.
+ * @var FrameRotationCache::misses
+ * Member 'misses' is the number of lookups that had to compute the rotation.
+ * @var FrameRotationCache::generation
+ * Member 'generation' is bumped whenever the cache is invalidated, a rotation composed across a bump is not stored.
+ * @var FrameRotationCache::lock
+ * Member 'lock' guards the entries and counters, lookups run with the GIL released and from the thread pool.
+ */
+typedef struct {
+    int nentries;
+    FrameRotation* entries;
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long generation;
+    Mutex lock;
+} FrameRotationCache;
+
+/** @struct
+ * @brief Where the last lookups into an Earth model's time tables landed, so a time ordered run of epochs can step
+ * through the tables instead of searching them for every epoch. Start from zeroes, any values are safe.
+ * @var EarthModelCursor::eop
+ * Member 'eop' is the index of the EOP record the last lookup landed on.
+ * @var EarthModelCursor::delta_t
+ * Member 'delta_t' is the index of the Delta T record the last lookup landed on.
+ */
+typedef struct {
+    int eop;
+    int delta_t;
+} EarthModelCursor;
 
 typedef struct {
 
     /* Earth Shape */
     Ellipsoid ellipsoid;
+    GeodeticAlgorithm geodetic_algorithm;
     Geoid geoid;
 
     /* Earth Motion */
     NutationSeries nutation_series;
-    EOPTable earth_orientation_parameters;
+    NutationSeries truncated_nutation_series;
+    NutationEphemeris nutation_ephemeris;
+    /* Published EOPTable, swapped whole so readers never wait on or see a table being replaced */
+    RCUPointer earth_orientation_parameters;
 
     /* Earth Time */
     DeltaTTable delta_t_table;
 
+    /* Derived */
+    FrameRotationCache rotation_cache;
+
+    /* Shared, the snapshot the tables point into once attached, no data otherwise */
+    MappedFile snapshot;
+
 } EarthModel;
 
+/**
+ * @brief Default number of epochs held in an Earth Model's frame rotation cache.
+ */
+#define DEFAULT_ROTATION_CACHE_SIZE 64
+
 
 #ifdef __compile_models_earth_earth__
 
@@ -69,16 +155,52 @@ static void delete_EarthModel(PyObject* obj);
  */
 static PyObject* earth_model_set_ellipsoid(PyObject* self, PyObject* args);
 
+/**
+ * @brief Set the algorithm the Earth Model inverts positions onto its Ellipsoid with
+ */
+static PyObject* earth_model_set_geodetic_algorithm(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the algorithm the Earth Model inverts positions onto its Ellipsoid with
+ */
+static PyObject* earth_model_get_geodetic_algorithm(PyObject* self, PyObject* args);
+
 /**
  * @brief Set the Earth Model's Nutation Series
  */
 static PyObject* earth_model_set_nutation_series(PyObject* self, PyObject* args);
 
 /**
- * @brief Set the Earth Model's Earth Orientation Parameters
+ * @brief Set the Earth Model's Nutation Ephemeris, or drop it when passed None
+ */
+static PyObject* earth_model_set_nutation_ephemeris(PyObject* self, PyObject* args);
+
+/**
+ * @brief Set the truncated Nutation Series the Earth Model evaluates in place of its full series, or go back to the
+ * full series when passed None
+ */
+static PyObject* earth_model_set_truncated_nutation_series(PyObject* self, PyObject* args);
+
+/**
+ * @brief Set how the Earth Model evaluates its Nutation Series
+ */
+static PyObject* earth_model_set_nutation_strategy(PyObject* self, PyObject* args);
+
+/**
+ * @brief Set the Earth Model's Earth Orientation Parameters, swapping the table in whole while other threads convert
  */
 static PyObject* earth_model_set_earth_orientation_parameters(PyObject* self, PyObject* args);
 
+/**
+ * @brief Set how the Earth Model interpolates its Earth Orientation Parameters between records
+ */
+static PyObject* earth_model_set_eop_interpolation(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the version of the Earth Model's Earth Orientation Parameters, counting the tables swapped in
+ */
+static PyObject* earth_model_get_eop_version(PyObject* self, PyObject* args);
+
 /**
  * @brief Get the Earth Model's Ellipsoid
  */
@@ -114,6 +236,38 @@ static PyObject* earth_model_set_delta_t_table(PyObject* self, PyObject* args);
  */
 static PyObject* earth_model_get_delta_t_table(PyObject* self, PyObject* args);
 
+/**
+ * @brief Resize the Earth Model's frame rotation cache, dropping all cached epochs.
+ */
+static PyObject* earth_model_set_rotation_cache_size(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the Earth Model's frame rotation cache size, hits and misses.
+ */
+static PyObject* earth_model_get_rotation_cache_statistics(PyObject* self, PyObject* args);
+
+/**
+ * @brief Drop all cached epochs from the Earth Model's frame rotation cache and reset its counters.
+ */
+static PyObject* earth_model_clear_rotation_cache(PyObject* self, PyObject* args);
+
+/**
+ * @brief Save the Earth Model's tables to a snapshot file.
+ */
+static PyObject* earth_model_save(PyObject* self, PyObject* args);
+
+/**
+ * @brief Replace the Earth Model's tables with those of a snapshot file, dropping its truncated series, nutation
+ * ephemeris and cached rotations.
+ */
+static PyObject* earth_model_load(PyObject* self, PyObject* args);
+
+/**
+ * @brief Point the Earth Model's tables into a read only mapping of a snapshot file shared with every other process
+ * attached to it, dropping its truncated series, nutation ephemeris and cached rotations.
+ */
+static PyObject* earth_model_attach(PyObject* self, PyObject* args);
+
 
 #endif /* __compile_models_earth_earth__ */
 
@@ -28,54 +28,211 @@
 extern "C" {
 #endif
 
+#include "math/real.h"
+
 /** @struct
  * @brief Earth Orientation Parameters Table Record
  * */
 typedef struct {
 
-    long double timestamp;
+    Real timestamp;
 
     int is_bulletin_a_PM_predicted;
-    long double bulletin_a_PM_x;
-    long double bulletin_a_PM_x_error;
-    long double bulletin_a_PM_y;
-    long double bulletin_a_PM_y_error;
+    Real bulletin_a_PM_x;
+    Real bulletin_a_PM_x_error;
+    Real bulletin_a_PM_y;
+    Real bulletin_a_PM_y_error;
 
     int is_bulletin_a_dut1_predicted;
-    long double bulletin_a_dut1;
-    long double bulletin_a_dut1_error;
+    Real bulletin_a_dut1;
+    Real bulletin_a_dut1_error;
 
-    long double bulletin_a_lod;
-    long double bulletin_a_lod_error;
+    Real bulletin_a_lod;
+    Real bulletin_a_lod_error;
 
-    long double bulletin_b_PM_x;
-    long double bulletin_b_PM_y;
-    long double bulletin_b_dut1;
+    Real bulletin_b_PM_x;
+    Real bulletin_b_PM_y;
+    Real bulletin_b_dut1;
 
 } EOPTableRecord;
 
+/** @enum
+ *  @brief Ways of evaluating the Earth Orientation Parameters between the daily records of the table.
+ */
+typedef enum {
+    NearestEOPInterpolation  = 1,
+    LinearEOPInterpolation   = 2,
+    LagrangeEOPInterpolation = 3
+} EOPInterpolation;
+
+/**
+ * @brief Largest jump in dUT1 between neighbouring records taken as the motion of UT1 rather than a leap second, in
+ * the units of the table, seconds.
+ */
+#define EOP_LEAP_SECOND_THRESHOLD 0.5
+
+/**
+ * @brief Modified Julian Date of the UNIX epoch.
+ */
+#define MJD_UNIX_EPOCH 40587
+
+/**
+ * @brief Seconds in a UTC day without a leap second, the spacing of the finals2000A records in UNIX time.
+ */
+#define SECONDS_PER_DAY_UTC 86400.0
+
+/**
+ * @brief Number of values in each row of a buffer of records, in the order of the EOPTableRecord members.
+ */
+#define EOP_RECORD_NVALUES 14
+
+/**
+ * @brief Number of double columns the frame transforms read, timestamp, PM x, PM y, dUT1 and LOD in that order.
+ */
+#define EOP_TABLE_NCOLUMNS 5
+
+/** @struct
+ * @brief The Earth Orientation Parameters the frame transforms read, interpolated to a time.
+ * @var EOPValues::PM_x
+ * Member 'PM_x' is the Bulletin A polar motion x in arcseconds.
+ * @var EOPValues::PM_y
+ * Member 'PM_y' is the Bulletin A polar motion y in arcseconds.
+ * @var EOPValues::dut1
+ * Member 'dut1' is the Bulletin A dUT1 in the units of the table.
+ * @var EOPValues::lod
+ * Member 'lod' is the Bulletin A excess length of day in the units of the table.
+ */
+typedef struct {
+    Real PM_x;
+    Real PM_y;
+    Real dut1;
+    Real lod;
+} EOPValues;
+
 /** @struct
  * @brief Earth Orientation Parameters Table
+ * @var EOPTable::nrecords
+ * Member 'nrecords' is the number of records in the table.
+ * @var EOPTable::nrecords_allocated
+ * Member 'nrecords_allocated' is the number of records allocated in the table.
+ * @var EOPTable::records
+ * Member 'records' is the records sorted by timestamp.
+ * @var EOPTable::start
+ * Member 'start' is the timestamp of the first record.
+ * @var EOPTable::step
+ * Member 'step' is the spacing of the indexed records in seconds, one day for finals2000A.
+ * @var EOPTable::nindexed
+ * Member 'nindexed' is the number of leading records spaced exactly 'step' apart, found by computing their slot from
+ * the timestamp instead of searching.
+ * @var EOPTable::interpolation
+ * Member 'interpolation' is how the parameters are evaluated between records.
+ * @var EOPTable::ncolumns
+ * Member 'ncolumns' is the number of records copied into the columns, kept equal to nrecords.
+ * @var EOPTable::column_stride
+ * Member 'column_stride' is the allocated length of each column.
+ * @var EOPTable::columns
+ * Member 'columns' is the structure of arrays copy in double precision of the record members the transforms read,
+ * EOP_TABLE_NCOLUMNS columns of 'column_stride' values. Forty bytes a day keep decades of records in cache where the
+ * full records, with their errors and Bulletin B values, take several times that.
  * */
 typedef struct {
     int nrecords;
     int nrecords_allocated;
     EOPTableRecord* records;
+    Real start;
+    Real step;
+    int nindexed;
+    EOPInterpolation interpolation;
+    int ncolumns;
+    int column_stride;
+    double* columns;
 } EOPTable;
 
+/**
+ * @brief Find the record at or before a timestamp by binary search, clamped to the table.
+ *
+ * @param table The EOP table, must hold at least one record.
+ * @param timestamp Unix time
+ * @return The index of the record.
+ */
+int eop_table_search(EOPTable* table, double timestamp);
 
-#ifdef __compile_models_earth_earth_orientation_parameters__
+/**
+ * @brief Find the record at or before a timestamp, computing the slot directly for timestamps inside the uniformly
+ * spaced run of records and searching outside of it.
+ *
+ * @param table The EOP table, must hold at least one record.
+ * @param timestamp Unix time
+ * @return The index of the record.
+ */
+int eop_table_index(EOPTable* table, double timestamp);
+
+/**
+ * @brief Find the record at or before a timestamp starting from where the previous lookup landed. A time ordered run of
+ * epochs stays in the same interval or steps into the next one, anything else falls back to eop_table_index.
+ *
+ * @param table The EOP table, must hold at least one record.
+ * @param timestamp Unix time
+ * @param cursor The index of the previous lookup, updated to this one. Any value is safe, the table may have changed
+ * since it was set.
+ * @return The index of the record.
+ */
+int eop_table_cursor_index(EOPTable* table, double timestamp, int* cursor);
+
+/**
+ * @brief Look up polar motion, dUT1 and LOD for a given timestamp from the table's columns, interpolated between the
+ * records as set by the table's interpolation. All zero for an empty table.
+ *
+ * @param table The EOP table.
+ * @param timestamp Unix time
+ * @param values The parameters at the timestamp.
+ */
+void eop_table_values_lookup(EOPTable* table, double timestamp, EOPValues* values);
 
 /**
- * @brief Look up the EOP table record for a given timestamp
+ * @brief Look up polar motion, dUT1 and LOD for a given timestamp, finding the records from a cursor if given.
+ *
+ * @param table The EOP table.
+ * @param timestamp Unix time
+ * @param cursor The index of the previous lookup as for eop_table_cursor_index, NULL to search the table.
+ * @param values The parameters at the timestamp.
+ */
+void eop_table_values_lookup_from(EOPTable* table, double timestamp, int* cursor, EOPValues* values);
+
+/**
+ * @brief Look up the EOP table record for a given timestamp. Polar motion, dUT1 and LOD are interpolated between the
+ * records as set by the table's interpolation, the other members are those of the record at or before the timestamp.
  */
 void eop_table_record_lookup(EOPTable* table, double timestamp, EOPTableRecord* record);
 
+
+#ifdef __compile_models_earth_earth_orientation_parameters__
+
 /**
  * @brief Add a record to the EOP table
  */
 static PyObject* eop_table_add_record(PyObject* self, PyObject* args);
 
+/**
+ * @brief Add a buffer of records to the EOP table, reserving room for all of them at once and sorting once at the end
+ */
+static PyObject* eop_table_add_records(PyObject* self, PyObject* args);
+
+/**
+ * @brief Load the records of an IERS finals2000A file into the EOP table
+ */
+static PyObject* eop_table_load_file(PyObject* self, PyObject* args);
+
+/**
+ * @brief Set how an EOP table is interpolated between records
+ */
+static PyObject* eop_table_set_interpolation(PyObject* self, PyObject* args);
+
+/**
+ * @brief Evaluate polar motion, dUT1 and LOD at a buffer of times, used to compare the lookups and interpolations
+ */
+static PyObject* eop_table_interpolate(PyObject* self, PyObject* args);
+
 /**
  * @brief Create a new EOP table
  */
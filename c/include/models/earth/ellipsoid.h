@@ -28,6 +28,8 @@
 extern "C" {
 #endif
 
+#include "math/real.h"
+
 
 /** @struct
  * @brief The Ellipsoid object
@@ -39,10 +41,22 @@ extern "C" {
  * Member 'b' contains the semi-minor axis
  */
 typedef struct {
-    long double a;   /* Semi-major axis */
-    long double b;   /* Semi-minor axis */
+    Real a;   /* Semi-major axis */
+    Real b;   /* Semi-minor axis */
 } Ellipsoid;
 
+/** @enum
+ *  @brief Algorithms inverting a Cartesian position onto the ellipsoid for its geodetic latitude and height. The
+ *  alternatives to the closed form hold outside the ellipsoid's evolute, a few tens of kilometers around the center.
+ */
+typedef enum {
+    ClosedFormGeodeticAlgorithm = 1,    /* Heikkinen's closed form, as given by Zhu */
+    BowringGeodeticAlgorithm    = 2,    /* One iteration of Bowring's method */
+    Bowring2GeodeticAlgorithm   = 3,    /* Two iterations of Bowring's method */
+    VermeilleGeodeticAlgorithm  = 4,    /* Vermeille's closed form */
+    FukushimaGeodeticAlgorithm  = 5     /* One Halley step of Fukushima's method */
+} GeodeticAlgorithm;
+
 
 #ifdef __compile_models_earth_ellipsoid__
 
@@ -56,6 +56,8 @@ static PyObject* add_interpolation(PyObject* self, PyObject* args);
 
 static PyObject* add_coefficient(PyObject* self, PyObject* args);
 
+static PyObject* add_coefficients(PyObject* self, PyObject* args);
+
 #endif /* __compile_models_earth_geoid__ */
 
 
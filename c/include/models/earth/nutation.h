@@ -28,6 +28,8 @@
 extern "C" {
 #endif /* __cplusplus */
 
+#include "math/real.h"
+
 /** @struct
  * @brief A record of the nutation series.
  * @var NutationSeriesRecord::heliocentric_elliptical_longitude_mercury_coefficient
@@ -96,9 +98,40 @@ typedef struct {
     int mean_argument_of_latitude_moon_coefficient;
     int mean_elongation_moon_from_the_sun_coefficient;
     int mean_longitude_of_moon_mean_ascending_node_coefficient;
-    long double S, S_dot, C_prime, C, C_dot, S_prime;
+    Real S, S_dot, C_prime, C, C_dot, S_prime;
 } NutationSeriesRecord;
 
+/** @enum
+ *  @brief Ways of evaluating a nutation series.
+ */
+typedef enum {
+    ExtendedNutationStrategy   = 1,
+    VectorizedNutationStrategy = 2,
+    RecurrenceNutationStrategy = 3
+} NutationStrategy;
+
+/**
+ * @brief Strategy new series and models start with. The vectorized kernels sum in double, so only the double precision
+ * build uses them by default and the extended build keeps its long double sums.
+ */
+#ifdef TOLUENE_DOUBLE_PRECISION
+#define DEFAULT_NUTATION_STRATEGY VectorizedNutationStrategy
+#else
+#define DEFAULT_NUTATION_STRATEGY ExtendedNutationStrategy
+#endif /* TOLUENE_DOUBLE_PRECISION */
+
+/**
+ * @brief Largest multiple of a fundamental argument the recurrence strategy tabulates, larger multiples are evaluated
+ * directly.
+ */
+#define NUTATION_RECURRENCE_MAX_MULTIPLE 32
+
+/**
+ * @brief Number of values in each row of a buffer of nutation records, the 14 argument multipliers followed by S,
+ * S_dot, C_prime, C, C_dot and S_prime.
+ */
+#define NUTATION_RECORD_NVALUES 20
+
 /** @struct
  * @brief A series of nutation records.
  * @var NutationSeries::nrecords
@@ -107,13 +140,54 @@ typedef struct {
  * Member 'nrecords_allocated' is the number of records allocated in the series.
  * @var NutationSeries::records
  * Member 'records' is the array of records.
+ * @var NutationSeries::strategy
+ * Member 'strategy' is how the series is evaluated, over the records, over the double columns or by
+ * recurrence over the records.
+ * @var NutationSeries::ncolumns
+ * Member 'ncolumns' is the number of records copied into the columns, they are stale when it differs from nrecords.
+ * @var NutationSeries::column_stride
+ * Member 'column_stride' is the padded length of each column.
+ * @var NutationSeries::columns
+ * Member 'columns' is the structure of arrays copy of the records in double precision.
  */
 typedef struct {
     int nrecords;
     int nrecords_allocated;
     NutationSeriesRecord* records;
+    NutationStrategy strategy;
+    int ncolumns;
+    int column_stride;
+    double* columns;
 } NutationSeries;
 
+/** @struct
+ * @brief Chebyshev fit of the nutation values of date over a span of time.
+ * @var NutationEphemeris::start
+ * Member 'start' is the Unix time the ephemeris starts at.
+ * @var NutationEphemeris::end
+ * Member 'end' is the Unix time the ephemeris ends at.
+ * @var NutationEphemeris::interval
+ * Member 'interval' is the length of each segment in seconds.
+ * @var NutationEphemeris::nsegments
+ * Member 'nsegments' is the number of equal length segments the span is split into.
+ * @var NutationEphemeris::ncoefficients
+ * Member 'ncoefficients' is the number of Chebyshev coefficients per quantity per segment.
+ * @var NutationEphemeris::max_error
+ * Member 'max_error' is the largest error against the series seen while fitting in arcseconds.
+ * @var NutationEphemeris::coefficients
+ * Member 'coefficients' holds, for each segment, the coefficients of the nutation in longitude, the nutation in
+ * obliquity and the equation of the equinoxes in that order.
+ */
+typedef struct {
+    Real start;
+    Real end;
+    Real interval;
+    int nsegments;
+    int ncoefficients;
+    Real max_error;
+    Real* coefficients;
+} NutationEphemeris;
+
 
 #ifdef __compile_models_earth_nutation__
 
@@ -122,13 +196,77 @@ typedef struct {
 /**
  * @brief Compute nutation values of date along with the equation of the equinoxes.
  */
-void nutation_values_of_date(long double t, NutationSeries* series, long double* nutation_longitude,
-    long double* nutation_obliquity, long double* mean_obliquity_date, long double* equation_of_the_equinoxes);
+void nutation_values_of_date(Real t, NutationSeries* series, Real* nutation_longitude,
+    Real* nutation_obliquity, Real* mean_obliquity_date, Real* equation_of_the_equinoxes);
+
+/**
+ * @brief Tabulate the cosine and sine of the multiples of a set of angles by repeated complex multiplication.
+ *
+ * @param arguments The angles in radians.
+ * @param narguments The number of angles.
+ * @param max_multiple The largest multiple tabulated, at most NUTATION_RECURRENCE_MAX_MULTIPLE.
+ * @param table Receives cos and sin of m * arguments[k] at table[2 * (k * (max_multiple + 1) + m)] for m from 0 to
+ * max_multiple.
+ */
+void argument_multiple_table(const Real* arguments, int narguments, int max_multiple, Real* table);
+
+/**
+ * @brief Cosine and sine of an integer combination of tabulated angles, built by complex multiplication.
+ *
+ * @return Non-zero on success, 0 if a multiplier is larger than the table.
+ */
+int argument_combination(const Real* table, const int* multipliers, int narguments, int max_multiple,
+    Real* cos_value, Real* sin_value);
+
+/**
+ * @brief Fit a Chebyshev ephemeris of the nutation values of date to a series.
+ *
+ * The span is split into equal segments which are halved until every segment reproduces the series to within the
+ * tolerance at points between the fitting nodes.
+ *
+ * @param series The nutation series to fit.
+ * @param start Unix time the ephemeris starts at.
+ * @param end Unix time the ephemeris ends at.
+ * @param tolerance The largest acceptable error in arcseconds.
+ * @param degree The degree of the Chebyshev polynomial of each segment.
+ * @param ephemeris The fitted ephemeris. Its coefficients are allocated and owned by the caller.
+ * @return 0 on success, 1 if the tolerance could not be reached with segments of a minute or more and -1 if memory
+ * could not be allocated.
+ */
+int fit_nutation_ephemeris(NutationSeries* series, Real start, Real end, Real tolerance,
+    int degree, NutationEphemeris* ephemeris);
+
+/**
+ * @brief Evaluate the nutation values of date from a Chebyshev ephemeris.
+ *
+ * @return Non-zero if the ephemeris covers t and the values were written, 0 otherwise.
+ */
+int nutation_ephemeris_values_of_date(Real t, NutationEphemeris* ephemeris, Real* nutation_longitude,
+    Real* nutation_obliquity, Real* mean_obliquity_date, Real* equation_of_the_equinoxes);
+
+/**
+ * @brief Build a truncated copy of a nutation series keeping only its largest terms.
+ *
+ * A term's amplitude is the largest of |S|, |C|, |S'| and |C'|. Terms below the threshold are dropped and, when
+ * max_terms is positive, only the max_terms largest of the rest are kept. Kept terms stay in series order.
+ *
+ * @param series The full nutation series.
+ * @param threshold The smallest amplitude kept in arcseconds.
+ * @param max_terms The largest number of terms kept, or 0 to keep every term above the threshold.
+ * @param truncated The truncated series. Its records are allocated and owned by the caller.
+ * @param error_bound The sum of the dropped amplitudes within a century of J2000, a hard bound on the error of the
+ * nutation in longitude and obliquity in arcseconds.
+ * @param max_error The largest error of the nutation in longitude and obliquity against the full series seen between
+ * 1950 and 2050 in arcseconds.
+ * @return 0 on success and -1 if memory could not be allocated.
+ */
+int truncate_nutation_series(NutationSeries* series, Real threshold, int max_terms, NutationSeries* truncated,
+    Real* error_bound, Real* max_error);
 
 /**
  * @brief Compute the nutation series.
  */
-void nutation_matrix(long double mean_obliquity_date, long double nutation_longitude, long double true_obliquity_date,
+void nutation_matrix(Real mean_obliquity_date, Real nutation_longitude, Real true_obliquity_date,
     Mat3* nutation_matrix);
 
 /**
@@ -136,6 +274,11 @@ void nutation_matrix(long double mean_obliquity_date, long double nutation_longi
  */
 static PyObject* nutation_series_add_record(PyObject* self, PyObject* args);
 
+/**
+ * @brief Add a buffer of records to the nutation series, reserving room for all of them at once.
+ */
+static PyObject* nutation_series_add_records(PyObject* self, PyObject* args);
+
 /**
  * @brief Create a new nutation series object available in Python.
  */
@@ -146,6 +289,51 @@ static PyObject* new_NutationSeries(PyObject* self, PyObject* args);
  */
 static void delete_NutationSeries(PyObject* obj);
 
+/**
+ * @brief Set how a nutation series is evaluated.
+ */
+static PyObject* set_nutation_strategy(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the double precision kernel in use and the best kernel the CPU supports.
+ */
+static PyObject* get_nutation_kernel(PyObject* self, PyObject* args);
+
+/**
+ * @brief Force the double precision kernel this module evaluates nutation series with.
+ */
+static PyObject* nutation_set_kernel(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the number of terms in a nutation series.
+ */
+static PyObject* nutation_series_size(PyObject* self, PyObject* args);
+
+/**
+ * @brief Create a truncated copy of a nutation series or an Earth model's series.
+ */
+static PyObject* truncate_NutationSeries(PyObject* self, PyObject* args);
+
+/**
+ * @brief Create a new nutation ephemeris fitted to a nutation series or an Earth model's series.
+ */
+static PyObject* new_NutationEphemeris(PyObject* self, PyObject* args);
+
+/**
+ * @brief Delete a nutation ephemeris object available in Python.
+ */
+static void delete_NutationEphemeris(PyObject* obj);
+
+/**
+ * @brief Get the span, number of segments, degree and fitting error of a nutation ephemeris.
+ */
+static PyObject* nutation_ephemeris_info(PyObject* self, PyObject* args);
+
+/**
+ * @brief Get the nutation values of date from a nutation series or a nutation ephemeris.
+ */
+static PyObject* get_nutation_values(PyObject* self, PyObject* args);
+
 
 #endif /* __compile_models_earth_nutation */
 
@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __MODELS_EARTH_NUTATION_KERNEL_H__
+#define __MODELS_EARTH_NUTATION_KERNEL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "models/earth/nutation.h"
+
+/** @enum
+ *  @brief Instruction sets the double precision nutation kernel can run on.
+ */
+typedef enum {
+    ScalarNutationKernel = 1,
+    AVX2NutationKernel   = 2,
+    AVX512NutationKernel = 3
+} NutationKernel;
+
+/**
+ * @brief Number of columns of a nutation series in structure of arrays form, the 14 argument multipliers followed by
+ * S, S_dot, C_prime, C, C_dot and S_prime.
+ */
+#define NUTATION_SERIES_NCOLUMNS 20
+
+
+#ifdef __compile_models_earth_nutation_kernel__
+
+/**
+ * @brief Check whether the double precision columns of a nutation series match its records.
+ *
+ * This only reads the series, so it is safe without the GIL. The columns themselves are only ever rebuilt by
+ * nutation_series_columns with the GIL held.
+ *
+ * @return 1 if the columns are up to date and 0 otherwise.
+ */
+int nutation_series_columns_current(const NutationSeries* series);
+
+/**
+ * @brief Bring the double precision columns of a nutation series up to date with its records.
+ *
+ * Each column is padded with zero terms to a multiple of eight so the kernels never need a remainder loop. Stale
+ * columns are freed and replaced, so this must only be called with the GIL held or on a series no other thread sees.
+ *
+ * @return 0 on success and -1 if memory could not be allocated.
+ */
+int nutation_series_columns(NutationSeries* series);
+
+/**
+ * @brief Sum the nutation terms held in a series' columns.
+ *
+ * @param series The series, its columns must be up to date.
+ * @param arguments The 14 fundamental arguments in radians, reduced to a single turn.
+ * @param t Julian centuries since J2000.
+ * @param sums The nutation in longitude, nutation in obliquity and the equation of the equinoxes terms in arcseconds.
+ */
+void nutation_kernel_sum(NutationSeries* series, const double* arguments, double t, double* sums);
+
+/**
+ * @brief Get the kernel sums are currently computed with.
+ */
+NutationKernel nutation_kernel(void);
+
+/**
+ * @brief Get the best kernel the CPU supports.
+ */
+NutationKernel nutation_kernel_supported(void);
+
+/**
+ * @brief Force the kernel sums are computed with, used to compare kernels against one another.
+ *
+ * @return 0 on success and -1 if the CPU does not support the kernel.
+ */
+int set_nutation_kernel(NutationKernel kernel);
+
+#endif /* __compile_models_earth_nutation_kernel__ */
+
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __MODELS_EARTH_NUTATION_KERNEL_H__ */
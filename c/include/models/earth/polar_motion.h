@@ -38,7 +38,16 @@ extern "C" {
  * @param t Time in seconds since J2000.0.
  * @param matrix Output matrix.
  * */
-void wobble(long double t, EOPTable* earth_orientation_parameter_table, Mat3* matrix);
+void wobble(Real t, EOPTable* earth_orientation_parameter_table, Mat3* matrix);
+
+/**
+ * @brief Polar motion matrix for time T from Earth orientation parameters already looked up.
+ *
+ * @param t Unix time
+ * @param eop The Earth orientation parameters at t.
+ * @param matrix Output matrix.
+ * */
+void polar_motion_matrix(Real t, const EOPValues* eop, Mat3* matrix);
 
 
 #ifdef __cplusplus
@@ -36,7 +36,7 @@ extern "C" {
  * @param t Time in seconds since J2000.0.
  * @param matrix Output matrix.
  * */
-void iau_2000a_precession(long double t, Mat3* matrix);
+void iau_2000a_precession(Real t, Mat3* matrix);
 
 
 #ifdef __cplusplus
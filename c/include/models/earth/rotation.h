@@ -36,7 +36,17 @@ extern "C" {
  *
  * @param[in] t seconds since J2000.0.
  */
-void gmst(long double t, EarthModel* model, long double* gmst);
+void gmst(Real t, EarthModel* model, Real* gmst);
+
+/**
+ * @brief Calculate the Greenwich Mean Sidereal Time (GMST) from dUT1 and Delta T already looked up.
+ *
+ * @param[in] t Unix time
+ * @param[in] dut1 UT1-UTC at t in ms.
+ * @param[in] delta_t TT-UT1 at t in s.
+ * @param[out] gmst the Greenwich Mean Sidereal Time in s.
+ */
+void gmst_of_values(Real t, Real dut1, Real delta_t, Real* gmst);
 
 /**
  * @brief Calculate the Earth rotation matrix.
@@ -44,7 +54,17 @@ void gmst(long double t, EarthModel* model, long double* gmst);
  * @param[in] angle angle of rotation.
  * @param[out] matrix rotation matrix.
  */
-void earth_rotation_matrix(long double angle, Mat3* matrix);
+void earth_rotation_matrix(Real angle, Mat3* matrix);
+
+/**
+ * @brief Calculate the first and second time derivatives of the Earth rotation matrix.
+ *
+ * @param[in] angle angle of rotation.
+ * @param[in] rate rate of rotation in rad/s.
+ * @param[out] first the first time derivative.
+ * @param[out] second the second time derivative.
+ */
+void earth_rotation_matrix_derivatives(Real angle, Real rate, Mat3* first, Mat3* second);
 
 /**
  * @brief Calculate the Earth rotation angle.
@@ -53,16 +73,18 @@ void earth_rotation_matrix(long double angle, Mat3* matrix);
  * @param[in] model Earth model
  * @param[out] era the Earth rotation angle in rad.
  */
-void earth_rotation_angle(long double t, EarthModel* model, long double* era);
+void earth_rotation_angle(Real t, EarthModel* model, Real* era);
 
 /**
  * @brief Calculate the equation of origins.
  *
  * @param[in] t Unix time
+ * @param[in] strategy RecurrenceNutationStrategy builds the sines and cosines of the terms from those of the
+ * fundamental arguments, any other strategy evaluates every term directly.
  * @param[out] eo the equation of origins in rad.
  */
-void equation_of_origins(long double t, long double nutation_longitude, long double mean_obliquity_date,
-    long double* eo);
+void equation_of_origins(Real t, Real nutation_longitude, Real mean_obliquity_date,
+    NutationStrategy strategy, Real* eo);
 
 /**
  * @brief Calculate the Greenwich Apparent Sidereal Time (GAST).
@@ -71,8 +93,8 @@ void equation_of_origins(long double t, long double nutation_longitude, long dou
  * @param[in] model Earth model
  * @param[out] gast the Greenwich Apparent Sidereal Time in rad.
  */
-void gast_2000(long double t, EarthModel* model, long double nutation_longitude, long double mean_obliquity_date,
-    long double* gast);
+void gast_2000(Real t, EarthModel* model, Real nutation_longitude, Real mean_obliquity_date,
+    Real* gast);
 
 /**
  * @brief Calculate the Earth rotation matrix.
@@ -81,7 +103,62 @@ void gast_2000(long double t, EarthModel* model, long double nutation_longitude,
  * @param[in] model Earth model
  * @param[out] rate the rotation rate in rad/s.
  */
-void rate_of_earth_rotation(long double t, EarthModel* model, long double* rate);
+void rate_of_earth_rotation(Real t, EarthModel* model, Real* rate);
+
+/**
+ * @brief Compose the full GCRF to ITRF rotation for an epoch.
+ *
+ * Composes wobble * earth rotation * nutation * precession * bias into a single matrix along with its first and
+ * second time derivatives so positions, velocities and accelerations each cross frames with one product per vector.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[out] rotation the composed frame rotation.
+ */
+void frame_rotation_of_date(Real t, EarthModel* model, FrameRotation* rotation);
+
+/**
+ * @brief Look up the composed frame rotation for an epoch in the Earth model's cache, computing it on a miss.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the table lookups of a miss start from, NULL to search the tables. Sharing one across
+ * a time ordered run of epochs steps through the tables instead of searching them for every epoch.
+ * @param[out] rotation the composed frame rotation.
+ */
+void cached_frame_rotation(Real t, EarthModel* model, EarthModelCursor* cursor, FrameRotation* rotation);
+
+/**
+ * @brief Compose only the GCRF to ITRF rotation matrix for an epoch, for converting positions.
+ *
+ * Skips the rate of Earth rotation lookup and the derivative products, 'derivatives' is left zero.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[out] rotation the composed frame rotation without its derivatives.
+ */
+void frame_rotation_matrix_of_date(Real t, EarthModel* model, FrameRotation* rotation);
+
+/**
+ * @brief Look up the frame rotation matrix for an epoch in the Earth model's cache, composing only the matrix on a
+ * miss. Cached rotations with derivatives are used as well.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the table lookups of a miss start from, NULL to search the tables.
+ * @param[out] rotation the composed frame rotation, its derivatives only valid if 'derivatives' is set.
+ */
+void cached_frame_rotation_matrix(Real t, EarthModel* model, EarthModelCursor* cursor, FrameRotation* rotation);
+
+/**
+ * @brief Build everything the frame rotation fills in lazily, so the rotation can be composed with the GIL released.
+ *
+ * Must be called with the GIL held before any cached_frame_rotation call that runs without it.
+ *
+ * @param[in] model Earth model
+ * @return 0 on success and -1 if memory could not be allocated.
+ */
+int prepare_frame_rotation(EarthModel* model);
 
 #ifdef __cplusplus
 }   /* extern "C" */
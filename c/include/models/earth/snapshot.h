@@ -0,0 +1,205 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __MODELS_EARTH_SNAPSHOT_H__
+#define __MODELS_EARTH_SNAPSHOT_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "models/earth/earth.h"
+
+/**
+ * @brief The first eight bytes of every Earth Model snapshot.
+ */
+#define EARTH_MODEL_SNAPSHOT_MAGIC "TOLUENEM"
+
+/**
+ * @brief Version of the snapshot layout, bumped whenever the header, the sections or the records change.
+ */
+#define EARTH_MODEL_SNAPSHOT_VERSION 3
+
+/**
+ * @brief Alignment of every section in the file, so each can be used in place from a mapping of the file.
+ */
+#define EARTH_MODEL_SNAPSHOT_ALIGNMENT 64
+
+/** @enum
+ *  @brief The tables a snapshot section holds.
+ */
+typedef enum {
+    EllipsoidSnapshotSection          = 1,
+    NutationRecordsSnapshotSection    = 2,
+    NutationColumnsSnapshotSection    = 3,
+    EOPRecordsSnapshotSection         = 4,
+    EOPColumnsSnapshotSection         = 5,
+    DeltaTRecordsSnapshotSection      = 6,
+    GeoidInterpolationSnapshotSection = 7,
+    GeoidCoefficientsSnapshotSection  = 8
+} EarthModelSnapshotSectionKind;
+
+/** @struct
+ * @brief The header at the start of a snapshot, followed by its section table.
+ * @var EarthModelSnapshotHeader::magic
+ * Member 'magic' is EARTH_MODEL_SNAPSHOT_MAGIC without its terminator.
+ * @var EarthModelSnapshotHeader::version
+ * Member 'version' is the EARTH_MODEL_SNAPSHOT_VERSION the snapshot was written with.
+ * @var EarthModelSnapshotHeader::real_size
+ * Member 'real_size' is sizeof(Real) of the build that wrote the snapshot, the records are stored as they are held in
+ * memory so a snapshot only loads into a build of the same precision.
+ * @var EarthModelSnapshotHeader::size
+ * Member 'size' is the size of the whole file in bytes.
+ * @var EarthModelSnapshotHeader::checksum
+ * Member 'checksum' is the checksum of the whole file taken with this member zero.
+ * @var EarthModelSnapshotHeader::nsections
+ * Member 'nsections' is the number of entries in the section table.
+ * @var EarthModelSnapshotHeader::nutation_strategy
+ * Member 'nutation_strategy' is how the nutation series is evaluated.
+ * @var EarthModelSnapshotHeader::nutation_column_stride
+ * Member 'nutation_column_stride' is the padded length of each nutation column, 0 without a columns section.
+ * @var EarthModelSnapshotHeader::eop_interpolation
+ * Member 'eop_interpolation' is how the EOP table is interpolated between records.
+ * @var EarthModelSnapshotHeader::eop_nindexed
+ * Member 'eop_nindexed' is the number of uniformly spaced records at the start of the EOP table.
+ * @var EarthModelSnapshotHeader::delta_t_interpolation
+ * Member 'delta_t_interpolation' is how the Delta T table is interpolated between records.
+ * @var EarthModelSnapshotHeader::delta_t_extrapolation
+ * Member 'delta_t_extrapolation' is how the Delta T table is extrapolated outside its records.
+ * @var EarthModelSnapshotHeader::geodetic_algorithm
+ * Member 'geodetic_algorithm' is the algorithm positions are inverted onto the ellipsoid with.
+ * @var EarthModelSnapshotHeader::eop_start
+ * Member 'eop_start' is the timestamp of the first EOP record.
+ * @var EarthModelSnapshotHeader::eop_step
+ * Member 'eop_step' is the spacing of the uniformly spaced EOP records.
+ * @var EarthModelSnapshotHeader::geoid_interpolation_spacing
+ * Member 'geoid_interpolation_spacing' is the spacing of the geoid grid in degrees, 0 without a grid.
+ */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t real_size;
+    uint64_t size;
+    uint64_t checksum;
+    uint32_t nsections;
+    int32_t nutation_strategy;
+    int32_t nutation_column_stride;
+    int32_t eop_interpolation;
+    int32_t eop_nindexed;
+    int32_t delta_t_interpolation;
+    int32_t delta_t_extrapolation;
+    int32_t geodetic_algorithm;
+    double eop_start;
+    double eop_step;
+    double geoid_interpolation_spacing;
+} EarthModelSnapshotHeader;
+
+/** @struct
+ * @brief An entry of the section table.
+ * @var EarthModelSnapshotSection::kind
+ * Member 'kind' is the table the section holds.
+ * @var EarthModelSnapshotSection::element_size
+ * Member 'element_size' is the size of each element in bytes, checked against the build loading the snapshot.
+ * @var EarthModelSnapshotSection::count
+ * Member 'count' is the number of elements in the section.
+ * @var EarthModelSnapshotSection::offset
+ * Member 'offset' is the offset of the section from the start of the file, a multiple of
+ * EARTH_MODEL_SNAPSHOT_ALIGNMENT.
+ */
+typedef struct {
+    uint32_t kind;
+    uint32_t element_size;
+    uint64_t count;
+    uint64_t offset;
+} EarthModelSnapshotSection;
+
+/**
+ * @brief Write the tables of an Earth Model to a snapshot file. The file is written next to path and renamed over it,
+ * so readers only ever see a whole snapshot. The derived state, truncated series, nutation ephemeris and rotation
+ * cache, is not written.
+ *
+ * Models attached to the old file keep reading it. Windows can not rename over a mapped file, so there the old file is
+ * renamed aside to path.<pid>.<n>.old first and deleted, and it stays on disk until the last attached model releases
+ * it.
+ *
+ * @param model The Earth Model.
+ * @param path The path of the snapshot.
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int write_earth_model_snapshot(EarthModel* model, const char* path);
+
+/**
+ * @brief Check a snapshot held in memory: its magic, version, precision, size, checksum and section table.
+ *
+ * @param data The contents of the snapshot.
+ * @param size The size of the snapshot in bytes.
+ * @param error Receives a description of the first problem found.
+ * @return 0 if the snapshot is sound, -1 otherwise.
+ */
+int check_earth_model_snapshot(const char* data, size_t size, const char** error);
+
+/**
+ * @brief Replace the tables of an Earth Model with copies of those of a checked snapshot.
+ *
+ * @param model The Earth Model, its previous tables are freed so the caller must hold the GIL.
+ * @param data The contents of the snapshot, already checked with check_earth_model_snapshot.
+ * @return 0 on success, -1 if the tables could not be allocated, leaving the model as it was.
+ */
+int read_earth_model_snapshot(EarthModel* model, const char* data);
+
+/**
+ * @brief Point the tables of an Earth Model into a checked snapshot held in memory instead of copying them. The
+ * snapshot must outlive the tables, the model keeps the mapping it came from in its 'snapshot' member. Nothing writes
+ * to the tables after this, so a read only mapping of the file is shared by every process attached to it.
+ *
+ * @param model The Earth Model, its previous tables are released.
+ * @param data The contents of the snapshot, already checked with check_earth_model_snapshot.
+ * @return 0 on success, -1 if the EOP table could not be allocated, leaving the model as it was.
+ */
+int attach_earth_model_snapshot(EarthModel* model, const char* data);
+
+/**
+ * @brief Non-zero if a table lies in the snapshot an Earth Model is attached to, such tables are never freed.
+ *
+ * @param model The Earth Model.
+ * @param table The table.
+ */
+int earth_model_snapshot_holds(const EarthModel* model, const void* table);
+
+/**
+ * @brief Free an EOP table an Earth Model no longer publishes, with those of its arrays not in the model's snapshot.
+ *
+ * @param model The Earth Model.
+ * @param table The EOP table, may be NULL.
+ */
+void release_earth_model_eop_table(EarthModel* model, EOPTable* table);
+
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __MODELS_EARTH_SNAPSHOT_H__ */
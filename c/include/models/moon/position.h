@@ -28,6 +28,8 @@
 extern "C" {
 #endif
 
+#include "math/real.h"
+
 
 /**
  * @brief Get the moon position object
@@ -37,7 +39,7 @@ extern "C" {
  * @param y The y position of the sun
  * @param z The z position of the sun
  */
-void moon_position(long double time, long double* x, long double* y, long double* z);
+void moon_position(Real time, Real* x, Real* y, Real* z);
 
 /**
  * @brief Get the moon position object
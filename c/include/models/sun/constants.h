@@ -28,17 +28,19 @@
 extern "C" {
 #endif
 
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_MERCURY[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_VENUS[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_EARTH[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_MARS[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_JUPITER[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_SATURN[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_URANUS[];
-extern const long double MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_NEPTUNE[];
+#include "math/real.h"
 
-extern const long double MEAN_ANOMALY_SUN[];
-extern const long double MEAN_LONGITUDE_SUN[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_MERCURY[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_VENUS[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_EARTH[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_MARS[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_JUPITER[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_SATURN[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_URANUS[];
+extern const Real MEAN_HELIOCENTRIC_ECLIPTIC_LONGITUDE_NEPTUNE[];
+
+extern const Real MEAN_ANOMALY_SUN[];
+extern const Real MEAN_LONGITUDE_SUN[];
 
 #ifdef __cplusplus
 }   /* extern "C" */
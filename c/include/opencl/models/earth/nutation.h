@@ -36,8 +36,8 @@ extern "C" {
 /**
  * @brief Compute nutation values of date along with the equation of the equinoxes.
  */
-void nutation_values_of_date_opencl(OpenCLKernel* kernel, long double t, NutationSeries* series, long double* nutation_longitude,
-    long double* nutation_obliquity, long double* mean_obliquity_date, long double* equation_of_the_equinoxes);
+void nutation_values_of_date_opencl(OpenCLKernel* kernel, Real t, NutationSeries* series, Real* nutation_longitude,
+    Real* nutation_obliquity, Real* mean_obliquity_date, Real* equation_of_the_equinoxes);
 
 
 #endif /* __compile_opencl_models_earth_nutation */
@@ -28,12 +28,14 @@
 extern "C" {
 #endif
 
-extern const long double SECONDS_PER_DAY;
-extern const long double DAYS_PER_JULIAN_CENTURY;
-extern const long double SECONDS_PER_JULIAN_CENTURY;
-extern const long double J2000_UNIX_TIME;
+#include "math/real.h"
 
-extern const long double GMST_DELTA_T;
+extern const Real SECONDS_PER_DAY;
+extern const Real DAYS_PER_JULIAN_CENTURY;
+extern const Real SECONDS_PER_JULIAN_CENTURY;
+extern const Real J2000_UNIX_TIME;
+
+extern const Real GMST_DELTA_T;
 
 #ifdef __cplusplus
 }   /* extern "C" */
@@ -28,27 +28,147 @@
 extern "C" {
 #endif
 
+#include "math/real.h"
+
+/**
+ * @brief Seconds in a mean Gregorian year, used to turn UNIX time into the decimal year of the Delta T polynomials.
+ */
+#define DELTA_T_SECONDS_PER_YEAR 31556952.0
+
+/**
+ * @brief Decimal year of the UNIX epoch.
+ */
+#define DELTA_T_UNIX_EPOCH_YEAR 1970.0
+
+/**
+ * @brief Years over which the offset between the last record at an end of the table and the polynomial model fades
+ * out, so the extrapolation joins the table without a step.
+ */
+#define DELTA_T_EXTRAPOLATION_BLEND_YEARS 100.0
+
+/** @enum
+ *  @brief How Delta T is evaluated between the records of the table.
+ */
+typedef enum {
+    StepDeltaTInterpolation   = 1,
+    LinearDeltaTInterpolation = 2
+} DeltaTInterpolation;
+
+/** @enum
+ *  @brief How Delta T is evaluated before the first record and after the last.
+ */
+typedef enum {
+    ClampDeltaTExtrapolation      = 1,
+    PolynomialDeltaTExtrapolation = 2
+} DeltaTExtrapolation;
+
 typedef struct {
 
-    long double timestamp;
-    long double deltaT;
+    Real timestamp;
+    Real deltaT;
 
 } DeltaTTableRecord;
 
 
+/** @struct
+ * @brief The Delta T, TT-UT1, records in time order.
+ * @var DeltaTTable::nrecords
+ * Member 'nrecords' is the number of records held.
+ * @var DeltaTTable::nrecords_allocated
+ * Member 'nrecords_allocated' is the number of records there is room for.
+ * @var DeltaTTable::records
+ * Member 'records' is the records sorted by timestamp.
+ * @var DeltaTTable::interpolation
+ * Member 'interpolation' is how Delta T is evaluated between records.
+ * @var DeltaTTable::extrapolation
+ * Member 'extrapolation' is how Delta T is evaluated outside the records.
+ */
 typedef struct {
     int nrecords;
     int nrecords_allocated;
     DeltaTTableRecord* records;
+    DeltaTInterpolation interpolation;
+    DeltaTExtrapolation extrapolation;
 } DeltaTTable;
 
 
-#ifdef __compile_time_delta_t__
+/**
+ * @brief Set up an empty Delta T table, interpolated linearly and extrapolated with the polynomial model.
+ *
+ * @param table The Delta T table.
+ */
+void init_delta_t_table(DeltaTTable* table);
+
+
+/**
+ * @brief Find the record at or before a timestamp, clamped to the table. Starts from where the previous lookup landed
+ * if given a cursor, a time ordered run of epochs stays in the same interval or steps into the next one and anything
+ * else falls back to a binary search.
+ *
+ * @param table The Delta T table, must hold at least one record.
+ * @param timestamp Unix time
+ * @param cursor The index of the previous lookup, updated to this one, or NULL. Any value is safe.
+ * @return The index of the record.
+ */
+int delta_t_table_index(DeltaTTable* table, Real timestamp, int* cursor);
+
+/**
+ * @brief Look up the Delta T record at or before a timestamp. Zero for an empty table.
+ *
+ * @param table The Delta T table.
+ * @param timestamp Unix time
+ * @param record The record at or before the timestamp.
+ */
+void delta_t_record_lookup(DeltaTTable* table, Real timestamp, DeltaTTableRecord* record);
 
-void delta_t_record_lookup(DeltaTTable* table, long double timestamp, DeltaTTableRecord* record);
+/**
+ * @brief Look up the Delta T record at or before a timestamp, finding it from a cursor if given.
+ *
+ * @param table The Delta T table.
+ * @param timestamp Unix time
+ * @param cursor The index of the previous lookup as for delta_t_table_index, NULL to search the table.
+ * @param record The record at or before the timestamp.
+ */
+void delta_t_record_lookup_from(DeltaTTable* table, Real timestamp, int* cursor, DeltaTTableRecord* record);
+
+/**
+ * @brief The polynomial model of Delta T of Espenak and Meeus, used past the ends of the table. Covers any year, the
+ * pieces after 2150 and before -500 are the long term parabola of Morrison and Stephenson.
+ *
+ * @param timestamp Unix time
+ * @return Delta T in s.
+ */
+Real delta_t_polynomial(Real timestamp);
+
+/**
+ * @brief Evaluate Delta T at a timestamp as set by the table's interpolation inside the records and its
+ * extrapolation outside them. Zero for an empty table.
+ *
+ * @param table The Delta T table.
+ * @param timestamp Unix time
+ * @param cursor The index of the previous lookup as for delta_t_table_index, NULL to search the table.
+ * @return Delta T in s.
+ */
+Real delta_t_of_date(DeltaTTable* table, Real timestamp, int* cursor);
+
+
+#ifdef __compile_time_delta_t__
 
 static PyObject* delta_t_add_record(PyObject* self, PyObject* args);
 
+static PyObject* delta_t_add_records(PyObject* self, PyObject* args);
+
+static PyObject* delta_t_load_file(PyObject* self, PyObject* args);
+
+static PyObject* delta_t_set_interpolation(PyObject* self, PyObject* args);
+
+static PyObject* delta_t_set_extrapolation(PyObject* self, PyObject* args);
+
+/**
+ * @brief Evaluate Delta T at a buffer of times in one call.
+ */
+static PyObject* delta_t_lookup(PyObject* self, PyObject* args);
+
 static PyObject* new_DeltaTTable(PyObject* self, PyObject* args);
 static void delete_DeltaTTable(PyObject* obj);
 
@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __UTIL_BUFFER_H__
+#define __UTIL_BUFFER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <Python.h>
+#include <string.h>
+
+/**
+ * @brief Acquires a C contiguous buffer of doubles from a Python object supporting the buffer protocol.
+ *
+ * @param obj The object exposing the buffer.
+ * @param view The acquired view. Must be released with PyBuffer_Release on success.
+ * @param writable Non-zero if the buffer is written to.
+ * @param nelements The number of doubles in the buffer.
+ * @return 0 on success, -1 with a Python exception set otherwise.
+ */
+static inline int get_double_buffer(PyObject* obj, Py_buffer* view, int writable, Py_ssize_t* nelements) {
+
+    int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+    if(writable) flags |= PyBUF_WRITABLE;
+
+    if(PyObject_GetBuffer(obj, view, flags) < 0) {
+        return -1;
+    }
+
+    if(view->itemsize != sizeof(double) || (view->format && strcmp(view->format, "d") != 0 &&
+        strcmp(view->format, "<d") != 0 && strcmp(view->format, "=d") != 0)) {
+        PyBuffer_Release(view);
+        PyErr_SetString(PyExc_TypeError, "Expected a buffer of doubles.");
+        return -1;
+    }
+
+    *nelements = view->len / view->itemsize;
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __UTIL_BUFFER_H__ */
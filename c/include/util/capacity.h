@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __UTIL_CAPACITY_H__
+#define __UTIL_CAPACITY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stdlib.h>
+
+/**
+ * @brief Smallest number of elements an array grown by reserve_capacity holds.
+ */
+#define MIN_CAPACITY 16
+
+/**
+ * @brief The capacity an array holding allocated elements grows to so it holds at least required, at least doubling.
+ *
+ * @param allocated The number of elements the array holds.
+ * @param required The number of elements needed.
+ * @return The new capacity, -1 if required does not fit an int.
+ */
+static inline long long grow_capacity(int allocated, long long required) {
+
+    if(required > 0x7fffffff) {
+        return -1;
+    }
+
+    long long capacity = allocated > 0 ? 2LL * allocated : MIN_CAPACITY;
+    if(capacity < required) capacity = required;
+    if(capacity > 0x7fffffff) capacity = 0x7fffffff;
+
+    return capacity;
+}
+
+/**
+ * @brief Grow an array of records to hold at least required elements, keeping its contents. The capacity at least
+ * doubles on every growth so appending n records one at a time costs O(n) copies in total.
+ *
+ * @param records The array, reallocated in place. May be NULL when allocated is 0.
+ * @param allocated The number of elements the array holds, updated on growth.
+ * @param required The number of elements needed.
+ * @param element_size The size of each element in bytes.
+ * @return 0 on success, -1 if the array could not be grown, leaving it untouched.
+ */
+static inline int reserve_capacity(void** records, int* allocated, long long required, size_t element_size) {
+
+    if(required <= *allocated) {
+        return 0;
+    }
+
+    long long capacity = grow_capacity(*allocated, required);
+    if(capacity < 0) {
+        return -1;
+    }
+
+    void* grown = realloc(*records, (size_t)capacity * element_size);
+    if(!grown) {
+        return -1;
+    }
+
+    *records = grown;
+    *allocated = (int)capacity;
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __UTIL_CAPACITY_H__ */
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __UTIL_MAPPED_FILE_H__
+#define __UTIL_MAPPED_FILE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stddef.h>
+
+#if defined(_WIN32) || defined(WIN32)
+
+#include <windows.h>
+
+#endif /* _WIN32 */
+
+/** @struct
+ * @brief A file mapped read only into memory.
+ * @var MappedFile::data
+ * Member 'data' is the contents of the file, NULL for an empty file. Not NUL terminated.
+ * @var MappedFile::size
+ * Member 'size' is the size of the file in bytes.
+ */
+typedef struct {
+    const char* data;
+    size_t size;
+#if defined(_WIN32) || defined(WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif /* _WIN32 */
+} MappedFile;
+
+/**
+ * @brief Map a file read only into memory. On Windows the file is opened sharing delete access, so a mapped file can
+ * still be renamed or deleted while it is mapped.
+ *
+ * @param path The path of the file.
+ * @param file The mapping, released with unmap_file on success.
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int map_file(const char* path, MappedFile* file);
+
+/**
+ * @brief Advise that a mapping is kept and read at random for its whole life rather than once front to back.
+ *
+ * @param file The mapping.
+ */
+void keep_mapped_file(MappedFile* file);
+
+/**
+ * @brief Release a file mapped with map_file.
+ *
+ * @param file The mapping.
+ */
+void unmap_file(MappedFile* file);
+
+#if defined(_WIN32) || defined(WIN32)
+
+/**
+ * @brief Translate a Windows error code, as returned by GetLastError, to the nearest errno value.
+ *
+ * @param error The Windows error code.
+ * @return The errno value, EIO for codes without a closer match.
+ */
+int windows_errno(DWORD error);
+
+#endif /* _WIN32 */
+
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __UTIL_MAPPED_FILE_H__ */
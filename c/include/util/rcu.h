@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __UTIL_RCU_H__
+#define __UTIL_RCU_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "util/thread_pool.h"
+
+#if defined(_WIN32) || defined(WIN32)
+
+static inline long atomic_load_long(volatile long* value) { return InterlockedCompareExchange(value, 0, 0); }
+static inline void atomic_add_long(volatile long* value, long delta) { InterlockedExchangeAdd(value, delta); }
+static inline void* atomic_load_pointer(void* volatile* value) {
+    return InterlockedCompareExchangePointer(value, NULL, NULL);
+}
+static inline void* atomic_exchange_pointer(void* volatile* value, void* desired) {
+    return InterlockedExchangePointer(value, desired);
+}
+
+#else
+
+static inline long atomic_load_long(volatile long* value) { return __atomic_load_n(value, __ATOMIC_SEQ_CST); }
+static inline void atomic_add_long(volatile long* value, long delta) {
+    __atomic_fetch_add(value, delta, __ATOMIC_SEQ_CST);
+}
+static inline void* atomic_load_pointer(void* volatile* value) { return __atomic_load_n(value, __ATOMIC_SEQ_CST); }
+static inline void* atomic_exchange_pointer(void* volatile* value, void* desired) {
+    return __atomic_exchange_n(value, desired, __ATOMIC_SEQ_CST);
+}
+
+#endif /* _WIN32 */
+
+/** @struct
+ * @brief A pointer published read-copy-update style. Readers take the current value without locking or waiting, a
+ * writer never changes a published value in place but publishes a new one and waits until no reader can still hold
+ * the old one before handing it back to be freed.
+ * @var RCUPointer::value
+ * Member 'value' is the published value.
+ * @var RCUPointer::version
+ * Member 'version' counts the values published after the first.
+ * @var RCUPointer::readers
+ * Member 'readers' counts the readers inside a section by the parity of the version they entered on.
+ * @var RCUPointer::writer
+ * Member 'writer' is held by the writer between reading the value it copies and publishing the copy.
+ */
+typedef struct {
+    void* volatile value;
+    volatile long version;
+    volatile long readers[2];
+    Mutex writer;
+} RCUPointer;
+
+/**
+ * @brief Enter a read section and take the published value, which stays valid until the section is left.
+ *
+ * @param pointer The published pointer.
+ * @param version Set to the version the section entered on, to leave it with.
+ * @return The published value.
+ */
+static inline void* rcu_read_lock(RCUPointer* pointer, long* version) {
+
+    long entered = atomic_load_long(&pointer->version);
+    atomic_add_long(&pointer->readers[entered & 1], 1);
+
+    /* A writer publishing in between may already have stopped waiting on this parity, so go again on the next. */
+    while(atomic_load_long(&pointer->version) != entered) {
+        atomic_add_long(&pointer->readers[entered & 1], -1);
+        entered = atomic_load_long(&pointer->version);
+        atomic_add_long(&pointer->readers[entered & 1], 1);
+    }
+
+    *version = entered;
+    return atomic_load_pointer(&pointer->value);
+}
+
+/**
+ * @brief Leave a read section, after which the value taken in it may be freed.
+ *
+ * @param pointer The published pointer.
+ * @param version The version the section entered on.
+ */
+static inline void rcu_read_unlock(RCUPointer* pointer, long version) {
+    atomic_add_long(&pointer->readers[version & 1], -1);
+}
+
+/**
+ * @brief Get the number of values published after the first.
+ *
+ * @param pointer The published pointer.
+ */
+static inline long rcu_version(RCUPointer* pointer) {
+    return atomic_load_long(&pointer->version);
+}
+
+
+
+#ifdef __compile_util_rcu__
+
+/**
+ * @brief Initialise a published pointer with its first value.
+ *
+ * @param pointer The published pointer.
+ * @param value The first value.
+ */
+void rcu_init(RCUPointer* pointer, void* value);
+
+/**
+ * @brief Release what the published pointer holds, other than its value. No reader may be left.
+ *
+ * @param pointer The published pointer.
+ */
+void rcu_destroy(RCUPointer* pointer);
+
+/**
+ * @brief Take the published value to copy, holding off other writers until rcu_write_unlock.
+ *
+ * @param pointer The published pointer.
+ * @return The published value, which must not be changed in place.
+ */
+void* rcu_write_lock(RCUPointer* pointer);
+
+/**
+ * @brief Publish a value and let other writers in. Waits until every reader that could have taken the previous value
+ * has left its section, readers are never held up.
+ *
+ * @param pointer The published pointer.
+ * @param value The value to publish, the one taken from rcu_write_lock to leave it unchanged.
+ * @return The previous value, free for the caller to release, or NULL if it was left unchanged.
+ */
+void* rcu_write_unlock(RCUPointer* pointer, void* value);
+
+#endif /* __compile_util_rcu__ */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __UTIL_RCU_H__ */
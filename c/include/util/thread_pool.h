@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#ifndef __UTIL_THREAD_POOL_H__
+#define __UTIL_THREAD_POOL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#if defined(_WIN32) || defined(WIN32)
+
+#include <windows.h>
+
+typedef SRWLOCK Mutex;
+
+static inline void mutex_init(Mutex* mutex) { InitializeSRWLock(mutex); }
+static inline void mutex_destroy(Mutex* mutex) { (void)mutex; }
+static inline void mutex_lock(Mutex* mutex) { AcquireSRWLockExclusive(mutex); }
+static inline void mutex_unlock(Mutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+
+#else
+
+#include <pthread.h>
+
+typedef pthread_mutex_t Mutex;
+
+static inline void mutex_init(Mutex* mutex) { pthread_mutex_init(mutex, NULL); }
+static inline void mutex_destroy(Mutex* mutex) { pthread_mutex_destroy(mutex); }
+static inline void mutex_lock(Mutex* mutex) { pthread_mutex_lock(mutex); }
+static inline void mutex_unlock(Mutex* mutex) { pthread_mutex_unlock(mutex); }
+
+#endif /* _WIN32 */
+
+/**
+ * @brief Work run over the range [begin, end) of a parallel loop. Must not touch the Python API.
+ */
+typedef void (*ParallelTask)(void* context, long long begin, long long end);
+
+
+#ifdef __compile_util_thread_pool__
+
+/**
+ * @brief Get the number of threads, the caller included, parallel loops are split across.
+ */
+int thread_pool_size(void);
+
+/**
+ * @brief Set the number of threads parallel loops are split across. The workers are started on the next loop.
+ *
+ * @param nthreads The number of threads, the caller included. 0 picks the number of online processors.
+ * @return 0 on success and -1 if nthreads is negative.
+ */
+int set_thread_pool_size(int nthreads);
+
+/**
+ * @brief Run a task over [0, n) split into contiguous ranges across the pool, the calling thread included.
+ *
+ * Ranges are never shorter than grain. When another loop is already running on the pool the calling thread runs the
+ * whole range itself rather than wait. Returns once every range has been run.
+ *
+ * @param n The number of items.
+ * @param grain The fewest items worth handing to a thread.
+ * @param task The work to run over each range.
+ * @param context Passed through to the task.
+ */
+void parallel_for(long long n, long long grain, ParallelTask task, void* context);
+
+#endif /* __compile_util_thread_pool__ */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __UTIL_THREAD_POOL_H__ */
@@ -0,0 +1,858 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#define __compile_coordinates_geodetic_kernel__
+#include "coordinates/geodetic_kernel.h"
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GEODETIC_KERNEL_X86
+#include <immintrin.h>
+#endif /* __GNUC__ && x86 */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/* Cephes atan, the argument is reduced to [0, 0.66] through tan(3pi/8) and tan(pi/8) and the rational approximation
+ * P(z)/Q(z) in z = x^2 taken there. MOREBITS carries the bits of pi/2 a double drops. */
+#define ATAN_T3P8 2.41421356237309504880
+#define ATAN_T1P8 0.66
+#define ATAN_PIO2 1.57079632679489661923
+#define ATAN_PIO4 0.78539816339744830962
+#define ATAN_MOREBITS 6.123233995736765886130e-17
+#define ATAN_P0 -8.750608600031904122785e-01
+#define ATAN_P1 -1.615753718733365076637e+01
+#define ATAN_P2 -7.500855792314704667340e+01
+#define ATAN_P3 -1.228866684490136173410e+02
+#define ATAN_P4 -6.485021904942025371773e+01
+#define ATAN_Q0 2.485846490142306297962e+01
+#define ATAN_Q1 1.650270098316988542046e+02
+#define ATAN_Q2 4.328810604912902668951e+02
+#define ATAN_Q3 4.853903996359136964868e+02
+#define ATAN_Q4 1.945506571482613964425e+02
+
+/* The high word of a double divided by three plus CBRT_B1 is within 1/32 of its cube root, from fdlibm. Three Halley
+ * steps take that to full precision. */
+#define CBRT_B1 715094163
+
+/* Adding this to a double holding an integer below 2^51 leaves the integer in the low bits of the mantissa. */
+#define ROUNDING_MAGIC 6755399441055744.0
+
+/* Two to the 52, ORing an integer below it into the mantissa and subtracting it gives the integer as a double. */
+#define TWO_52 4503599627370496.0
+
+#define DEGREES_PER_RADIAN 57.29577951308232087680
+
+/* Near the poles x and y are both 0 and p divides by 0, the scalar conversion nudges x the same way. */
+#define POLE_OFFSET 0.000000001
+
+static GeodeticKernel selected_kernel = 0;
+
+/** @struct
+ * @brief The ellipsoid terms the geodetic algorithms need, computed once per batch.
+ */
+typedef struct {
+    double a;
+    double b;
+    double a2;
+    double b2;
+    double e_2;
+    double e_r2;
+    double e_c;
+    double e_numerator;
+} GeodeticTerms;
+
+/**
+ * @brief Compute the ellipsoid terms of the geodetic algorithms.
+ */
+static void geodetic_terms(double a, double b, GeodeticTerms* terms) {
+
+    terms->a = a;
+    terms->b = b;
+    terms->a2 = a * a;
+    terms->b2 = b * b;
+    terms->e_numerator = terms->a2 - terms->b2;
+    terms->e_2 = terms->e_numerator / terms->a2;
+    terms->e_r2 = terms->e_numerator / terms->b2;
+    terms->e_c = b / a;
+}
+
+/**
+ * @brief Heikkinen's closed form solution for one row, as itrf_to_geodetic_state_vector.
+ */
+static inline void closed_form_scalar(const GeodeticTerms* terms, double p, double z, double* latitude,
+    double* height) {
+
+    const double e_2 = terms->e_2;
+
+    double big_f = 54.0 * terms->b2 * z * z;
+    double big_g = p * p + z * z * (1.0 - e_2) - e_2 * terms->e_numerator;
+    double c = (e_2 * e_2 * big_f * p * p) / (big_g * big_g * big_g);
+    double s = cbrt(1.0 + c + sqrt(c * c + 2.0 * c));
+    double k = s + 1.0 + 1.0 / s;
+    double big_p = big_f / (3.0 * k * k * big_g * big_g);
+    double big_q = sqrt(1.0 + 2.0 * e_2 * e_2 * big_p);
+    double sqrt_r_0 = (terms->a2 / 2.0) * (1.0 + 1.0 / big_q) - (big_p * (1.0 - e_2) * z * z) /
+        (big_q * (1.0 + big_q)) - (big_p * p * p) / 2.0;
+    sqrt_r_0 = sqrt_r_0 < 0.0 ? 0.0 : sqrt(sqrt_r_0);
+    double r_0 = (-big_p * e_2 * p) / (1.0 + big_q) + sqrt_r_0;
+    double p_e_2_r_0 = p - e_2 * r_0;
+    double big_u = sqrt(p_e_2_r_0 * p_e_2_r_0 + z * z);
+    double big_v = sqrt(p_e_2_r_0 * p_e_2_r_0 + (1.0 - e_2) * z * z);
+    double z_0 = (terms->b2 * z) / (terms->a * big_v);
+
+    *latitude = atan((z + terms->e_r2 * z_0) / p);
+    *height = big_u * (1.0 - terms->b2 / (terms->a * big_v));
+}
+
+/**
+ * @brief Latitude and height of one row from the tangent n / d of its latitude.
+ */
+static inline void tangent_scalar(const GeodeticTerms* terms, double p, double z, double n, double d,
+    double* latitude, double* height) {
+
+    *latitude = atan(n / d);
+    *height = (p * d + z * n - sqrt(terms->a2 * d * d + terms->b2 * n * n)) / sqrt(n * n + d * d);
+}
+
+/**
+ * @brief Bowring's method for one row.
+ */
+static inline void bowring_scalar(const GeodeticTerms* terms, double p, double z, int iterations, double* latitude,
+    double* height) {
+
+    double s = terms->a * z, c = terms->b * p;
+    double n = z, d = p;
+
+    for(int i = 0; i < iterations; ++i) {
+        double norm = sqrt(s * s + c * c);
+        double sin_beta = s / norm, cos_beta = c / norm;
+        n = z + terms->e_r2 * terms->b * sin_beta * sin_beta * sin_beta;
+        d = p - terms->e_2 * terms->a * cos_beta * cos_beta * cos_beta;
+        s = terms->b * n;
+        c = terms->a * d;
+    }
+
+    tangent_scalar(terms, p, z, n, d, latitude, height);
+}
+
+/**
+ * @brief Vermeille's closed form solution for one row.
+ */
+static inline void vermeille_scalar(const GeodeticTerms* terms, double p, double z, double* latitude,
+    double* height) {
+
+    const double e_2 = terms->e_2, e_4 = e_2 * e_2;
+
+    double p_2 = p * p / terms->a2;
+    double q = (1.0 - e_2) * z * z / terms->a2;
+    double r = (p_2 + q - e_4) / 6.0;
+    double s = e_4 * p_2 * q / (4.0 * r * r * r);
+    double t = cbrt(1.0 + s + sqrt(s * (2.0 + s)));
+    double u = r * (1.0 + t + 1.0 / t);
+    double v = sqrt(u * u + e_4 * q);
+    double w = e_2 * (u + v - q) / (2.0 * v);
+    double k = sqrt(u + v + w * w) - w;
+    double d = k * p / (k + e_2);
+    double hypotenuse = sqrt(d * d + z * z);
+
+    *latitude = 2.0 * atan(z / (d + hypotenuse));
+    *height = (k + e_2 - 1.0) / k * hypotenuse;
+}
+
+/**
+ * @brief Fukushima's method for one row.
+ */
+static inline void fukushima_scalar(const GeodeticTerms* terms, double p, double z, double* latitude,
+    double* height) {
+
+    const double e_2 = terms->e_2, e_c = terms->e_c;
+
+    double big_p = p / terms->a;
+    double big_z = e_c * fabs(z) / terms->a;
+    double s_0 = big_z, c_0 = e_c * e_c * big_p;
+    double a_0 = sqrt(s_0 * s_0 + c_0 * c_0);
+    double a_0_3 = a_0 * a_0 * a_0;
+    double d_0 = big_z * a_0_3 + e_2 * s_0 * s_0 * s_0;
+    double f_0 = big_p * a_0_3 - e_2 * c_0 * c_0 * c_0;
+    double b_0 = 1.5 * e_2 * s_0 * c_0 * c_0 * (a_0 * (big_p * s_0 - big_z * c_0) - e_2 * s_0 * c_0);
+    double s_1 = d_0 * f_0 - b_0 * s_0;
+    double c_1 = f_0 * f_0 - b_0 * c_0;
+
+    tangent_scalar(terms, p, fabs(z), s_1, e_c * c_1, latitude, height);
+    *latitude = copysign(*latitude, z);
+}
+
+/**
+ * @brief Convert rows one at a time with the C library's sqrt, cbrt and atan.
+ */
+static void geodetic_kernel_convert_scalar(const GeodeticTerms* terms, GeodeticAlgorithm algorithm,
+    const double* positions, double* geodetic, long long n) {
+
+    for(long long i = 0; i < n; ++i, positions += 3, geodetic += 3) {
+        double x = positions[0], y = positions[1], z = positions[2];
+        double x_p = (x == 0.0 && y == 0.0) ? POLE_OFFSET : x;
+        double p = sqrt(x_p * x_p + y * y);
+        double latitude, height;
+
+        switch(algorithm) {
+            case BowringGeodeticAlgorithm:
+                bowring_scalar(terms, p, z, 1, &latitude, &height);
+                break;
+            case Bowring2GeodeticAlgorithm:
+                bowring_scalar(terms, p, z, 2, &latitude, &height);
+                break;
+            case VermeilleGeodeticAlgorithm:
+                vermeille_scalar(terms, p, z, &latitude, &height);
+                break;
+            case FukushimaGeodeticAlgorithm:
+                fukushima_scalar(terms, p, z, &latitude, &height);
+                break;
+            default:
+                closed_form_scalar(terms, p, z, &latitude, &height);
+                break;
+        }
+
+        geodetic[0] = latitude * DEGREES_PER_RADIAN;
+        geodetic[1] = atan2(y, x) * DEGREES_PER_RADIAN;
+        geodetic[2] = height;
+    }
+}
+
+#ifdef GEODETIC_KERNEL_X86
+
+/**
+ * @brief Arc tangent of four doubles.
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256d atan_avx2(__m256d x) {
+
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d sign = _mm256_and_pd(x, sign_mask);
+    __m256d ax = _mm256_andnot_pd(sign_mask, x);
+
+    __m256d big = _mm256_cmp_pd(ax, _mm256_set1_pd(ATAN_T3P8), _CMP_GT_OQ);
+    __m256d middle = _mm256_andnot_pd(big, _mm256_cmp_pd(ax, _mm256_set1_pd(ATAN_T1P8), _CMP_GT_OQ));
+
+    __m256d r = _mm256_blendv_pd(ax, _mm256_div_pd(_mm256_sub_pd(ax, _mm256_set1_pd(1.0)),
+        _mm256_add_pd(ax, _mm256_set1_pd(1.0))), middle);
+    r = _mm256_blendv_pd(r, _mm256_div_pd(_mm256_set1_pd(-1.0), ax), big);
+    __m256d y_0 = _mm256_blendv_pd(_mm256_and_pd(middle, _mm256_set1_pd(ATAN_PIO4)), _mm256_set1_pd(ATAN_PIO2), big);
+    __m256d more = _mm256_blendv_pd(_mm256_and_pd(middle, _mm256_set1_pd(0.5 * ATAN_MOREBITS)),
+        _mm256_set1_pd(ATAN_MOREBITS), big);
+
+    __m256d z = _mm256_mul_pd(r, r);
+    __m256d numerator = _mm256_fmadd_pd(z, _mm256_set1_pd(ATAN_P0), _mm256_set1_pd(ATAN_P1));
+    numerator = _mm256_fmadd_pd(z, numerator, _mm256_set1_pd(ATAN_P2));
+    numerator = _mm256_fmadd_pd(z, numerator, _mm256_set1_pd(ATAN_P3));
+    numerator = _mm256_fmadd_pd(z, numerator, _mm256_set1_pd(ATAN_P4));
+    __m256d denominator = _mm256_add_pd(z, _mm256_set1_pd(ATAN_Q0));
+    denominator = _mm256_fmadd_pd(z, denominator, _mm256_set1_pd(ATAN_Q1));
+    denominator = _mm256_fmadd_pd(z, denominator, _mm256_set1_pd(ATAN_Q2));
+    denominator = _mm256_fmadd_pd(z, denominator, _mm256_set1_pd(ATAN_Q3));
+    denominator = _mm256_fmadd_pd(z, denominator, _mm256_set1_pd(ATAN_Q4));
+
+    __m256d result = _mm256_mul_pd(_mm256_mul_pd(z, r), _mm256_div_pd(numerator, denominator));
+    result = _mm256_add_pd(_mm256_add_pd(result, more), r);
+    result = _mm256_add_pd(y_0, result);
+
+    return _mm256_or_pd(result, sign);
+}
+
+/**
+ * @brief Cube root of four positive doubles.
+ */
+__attribute__((target("avx2,fma")))
+static inline __m256d cbrt_avx2(__m256d v) {
+
+    const __m256d two_52 = _mm256_set1_pd(TWO_52);
+    __m256i high = _mm256_srli_epi64(_mm256_castpd_si256(v), 32);
+    __m256d high_value = _mm256_sub_pd(_mm256_or_pd(_mm256_castsi256_pd(high), two_52), two_52);
+    __m256i guess = _mm256_castpd_si256(_mm256_fmadd_pd(high_value, _mm256_set1_pd(1.0 / 3.0),
+        _mm256_set1_pd(ROUNDING_MAGIC)));
+    guess = _mm256_and_si256(guess, _mm256_set1_epi64x(0xffffffffLL));
+    __m256d y = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(guess, _mm256_set1_epi64x(CBRT_B1)), 32));
+
+    for(int i = 0; i < 3; ++i) {
+        __m256d y_3 = _mm256_mul_pd(_mm256_mul_pd(y, y), y);
+        y = _mm256_mul_pd(y, _mm256_div_pd(_mm256_fmadd_pd(_mm256_set1_pd(2.0), v, y_3),
+            _mm256_fmadd_pd(_mm256_set1_pd(2.0), y_3, v)));
+    }
+
+    return y;
+}
+
+/**
+ * @brief Heikkinen's closed form solution for four rows.
+ */
+__attribute__((target("avx2,fma")))
+static inline void closed_form_avx2(const GeodeticTerms* terms, __m256d p, __m256d p_2, __m256d z, __m256d* latitude,
+    __m256d* height) {
+
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d e_2 = _mm256_set1_pd(terms->e_2);
+    const __m256d one_e_2 = _mm256_set1_pd(1.0 - terms->e_2);
+    const __m256d b2 = _mm256_set1_pd(terms->b2);
+
+    __m256d z_2 = _mm256_mul_pd(z, z);
+    __m256d big_f = _mm256_mul_pd(_mm256_set1_pd(54.0 * terms->b2), z_2);
+    __m256d big_g = _mm256_fmadd_pd(z_2, one_e_2, _mm256_sub_pd(p_2,
+        _mm256_set1_pd(terms->e_2 * terms->e_numerator)));
+    __m256d big_g_2 = _mm256_mul_pd(big_g, big_g);
+    __m256d c = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(terms->e_2 * terms->e_2), _mm256_mul_pd(big_f, p_2)),
+        _mm256_mul_pd(big_g_2, big_g));
+    __m256d s = cbrt_avx2(_mm256_add_pd(_mm256_add_pd(one, c),
+        _mm256_sqrt_pd(_mm256_fmadd_pd(c, c, _mm256_add_pd(c, c)))));
+    __m256d k = _mm256_add_pd(_mm256_add_pd(s, one), _mm256_div_pd(one, s));
+    __m256d big_p = _mm256_div_pd(big_f, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(3.0), _mm256_mul_pd(k, k)),
+        big_g_2));
+    __m256d big_q = _mm256_sqrt_pd(_mm256_fmadd_pd(_mm256_set1_pd(2.0 * terms->e_2 * terms->e_2), big_p, one));
+    __m256d one_q = _mm256_add_pd(one, big_q);
+    __m256d sqrt_r_0 = _mm256_mul_pd(_mm256_set1_pd(terms->a2 / 2.0), _mm256_add_pd(one,
+        _mm256_div_pd(one, big_q)));
+    sqrt_r_0 = _mm256_sub_pd(sqrt_r_0, _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(big_p, one_e_2), z_2),
+        _mm256_mul_pd(big_q, one_q)));
+    sqrt_r_0 = _mm256_fnmadd_pd(_mm256_mul_pd(big_p, _mm256_set1_pd(0.5)), p_2, sqrt_r_0);
+    sqrt_r_0 = _mm256_sqrt_pd(_mm256_max_pd(sqrt_r_0, zero));
+    __m256d r_0 = _mm256_sub_pd(sqrt_r_0, _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(big_p, e_2), p), one_q));
+    __m256d p_e_2_r_0 = _mm256_fnmadd_pd(e_2, r_0, p);
+    __m256d p_e_2_r_0_2 = _mm256_mul_pd(p_e_2_r_0, p_e_2_r_0);
+    __m256d big_u = _mm256_sqrt_pd(_mm256_add_pd(p_e_2_r_0_2, z_2));
+    __m256d big_v = _mm256_sqrt_pd(_mm256_fmadd_pd(one_e_2, z_2, p_e_2_r_0_2));
+    __m256d a_v = _mm256_mul_pd(_mm256_set1_pd(terms->a), big_v);
+    __m256d z_0 = _mm256_div_pd(_mm256_mul_pd(b2, z), a_v);
+
+    *latitude = atan_avx2(_mm256_div_pd(_mm256_fmadd_pd(_mm256_set1_pd(terms->e_r2), z_0, z), p));
+    *height = _mm256_mul_pd(big_u, _mm256_sub_pd(one, _mm256_div_pd(b2, a_v)));
+}
+
+/**
+ * @brief Latitude and height of four rows from the tangents n / d of their latitudes.
+ */
+__attribute__((target("avx2,fma")))
+static inline void tangent_avx2(const GeodeticTerms* terms, __m256d p, __m256d z, __m256d n, __m256d d,
+    __m256d* latitude, __m256d* height) {
+
+    __m256d n_2 = _mm256_mul_pd(n, n);
+    __m256d d_2 = _mm256_mul_pd(d, d);
+    __m256d foot = _mm256_sqrt_pd(_mm256_fmadd_pd(_mm256_set1_pd(terms->a2), d_2,
+        _mm256_mul_pd(_mm256_set1_pd(terms->b2), n_2)));
+
+    *latitude = atan_avx2(_mm256_div_pd(n, d));
+    *height = _mm256_div_pd(_mm256_sub_pd(_mm256_fmadd_pd(p, d, _mm256_mul_pd(z, n)), foot),
+        _mm256_sqrt_pd(_mm256_add_pd(n_2, d_2)));
+}
+
+/**
+ * @brief Bowring's method for four rows.
+ */
+__attribute__((target("avx2,fma")))
+static inline void bowring_avx2(const GeodeticTerms* terms, __m256d p, __m256d z, int iterations, __m256d* latitude,
+    __m256d* height) {
+
+    const __m256d a = _mm256_set1_pd(terms->a);
+    const __m256d b = _mm256_set1_pd(terms->b);
+    __m256d s = _mm256_mul_pd(a, z), c = _mm256_mul_pd(b, p);
+    __m256d n = z, d = p;
+
+    for(int i = 0; i < iterations; ++i) {
+        __m256d inverse_norm = _mm256_div_pd(_mm256_set1_pd(1.0), _mm256_sqrt_pd(_mm256_fmadd_pd(s, s,
+            _mm256_mul_pd(c, c))));
+        __m256d sin_beta = _mm256_mul_pd(s, inverse_norm), cos_beta = _mm256_mul_pd(c, inverse_norm);
+        n = _mm256_fmadd_pd(_mm256_set1_pd(terms->e_r2 * terms->b), _mm256_mul_pd(_mm256_mul_pd(sin_beta, sin_beta),
+            sin_beta), z);
+        d = _mm256_fnmadd_pd(_mm256_set1_pd(terms->e_2 * terms->a), _mm256_mul_pd(_mm256_mul_pd(cos_beta, cos_beta),
+            cos_beta), p);
+        s = _mm256_mul_pd(b, n);
+        c = _mm256_mul_pd(a, d);
+    }
+
+    tangent_avx2(terms, p, z, n, d, latitude, height);
+}
+
+/**
+ * @brief Vermeille's closed form solution for four rows.
+ */
+__attribute__((target("avx2,fma")))
+static inline void vermeille_avx2(const GeodeticTerms* terms, __m256d p, __m256d p_2, __m256d z, __m256d* latitude,
+    __m256d* height) {
+
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d e_2 = _mm256_set1_pd(terms->e_2);
+    const __m256d e_4 = _mm256_set1_pd(terms->e_2 * terms->e_2);
+
+    p_2 = _mm256_mul_pd(p_2, _mm256_set1_pd(1.0 / terms->a2));
+    __m256d q = _mm256_mul_pd(_mm256_set1_pd((1.0 - terms->e_2) / terms->a2), _mm256_mul_pd(z, z));
+    __m256d r = _mm256_mul_pd(_mm256_sub_pd(_mm256_add_pd(p_2, q), e_4), _mm256_set1_pd(1.0 / 6.0));
+    __m256d s = _mm256_div_pd(_mm256_mul_pd(e_4, _mm256_mul_pd(p_2, q)),
+        _mm256_mul_pd(_mm256_set1_pd(4.0), _mm256_mul_pd(_mm256_mul_pd(r, r), r)));
+    __m256d t = cbrt_avx2(_mm256_add_pd(_mm256_add_pd(one, s),
+        _mm256_sqrt_pd(_mm256_mul_pd(s, _mm256_add_pd(_mm256_set1_pd(2.0), s)))));
+    __m256d u = _mm256_mul_pd(r, _mm256_add_pd(_mm256_add_pd(one, t), _mm256_div_pd(one, t)));
+    __m256d v = _mm256_sqrt_pd(_mm256_fmadd_pd(u, u, _mm256_mul_pd(e_4, q)));
+    __m256d u_v = _mm256_add_pd(u, v);
+    __m256d w = _mm256_div_pd(_mm256_mul_pd(e_2, _mm256_sub_pd(u_v, q)), _mm256_add_pd(v, v));
+    __m256d k = _mm256_sub_pd(_mm256_sqrt_pd(_mm256_fmadd_pd(w, w, u_v)), w);
+    __m256d d = _mm256_div_pd(_mm256_mul_pd(k, p), _mm256_add_pd(k, e_2));
+    __m256d hypotenuse = _mm256_sqrt_pd(_mm256_fmadd_pd(d, d, _mm256_mul_pd(z, z)));
+
+    *latitude = _mm256_mul_pd(_mm256_set1_pd(2.0), atan_avx2(_mm256_div_pd(z, _mm256_add_pd(d, hypotenuse))));
+    *height = _mm256_mul_pd(_mm256_div_pd(_mm256_add_pd(k, _mm256_set1_pd(terms->e_2 - 1.0)), k), hypotenuse);
+}
+
+/**
+ * @brief Fukushima's method for four rows.
+ */
+__attribute__((target("avx2,fma")))
+static inline void fukushima_avx2(const GeodeticTerms* terms, __m256d p, __m256d z, __m256d* latitude,
+    __m256d* height) {
+
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d e_2 = _mm256_set1_pd(terms->e_2);
+
+    __m256d abs_z = _mm256_andnot_pd(sign_mask, z);
+    __m256d big_p = _mm256_mul_pd(p, _mm256_set1_pd(1.0 / terms->a));
+    __m256d big_z = _mm256_mul_pd(abs_z, _mm256_set1_pd(terms->e_c / terms->a));
+    __m256d s_0 = big_z, c_0 = _mm256_mul_pd(_mm256_set1_pd(terms->e_c * terms->e_c), big_p);
+    __m256d s_0_2 = _mm256_mul_pd(s_0, s_0), c_0_2 = _mm256_mul_pd(c_0, c_0);
+    __m256d a_0 = _mm256_sqrt_pd(_mm256_add_pd(s_0_2, c_0_2));
+    __m256d a_0_3 = _mm256_mul_pd(_mm256_mul_pd(a_0, a_0), a_0);
+    __m256d d_0 = _mm256_fmadd_pd(big_z, a_0_3, _mm256_mul_pd(e_2, _mm256_mul_pd(s_0_2, s_0)));
+    __m256d f_0 = _mm256_fmsub_pd(big_p, a_0_3, _mm256_mul_pd(e_2, _mm256_mul_pd(c_0_2, c_0)));
+    __m256d e_2_s_0_c_0 = _mm256_mul_pd(e_2, _mm256_mul_pd(s_0, c_0));
+    __m256d b_0 = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(1.5), _mm256_mul_pd(e_2_s_0_c_0, c_0)),
+        _mm256_fmsub_pd(a_0, _mm256_fmsub_pd(big_p, s_0, _mm256_mul_pd(big_z, c_0)), e_2_s_0_c_0));
+    __m256d s_1 = _mm256_fmsub_pd(d_0, f_0, _mm256_mul_pd(b_0, s_0));
+    __m256d c_1 = _mm256_fmsub_pd(f_0, f_0, _mm256_mul_pd(b_0, c_0));
+
+    tangent_avx2(terms, p, abs_z, s_1, _mm256_mul_pd(_mm256_set1_pd(terms->e_c), c_1), latitude, height);
+    *latitude = _mm256_or_pd(*latitude, _mm256_and_pd(z, sign_mask));
+}
+
+/**
+ * @brief Convert rows four at a time with AVX2 and FMA.
+ */
+__attribute__((target("avx2,fma")))
+static void geodetic_kernel_convert_avx2(const GeodeticTerms* terms, GeodeticAlgorithm algorithm,
+    const double* positions, double* geodetic, long long n) {
+
+    const __m256i rows = _mm256_set_epi64x(9, 6, 3, 0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d pi = _mm256_set1_pd(M_PI);
+    const __m256d sign_mask = _mm256_set1_pd(-0.0);
+    const __m256d degrees = _mm256_set1_pd(DEGREES_PER_RADIAN);
+
+    long long i = 0;
+    for(; i + 4 <= n; i += 4, positions += 12, geodetic += 12) {
+
+        __m256d x = _mm256_i64gather_pd(positions, rows, 8);
+        __m256d y = _mm256_i64gather_pd(positions + 1, rows, 8);
+        __m256d z = _mm256_i64gather_pd(positions + 2, rows, 8);
+
+        __m256d pole = _mm256_and_pd(_mm256_cmp_pd(x, zero, _CMP_EQ_OQ), _mm256_cmp_pd(y, zero, _CMP_EQ_OQ));
+        __m256d x_p = _mm256_blendv_pd(x, _mm256_set1_pd(POLE_OFFSET), pole);
+
+        __m256d p_2 = _mm256_fmadd_pd(x_p, x_p, _mm256_mul_pd(y, y));
+        __m256d p = _mm256_sqrt_pd(p_2);
+        __m256d latitude, height;
+
+        switch(algorithm) {
+            case BowringGeodeticAlgorithm:
+                bowring_avx2(terms, p, z, 1, &latitude, &height);
+                break;
+            case Bowring2GeodeticAlgorithm:
+                bowring_avx2(terms, p, z, 2, &latitude, &height);
+                break;
+            case VermeilleGeodeticAlgorithm:
+                vermeille_avx2(terms, p, p_2, z, &latitude, &height);
+                break;
+            case FukushimaGeodeticAlgorithm:
+                fukushima_avx2(terms, p, z, &latitude, &height);
+                break;
+            default:
+                closed_form_avx2(terms, p, p_2, z, &latitude, &height);
+                break;
+        }
+
+        /* atan2 from the atan of y/x, a negative x adds a half turn with the sign of y. */
+        __m256d longitude = atan_avx2(_mm256_div_pd(y, x_p));
+        __m256d turn = _mm256_and_pd(_mm256_cmp_pd(x_p, zero, _CMP_LT_OQ),
+            _mm256_or_pd(pi, _mm256_and_pd(y, sign_mask)));
+        longitude = _mm256_add_pd(longitude, turn);
+
+        double lanes[12];
+        _mm256_storeu_pd(lanes, _mm256_mul_pd(latitude, degrees));
+        _mm256_storeu_pd(lanes + 4, _mm256_mul_pd(longitude, degrees));
+        _mm256_storeu_pd(lanes + 8, height);
+        for(int lane = 0; lane < 4; ++lane) {
+            geodetic[3 * lane] = lanes[lane];
+            geodetic[3 * lane + 1] = lanes[lane + 4];
+            geodetic[3 * lane + 2] = lanes[lane + 8];
+        }
+    }
+
+    geodetic_kernel_convert_scalar(terms, algorithm, positions, geodetic, n - i);
+}
+
+/**
+ * @brief Arc tangent of eight doubles.
+ */
+__attribute__((target("avx512f")))
+static inline __m512d atan_avx512(__m512d x) {
+
+    const __m512i sign_mask = _mm512_set1_epi64((long long)0x8000000000000000ULL);
+    __m512i sign = _mm512_and_si512(_mm512_castpd_si512(x), sign_mask);
+    __m512d ax = _mm512_abs_pd(x);
+
+    __mmask8 big = _mm512_cmp_pd_mask(ax, _mm512_set1_pd(ATAN_T3P8), _CMP_GT_OQ);
+    __mmask8 middle = _mm512_cmp_pd_mask(ax, _mm512_set1_pd(ATAN_T1P8), _CMP_GT_OQ) & ~big;
+
+    __m512d r = _mm512_mask_div_pd(ax, middle, _mm512_sub_pd(ax, _mm512_set1_pd(1.0)),
+        _mm512_add_pd(ax, _mm512_set1_pd(1.0)));
+    r = _mm512_mask_div_pd(r, big, _mm512_set1_pd(-1.0), ax);
+    __m512d y_0 = _mm512_mask_blend_pd(big, _mm512_maskz_mov_pd(middle, _mm512_set1_pd(ATAN_PIO4)),
+        _mm512_set1_pd(ATAN_PIO2));
+    __m512d more = _mm512_mask_blend_pd(big, _mm512_maskz_mov_pd(middle, _mm512_set1_pd(0.5 * ATAN_MOREBITS)),
+        _mm512_set1_pd(ATAN_MOREBITS));
+
+    __m512d z = _mm512_mul_pd(r, r);
+    __m512d numerator = _mm512_fmadd_pd(z, _mm512_set1_pd(ATAN_P0), _mm512_set1_pd(ATAN_P1));
+    numerator = _mm512_fmadd_pd(z, numerator, _mm512_set1_pd(ATAN_P2));
+    numerator = _mm512_fmadd_pd(z, numerator, _mm512_set1_pd(ATAN_P3));
+    numerator = _mm512_fmadd_pd(z, numerator, _mm512_set1_pd(ATAN_P4));
+    __m512d denominator = _mm512_add_pd(z, _mm512_set1_pd(ATAN_Q0));
+    denominator = _mm512_fmadd_pd(z, denominator, _mm512_set1_pd(ATAN_Q1));
+    denominator = _mm512_fmadd_pd(z, denominator, _mm512_set1_pd(ATAN_Q2));
+    denominator = _mm512_fmadd_pd(z, denominator, _mm512_set1_pd(ATAN_Q3));
+    denominator = _mm512_fmadd_pd(z, denominator, _mm512_set1_pd(ATAN_Q4));
+
+    __m512d result = _mm512_mul_pd(_mm512_mul_pd(z, r), _mm512_div_pd(numerator, denominator));
+    result = _mm512_add_pd(_mm512_add_pd(result, more), r);
+    result = _mm512_add_pd(y_0, result);
+
+    return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(result), sign));
+}
+
+/**
+ * @brief Cube root of eight positive doubles.
+ */
+__attribute__((target("avx512f")))
+static inline __m512d cbrt_avx512(__m512d v) {
+
+    const __m512d two_52 = _mm512_set1_pd(TWO_52);
+    __m512i high = _mm512_srli_epi64(_mm512_castpd_si512(v), 32);
+    __m512d high_value = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(high, _mm512_castpd_si512(two_52))),
+        two_52);
+    __m512i guess = _mm512_castpd_si512(_mm512_fmadd_pd(high_value, _mm512_set1_pd(1.0 / 3.0),
+        _mm512_set1_pd(ROUNDING_MAGIC)));
+    guess = _mm512_and_si512(guess, _mm512_set1_epi64(0xffffffffLL));
+    __m512d y = _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(guess, _mm512_set1_epi64(CBRT_B1)), 32));
+
+    for(int i = 0; i < 3; ++i) {
+        __m512d y_3 = _mm512_mul_pd(_mm512_mul_pd(y, y), y);
+        y = _mm512_mul_pd(y, _mm512_div_pd(_mm512_fmadd_pd(_mm512_set1_pd(2.0), v, y_3),
+            _mm512_fmadd_pd(_mm512_set1_pd(2.0), y_3, v)));
+    }
+
+    return y;
+}
+
+/**
+ * @brief Heikkinen's closed form solution for eight rows.
+ */
+__attribute__((target("avx512f")))
+static inline void closed_form_avx512(const GeodeticTerms* terms, __m512d p, __m512d p_2, __m512d z,
+    __m512d* latitude, __m512d* height) {
+
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d e_2 = _mm512_set1_pd(terms->e_2);
+    const __m512d one_e_2 = _mm512_set1_pd(1.0 - terms->e_2);
+    const __m512d b2 = _mm512_set1_pd(terms->b2);
+
+    __m512d z_2 = _mm512_mul_pd(z, z);
+    __m512d big_f = _mm512_mul_pd(_mm512_set1_pd(54.0 * terms->b2), z_2);
+    __m512d big_g = _mm512_fmadd_pd(z_2, one_e_2, _mm512_sub_pd(p_2,
+        _mm512_set1_pd(terms->e_2 * terms->e_numerator)));
+    __m512d big_g_2 = _mm512_mul_pd(big_g, big_g);
+    __m512d c = _mm512_div_pd(_mm512_mul_pd(_mm512_set1_pd(terms->e_2 * terms->e_2), _mm512_mul_pd(big_f, p_2)),
+        _mm512_mul_pd(big_g_2, big_g));
+    __m512d s = cbrt_avx512(_mm512_add_pd(_mm512_add_pd(one, c),
+        _mm512_sqrt_pd(_mm512_fmadd_pd(c, c, _mm512_add_pd(c, c)))));
+    __m512d k = _mm512_add_pd(_mm512_add_pd(s, one), _mm512_div_pd(one, s));
+    __m512d big_p = _mm512_div_pd(big_f, _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(3.0), _mm512_mul_pd(k, k)),
+        big_g_2));
+    __m512d big_q = _mm512_sqrt_pd(_mm512_fmadd_pd(_mm512_set1_pd(2.0 * terms->e_2 * terms->e_2), big_p, one));
+    __m512d one_q = _mm512_add_pd(one, big_q);
+    __m512d sqrt_r_0 = _mm512_mul_pd(_mm512_set1_pd(terms->a2 / 2.0), _mm512_add_pd(one,
+        _mm512_div_pd(one, big_q)));
+    sqrt_r_0 = _mm512_sub_pd(sqrt_r_0, _mm512_div_pd(_mm512_mul_pd(_mm512_mul_pd(big_p, one_e_2), z_2),
+        _mm512_mul_pd(big_q, one_q)));
+    sqrt_r_0 = _mm512_fnmadd_pd(_mm512_mul_pd(big_p, _mm512_set1_pd(0.5)), p_2, sqrt_r_0);
+    sqrt_r_0 = _mm512_sqrt_pd(_mm512_max_pd(sqrt_r_0, zero));
+    __m512d r_0 = _mm512_sub_pd(sqrt_r_0, _mm512_div_pd(_mm512_mul_pd(_mm512_mul_pd(big_p, e_2), p), one_q));
+    __m512d p_e_2_r_0 = _mm512_fnmadd_pd(e_2, r_0, p);
+    __m512d p_e_2_r_0_2 = _mm512_mul_pd(p_e_2_r_0, p_e_2_r_0);
+    __m512d big_u = _mm512_sqrt_pd(_mm512_add_pd(p_e_2_r_0_2, z_2));
+    __m512d big_v = _mm512_sqrt_pd(_mm512_fmadd_pd(one_e_2, z_2, p_e_2_r_0_2));
+    __m512d a_v = _mm512_mul_pd(_mm512_set1_pd(terms->a), big_v);
+    __m512d z_0 = _mm512_div_pd(_mm512_mul_pd(b2, z), a_v);
+
+    *latitude = atan_avx512(_mm512_div_pd(_mm512_fmadd_pd(_mm512_set1_pd(terms->e_r2), z_0, z), p));
+    *height = _mm512_mul_pd(big_u, _mm512_sub_pd(one, _mm512_div_pd(b2, a_v)));
+}
+
+/**
+ * @brief Latitude and height of eight rows from the tangents n / d of their latitudes.
+ */
+__attribute__((target("avx512f")))
+static inline void tangent_avx512(const GeodeticTerms* terms, __m512d p, __m512d z, __m512d n, __m512d d,
+    __m512d* latitude, __m512d* height) {
+
+    __m512d n_2 = _mm512_mul_pd(n, n);
+    __m512d d_2 = _mm512_mul_pd(d, d);
+    __m512d foot = _mm512_sqrt_pd(_mm512_fmadd_pd(_mm512_set1_pd(terms->a2), d_2,
+        _mm512_mul_pd(_mm512_set1_pd(terms->b2), n_2)));
+
+    *latitude = atan_avx512(_mm512_div_pd(n, d));
+    *height = _mm512_div_pd(_mm512_sub_pd(_mm512_fmadd_pd(p, d, _mm512_mul_pd(z, n)), foot),
+        _mm512_sqrt_pd(_mm512_add_pd(n_2, d_2)));
+}
+
+/**
+ * @brief Bowring's method for eight rows.
+ */
+__attribute__((target("avx512f")))
+static inline void bowring_avx512(const GeodeticTerms* terms, __m512d p, __m512d z, int iterations,
+    __m512d* latitude, __m512d* height) {
+
+    const __m512d a = _mm512_set1_pd(terms->a);
+    const __m512d b = _mm512_set1_pd(terms->b);
+    __m512d s = _mm512_mul_pd(a, z), c = _mm512_mul_pd(b, p);
+    __m512d n = z, d = p;
+
+    for(int i = 0; i < iterations; ++i) {
+        __m512d inverse_norm = _mm512_div_pd(_mm512_set1_pd(1.0), _mm512_sqrt_pd(_mm512_fmadd_pd(s, s,
+            _mm512_mul_pd(c, c))));
+        __m512d sin_beta = _mm512_mul_pd(s, inverse_norm), cos_beta = _mm512_mul_pd(c, inverse_norm);
+        n = _mm512_fmadd_pd(_mm512_set1_pd(terms->e_r2 * terms->b), _mm512_mul_pd(_mm512_mul_pd(sin_beta, sin_beta),
+            sin_beta), z);
+        d = _mm512_fnmadd_pd(_mm512_set1_pd(terms->e_2 * terms->a), _mm512_mul_pd(_mm512_mul_pd(cos_beta, cos_beta),
+            cos_beta), p);
+        s = _mm512_mul_pd(b, n);
+        c = _mm512_mul_pd(a, d);
+    }
+
+    tangent_avx512(terms, p, z, n, d, latitude, height);
+}
+
+/**
+ * @brief Vermeille's closed form solution for eight rows.
+ */
+__attribute__((target("avx512f")))
+static inline void vermeille_avx512(const GeodeticTerms* terms, __m512d p, __m512d p_2, __m512d z,
+    __m512d* latitude, __m512d* height) {
+
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d e_2 = _mm512_set1_pd(terms->e_2);
+    const __m512d e_4 = _mm512_set1_pd(terms->e_2 * terms->e_2);
+
+    p_2 = _mm512_mul_pd(p_2, _mm512_set1_pd(1.0 / terms->a2));
+    __m512d q = _mm512_mul_pd(_mm512_set1_pd((1.0 - terms->e_2) / terms->a2), _mm512_mul_pd(z, z));
+    __m512d r = _mm512_mul_pd(_mm512_sub_pd(_mm512_add_pd(p_2, q), e_4), _mm512_set1_pd(1.0 / 6.0));
+    __m512d s = _mm512_div_pd(_mm512_mul_pd(e_4, _mm512_mul_pd(p_2, q)),
+        _mm512_mul_pd(_mm512_set1_pd(4.0), _mm512_mul_pd(_mm512_mul_pd(r, r), r)));
+    __m512d t = cbrt_avx512(_mm512_add_pd(_mm512_add_pd(one, s),
+        _mm512_sqrt_pd(_mm512_mul_pd(s, _mm512_add_pd(_mm512_set1_pd(2.0), s)))));
+    __m512d u = _mm512_mul_pd(r, _mm512_add_pd(_mm512_add_pd(one, t), _mm512_div_pd(one, t)));
+    __m512d v = _mm512_sqrt_pd(_mm512_fmadd_pd(u, u, _mm512_mul_pd(e_4, q)));
+    __m512d u_v = _mm512_add_pd(u, v);
+    __m512d w = _mm512_div_pd(_mm512_mul_pd(e_2, _mm512_sub_pd(u_v, q)), _mm512_add_pd(v, v));
+    __m512d k = _mm512_sub_pd(_mm512_sqrt_pd(_mm512_fmadd_pd(w, w, u_v)), w);
+    __m512d d = _mm512_div_pd(_mm512_mul_pd(k, p), _mm512_add_pd(k, e_2));
+    __m512d hypotenuse = _mm512_sqrt_pd(_mm512_fmadd_pd(d, d, _mm512_mul_pd(z, z)));
+
+    *latitude = _mm512_mul_pd(_mm512_set1_pd(2.0), atan_avx512(_mm512_div_pd(z, _mm512_add_pd(d, hypotenuse))));
+    *height = _mm512_mul_pd(_mm512_div_pd(_mm512_add_pd(k, _mm512_set1_pd(terms->e_2 - 1.0)), k), hypotenuse);
+}
+
+/**
+ * @brief Fukushima's method for eight rows.
+ */
+__attribute__((target("avx512f")))
+static inline void fukushima_avx512(const GeodeticTerms* terms, __m512d p, __m512d z, __m512d* latitude,
+    __m512d* height) {
+
+    const __m512i sign_mask = _mm512_set1_epi64((long long)0x8000000000000000ULL);
+    const __m512d e_2 = _mm512_set1_pd(terms->e_2);
+
+    __m512d abs_z = _mm512_abs_pd(z);
+    __m512d big_p = _mm512_mul_pd(p, _mm512_set1_pd(1.0 / terms->a));
+    __m512d big_z = _mm512_mul_pd(abs_z, _mm512_set1_pd(terms->e_c / terms->a));
+    __m512d s_0 = big_z, c_0 = _mm512_mul_pd(_mm512_set1_pd(terms->e_c * terms->e_c), big_p);
+    __m512d s_0_2 = _mm512_mul_pd(s_0, s_0), c_0_2 = _mm512_mul_pd(c_0, c_0);
+    __m512d a_0 = _mm512_sqrt_pd(_mm512_add_pd(s_0_2, c_0_2));
+    __m512d a_0_3 = _mm512_mul_pd(_mm512_mul_pd(a_0, a_0), a_0);
+    __m512d d_0 = _mm512_fmadd_pd(big_z, a_0_3, _mm512_mul_pd(e_2, _mm512_mul_pd(s_0_2, s_0)));
+    __m512d f_0 = _mm512_fmsub_pd(big_p, a_0_3, _mm512_mul_pd(e_2, _mm512_mul_pd(c_0_2, c_0)));
+    __m512d e_2_s_0_c_0 = _mm512_mul_pd(e_2, _mm512_mul_pd(s_0, c_0));
+    __m512d b_0 = _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(1.5), _mm512_mul_pd(e_2_s_0_c_0, c_0)),
+        _mm512_fmsub_pd(a_0, _mm512_fmsub_pd(big_p, s_0, _mm512_mul_pd(big_z, c_0)), e_2_s_0_c_0));
+    __m512d s_1 = _mm512_fmsub_pd(d_0, f_0, _mm512_mul_pd(b_0, s_0));
+    __m512d c_1 = _mm512_fmsub_pd(f_0, f_0, _mm512_mul_pd(b_0, c_0));
+
+    tangent_avx512(terms, p, abs_z, s_1, _mm512_mul_pd(_mm512_set1_pd(terms->e_c), c_1), latitude, height);
+    *latitude = _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(*latitude),
+        _mm512_and_si512(_mm512_castpd_si512(z), sign_mask)));
+}
+
+/**
+ * @brief Convert rows eight at a time with AVX-512.
+ */
+__attribute__((target("avx512f")))
+static void geodetic_kernel_convert_avx512(const GeodeticTerms* terms, GeodeticAlgorithm algorithm,
+    const double* positions, double* geodetic, long long n) {
+
+    const __m512i rows = _mm512_set_epi64(21, 18, 15, 12, 9, 6, 3, 0);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d degrees = _mm512_set1_pd(DEGREES_PER_RADIAN);
+    const __m512i sign_mask = _mm512_set1_epi64((long long)0x8000000000000000ULL);
+    const __m512i pi = _mm512_castpd_si512(_mm512_set1_pd(M_PI));
+
+    long long i = 0;
+    for(; i + 8 <= n; i += 8, positions += 24, geodetic += 24) {
+
+        __m512d x = _mm512_i64gather_pd(rows, positions, 8);
+        __m512d y = _mm512_i64gather_pd(rows, positions + 1, 8);
+        __m512d z = _mm512_i64gather_pd(rows, positions + 2, 8);
+
+        __mmask8 pole = _mm512_cmp_pd_mask(x, zero, _CMP_EQ_OQ) & _mm512_cmp_pd_mask(y, zero, _CMP_EQ_OQ);
+        __m512d x_p = _mm512_mask_blend_pd(pole, x, _mm512_set1_pd(POLE_OFFSET));
+
+        __m512d p_2 = _mm512_fmadd_pd(x_p, x_p, _mm512_mul_pd(y, y));
+        __m512d p = _mm512_sqrt_pd(p_2);
+        __m512d latitude, height;
+
+        switch(algorithm) {
+            case BowringGeodeticAlgorithm:
+                bowring_avx512(terms, p, z, 1, &latitude, &height);
+                break;
+            case Bowring2GeodeticAlgorithm:
+                bowring_avx512(terms, p, z, 2, &latitude, &height);
+                break;
+            case VermeilleGeodeticAlgorithm:
+                vermeille_avx512(terms, p, p_2, z, &latitude, &height);
+                break;
+            case FukushimaGeodeticAlgorithm:
+                fukushima_avx512(terms, p, z, &latitude, &height);
+                break;
+            default:
+                closed_form_avx512(terms, p, p_2, z, &latitude, &height);
+                break;
+        }
+
+        /* atan2 from the atan of y/x, a negative x adds a half turn with the sign of y. */
+        __m512d longitude = atan_avx512(_mm512_div_pd(y, x_p));
+        __m512d turn = _mm512_castsi512_pd(_mm512_or_si512(pi, _mm512_and_si512(_mm512_castpd_si512(y), sign_mask)));
+        longitude = _mm512_mask_add_pd(longitude, _mm512_cmp_pd_mask(x_p, zero, _CMP_LT_OQ), longitude, turn);
+
+        _mm512_i64scatter_pd(geodetic, rows, _mm512_mul_pd(latitude, degrees), 8);
+        _mm512_i64scatter_pd(geodetic + 1, rows, _mm512_mul_pd(longitude, degrees), 8);
+        _mm512_i64scatter_pd(geodetic + 2, rows, height, 8);
+    }
+
+    geodetic_kernel_convert_scalar(terms, algorithm, positions, geodetic, n - i);
+}
+
+#endif /* GEODETIC_KERNEL_X86 */
+
+/**
+ * @brief Get the best kernel the CPU supports.
+ */
+GeodeticKernel geodetic_kernel_supported(void) {
+
+#ifdef GEODETIC_KERNEL_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) return AVX512GeodeticKernel;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return AVX2GeodeticKernel;
+#endif /* GEODETIC_KERNEL_X86 */
+
+    return ScalarGeodeticKernel;
+}
+
+/**
+ * @brief Get the kernel geodetic coordinates are currently computed with.
+ */
+GeodeticKernel geodetic_kernel(void) {
+
+    if(!selected_kernel) {
+        selected_kernel = geodetic_kernel_supported();
+    }
+    return selected_kernel;
+}
+
+/**
+ * @brief Force the kernel geodetic coordinates are computed with, used to compare kernels against one another.
+ */
+int set_geodetic_kernel(GeodeticKernel kernel) {
+
+    if(kernel < ScalarGeodeticKernel || kernel > geodetic_kernel_supported()) {
+        return -1;
+    }
+    selected_kernel = kernel;
+    return 0;
+}
+
+/**
+ * @brief Convert rows of ITRS positions to geodetic coordinates with an algorithm on the selected kernel.
+ */
+void geodetic_kernel_convert(double a, double b, GeodeticAlgorithm algorithm, const double* positions,
+    double* geodetic, long long n) {
+
+    GeodeticTerms terms;
+    geodetic_terms(a, b, &terms);
+
+    switch(geodetic_kernel()) {
+#ifdef GEODETIC_KERNEL_X86
+        case AVX512GeodeticKernel:
+            geodetic_kernel_convert_avx512(&terms, algorithm, positions, geodetic, n);
+            break;
+        case AVX2GeodeticKernel:
+            geodetic_kernel_convert_avx2(&terms, algorithm, positions, geodetic, n);
+            break;
+#endif /* GEODETIC_KERNEL_X86 */
+        default:
+            geodetic_kernel_convert_scalar(&terms, algorithm, positions, geodetic, n);
+            break;
+    }
+}
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
@@ -23,6 +23,7 @@
  * */
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
+#include <stddef.h>
 
 #if defined(_WIN32) || defined(WIN32)     /* _Win32 is usually defined by compilers targeting 32 or 64 bit Windows systems */
 
@@ -39,309 +40,1061 @@ extern "C"
 #define __compile_coordinates_state_vector__
 #include "coordinates/state_vector.h"
 
+/** @brief The number of released StateVector objects kept for reuse. */
+#define STATE_VECTOR_FREE_LIST_SIZE 256
+
+/** @brief The number of state arguments the StateVector constructor takes. */
+#define STATE_VECTOR_NARGS 11
+
+/** @brief The number of keywords the StateVector constructor takes, the state arguments and the deprecated capsule. */
+#define STATE_VECTOR_NKEYWORDS (STATE_VECTOR_NARGS + 1)
+
+static PyTypeObject StateVectorType;
+static PyTypeObject StateVectorArrayType;
+static PyTypeObject StateVectorColumnType;
+
+/* Only touched with the GIL held, the transforms allocate their results before releasing it. */
+static StateVectorObject* free_list[STATE_VECTOR_FREE_LIST_SIZE];
+static int free_list_size = 0;
+
+static const char* state_vector_keywords[] = {
+    "x", "y", "z", "vx", "vy", "vz", "ax", "ay", "az", "time", "frame", "capsule", NULL
+};
+
+/* The keywords interned when the module is initialised, keyword names are matched by identity first. */
+static PyObject* state_vector_keyword_objects[STATE_VECTOR_NKEYWORDS];
+
 /**
- * @brief Creates a new StateVector object and makes it available to Python
+ * @brief Checks objects of the given type all share the plain StateVector layout, so their memory is interchangeable.
  */
-static PyObject* new_StateVector(PyObject* self, PyObject* args){
+static int shares_state_vector_layout(PyTypeObject* type) {
+    return type->tp_basicsize == sizeof(StateVectorObject) && type->tp_itemsize == 0 && !PyType_IS_GC(type)
+        && type->tp_free == PyObject_Free;
+}
 
-    StateVector* state_vector = (StateVector*)malloc(sizeof(StateVector));
+/**
+ * @brief Allocates a zeroed StateVector object, taking it from the free list when the type allows it.
+ *
+ * @param type The StateVector type or a subclass of it.
+ * @return The new object or NULL with a Python exception set.
+ */
+static StateVectorObject* new_StateVectorObject(PyTypeObject* type) {
 
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_StateVector.");
-        return PyErr_Occurred();
+    StateVectorObject* object;
+
+    if(free_list_size > 0 && shares_state_vector_layout(type)) {
+        object = free_list[--free_list_size];
+        PyObject_Init((PyObject*)object, type);
+    }
+    else {
+        object = (StateVectorObject*)type->tp_alloc(type, 0);
+        if(!object) {
+            return NULL;
+        }
     }
 
-    double x, y, z, vx, vy, vz, ax, ay, az, time;
-    int frame;
+    memset(&object->state_vector, 0, sizeof(StateVector));
 
-    if(!PyArg_ParseTuple(args, "ddddddddddi", &x, &y, &z, &vx, &vy, &vz, &ax, &ay, &az, &time, &frame)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. new_StateVector()");
-        return PyErr_Occurred();
-    }
-
-    state_vector->r.x = x;
-    state_vector->r.y = y;
-    state_vector->r.z = z;
-    state_vector->v.x = vx;
-    state_vector->v.y = vy;
-    state_vector->v.z = vz;
-    state_vector->a.x = ax;
-    state_vector->a.y = ay;
-    state_vector->a.z = az;
-    state_vector->time = time;
-    state_vector->frame = frame;
+    return object;
+}
+
+/**
+ * @brief Returns the StateVector object to the free list or releases it.
+ */
+static void StateVector_dealloc(PyObject* self) {
 
-    return PyCapsule_New(state_vector, "StateVector", delete_StateVector);
+    PyTypeObject* type = Py_TYPE(self);
+
+    /* Subclasses without extra slots are kept as well, subtype_dealloc releases their type reference after this. */
+    if(free_list_size < STATE_VECTOR_FREE_LIST_SIZE && shares_state_vector_layout(type)) {
+        free_list[free_list_size++] = (StateVectorObject*)self;
+        return;
+    }
+
+    type->tp_free(self);
+}
+
+/**
+ * @brief Gets the state vector held by a StateVector object passed to the module functions.
+ */
+static StateVector* get_state_vector(PyObject* obj, const char* function) {
+
+    if(!PyObject_TypeCheck(obj, &StateVectorType)) {
+        PyErr_Format(PyExc_TypeError, "%s() was expecting a StateVector.", function);
+        return NULL;
+    }
+
+    return &((StateVectorObject*)obj)->state_vector;
 }
 
 /**
- * @brief Deletes the StateVector object
+ * @brief Checks a reference frame is one of the ReferenceFrame values.
+ */
+static int check_frame(long frame) {
+
+    if(frame < InternationalTerrestrialReferenceFrame || frame > GeodeticReferenceFrame) {
+        PyErr_Format(PyExc_ValueError, "%ld is not a valid ReferenceFrame.", frame);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Fills a state vector from the constructor arguments, laid out in the order of state_vector_keywords.
  *
- * @param obj The StateVector object
+ * @param values The arguments, NULL for the ones not given.
+ * @param state_vector The state vector to fill.
+ * @return 0 on success, -1 with a Python exception set otherwise.
  */
-void delete_StateVector(PyObject* obj) {
+static int parse_state_vector(PyObject** values, StateVector* state_vector) {
+
+    double components[STATE_VECTOR_NARGS - 1];
+    long frame = GeodeticReferenceFrame;
+
+    /* Deprecated, kept for one release for callers still holding a capsule from before StateVector was native. */
+    PyObject* capsule = values[STATE_VECTOR_NKEYWORDS - 1];
+    if(capsule && capsule != Py_None) {
+        if(PyErr_WarnEx(PyExc_DeprecationWarning,
+            "StateVector(capsule=...) is deprecated, pass the state values or copy a StateVector instead.", 1) < 0) {
+            return -1;
+        }
+        if(!PyCapsule_IsValid(capsule, "StateVector")) {
+            PyErr_SetString(PyExc_TypeError, "StateVector() was expecting a StateVector capsule.");
+            return -1;
+        }
+        const StateVector* wrapped = (const StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
+        if(check_frame(wrapped->frame) != 0) {
+            return -1;
+        }
+        *state_vector = *wrapped;
+        return 0;
+    }
 
-    StateVector* state_vector = (StateVector*)PyCapsule_GetPointer(obj, "StateVector");
+    if(!values[0] || !values[1]) {
+        PyErr_SetString(PyExc_TypeError, "StateVector() requires at least x and y.");
+        return -1;
+    }
+
+    for(int i = 0; i < STATE_VECTOR_NARGS - 1; ++i) {
+        components[i] = 0.0;
+        if(values[i]) {
+            components[i] = PyFloat_AsDouble(values[i]);
+            if(components[i] == -1.0 && PyErr_Occurred()) {
+                return -1;
+            }
+        }
+    }
+
+    if(values[STATE_VECTOR_NARGS - 1]) {
+        frame = PyLong_AsLong(values[STATE_VECTOR_NARGS - 1]);
+        if(frame == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+    }
 
-    if(state_vector) {
-        free(state_vector);
+    if(check_frame(frame) != 0) {
+        return -1;
     }
+
+    state_vector->r.x = components[0];
+    state_vector->r.y = components[1];
+    state_vector->r.z = components[2];
+    state_vector->v.x = components[3];
+    state_vector->v.y = components[4];
+    state_vector->v.z = components[5];
+    state_vector->a.x = components[6];
+    state_vector->a.y = components[7];
+    state_vector->a.z = components[8];
+    state_vector->time = components[9];
+    state_vector->frame = (ReferenceFrame)frame;
+
+    return 0;
 }
 
 /**
- * @brief Sets the position vector.
+ * @brief Places a keyword argument in the slot of its name.
+ *
+ * @return 0 on success, -1 with a Python exception set otherwise.
  */
-static PyObject* set_position(PyObject* self, PyObject* args) {
+static int place_keyword(PyObject** values, PyObject* name, PyObject* value) {
 
-    PyObject* capsule;
-    StateVector* state_vector;
-    double x, y, z;
+    int index = -1;
 
-    if(!PyArg_ParseTuple(args, "Oddd", &capsule, &x, &y, &z)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_position.");
-        return PyErr_Occurred();
+    for(int i = 0; i < STATE_VECTOR_NKEYWORDS && index < 0; ++i) {
+        if(name == state_vector_keyword_objects[i]) {
+            index = i;
+        }
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+    for(int i = 0; i < STATE_VECTOR_NKEYWORDS && index < 0; ++i) {
+        if(PyUnicode_Check(name) && PyUnicode_Compare(name, state_vector_keyword_objects[i]) == 0) {
+            index = i;
+        }
     }
 
-    state_vector->r.x = x;
-    state_vector->r.y = y;
-    state_vector->r.z = z;
+    if(index < 0) {
+        PyErr_Format(PyExc_TypeError, "StateVector() got an unexpected keyword argument '%S'", name);
+        return -1;
+    }
 
-    Py_RETURN_NONE;
+    if(values[index]) {
+        PyErr_Format(PyExc_TypeError, "StateVector() got multiple values for argument '%s'",
+            state_vector_keywords[index]);
+        return -1;
+    }
+
+    values[index] = value;
+
+    return 0;
 }
 
 /**
- * @brief Sets the velocity vector.
+ * @brief Creates a StateVector from positional arguments followed by the values of the keyword arguments.
  */
-static PyObject* set_velocity(PyObject* self, PyObject* args) {
+static PyObject* create_state_vector(PyTypeObject* type, PyObject* const* args, Py_ssize_t nargs,
+    PyObject* const* kwvalues, PyObject* kwnames) {
 
-    PyObject* capsule;
-    StateVector* state_vector;
-    double x, y, z;
+    PyObject* values[STATE_VECTOR_NKEYWORDS] = {NULL};
 
-    if(!PyArg_ParseTuple(args, "Oddd", &capsule, &x, &y, &z)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_velocity.");
-        return PyErr_Occurred();
+    if(nargs > STATE_VECTOR_NKEYWORDS) {
+        PyErr_Format(PyExc_TypeError, "StateVector() takes at most %d arguments (%zd given)", STATE_VECTOR_NKEYWORDS,
+            nargs);
+        return NULL;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+    for(Py_ssize_t i = 0; i < nargs; ++i) {
+        values[i] = args[i];
     }
 
-    state_vector->v.x = x;
-    state_vector->v.y = y;
-    state_vector->v.z = z;
+    if(kwnames) {
+        for(Py_ssize_t i = 0; i < PyTuple_GET_SIZE(kwnames); ++i) {
+            if(place_keyword(values, PyTuple_GET_ITEM(kwnames, i), kwvalues[i]) != 0) {
+                return NULL;
+            }
+        }
+    }
+
+    StateVectorObject* object = new_StateVectorObject(type);
+    if(!object) {
+        return NULL;
+    }
+
+    if(parse_state_vector(values, &object->state_vector) != 0) {
+        Py_DECREF(object);
+        return NULL;
+    }
+
+    return (PyObject*)object;
+}
+
+/**
+ * @brief Creates a StateVector when a subclass is called, keyword arguments are parsed by name.
+ */
+static PyObject* StateVector_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+
+    PyObject* values[STATE_VECTOR_NKEYWORDS] = {NULL};
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+
+    if(nargs > STATE_VECTOR_NKEYWORDS) {
+        PyErr_Format(PyExc_TypeError, "StateVector() takes at most %d arguments (%zd given)", STATE_VECTOR_NKEYWORDS,
+            nargs);
+        return NULL;
+    }
+
+    for(Py_ssize_t i = 0; i < nargs; ++i) {
+        values[i] = PyTuple_GET_ITEM(args, i);
+    }
+
+    if(kwds) {
+        PyObject* name;
+        PyObject* value;
+        Py_ssize_t position = 0;
+        while(PyDict_Next(kwds, &position, &name, &value)) {
+            if(place_keyword(values, name, value) != 0) {
+                return NULL;
+            }
+        }
+    }
+
+    StateVectorObject* object = new_StateVectorObject(type);
+    if(!object) {
+        return NULL;
+    }
+
+    if(parse_state_vector(values, &object->state_vector) != 0) {
+        Py_DECREF(object);
+        return NULL;
+    }
+
+    return (PyObject*)object;
+}
+
+/**
+ * @brief Creates a StateVector when the type itself is called, without building an argument tuple.
+ */
+static PyObject* StateVector_vectorcall(PyObject* type, PyObject* const* args, size_t nargsf, PyObject* kwnames) {
+
+    PyTypeObject* cls = (PyTypeObject*)type;
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+
+    /* A subclass given __new__ or __init__ after it was created goes through the regular type call. */
+    if(cls->tp_new != StateVector_new || cls->tp_init != StateVectorType.tp_init) {
+
+        PyObject* positional = PyTuple_New(nargs);
+        PyObject* keywords = NULL;
+        PyObject* retval = NULL;
+
+        if(!positional) {
+            return NULL;
+        }
+
+        for(Py_ssize_t i = 0; i < nargs; ++i) {
+            Py_INCREF(args[i]);
+            PyTuple_SET_ITEM(positional, i, args[i]);
+        }
+
+        if(kwnames && PyTuple_GET_SIZE(kwnames) > 0) {
+            keywords = PyDict_New();
+            for(Py_ssize_t i = 0; keywords && i < PyTuple_GET_SIZE(kwnames); ++i) {
+                if(PyDict_SetItem(keywords, PyTuple_GET_ITEM(kwnames, i), args[nargs + i]) < 0) {
+                    Py_CLEAR(keywords);
+                }
+            }
+            if(!keywords) {
+                Py_DECREF(positional);
+                return NULL;
+            }
+        }
+
+        retval = PyType_Type.tp_call(type, positional, keywords);
+        Py_DECREF(positional);
+        Py_XDECREF(keywords);
+
+        return retval;
+    }
+
+    return create_state_vector(cls, args, nargs, args + nargs, kwnames);
+}
+
+/**
+ * @brief Gives subclasses that leave construction to StateVector the vectorcall constructor as well.
+ */
+static PyObject* StateVector_init_subclass(PyObject* cls, PyObject* Py_UNUSED(ignored)) {
+
+    PyTypeObject* type = (PyTypeObject*)cls;
+
+    if(type->tp_new == StateVector_new && type->tp_init == StateVectorType.tp_init) {
+        type->tp_vectorcall = StateVector_vectorcall;
+    }
 
     Py_RETURN_NONE;
 }
 
 /**
- * @brief Sets the acceleration vector.
+ * @brief Gets one of the vectors, the closure is the offset of the vector in the StateVector.
  */
-static PyObject* set_acceleration(PyObject* self, PyObject* args) {
+static PyObject* StateVector_get_vec3(StateVectorObject* self, void* closure) {
+
+    Vec3* vector = (Vec3*)((char*)&self->state_vector + (size_t)closure);
+    PyObject* retval = PyTuple_New(3);
+
+    if(retval) {
+        PyTuple_SET_ITEM(retval, 0, PyFloat_FromDouble((double)vector->x));
+        PyTuple_SET_ITEM(retval, 1, PyFloat_FromDouble((double)vector->y));
+        PyTuple_SET_ITEM(retval, 2, PyFloat_FromDouble((double)vector->z));
+        if(!PyTuple_GET_ITEM(retval, 0) || !PyTuple_GET_ITEM(retval, 1) || !PyTuple_GET_ITEM(retval, 2)) {
+            Py_CLEAR(retval);
+        }
+    }
 
-    PyObject* capsule;
-    StateVector* state_vector;
+    return retval;
+}
+
+/**
+ * @brief Sets one of the vectors from a sequence of three floats, the closure is the offset of the vector.
+ */
+static int StateVector_set_vec3(StateVectorObject* self, PyObject* value, void* closure) {
+
+    Vec3* vector = (Vec3*)((char*)&self->state_vector + (size_t)closure);
     double x, y, z;
 
-    if(!PyArg_ParseTuple(args, "Oddd", &capsule, &x, &y, &z)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_acceleration.");
-        return PyErr_Occurred();
+    if(!value) {
+        PyErr_SetString(PyExc_AttributeError, "StateVector attributes can not be deleted.");
+        return -1;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+    PyObject* sequence = PySequence_Fast(value, "StateVector vectors must be a sequence of three floats.");
+    if(!sequence) {
+        return -1;
     }
 
-    state_vector->a.x = x;
-    state_vector->a.y = y;
-    state_vector->a.z = z;
+    if(PySequence_Fast_GET_SIZE(sequence) != 3) {
+        Py_DECREF(sequence);
+        PyErr_SetString(PyExc_ValueError, "StateVector vectors must be a sequence of three floats.");
+        return -1;
+    }
 
-    Py_RETURN_NONE;
+    x = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, 0));
+    y = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, 1));
+    z = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(sequence, 2));
+    Py_DECREF(sequence);
+    if(PyErr_Occurred()) {
+        return -1;
+    }
+
+    vector->x = x;
+    vector->y = y;
+    vector->z = z;
+
+    return 0;
 }
 
 /**
- * @brief Sets the timestamp.
+ * @brief Gets the timestamp as a float.
  */
-static PyObject* set_time(PyObject* self, PyObject* args) {
+static PyObject* StateVector_get_time(StateVectorObject* self, void* closure) {
+    return PyFloat_FromDouble((double)self->state_vector.time);
+}
 
-    PyObject* capsule;
-    StateVector* state_vector;
-    double time;
+/**
+ * @brief Sets the timestamp from a float.
+ */
+static int StateVector_set_time(StateVectorObject* self, PyObject* value, void* closure) {
 
-    if(!PyArg_ParseTuple(args, "Od", &capsule, &time)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_time.");
-        return PyErr_Occurred();
+    if(!value) {
+        PyErr_SetString(PyExc_AttributeError, "StateVector attributes can not be deleted.");
+        return -1;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+    double time = PyFloat_AsDouble(value);
+    if(time == -1.0 && PyErr_Occurred()) {
+        return -1;
     }
 
-    state_vector->time = time;
+    self->state_vector.time = time;
 
-    Py_RETURN_NONE;
+    return 0;
 }
 
 /**
- * @brief Sets the reference frame.
+ * @brief Gets the reference frame as an int.
  */
-static PyObject* set_frame(PyObject* self, PyObject* args) {
+static PyObject* StateVector_get_frame(StateVectorObject* self, void* closure) {
+    return PyLong_FromLong(self->state_vector.frame);
+}
 
-    PyObject* capsule;
-    StateVector* state_vector;
-    ReferenceFrame frame;
+/**
+ * @brief Sets the reference frame from an int or a ReferenceFrame.
+ */
+static int StateVector_set_frame(StateVectorObject* self, PyObject* value, void* closure) {
 
-    if(!PyArg_ParseTuple(args, "Oi", &capsule, &frame)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_frame.");
-        return PyErr_Occurred();
+    if(!value) {
+        PyErr_SetString(PyExc_AttributeError, "StateVector attributes can not be deleted.");
+        return -1;
+    }
+
+    long frame = PyLong_AsLong(value);
+    if((frame == -1 && PyErr_Occurred()) || check_frame(frame) != 0) {
+        return -1;
+    }
+
+    self->state_vector.frame = (ReferenceFrame)frame;
+
+    return 0;
+}
+
+/**
+ * @brief Creates a copy of the StateVector of the same type.
+ */
+static PyObject* StateVector_copy(StateVectorObject* self, PyObject* Py_UNUSED(ignored)) {
+
+    StateVectorObject* retval = new_StateVectorObject(Py_TYPE(self));
+
+    if(retval) {
+        retval->state_vector = self->state_vector;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
+    return (PyObject*)retval;
+}
+
+/**
+ * @brief Copies another StateVector into this one without allocating.
+ */
+static PyObject* StateVector_assign(StateVectorObject* self, PyObject* other) {
+
+    StateVector* state_vector = get_state_vector(other, "assign");
     if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+        return NULL;
     }
 
-    state_vector->frame = frame;
+    self->state_vector = *state_vector;
 
     Py_RETURN_NONE;
 }
 
 /**
- * @brief Gets the position vector.
+ * @brief Formats the StateVector for debugging.
  */
-static PyObject* get_position(PyObject* self, PyObject* args) {
+static PyObject* StateVector_repr(StateVectorObject* self) {
+
+    char buffer[512];
+    StateVector* state_vector = &self->state_vector;
+
+    PyOS_snprintf(buffer, sizeof(buffer), "%s((%.17g, %.17g, %.17g), (%.17g, %.17g, %.17g), (%.17g, %.17g, %.17g), "
+        "time=%.17g, frame=%d)", Py_TYPE(self)->tp_name,
+        (double)state_vector->r.x, (double)state_vector->r.y, (double)state_vector->r.z,
+        (double)state_vector->v.x, (double)state_vector->v.y, (double)state_vector->v.z,
+        (double)state_vector->a.x, (double)state_vector->a.y, (double)state_vector->a.z,
+        (double)state_vector->time, (int)state_vector->frame);
+
+    return PyUnicode_FromString(buffer);
+}
 
-    PyObject* capsule;
-    StateVector* state_vector;
 
-    if(!PyArg_ParseTuple(args, "O", &capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for get_position.");
-        return PyErr_Occurred();
+static PyGetSetDef StateVectorGetSet[] = {
+    {"position", (getter)StateVector_get_vec3, (setter)StateVector_set_vec3,
+        "The position vector as a tuple of floats.", (void*)offsetof(StateVector, r)},
+    {"velocity", (getter)StateVector_get_vec3, (setter)StateVector_set_vec3,
+        "The velocity vector as a tuple of floats.", (void*)offsetof(StateVector, v)},
+    {"acceleration", (getter)StateVector_get_vec3, (setter)StateVector_set_vec3,
+        "The acceleration vector as a tuple of floats.", (void*)offsetof(StateVector, a)},
+    {"time", (getter)StateVector_get_time, (setter)StateVector_set_time,
+        "The time in seconds since the UNIX epoch.", NULL},
+    {"frame", (getter)StateVector_get_frame, (setter)StateVector_set_frame,
+        "The reference frame as an int.", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef StateVectorMethods[] = {
+    {"__copy__", (PyCFunction)StateVector_copy, METH_NOARGS, "Creates a copy of the state vector."},
+    {"assign", (PyCFunction)StateVector_assign, METH_O, "Copies the given state vector into this one."},
+    {"__init_subclass__", (PyCFunction)StateVector_init_subclass, METH_CLASS | METH_NOARGS,
+        "Gives subclasses not overriding __new__ or __init__ the vectorcall constructor."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject StateVectorType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "coordinates.state_vector.StateVector",
+    .tp_doc = "A position, velocity and acceleration at a time in a reference frame.",
+    .tp_basicsize = sizeof(StateVectorObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new = StateVector_new,
+    .tp_vectorcall = StateVector_vectorcall,
+    .tp_dealloc = StateVector_dealloc,
+    .tp_free = PyObject_Free,
+    .tp_repr = (reprfunc)StateVector_repr,
+    .tp_getset = StateVectorGetSet,
+    .tp_methods = StateVectorMethods,
+};
+
+/**
+ * @brief Allocates a StateVectorArray of the given type with zeroed columns.
+ *
+ * @param type The StateVectorArray type or a subclass of it.
+ * @param size The number of states.
+ * @return The new object or NULL with a Python exception set.
+ */
+static StateVectorArrayObject* new_StateVectorArrayObject(PyTypeObject* type, Py_ssize_t size) {
+
+    if(size < 0 || (size_t)size > PY_SSIZE_T_MAX / (10 * sizeof(double) + sizeof(int))) {
+        PyErr_SetString(PyExc_ValueError, "Invalid StateVectorArray size.");
+        return NULL;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+    StateVectorArrayObject* array = (StateVectorArrayObject*)type->tp_alloc(type, 0);
+    if(!array) {
+        return NULL;
+    }
+
+    /* One block holding the columns one after the other, the doubles first so every column stays aligned. */
+    array->r = (double*)PyMem_Calloc(1, size * (10 * sizeof(double) + sizeof(int)) + 1);
+    if(!array->r) {
+        Py_DECREF(array);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    array->size = size;
+    array->v = array->r + 3 * size;
+    array->a = array->v + 3 * size;
+    array->time = array->a + 3 * size;
+    array->frame = (int*)(array->time + size);
+
+    /* Subclasses name the StateVector subclass indexing returns with an _item_type attribute. */
+    array->item_type = &StateVectorType;
+    if(type != &StateVectorArrayType) {
+        PyObject* item_type = PyObject_GetAttrString((PyObject*)type, "_item_type");
+        if(item_type && PyType_Check(item_type) && PyType_IsSubtype((PyTypeObject*)item_type, &StateVectorType)) {
+            array->item_type = (PyTypeObject*)item_type;
+        }
+        else {
+            Py_XDECREF(item_type);
+            PyErr_Clear();
+        }
+    }
+    if(array->item_type == &StateVectorType) {
+        Py_INCREF(&StateVectorType);
     }
 
-    return Py_BuildValue("(ddd)", (double)state_vector->r.x, (double)state_vector->r.y, (double)state_vector->r.z);
+    return array;
 }
 
 /**
- * @brief Gets the velocity vector.
+ * @brief Releases the columns of the StateVectorArray.
  */
-static PyObject* get_velocity(PyObject* self, PyObject* args) {
+static void StateVectorArray_dealloc(PyObject* self) {
 
-    PyObject* capsule;
-    StateVector* state_vector;
+    StateVectorArrayObject* array = (StateVectorArrayObject*)self;
+
+    PyMem_Free(array->r);
+    Py_XDECREF(array->item_type);
+    Py_TYPE(self)->tp_free(self);
+}
+
+/**
+ * @brief Creates a StateVectorArray from a size or from a sequence of StateVectors.
+ */
+static PyObject* StateVectorArray_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+
+    static char* keywords[] = {"states", "frame", NULL};
+    PyObject* states;
+    int frame = GeodeticReferenceFrame;
+
+    if(!PyArg_ParseTupleAndKeywords(args, kwds, "O|i:StateVectorArray", keywords, &states, &frame)) {
+        return NULL;
+    }
+
+    if(PyIndex_Check(states)) {
 
-    if(!PyArg_ParseTuple(args, "O", &capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for get_velocity.");
-        return PyErr_Occurred();
+        Py_ssize_t size = PyNumber_AsSsize_t(states, PyExc_OverflowError);
+        if((size == -1 && PyErr_Occurred()) || check_frame(frame) != 0) {
+            return NULL;
+        }
+
+        StateVectorArrayObject* array = new_StateVectorArrayObject(type, size);
+        if(!array) {
+            return NULL;
+        }
+
+        for(Py_ssize_t i = 0; i < size; ++i) {
+            array->frame[i] = frame;
+        }
+
+        return (PyObject*)array;
+    }
+
+    PyObject* sequence = PySequence_Fast(states, "StateVectorArray() takes a size or a sequence of StateVectors.");
+    if(!sequence) {
+        return NULL;
+    }
+
+    Py_ssize_t size = PySequence_Fast_GET_SIZE(sequence);
+    StateVectorArrayObject* array = new_StateVectorArrayObject(type, size);
+    if(!array) {
+        Py_DECREF(sequence);
+        return NULL;
+    }
+
+    for(Py_ssize_t i = 0; i < size; ++i) {
+        StateVector* state_vector = get_state_vector(PySequence_Fast_GET_ITEM(sequence, i), "StateVectorArray");
+        if(!state_vector) {
+            Py_DECREF(sequence);
+            Py_DECREF(array);
+            return NULL;
+        }
+        state_vector_array_set(array, i, state_vector);
+    }
+
+    Py_DECREF(sequence);
+
+    return (PyObject*)array;
+}
+
+/**
+ * @brief The number of states in the StateVectorArray.
+ */
+static Py_ssize_t StateVectorArray_length(StateVectorArrayObject* self) {
+    return self->size;
+}
+
+/**
+ * @brief Copies state i out of the StateVectorArray into a new StateVector.
+ */
+static PyObject* StateVectorArray_item(StateVectorArrayObject* self, Py_ssize_t i) {
+
+    if(i < 0 || i >= self->size) {
+        PyErr_SetString(PyExc_IndexError, "StateVectorArray index out of range.");
+        return NULL;
+    }
+
+    StateVectorObject* retval = new_StateVectorObject(self->item_type);
+    if(retval) {
+        state_vector_array_get(self, i, &retval->state_vector);
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
+    return (PyObject*)retval;
+}
+
+/**
+ * @brief Copies a StateVector into state i of the StateVectorArray.
+ */
+static int StateVectorArray_ass_item(StateVectorArrayObject* self, Py_ssize_t i, PyObject* value) {
+
+    if(i < 0 || i >= self->size) {
+        PyErr_SetString(PyExc_IndexError, "StateVectorArray index out of range.");
+        return -1;
+    }
+
+    if(!value) {
+        PyErr_SetString(PyExc_TypeError, "StateVectorArray states can not be deleted.");
+        return -1;
+    }
+
+    StateVector* state_vector = get_state_vector(value, "StateVectorArray");
     if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+        return -1;
     }
 
-    return Py_BuildValue("(ddd)", (double)state_vector->v.x, (double)state_vector->v.y, (double)state_vector->v.z);
+    state_vector_array_set(self, i, state_vector);
+
+    return 0;
 }
 
 /**
- * @brief Gets the acceleration vector.
+ * @brief Creates a copy of the StateVectorArray of the same type.
  */
-static PyObject* get_acceleration(PyObject* self, PyObject* args) {
+static PyObject* StateVectorArray_copy(StateVectorArrayObject* self, PyObject* Py_UNUSED(ignored)) {
+
+    StateVectorArrayObject* retval = new_StateVectorArrayObject(Py_TYPE(self), self->size);
+
+    if(retval) {
+        memcpy(retval->r, self->r, self->size * (10 * sizeof(double) + sizeof(int)));
+    }
+
+    return (PyObject*)retval;
+}
+
+/**
+ * @brief Copies another StateVectorArray of the same size into this one without allocating.
+ */
+static PyObject* StateVectorArray_assign(StateVectorArrayObject* self, PyObject* other) {
+
+    if(!PyObject_TypeCheck(other, &StateVectorArrayType)) {
+        PyErr_SetString(PyExc_TypeError, "assign() was expecting a StateVectorArray.");
+        return NULL;
+    }
+
+    StateVectorArrayObject* states = (StateVectorArrayObject*)other;
+    if(states->size != self->size) {
+        PyErr_SetString(PyExc_ValueError, "assign() needs a StateVectorArray of the same size.");
+        return NULL;
+    }
+
+    memmove(self->r, states->r, self->size * (10 * sizeof(double) + sizeof(int)));
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Gets a zero copy memoryview of one of the columns, the closure is the StateVectorColumn.
+ */
+static PyObject* StateVectorArray_get_column(StateVectorArrayObject* self, void* closure) {
+
+    StateVectorColumnObject* column = PyObject_New(StateVectorColumnObject, &StateVectorColumnType);
+    if(!column) {
+        return NULL;
+    }
+
+    Py_INCREF(self);
+    column->array = self;
+    column->column = (int)(size_t)closure;
+
+    if(column->column == TimeColumn || column->column == FrameColumn) {
+        column->shape[0] = self->size;
+        column->strides[0] = column->column == TimeColumn ? sizeof(double) : sizeof(int);
+    }
+    else {
+        column->shape[0] = self->size;
+        column->shape[1] = 3;
+        column->strides[0] = 3 * sizeof(double);
+        column->strides[1] = sizeof(double);
+    }
+
+    PyObject* retval = PyMemoryView_FromObject((PyObject*)column);
+    Py_DECREF(column);
+
+    return retval;
+}
+
+/**
+ * @brief Releases the reference the column holds on its StateVectorArray.
+ */
+static void StateVectorColumn_dealloc(PyObject* self) {
+
+    Py_DECREF(((StateVectorColumnObject*)self)->array);
+    PyObject_Free(self);
+}
+
+/**
+ * @brief Exposes the column without copying, vectors as N x 3 doubles, times as N doubles and frames as N ints.
+ */
+static int StateVectorColumn_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+
+    StateVectorColumnObject* column = (StateVectorColumnObject*)self;
+    StateVectorArrayObject* array = column->array;
+
+    switch(column->column) {
+        case PositionColumn: view->buf = array->r; break;
+        case VelocityColumn: view->buf = array->v; break;
+        case AccelerationColumn: view->buf = array->a; break;
+        case TimeColumn: view->buf = array->time; break;
+        default: view->buf = array->frame; break;
+    }
+
+    view->obj = self;
+    Py_INCREF(self);
+    view->itemsize = column->column == FrameColumn ? sizeof(int) : sizeof(double);
+    view->ndim = column->column == TimeColumn || column->column == FrameColumn ? 1 : 2;
+    view->len = array->size * (view->ndim == 2 ? 3 : 1) * view->itemsize;
+    view->readonly = 0;
+    view->format = (flags & PyBUF_FORMAT) ? (column->column == FrameColumn ? "i" : "d") : NULL;
+    view->shape = (flags & PyBUF_ND) == PyBUF_ND ? column->shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? column->strides : NULL;
+    view->suboffsets = NULL;
+    view->internal = NULL;
+
+    return 0;
+}
+
+
+static PyBufferProcs StateVectorColumnBuffer = {
+    StateVectorColumn_getbuffer,
+    NULL
+};
+
+static PyTypeObject StateVectorColumnType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "coordinates.state_vector.StateVectorColumn",
+    .tp_doc = "A column of a StateVectorArray exposed through the buffer protocol.",
+    .tp_basicsize = sizeof(StateVectorColumnObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = StateVectorColumn_dealloc,
+    .tp_as_buffer = &StateVectorColumnBuffer,
+};
+
+static PySequenceMethods StateVectorArraySequence = {
+    .sq_length = (lenfunc)StateVectorArray_length,
+    .sq_item = (ssizeargfunc)StateVectorArray_item,
+    .sq_ass_item = (ssizeobjargproc)StateVectorArray_ass_item,
+};
+
+static PyGetSetDef StateVectorArrayGetSet[] = {
+    {"position", (getter)StateVectorArray_get_column, NULL,
+        "The positions as an N x 3 memoryview of doubles.", (void*)PositionColumn},
+    {"velocity", (getter)StateVectorArray_get_column, NULL,
+        "The velocities as an N x 3 memoryview of doubles.", (void*)VelocityColumn},
+    {"acceleration", (getter)StateVectorArray_get_column, NULL,
+        "The accelerations as an N x 3 memoryview of doubles.", (void*)AccelerationColumn},
+    {"time", (getter)StateVectorArray_get_column, NULL,
+        "The times in seconds since the UNIX epoch as a memoryview of doubles.", (void*)TimeColumn},
+    {"frame", (getter)StateVectorArray_get_column, NULL,
+        "The reference frames as a memoryview of ints.", (void*)FrameColumn},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PyMethodDef StateVectorArrayMethods[] = {
+    {"__copy__", (PyCFunction)StateVectorArray_copy, METH_NOARGS, "Creates a copy of the states."},
+    {"assign", (PyCFunction)StateVectorArray_assign, METH_O, "Copies the given states of the same size into these."},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject StateVectorArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "coordinates.state_vector.StateVectorArray",
+    .tp_doc = "States stored as contiguous position, velocity, acceleration, time and frame columns.",
+    .tp_basicsize = sizeof(StateVectorArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_new = StateVectorArray_new,
+    .tp_dealloc = StateVectorArray_dealloc,
+    .tp_as_sequence = &StateVectorArraySequence,
+    .tp_getset = StateVectorArrayGetSet,
+    .tp_methods = StateVectorArrayMethods,
+};
+
+static StateVectorAPI state_vector_api = {
+    &StateVectorType,
+    sizeof(Real),
+    new_StateVectorObject,
+    &StateVectorArrayType,
+    new_StateVectorArrayObject
+};
 
-    PyObject* capsule;
+
+/**
+ * @brief Creates a new StateVector object and makes it available to Python
+ */
+static PyObject* new_StateVector(PyObject* self, PyObject* const* args, Py_ssize_t nargs){
+
+    if(nargs != STATE_VECTOR_NARGS) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. new_StateVector()");
+        return NULL;
+    }
+
+    return create_state_vector(&StateVectorType, args, nargs, NULL, NULL);
+}
+
+/**
+ * @brief Sets one of the vectors of the StateVector passed as the first argument.
+ */
+static PyObject* set_vec3(PyObject* args, size_t offset, const char* function) {
+
+    PyObject* obj;
     StateVector* state_vector;
+    double x, y, z;
 
-    if(!PyArg_ParseTuple(args, "O", &capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for get_acceleration.");
-        return PyErr_Occurred();
+    if(!PyArg_ParseTuple(args, "Oddd", &obj, &x, &y, &z)) {
+        PyErr_Format(PyExc_TypeError, "Unable to parse arguments for %s.", function);
+        return NULL;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
+    state_vector = get_state_vector(obj, function);
     if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+        return NULL;
     }
 
-    return Py_BuildValue("(ddd)", (double)state_vector->a.x, (double)state_vector->a.y, (double)state_vector->a.z);
+    Vec3* vector = (Vec3*)((char*)state_vector + offset);
+    vector->x = x;
+    vector->y = y;
+    vector->z = z;
+
+    Py_RETURN_NONE;
 }
 
 /**
- * @brief Gets the timestamp.
+ * @brief Sets the position vector.
  */
-static PyObject* get_time(PyObject* self, PyObject* args) {
+static PyObject* set_position(PyObject* self, PyObject* args) {
+    return set_vec3(args, offsetof(StateVector, r), "set_position");
+}
 
-    PyObject* capsule;
+/**
+ * @brief Sets the velocity vector.
+ */
+static PyObject* set_velocity(PyObject* self, PyObject* args) {
+    return set_vec3(args, offsetof(StateVector, v), "set_velocity");
+}
+
+/**
+ * @brief Sets the acceleration vector.
+ */
+static PyObject* set_acceleration(PyObject* self, PyObject* args) {
+    return set_vec3(args, offsetof(StateVector, a), "set_acceleration");
+}
+
+/**
+ * @brief Sets the timestamp.
+ */
+static PyObject* set_time(PyObject* self, PyObject* args) {
+
+    PyObject* obj;
     StateVector* state_vector;
+    double time;
 
-    if(!PyArg_ParseTuple(args, "O", &capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for get_time.");
-        return PyErr_Occurred();
+    if(!PyArg_ParseTuple(args, "Od", &obj, &time)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_time.");
+        return NULL;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
+    state_vector = get_state_vector(obj, "set_time");
     if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+        return NULL;
     }
 
-    return Py_BuildValue("d", (double)state_vector->time);
+    state_vector->time = time;
+
+    Py_RETURN_NONE;
 }
 
 /**
- * @brief Gets the reference frame.
+ * @brief Sets the reference frame.
  */
-static PyObject* get_frame(PyObject* self, PyObject* args) {
+static PyObject* set_frame(PyObject* self, PyObject* args) {
 
-    PyObject* capsule;
+    PyObject* obj;
     StateVector* state_vector;
+    int frame;
 
-    if(!PyArg_ParseTuple(args, "O", &capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for get_frame.");
-        return PyErr_Occurred();
+    if(!PyArg_ParseTuple(args, "Oi", &obj, &frame)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments for set_frame.");
+        return NULL;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from capsule.");
-        return PyErr_Occurred();
+    state_vector = get_state_vector(obj, "set_frame");
+    if(!state_vector || check_frame(frame) != 0) {
+        return NULL;
     }
 
-    return Py_BuildValue("i", state_vector->frame);
+    state_vector->frame = (ReferenceFrame)frame;
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Gets the position vector.
+ */
+static PyObject* get_position(PyObject* self, PyObject* obj) {
+    return get_state_vector(obj, "get_position") ?
+        StateVector_get_vec3((StateVectorObject*)obj, (void*)offsetof(StateVector, r)) : NULL;
+}
+
+/**
+ * @brief Gets the velocity vector.
+ */
+static PyObject* get_velocity(PyObject* self, PyObject* obj) {
+    return get_state_vector(obj, "get_velocity") ?
+        StateVector_get_vec3((StateVectorObject*)obj, (void*)offsetof(StateVector, v)) : NULL;
+}
+
+/**
+ * @brief Gets the acceleration vector.
+ */
+static PyObject* get_acceleration(PyObject* self, PyObject* obj) {
+    return get_state_vector(obj, "get_acceleration") ?
+        StateVector_get_vec3((StateVectorObject*)obj, (void*)offsetof(StateVector, a)) : NULL;
+}
+
+/**
+ * @brief Gets the timestamp.
+ */
+static PyObject* get_time(PyObject* self, PyObject* obj) {
+    return get_state_vector(obj, "get_time") ? StateVector_get_time((StateVectorObject*)obj, NULL) : NULL;
+}
+
+/**
+ * @brief Gets the reference frame.
+ */
+static PyObject* get_frame(PyObject* self, PyObject* obj) {
+    return get_state_vector(obj, "get_frame") ? StateVector_get_frame((StateVectorObject*)obj, NULL) : NULL;
 }
 
 
 static PyMethodDef tolueneCoordinatesStateVectorMethods[] = {
-    {"new_StateVector", new_StateVector, METH_VARARGS, "Creates a new state vector."},
+    {"new_StateVector", (PyCFunction)(void(*)(void))new_StateVector, METH_FASTCALL, "Creates a new state vector."},
     {"set_position", set_position, METH_VARARGS, "Sets the position vector of the given statevector."},
     {"set_velocity", set_velocity, METH_VARARGS, "Sets the velocity vector of the given statevector."},
     {"set_acceleration", set_acceleration, METH_VARARGS, "Sets the acceleration vector of the given statevector."},
     {"set_time", set_time, METH_VARARGS, "Sets the time of the given statevector."},
     {"set_frame", set_frame, METH_VARARGS, "Sets the frame vector of the given statevector."},
-    {"get_position", get_position, METH_VARARGS, "Gets the position vector of the given statevector."},
-    {"get_velocity", get_velocity, METH_VARARGS, "Gets the velocity vector of the given statevector."},
-    {"get_acceleration", get_acceleration, METH_VARARGS, "Gets the acceleration vector of the given statevector."},
-    {"get_time", get_time, METH_VARARGS, "Gets the time of the given statevector."},
-    {"get_frame", get_frame, METH_VARARGS, "Gets the frame vector of the given statevector."},
+    {"get_position", get_position, METH_O, "Gets the position vector of the given statevector."},
+    {"get_velocity", get_velocity, METH_O, "Gets the velocity vector of the given statevector."},
+    {"get_acceleration", get_acceleration, METH_O, "Gets the acceleration vector of the given statevector."},
+    {"get_time", get_time, METH_O, "Gets the time of the given statevector."},
+    {"get_frame", get_frame, METH_O, "Gets the frame vector of the given statevector."},
     {NULL, NULL, 0, NULL}
 };
 
@@ -356,7 +1109,55 @@ static struct PyModuleDef coordinates_state_vector = {
 
 
 PyMODINIT_FUNC PyInit_state_vector(void) {
-    return PyModule_Create(&coordinates_state_vector);
+
+    if(PyType_Ready(&StateVectorType) < 0 || PyType_Ready(&StateVectorArrayType) < 0 ||
+        PyType_Ready(&StateVectorColumnType) < 0) {
+        return NULL;
+    }
+
+    for(int i = 0; i < STATE_VECTOR_NKEYWORDS; ++i) {
+        if(!state_vector_keyword_objects[i]) {
+            state_vector_keyword_objects[i] = PyUnicode_InternFromString(state_vector_keywords[i]);
+            if(!state_vector_keyword_objects[i]) {
+                return NULL;
+            }
+        }
+    }
+
+    PyObject* module = PyModule_Create(&coordinates_state_vector);
+    if(!module) {
+        return NULL;
+    }
+
+    /* Lets Python tell the extended and fast builds apart. */
+    if(PyModule_AddIntConstant(module, "real_size", sizeof(Real)) < 0) {
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&StateVectorType);
+    if(PyModule_AddObject(module, "StateVector", (PyObject*)&StateVectorType) < 0) {
+        Py_DECREF(&StateVectorType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    Py_INCREF(&StateVectorArrayType);
+    if(PyModule_AddObject(module, "StateVectorArray", (PyObject*)&StateVectorArrayType) < 0) {
+        Py_DECREF(&StateVectorArrayType);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    /* The transform extensions work on StateVector objects through this capsule. */
+    PyObject* api = PyCapsule_New(&state_vector_api, STATE_VECTOR_API_CAPSULE, NULL);
+    if(!api || PyModule_AddObject(module, "_C_API", api) < 0) {
+        Py_XDECREF(api);
+        Py_DECREF(module);
+        return NULL;
+    }
+
+    return module;
 }
 
 
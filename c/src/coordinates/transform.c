@@ -37,318 +37,320 @@ extern "C"
 {
 #endif
 
-#define __compile_coordinates_state_vector__
 #define __compile_math_linear_algebra__
-#define __compile_models_earth_nutation__
+#define __compile_util_thread_pool__
+#define __compile_coordinates_geodetic_kernel__
 
 #include "math/linear_algebra.h"
+#include "coordinates/geodetic_kernel.h"
 #include "coordinates/transform.h"
 #include "coordinates/state_vector.h"
-#include "models/earth/bias.h"
 #include "models/earth/earth.h"
-#include "models/earth/nutation.h"
-#include "models/earth/polar_motion.h"
-#include "models/earth/precession.h"
 #include "models/earth/rotation.h"
-#include "time/constants.h"
+#include "util/buffer.h"
+#include "util/thread_pool.h"
 
 /**
- * @brief Converts itrf coordinates to the equivalent gcrf coordinates.
+ * @brief Fewest rows of a batch worth handing to a thread of the pool.
  */
-static PyObject* itrf_to_gcrf(PyObject *self, PyObject *args) {
+#define BATCH_GRAIN 64
 
-    PyObject* state_vector_capsule;
-    PyObject* model_capsule;
-    StateVector* state_vector;
-    EarthModel* model;
+/**
+ * @brief Fewest rows of a geodetic batch worth handing to a thread of the pool, each row is only a few nanoseconds.
+ */
+#define GEODETIC_BATCH_GRAIN 4096
 
-    if(!PyArg_ParseTuple(args, "OO", &state_vector_capsule, &model_capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. itrf_to_geodetic()");
-        return PyErr_Occurred();
-    }
+/* The StateVector type, imported from the state vector extension when the module is initialised. */
+static StateVectorAPI* state_vector_api = NULL;
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(state_vector_capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from Capsule.");
-        return PyErr_Occurred();
-    }
+/**
+ * @brief Converts an itrf state vector to the equivalent gcrf state vector.
+ *
+ * @param state_vector The itrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void itrf_to_gcrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
 
-    if(state_vector->frame != InternationalTerrestrialReferenceFrame) {
-        PyErr_SetString(PyExc_TypeError, "itrf_to_geodetic() was expecting InternationalTerrestrialReferenceFrame");
-        return PyErr_Occurred();
-    }
+    FrameRotation rotation;
+    Vec3 term;
 
-    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
-    if(!model) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from Capsule.");
-        return PyErr_Occurred();
-    }
+    cached_frame_rotation(state_vector->time, model, cursor, &rotation);
 
-    Mat3 matrix;
-    Vec3 coriolis_velocity, coriolis_velocity_prime;
-    Vec3 coriolis_acceleration, coriolis_acceleration_prime;
-    Vec3 centrifugal_acceleration, centrifugal_acceleration_prime;
+    /* r = Q'r_t, v = Q'v_t + dQ'r_t, a = Q'a_t + 2dQ'v_t + ddQ'r_t */
+    dot_product_transpose(&rotation.matrix, &state_vector->r, &retval->r);
 
-    StateVector* retval = (StateVector*)malloc(sizeof(StateVector));
-    if(!retval) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_StateVector.");
-        return PyErr_Occurred();
-    }
-    StateVector temp;
+    dot_product_transpose(&rotation.matrix, &state_vector->v, &retval->v);
+    dot_product_transpose(&rotation.derivative, &state_vector->r, &term);
+    retval->v.x += term.x;
+    retval->v.y += term.y;
+    retval->v.z += term.z;
 
-    temp.r.x = coriolis_velocity.x = state_vector->r.x;
-    temp.r.y = coriolis_velocity.y = state_vector->r.y;
-    temp.r.z = coriolis_velocity.z = state_vector->r.z;
-    temp.v.x = coriolis_acceleration.x = state_vector->v.x;
-    temp.v.y = coriolis_acceleration.y = state_vector->v.y;
-    temp.v.z = coriolis_acceleration.z = state_vector->v.z;
-    temp.a.x = state_vector->a.x;
-    temp.a.y = state_vector->a.y;
-    temp.a.z = state_vector->a.z;
+    dot_product_transpose(&rotation.matrix, &state_vector->a, &retval->a);
+    dot_product_transpose(&rotation.derivative, &state_vector->v, &term);
+    retval->a.x += 2.0 * term.x;
+    retval->a.y += 2.0 * term.y;
+    retval->a.z += 2.0 * term.z;
+    dot_product_transpose(&rotation.second_derivative, &state_vector->r, &term);
+    retval->a.x += term.x;
+    retval->a.y += term.y;
+    retval->a.z += term.z;
 
     retval->time = state_vector->time;
     retval->frame = GeocentricCelestialReferenceFrame;
+}
+
+/**
+ * @brief Converts a gcrf state vector to the equivalent itrf state vector.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The itrf state vector. May not alias state_vector.
+ */
+void gcrf_to_itrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
 
-    long double gast;
-    gmst(state_vector->time, model, &gast);
-
-    long double nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
-    nutation_values_of_date(state_vector->time, &model->nutation_series, &nutation_longitude, &nutation_obliquity,
-        &mean_obliquity_date, &equation_of_the_equinoxes);
-
-    gast += equation_of_the_equinoxes/15.0;
-
-    wobble(state_vector->time, &model->earth_orientation_parameters, &matrix);
-    dot_product_transpose(&matrix, &temp.r, &retval->r);
-    dot_product_transpose(&matrix, &temp.v, &retval->v);
-    dot_product_transpose(&matrix, &temp.a, &retval->a);
-    dot_product_transpose(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
-    dot_product_transpose(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
-
-    long double rate;
-    Vec3 coriolis_rotation;
-    rate_of_earth_rotation(state_vector->time, model, &rate);
-    coriolis_rotation.x = 0.0;
-    coriolis_rotation.y = 0.0;
-    coriolis_rotation.z = rate;
-
-    cross_product(&coriolis_rotation, &coriolis_velocity_prime, &coriolis_velocity);
-
-    cross_product(&coriolis_rotation, &coriolis_velocity, &coriolis_acceleration);
-    cross_product(&coriolis_rotation, &coriolis_acceleration_prime, &centrifugal_acceleration);
-
-    centrifugal_acceleration.x *= 2.0;
-    centrifugal_acceleration.y *= 2.0;
-    centrifugal_acceleration.z *= 2.0;
-
-    earth_rotation_matrix(gast/SECONDS_PER_DAY * 2.0 * M_PI, &matrix);
-    dot_product_transpose(&matrix, &retval->r, &temp.r);
-    dot_product_transpose(&matrix, &retval->v, &temp.v);
-    dot_product_transpose(&matrix, &retval->a, &temp.a);
-    dot_product_transpose(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
-    dot_product_transpose(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
-    dot_product_transpose(&matrix, &centrifugal_acceleration, &centrifugal_acceleration_prime);
-
-    nutation_matrix(mean_obliquity_date, nutation_longitude, mean_obliquity_date-nutation_obliquity, &matrix);
-    dot_product_transpose(&matrix, &temp.r, &retval->r);
-    dot_product_transpose(&matrix, &temp.v, &retval->v);
-    dot_product_transpose(&matrix, &temp.a, &retval->a);
-    dot_product_transpose(&matrix, &coriolis_velocity_prime, &coriolis_velocity);
-    dot_product_transpose(&matrix, &coriolis_acceleration_prime, &coriolis_acceleration);
-    dot_product_transpose(&matrix, &centrifugal_acceleration_prime, &centrifugal_acceleration);
-
-    iau_2000a_precession(state_vector->time, &matrix);
-    dot_product_transpose(&matrix, &retval->r, &temp.r);
-    dot_product_transpose(&matrix, &retval->v, &temp.v);
-    dot_product_transpose(&matrix, &retval->a, &temp.a);
-    dot_product_transpose(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
-    dot_product_transpose(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
-    dot_product_transpose(&matrix, &centrifugal_acceleration, &centrifugal_acceleration_prime);
-
-    icrs_frame_bias(&matrix);
-    dot_product_transpose(&matrix, &temp.r, &retval->r);
-    dot_product_transpose(&matrix, &temp.v, &retval->v);
-    dot_product_transpose(&matrix, &temp.a, &retval->a);
-    dot_product_transpose(&matrix, &coriolis_velocity_prime, &coriolis_velocity);
-    dot_product_transpose(&matrix, &coriolis_acceleration_prime, &coriolis_acceleration);
-    dot_product_transpose(&matrix, &centrifugal_acceleration_prime, &centrifugal_acceleration);
-
-    retval->v.x += coriolis_velocity.x;
-    retval->v.y += coriolis_velocity.y;
-    retval->v.z += coriolis_velocity.z;
-    retval->a.x += coriolis_acceleration.x + centrifugal_acceleration.x;
-    retval->a.y += coriolis_acceleration.y + centrifugal_acceleration.y;
-    retval->a.z += coriolis_acceleration.z + centrifugal_acceleration.z;
-
-    return PyCapsule_New(retval, "StateVector", delete_StateVector);
+    FrameRotation rotation;
+    Vec3 term;
+
+    cached_frame_rotation(state_vector->time, model, cursor, &rotation);
+
+    /* r_t = Qr, v_t = Qv + dQr, a_t = Qa + 2dQv + ddQr */
+    dot_product(&rotation.matrix, &state_vector->r, &retval->r);
+
+    dot_product(&rotation.matrix, &state_vector->v, &retval->v);
+    dot_product(&rotation.derivative, &state_vector->r, &term);
+    retval->v.x += term.x;
+    retval->v.y += term.y;
+    retval->v.z += term.z;
+
+    dot_product(&rotation.matrix, &state_vector->a, &retval->a);
+    dot_product(&rotation.derivative, &state_vector->v, &term);
+    retval->a.x += 2.0 * term.x;
+    retval->a.y += 2.0 * term.y;
+    retval->a.z += 2.0 * term.z;
+    dot_product(&rotation.second_derivative, &state_vector->r, &term);
+    retval->a.x += term.x;
+    retval->a.y += term.y;
+    retval->a.z += term.z;
+
+    retval->time = state_vector->time;
+    retval->frame = InternationalTerrestrialReferenceFrame;
 }
 
 /**
- * @brief Converts gcrf coordinates to the equivalent itrf coordinates.
+ * @brief Converts only the position of an itrf state vector to gcrf, skipping the rate of Earth rotation and the
+ * velocity and acceleration terms. The velocity and acceleration of the result are zero.
+ *
+ * @param state_vector The itrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
  */
-static PyObject* gcrf_to_itrf(PyObject *self, PyObject *args) {
+void itrf_to_gcrf_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
 
-    PyObject* state_vector_capsule;
-    PyObject* model_capsule;
-    StateVector* state_vector;
-    EarthModel* model;
+    FrameRotation rotation;
 
-    if(!PyArg_ParseTuple(args, "OO", &state_vector_capsule, &model_capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. itrf_to_geodetic()");
-        return PyErr_Occurred();
-    }
+    cached_frame_rotation_matrix(state_vector->time, model, cursor, &rotation);
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(state_vector_capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from Capsule.");
-        return PyErr_Occurred();
-    }
+    /* r = Q'r_t */
+    dot_product_transpose(&rotation.matrix, &state_vector->r, &retval->r);
 
-    if(state_vector->frame != GeocentricCelestialReferenceFrame) {
-        PyErr_SetString(PyExc_TypeError, "itrf_to_geodetic() was expecting GeocentricCelestialReferenceFrame");
-        return PyErr_Occurred();
-    }
+    retval->v.x = retval->v.y = retval->v.z = 0.0;
+    retval->a.x = retval->a.y = retval->a.z = 0.0;
+    retval->time = state_vector->time;
+    retval->frame = GeocentricCelestialReferenceFrame;
+}
 
-    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
-    if(!model) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from Capsule.");
-        return PyErr_Occurred();
-    }
+/**
+ * @brief Converts only the position of a gcrf state vector to itrf, skipping the rate of Earth rotation and the
+ * velocity and acceleration terms. The velocity and acceleration of the result are zero.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The itrf state vector. May not alias state_vector.
+ */
+void gcrf_to_itrf_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
 
-    Mat3 matrix;
-    Vec3 coriolis_velocity, coriolis_velocity_prime;
-    Vec3 coriolis_acceleration, coriolis_acceleration_prime;
-    Vec3 centrifugal_acceleration, centrifugal_acceleration_prime;
+    FrameRotation rotation;
 
-    StateVector* retval = (StateVector*)malloc(sizeof(StateVector));
-    if(!retval) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_StateVector.");
-        return PyErr_Occurred();
-    }
-    StateVector temp;
+    cached_frame_rotation_matrix(state_vector->time, model, cursor, &rotation);
 
-    temp.r.x = coriolis_velocity.x = state_vector->r.x;
-    temp.r.y = coriolis_velocity.y = state_vector->r.y;
-    temp.r.z = coriolis_velocity.z = state_vector->r.z;
-    temp.v.x = coriolis_acceleration.x = state_vector->v.x;
-    temp.v.y = coriolis_acceleration.y = state_vector->v.y;
-    temp.v.z = coriolis_acceleration.z = state_vector->v.z;
-    temp.a.x = state_vector->a.x;
-    temp.a.y = state_vector->a.y;
-    temp.a.z = state_vector->a.z;
+    /* r_t = Qr */
+    dot_product(&rotation.matrix, &state_vector->r, &retval->r);
 
+    retval->v.x = retval->v.y = retval->v.z = 0.0;
+    retval->a.x = retval->a.y = retval->a.z = 0.0;
     retval->time = state_vector->time;
     retval->frame = InternationalTerrestrialReferenceFrame;
+}
 
-    long double gast;
-    gmst(state_vector->time, model, &gast);
-
-    long double nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
-    nutation_values_of_date(state_vector->time, &model->nutation_series, &nutation_longitude, &nutation_obliquity,
-        &mean_obliquity_date, &equation_of_the_equinoxes);
-
-    gast += equation_of_the_equinoxes/15.0;
-
-    icrs_frame_bias(&matrix);
-    dot_product(&matrix, &temp.r, &retval->r);
-    dot_product(&matrix, &temp.v, &retval->v);
-    dot_product(&matrix, &temp.a, &retval->a);
-    dot_product(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
-    dot_product(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
-
-    iau_2000a_precession(state_vector->time, &matrix);
-    dot_product(&matrix, &retval->r, &temp.r);
-    dot_product(&matrix, &retval->v, &temp.v);
-    dot_product(&matrix, &retval->a, &temp.a);
-    dot_product(&matrix, &coriolis_velocity_prime, &coriolis_velocity);
-    dot_product(&matrix, &centrifugal_acceleration_prime, &centrifugal_acceleration);
-
-    nutation_matrix(mean_obliquity_date, nutation_longitude, mean_obliquity_date-nutation_obliquity, &matrix);
-    dot_product(&matrix, &temp.r, &retval->r);
-    dot_product(&matrix, &temp.v, &retval->v);
-    dot_product(&matrix, &temp.a, &retval->a);
-    dot_product(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
-    dot_product(&matrix, &centrifugal_acceleration, &centrifugal_acceleration_prime);
-
-    long double rate;
-    Vec3 coriolis_rotation;
-    rate_of_earth_rotation(state_vector->time, model, &rate);
-    coriolis_rotation.x = 0.0;
-    coriolis_rotation.y = 0.0;
-    coriolis_rotation.z = rate;
-
-    cross_product(&coriolis_rotation, &coriolis_velocity_prime, &coriolis_velocity);
-
-    cross_product(&coriolis_rotation, &coriolis_velocity, &coriolis_acceleration);
-    cross_product(&coriolis_rotation, &coriolis_acceleration_prime, &centrifugal_acceleration);
-
-    centrifugal_acceleration.x *= 2.0;
-    centrifugal_acceleration.y *= 2.0;
-    centrifugal_acceleration.z *= 2.0;
-
-    earth_rotation_matrix(gast/SECONDS_PER_DAY * 2.0 * M_PI, &matrix);
-    dot_product(&matrix, &retval->r, &temp.r);
-    dot_product(&matrix, &retval->v, &temp.v);
-    dot_product(&matrix, &retval->a, &temp.a);
-    dot_product(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
-    dot_product(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
-    dot_product(&matrix, &centrifugal_acceleration, &centrifugal_acceleration_prime);
-
-    wobble(state_vector->time, &model->earth_orientation_parameters, &matrix);
-    dot_product(&matrix, &temp.r, &retval->r);
-    dot_product(&matrix, &temp.v, &retval->v);
-    dot_product(&matrix, &temp.a, &retval->a);
-    dot_product(&matrix, &coriolis_velocity_prime, &coriolis_velocity);
-    dot_product(&matrix, &coriolis_acceleration_prime, &coriolis_acceleration);
-    dot_product(&matrix, &centrifugal_acceleration_prime, &centrifugal_acceleration);
-
-    retval->v.x -= coriolis_velocity.x;
-    retval->v.y -= coriolis_velocity.y;
-    retval->v.z -= coriolis_velocity.z;
-    retval->a.x -= coriolis_acceleration.x - centrifugal_acceleration.x;
-    retval->a.y -= coriolis_acceleration.y - centrifugal_acceleration.y;
-    retval->a.z -= coriolis_acceleration.z - centrifugal_acceleration.z;
-
-    return PyCapsule_New(retval, "StateVector", delete_StateVector);
+/**
+ * @brief Heikkinen's closed form solution for the geodetic latitude and height, as given by Zhu.
+ *
+ * @param ellipsoid The ellipsoid the position is inverted onto.
+ * @param p The distance of the position from the polar axis.
+ * @param z The distance of the position above the equator.
+ * @param latitude The geodetic latitude in radians.
+ * @param height The height above the ellipsoid.
+ */
+static void closed_form_geodetic(const Ellipsoid* ellipsoid, Real p, Real z, Real* latitude, Real* height) {
+
+    Real e_numerator = ellipsoid->a*ellipsoid->a - ellipsoid->b*ellipsoid->b;
+    Real e_2 = e_numerator/(ellipsoid->a*ellipsoid->a);
+    Real e_r2 = e_numerator/(ellipsoid->b*ellipsoid->b);
+    Real big_f = 54.0*ellipsoid->b*ellipsoid->b*z*z;
+    Real big_g = p*p+z*z*(1-e_2)-e_2*e_numerator;
+    Real c = (e_2*e_2*big_f*p*p)/(big_g*big_g*big_g);
+    Real s = cbrt(1+c+sqrt(c*c+2*c));
+    Real k = s+1+1/s;
+    Real big_p = big_f/(3*k*k*big_g*big_g);
+    Real big_q = sqrt(1 + 2 * e_2 * e_2 * big_p);
+    Real sqrt_r_0 = (ellipsoid->a*ellipsoid->a/2)*(1+1/big_q)-
+        ((big_p*(1-e_2)*z*z)/(big_q*(1+big_q))) -(big_p*p*p)/2;
+    sqrt_r_0 = (sqrt_r_0 < 0? 0 : sqrt(sqrt_r_0));
+    Real r_0 = ((-1* big_p*e_2*p)/(1+big_q)) + sqrt_r_0;
+    Real p_e_2_r_0 = p-e_2*r_0;
+    Real big_u = sqrt( p_e_2_r_0*p_e_2_r_0+z*z);
+    Real big_v = sqrt(p_e_2_r_0*p_e_2_r_0+(1-e_2)*z*z);
+    Real z_0 = (ellipsoid->b*ellipsoid->b*z)/(ellipsoid->a*big_v);
+
+    *latitude = atan((z+(e_r2*z_0))/p);
+    *height = big_u * (1-(ellipsoid->b*ellipsoid->b)/(ellipsoid->a*big_v));
 }
 
 /**
- * @brief Converts itrf coordinates to the equivalent geodetic coordinates.
+ * @brief The geodetic latitude and height of a position given the tangent of its latitude as a ratio, the height is
+ * the distance along the normal at that latitude to the foot point on the ellipsoid.
+ *
+ * @param ellipsoid The ellipsoid the position is inverted onto.
+ * @param p The distance of the position from the polar axis.
+ * @param z The distance of the position above the equator.
+ * @param n The numerator of the tangent of the latitude.
+ * @param d The denominator of the tangent of the latitude, positive outside the evolute.
+ * @param latitude The geodetic latitude in radians.
+ * @param height The height above the ellipsoid.
  */
-static PyObject* itrf_to_geodetic(PyObject *self, PyObject *args) {
+static void geodetic_of_tangent(const Ellipsoid* ellipsoid, Real p, Real z, Real n, Real d, Real* latitude,
+    Real* height) {
 
-    PyObject* state_vector_capsule;
-    PyObject* model_capsule;
-    StateVector* state_vector;
-    EarthModel* model;
+    *latitude = atan(n/d);
+    *height = (p*d + z*n - sqrt(ellipsoid->a*ellipsoid->a*d*d + ellipsoid->b*ellipsoid->b*n*n))/sqrt(n*n + d*d);
+}
 
-    if(!PyArg_ParseTuple(args, "OO", &state_vector_capsule, &model_capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. itrf_to_geodetic()");
-        return PyErr_Occurred();
+/**
+ * @brief Bowring's method, each iteration takes the foot point at the parametric latitude of the last and the normal
+ * through it, starting from the parametric latitude of the position itself.
+ *
+ * @param ellipsoid The ellipsoid the position is inverted onto.
+ * @param p The distance of the position from the polar axis.
+ * @param z The distance of the position above the equator.
+ * @param iterations The number of iterations, one is good to a millimeter below a few hundred kilometers.
+ * @param latitude The geodetic latitude in radians.
+ * @param height The height above the ellipsoid.
+ */
+static void bowring_geodetic(const Ellipsoid* ellipsoid, Real p, Real z, int iterations, Real* latitude,
+    Real* height) {
+
+    Real a = ellipsoid->a;
+    Real b = ellipsoid->b;
+    Real e_2 = (a*a - b*b)/(a*a);
+    Real e_r2 = (a*a - b*b)/(b*b);
+    Real s = a*z;
+    Real c = b*p;
+    Real n = z;
+    Real d = p;
+
+    for(int i = 0; i < iterations; ++i) {
+        Real norm = sqrt(s*s + c*c);
+        Real sin_beta = s/norm;
+        Real cos_beta = c/norm;
+        n = z + e_r2*b*sin_beta*sin_beta*sin_beta;
+        d = p - e_2*a*cos_beta*cos_beta*cos_beta;
+        s = b*n;
+        c = a*d;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(state_vector_capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from Capsule.");
-        return PyErr_Occurred();
-    }
+    geodetic_of_tangent(ellipsoid, p, z, n, d, latitude, height);
+}
 
-    if(state_vector->frame != InternationalTerrestrialReferenceFrame) {
-        PyErr_SetString(PyExc_TypeError, "itrf_to_geodetic() was expecting InternationalTerrestrialReferenceFrame");
-        return PyErr_Occurred();
-    }
+/**
+ * @brief Vermeille's closed form solution.
+ *
+ * @param ellipsoid The ellipsoid the position is inverted onto.
+ * @param p The distance of the position from the polar axis.
+ * @param z The distance of the position above the equator.
+ * @param latitude The geodetic latitude in radians.
+ * @param height The height above the ellipsoid.
+ */
+static void vermeille_geodetic(const Ellipsoid* ellipsoid, Real p, Real z, Real* latitude, Real* height) {
+
+    Real a_2 = ellipsoid->a*ellipsoid->a;
+    Real e_2 = (a_2 - ellipsoid->b*ellipsoid->b)/a_2;
+    Real e_4 = e_2*e_2;
+    Real p_2 = p*p/a_2;
+    Real q = (1 - e_2)*z*z/a_2;
+    Real r = (p_2 + q - e_4)/6;
+    Real s = e_4*p_2*q/(4*r*r*r);
+    Real t = cbrt(1 + s + sqrt(s*(2 + s)));
+    Real u = r*(1 + t + 1/t);
+    Real v = sqrt(u*u + e_4*q);
+    Real w = e_2*(u + v - q)/(2*v);
+    Real k = sqrt(u + v + w*w) - w;
+    Real d = k*p/(k + e_2);
+    Real hypotenuse = sqrt(d*d + z*z);
+
+    *latitude = 2*atan(z/(d + hypotenuse));
+    *height = (k + e_2 - 1)/k*hypotenuse;
+}
 
-    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
-    if(!model) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from Capsule.");
-        return PyErr_Occurred();
-    }
+/**
+ * @brief Fukushima's method, a single Halley step on the parametric latitude from Bowring's starting point.
+ *
+ * @param ellipsoid The ellipsoid the position is inverted onto.
+ * @param p The distance of the position from the polar axis.
+ * @param z The distance of the position above the equator.
+ * @param latitude The geodetic latitude in radians.
+ * @param height The height above the ellipsoid.
+ */
+static void fukushima_geodetic(const Ellipsoid* ellipsoid, Real p, Real z, Real* latitude, Real* height) {
+
+    Real e_c = ellipsoid->b/ellipsoid->a;
+    Real e_2 = 1 - e_c*e_c;
+    Real big_p = p/ellipsoid->a;
+    Real big_z = e_c*fabs(z)/ellipsoid->a;
+    Real s_0 = big_z;
+    Real c_0 = e_c*e_c*big_p;
+    Real a_0 = sqrt(s_0*s_0 + c_0*c_0);
+    Real a_0_3 = a_0*a_0*a_0;
+    Real d_0 = big_z*a_0_3 + e_2*s_0*s_0*s_0;
+    Real f_0 = big_p*a_0_3 - e_2*c_0*c_0*c_0;
+    Real b_0 = 1.5*e_2*s_0*c_0*c_0*(a_0*(big_p*s_0 - big_z*c_0) - e_2*s_0*c_0);
+    Real s_1 = d_0*f_0 - b_0*s_0;
+    Real c_1 = f_0*f_0 - b_0*c_0;
+
+    geodetic_of_tangent(ellipsoid, p, fabs(z), s_1, e_c*c_1, latitude, height);
+    *latitude = copysign(*latitude, z);
+}
+
+/**
+ * @brief Converts an itrf state vector to the equivalent geodetic state vector with the model's geodetic algorithm.
+ *
+ * @param state_vector The itrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Unused, the geodetic conversions need no table lookups.
+ * @param retval The geodetic state vector, latitude and longitude in degrees and height in meters. May not alias
+ * state_vector.
+ */
+void itrf_to_geodetic_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
 
-    StateVector* retval = (StateVector*)malloc(sizeof(StateVector));
-    if(!retval) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_StateVector.");
-        return PyErr_Occurred();
-    }
     retval->r.x = state_vector->r.x;
     retval->r.y = state_vector->r.y;
     retval->r.z = state_vector->r.z;
@@ -357,29 +359,30 @@ static PyObject* itrf_to_geodetic(PyObject *self, PyObject *args) {
     // directly above the pole.
     if(retval->r.x == 0 && retval->r.y == 0) retval->r.x = 0.000000001;
 
-    long double e_numerator = model->ellipsoid.a*model->ellipsoid.a - model->ellipsoid.b*model->ellipsoid.b;
-    long double e_2 = e_numerator/(model->ellipsoid.a*model->ellipsoid.a);
-    long double e_r2 = e_numerator/(model->ellipsoid.b*model->ellipsoid.b);
-    long double p = sqrt(retval->r.x*retval->r.x+retval->r.y*retval->r.y);
-    long double big_f = 54.0*model->ellipsoid.b*model->ellipsoid.b*retval->r.z*retval->r.z;
-    long double big_g = p*p+retval->r.z*retval->r.z*(1-e_2)-e_2*e_numerator;
-    long double c = (e_2*e_2*big_f*p*p)/(big_g*big_g*big_g);
-    long double s = cbrt(1+c+sqrt(c*c+2*c));
-    long double k = s+1+1/s;
-    long double big_p = big_f/(3*k*k*big_g*big_g);
-    long double big_q = sqrt(1 + 2 * e_2 * e_2 * big_p);
-    long double sqrt_r_0 = (model->ellipsoid.a*model->ellipsoid.a/2)*(1+1/big_q)-
-        ((big_p*(1-e_2)*retval->r.z*retval->r.z)/(big_q*(1+big_q))) -(big_p*p*p)/2;
-    sqrt_r_0 = (sqrt_r_0 < 0? 0 : sqrt(sqrt_r_0));
-    long double r_0 = ((-1* big_p*e_2*p)/(1+big_q)) + sqrt_r_0;
-    long double p_e_2_r_0 = p-e_2*r_0;
-    long double big_u = sqrt( p_e_2_r_0*p_e_2_r_0+retval->r.z*retval->r.z);
-    long double big_v = sqrt(p_e_2_r_0*p_e_2_r_0+(1-e_2)*retval->r.z*retval->r.z);
-    long double z_0 = (model->ellipsoid.b*model->ellipsoid.b*retval->r.z)/(model->ellipsoid.a*big_v);
+    Real p = sqrt(retval->r.x*retval->r.x+retval->r.y*retval->r.y);
+    Real latitude, height;
+
+    switch(model->geodetic_algorithm) {
+        case BowringGeodeticAlgorithm:
+            bowring_geodetic(&model->ellipsoid, p, retval->r.z, 1, &latitude, &height);
+            break;
+        case Bowring2GeodeticAlgorithm:
+            bowring_geodetic(&model->ellipsoid, p, retval->r.z, 2, &latitude, &height);
+            break;
+        case VermeilleGeodeticAlgorithm:
+            vermeille_geodetic(&model->ellipsoid, p, retval->r.z, &latitude, &height);
+            break;
+        case FukushimaGeodeticAlgorithm:
+            fukushima_geodetic(&model->ellipsoid, p, retval->r.z, &latitude, &height);
+            break;
+        default:
+            closed_form_geodetic(&model->ellipsoid, p, retval->r.z, &latitude, &height);
+            break;
+    }
 
-    retval->r.x = atanl((retval->r.z+(e_r2*z_0))/p) * 180/M_PI;
-    retval->r.y = atan2l(retval->r.y,state_vector->r.x) * 180/M_PI;
-    retval->r.z = big_u * (1-(model->ellipsoid.b*model->ellipsoid.b)/(model->ellipsoid.a*big_v));
+    retval->r.x = latitude * 180/M_PI;
+    retval->r.y = atan2(retval->r.y,state_vector->r.x) * 180/M_PI;
+    retval->r.z = height;
 
     retval->v.x = state_vector->v.x;
     retval->v.y = state_vector->v.y;
@@ -389,72 +392,774 @@ static PyObject* itrf_to_geodetic(PyObject *self, PyObject *args) {
     retval->a.z = state_vector->a.z;
     retval->time = state_vector->time;
     retval->frame = GeodeticReferenceFrame;
+}
+
+/**
+ * @brief Converts a geodetic state vector to the equivalent itrf state vector.
+ *
+ * @param state_vector The geodetic state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Unused, the geodetic conversions need no table lookups.
+ * @param retval The itrf state vector. May not alias state_vector.
+ */
+void geodetic_to_itrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
 
-    return PyCapsule_New(retval, "StateVector", delete_StateVector);
+    Real e_2 = 1 - ((model->ellipsoid.b*model->ellipsoid.b)/(model->ellipsoid.a*model->ellipsoid.a));
+    Real sin_of_latitude = sin((state_vector->r.x * M_PI/180));
+    Real n_phi = model->ellipsoid.a/(sqrt(1-(e_2 * (sin_of_latitude*sin_of_latitude))));
+
+    retval->r.x = (n_phi + state_vector->r.z) * cos(state_vector->r.x * M_PI/180) * cos(state_vector->r.y
+        * M_PI/180);
+    retval->r.y = (n_phi + state_vector->r.z) * cos(state_vector->r.x * M_PI/180) * sin(state_vector->r.y
+        * M_PI/180);
+    retval->r.z = ((1 - e_2) * n_phi + state_vector->r.z) * sin(state_vector->r.x * M_PI/180);
+
+    retval->v.x = state_vector->v.x;
+    retval->v.y = state_vector->v.y;
+    retval->v.z = state_vector->v.z;
+    retval->a.x = state_vector->a.x;
+    retval->a.y = state_vector->a.y;
+    retval->a.z = state_vector->a.z;
+    retval->time = state_vector->time;
+    retval->frame = InternationalTerrestrialReferenceFrame;
 }
 
 /**
- * @brief Converts geodetic coordinates to the equivalent itrf coordinates.
+ * @brief Converts a gcrf state vector to the equivalent geodetic state vector, through an itrf state on the stack.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The geodetic state vector. May not alias state_vector.
+ */
+void gcrf_to_geodetic_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
+
+    StateVector itrf;
+
+    gcrf_to_itrf_state_vector(state_vector, model, cursor, &itrf);
+    itrf_to_geodetic_state_vector(&itrf, model, cursor, retval);
+}
+
+/**
+ * @brief Converts a geodetic state vector to the equivalent gcrf state vector, through an itrf state on the stack.
+ *
+ * @param state_vector The geodetic state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void geodetic_to_gcrf_state_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
+
+    StateVector itrf;
+
+    geodetic_to_itrf_state_vector(state_vector, model, cursor, &itrf);
+    itrf_to_gcrf_state_vector(&itrf, model, cursor, retval);
+}
+
+/**
+ * @brief Converts only the position of a gcrf state vector to geodetic. The velocity and acceleration of the result
+ * are zero.
+ *
+ * @param state_vector The gcrf state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The geodetic state vector. May not alias state_vector.
+ */
+void gcrf_to_geodetic_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
+
+    StateVector itrf;
+
+    gcrf_to_itrf_position_vector(state_vector, model, cursor, &itrf);
+    itrf_to_geodetic_state_vector(&itrf, model, cursor, retval);
+}
+
+/**
+ * @brief Converts only the position of a geodetic state vector to gcrf. The velocity and acceleration of the result
+ * are zero.
+ *
+ * @param state_vector The geodetic state vector.
+ * @param model The Earth model to use for the conversion.
+ * @param cursor Where the model's table lookups start from, NULL to search the tables.
+ * @param retval The gcrf state vector. May not alias state_vector.
+ */
+void geodetic_to_gcrf_position_vector(StateVector* state_vector, EarthModel* model, EarthModelCursor* cursor,
+    StateVector* retval) {
+
+    StateVector itrf;
+
+    geodetic_to_itrf_state_vector(state_vector, model, cursor, &itrf);
+    itrf_to_gcrf_position_vector(&itrf, model, cursor, retval);
+}
+
+/**
+ * @brief Names of the reference frames used in error messages, indexed by ReferenceFrame.
+ */
+static const char* frame_names[] = {
+    NULL,
+    "InternationalTerrestrialReferenceFrame",
+    "InternationalCelestialReferenceFrame",
+    "GeocentricCelestialReferenceFrame",
+    "GeodeticReferenceFrame"
+};
+
+/** @struct
+ * @brief The arguments of a frame transform over a StateVectorArray, shared by every thread of the pool.
+ * @var ArrayTransform::states
+ * Member 'states' is the input states.
+ * @var ArrayTransform::out
+ * Member 'out' is the output states.
+ * @var ArrayTransform::model
+ * Member 'model' is the Earth model to use for the conversion.
+ * @var ArrayTransform::transform
+ * Member 'transform' is the conversion applied to each state.
+ */
+typedef struct {
+    StateVectorArrayObject* states;
+    StateVectorArrayObject* out;
+    EarthModel* model;
+    void (*transform)(StateVector*, EarthModel*, EarthModelCursor*, StateVector*);
+} ArrayTransform;
+
+/**
+ * @brief Transforms states [begin, end) of a StateVectorArray. Runs on the thread pool without the GIL.
+ */
+static void transform_array_rows(void* context, long long begin, long long end) {
+
+    ArrayTransform* batch = (ArrayTransform*)context;
+    StateVector state_vector, retval;
+
+    /* One cursor per run of rows, each thread of the pool steps through the tables on its own. */
+    EarthModelCursor cursor = {0, 0};
+
+    for(long long i = begin; i < end; ++i) {
+        state_vector_array_get(batch->states, i, &state_vector);
+        batch->transform(&state_vector, batch->model, &cursor, &retval);
+        state_vector_array_set(batch->out, i, &retval);
+    }
+}
+
+/**
+ * @brief Transforms every state of a StateVectorArray into out, or into a new StateVectorArray of the same type.
+ *
+ * @param out The StateVectorArray to write to, may be states itself. NULL for a new one.
  */
-static PyObject* geodetic_to_itrf(PyObject *self, PyObject *args) {
+static PyObject* transform_array(StateVectorArrayObject* states, StateVectorArrayObject* out, EarthModel* model,
+    const char* name, void (*transform)(StateVector*, EarthModel*, EarthModelCursor*, StateVector*),
+    ReferenceFrame from, int rotates) {
+
+    for(Py_ssize_t i = 0; i < states->size; ++i) {
+        if(states->frame[i] != (int)from) {
+            PyErr_Format(PyExc_TypeError, "%s() was expecting %s, state %zd is not.", name, frame_names[from], i);
+            return NULL;
+        }
+    }
 
-    PyObject* state_vector_capsule;
+    if(out) {
+        if(out->size != states->size) {
+            PyErr_Format(PyExc_ValueError, "%s() needs an output StateVectorArray of %zd states.", name,
+                states->size);
+            return NULL;
+        }
+        Py_INCREF(out);
+    }
+    else {
+        out = state_vector_api->new_array(Py_TYPE(states), states->size);
+        if(!out) {
+            return NULL;
+        }
+    }
+
+    if(rotates && prepare_frame_rotation(model) != 0) {
+        Py_DECREF(out);
+        PyErr_SetString(PyExc_MemoryError, "Unable to prepare the EarthModel for the frame rotation.");
+        return NULL;
+    }
+
+    ArrayTransform batch;
+    batch.states = states;
+    batch.out = out;
+    batch.model = model;
+    batch.transform = transform;
+
+    Py_BEGIN_ALLOW_THREADS
+    parallel_for(states->size, BATCH_GRAIN, transform_array_rows, &batch);
+    Py_END_ALLOW_THREADS
+
+    return (PyObject*)out;
+}
+
+/**
+ * @brief Shared implementation of the frame transforms of a StateVector or of every state of a StateVectorArray.
+ *
+ * @param args The StateVector or StateVectorArray, the EarthModel capsule and optionally the object to write to. The
+ * output may be the input itself, with it the transform does not allocate.
+ * @param nargs The number of arguments.
+ * @param name The name of the Python function used in error messages.
+ * @param transform The conversion applied to each state.
+ * @param from The frame the states are expected in.
+ * @param rotates Non-zero if the conversion needs the frame rotation of the model.
+ * @return The output, or a new StateVector or StateVectorArray of the input's type, in the converted frame.
+ */
+static PyObject* transform_state_vector(PyObject* const* args, Py_ssize_t nargs, const char* name,
+    void (*transform)(StateVector*, EarthModel*, EarthModelCursor*, StateVector*), ReferenceFrame from,
+    int rotates) {
+
+    PyObject* state_vector_object;
     PyObject* model_capsule;
+    PyObject* out_object;
     StateVector* state_vector;
     EarthModel* model;
 
-    if(!PyArg_ParseTuple(args, "OO", &state_vector_capsule, &model_capsule)) {
-        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. geodetic_to_itrf()");
-        return PyErr_Occurred();
+    if(nargs < 2 || nargs > 3) {
+        PyErr_Format(PyExc_TypeError, "Unable to parse arguments. %s()", name);
+        return NULL;
+    }
+
+    state_vector_object = args[0];
+    model_capsule = args[1];
+    out_object = nargs > 2 ? args[2] : Py_None;
+
+    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from Capsule.");
+        return NULL;
+    }
+
+    if(PyObject_TypeCheck(state_vector_object, state_vector_api->array_type)) {
+        if(out_object != Py_None && !PyObject_TypeCheck(out_object, state_vector_api->array_type)) {
+            PyErr_Format(PyExc_TypeError, "%s() needs a StateVectorArray to write a StateVectorArray to.", name);
+            return NULL;
+        }
+        return transform_array((StateVectorArrayObject*)state_vector_object,
+            out_object != Py_None ? (StateVectorArrayObject*)out_object : NULL, model, name, transform, from, rotates);
+    }
+
+    if(!PyObject_TypeCheck(state_vector_object, state_vector_api->type)) {
+        PyErr_Format(PyExc_TypeError, "%s() was expecting a StateVector or a StateVectorArray.", name);
+        return NULL;
+    }
+    state_vector = &((StateVectorObject*)state_vector_object)->state_vector;
+
+    if(state_vector->frame != from) {
+        PyErr_Format(PyExc_TypeError, "%s() was expecting %s", name, frame_names[from]);
+        return NULL;
+    }
+
+    StateVectorObject* retval;
+    if(out_object != Py_None) {
+        if(!PyObject_TypeCheck(out_object, state_vector_api->type)) {
+            PyErr_Format(PyExc_TypeError, "%s() needs a StateVector to write a StateVector to.", name);
+            return NULL;
+        }
+        retval = (StateVectorObject*)out_object;
+        Py_INCREF(retval);
+    }
+    else {
+        retval = state_vector_api->new_object(Py_TYPE(state_vector_object));
+        if(!retval) {
+            return NULL;
+        }
+    }
+
+    if(rotates && prepare_frame_rotation(model) != 0) {
+        Py_DECREF(retval);
+        PyErr_SetString(PyExc_MemoryError, "Unable to prepare the EarthModel for the frame rotation.");
+        return NULL;
+    }
+
+    /* The conversions may not alias their input and output, the output may be the input here. */
+    StateVector input = *state_vector;
+
+    Py_BEGIN_ALLOW_THREADS
+    transform(&input, model, NULL, &retval->state_vector);
+    Py_END_ALLOW_THREADS
+
+    return (PyObject*)retval;
+}
+
+/**
+ * @brief Converts itrf coordinates to the equivalent gcrf coordinates.
+ */
+static PyObject* itrf_to_gcrf(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "itrf_to_gcrf", itrf_to_gcrf_state_vector,
+        InternationalTerrestrialReferenceFrame, 1);
+}
+
+/**
+ * @brief Converts gcrf coordinates to the equivalent itrf coordinates.
+ */
+static PyObject* gcrf_to_itrf(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "gcrf_to_itrf", gcrf_to_itrf_state_vector,
+        GeocentricCelestialReferenceFrame, 1);
+}
+
+
+/** @struct
+ * @brief The arguments of a batched frame transform, shared by every thread of the pool.
+ * @var BatchTransform::states
+ * Member 'states' is the input rows.
+ * @var BatchTransform::times
+ * Member 'times' is the time of each row.
+ * @var BatchTransform::out
+ * Member 'out' is the output rows.
+ * @var BatchTransform::model
+ * Member 'model' is the Earth model to use for the conversion.
+ * @var BatchTransform::transform
+ * Member 'transform' is the conversion applied to each row.
+ * @var BatchTransform::from
+ * Member 'from' is the frame of the input rows.
+ * @var BatchTransform::width
+ * Member 'width' is the number of doubles per row, 9 for full states or 3 for positions only.
+ */
+typedef struct {
+    const double* states;
+    const double* times;
+    double* out;
+    EarthModel* model;
+    void (*transform)(StateVector*, EarthModel*, EarthModelCursor*, StateVector*);
+    ReferenceFrame from;
+    int width;
+} BatchTransform;
+
+/**
+ * @brief Transforms rows [begin, end) of a batch. Runs on the thread pool without the GIL.
+ */
+static void transform_batch_rows(void* context, long long begin, long long end) {
+
+    BatchTransform* batch = (BatchTransform*)context;
+    const int width = batch->width;
+    const double* in_row = batch->states + width * begin;
+    double* out_row = batch->out + width * begin;
+    StateVector state_vector, retval;
+    EarthModelCursor cursor = {0, 0};
+
+    state_vector.frame = batch->from;
+    state_vector.v.x = state_vector.v.y = state_vector.v.z = 0.0;
+    state_vector.a.x = state_vector.a.y = state_vector.a.z = 0.0;
+    for(long long i = begin; i < end; ++i, in_row += width, out_row += width) {
+        state_vector.r.x = in_row[0];
+        state_vector.r.y = in_row[1];
+        state_vector.r.z = in_row[2];
+        state_vector.time = batch->times[i];
+
+        if(width == 3) {
+            batch->transform(&state_vector, batch->model, &cursor, &retval);
+            out_row[0] = (double)retval.r.x;
+            out_row[1] = (double)retval.r.y;
+            out_row[2] = (double)retval.r.z;
+            continue;
+        }
+
+        state_vector.v.x = in_row[3];
+        state_vector.v.y = in_row[4];
+        state_vector.v.z = in_row[5];
+        state_vector.a.x = in_row[6];
+        state_vector.a.y = in_row[7];
+        state_vector.a.z = in_row[8];
+
+        batch->transform(&state_vector, batch->model, &cursor, &retval);
+
+        out_row[0] = (double)retval.r.x;
+        out_row[1] = (double)retval.r.y;
+        out_row[2] = (double)retval.r.z;
+        out_row[3] = (double)retval.v.x;
+        out_row[4] = (double)retval.v.y;
+        out_row[5] = (double)retval.v.z;
+        out_row[6] = (double)retval.a.x;
+        out_row[7] = (double)retval.a.y;
+        out_row[8] = (double)retval.a.z;
+    }
+}
+
+/**
+ * @brief Shared implementation of the batched frame transforms. Rows are laid out as x, y, z, vx, vy, vz, ax, ay, az,
+ * or as x, y, z only if width is 3. The rows are read in the from frame and the target frame is the one transform
+ * converts to.
+ */
+static PyObject* transform_batch(PyObject* args, const char* name,
+    void (*transform)(StateVector*, EarthModel*, EarthModelCursor*, StateVector*), ReferenceFrame from, int width) {
+
+    PyObject* states_obj;
+    PyObject* times_obj;
+    PyObject* model_capsule;
+    PyObject* out_obj;
+    EarthModel* model;
+    Py_buffer states, times, out;
+    Py_ssize_t nstates, ntimes, nout;
+
+    if(!PyArg_ParseTuple(args, "OOOO", &states_obj, &times_obj, &model_capsule, &out_obj)) {
+        PyErr_Format(PyExc_TypeError, "Unable to parse arguments. %s()", name);
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from Capsule.");
+        return NULL;
+    }
+
+    if(prepare_frame_rotation(model) != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to prepare the EarthModel for the frame rotation.");
+        return NULL;
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(state_vector_capsule, "StateVector");
-    if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from Capsule.");
-        return PyErr_Occurred();
+    if(get_double_buffer(states_obj, &states, 0, &nstates) < 0) {
+        return NULL;
+    }
+    if(get_double_buffer(times_obj, &times, 0, &ntimes) < 0) {
+        PyBuffer_Release(&states);
+        return NULL;
+    }
+    if(get_double_buffer(out_obj, &out, 1, &nout) < 0) {
+        PyBuffer_Release(&states);
+        PyBuffer_Release(&times);
+        return NULL;
     }
 
-    if(state_vector->frame != GeodeticReferenceFrame) {
-        PyErr_SetString(PyExc_TypeError, "geodetic_to_itrf() was expecting GeodeticReferenceFrame");
-        return PyErr_Occurred();
+    if(nstates % width != 0 || nstates / width != ntimes || nout != nstates) {
+        PyBuffer_Release(&states);
+        PyBuffer_Release(&times);
+        PyBuffer_Release(&out);
+        PyErr_Format(PyExc_ValueError, "%s() expects N*%d states, N times and an N*%d output buffer.", name, width,
+            width);
+        return NULL;
+    }
+
+    BatchTransform batch;
+    batch.states = (const double*)states.buf;
+    batch.times = (const double*)times.buf;
+    batch.out = (double*)out.buf;
+    batch.model = model;
+    batch.transform = transform;
+    batch.from = from;
+    batch.width = width;
+
+    Py_BEGIN_ALLOW_THREADS
+    parallel_for(ntimes, BATCH_GRAIN, transform_batch_rows, &batch);
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&states);
+    PyBuffer_Release(&times);
+    PyBuffer_Release(&out);
+
+    return Py_BuildValue("n", ntimes);
+}
+
+/**
+ * @brief Converts a batch of itrf coordinates to the equivalent gcrf coordinates.
+ */
+static PyObject* itrf_to_gcrf_batch(PyObject *self, PyObject *args) {
+    return transform_batch(args, "itrf_to_gcrf_batch", itrf_to_gcrf_state_vector,
+        InternationalTerrestrialReferenceFrame, 9);
+}
+
+/**
+ * @brief Converts a batch of gcrf coordinates to the equivalent itrf coordinates.
+ */
+static PyObject* gcrf_to_itrf_batch(PyObject *self, PyObject *args) {
+    return transform_batch(args, "gcrf_to_itrf_batch", gcrf_to_itrf_state_vector,
+        GeocentricCelestialReferenceFrame, 9);
+}
+
+/**
+ * @brief Converts a batch of itrf positions to the equivalent gcrf positions.
+ */
+static PyObject* itrf_to_gcrf_position_batch(PyObject *self, PyObject *args) {
+    return transform_batch(args, "itrf_to_gcrf_position_batch", itrf_to_gcrf_position_vector,
+        InternationalTerrestrialReferenceFrame, 3);
+}
+
+/**
+ * @brief Converts a batch of gcrf positions to the equivalent itrf positions.
+ */
+static PyObject* gcrf_to_itrf_position_batch(PyObject *self, PyObject *args) {
+    return transform_batch(args, "gcrf_to_itrf_position_batch", gcrf_to_itrf_position_vector,
+        GeocentricCelestialReferenceFrame, 3);
+}
+
+/** @struct
+ * @brief The arguments of a batched itrf to geodetic conversion, shared by every thread of the pool.
+ * @var GeodeticBatch::positions
+ * Member 'positions' is the input itrf rows.
+ * @var GeodeticBatch::out
+ * Member 'out' is the output geodetic rows.
+ * @var GeodeticBatch::a
+ * Member 'a' is the semi-major axis of the model's ellipsoid.
+ * @var GeodeticBatch::b
+ * Member 'b' is the semi-minor axis of the model's ellipsoid.
+ * @var GeodeticBatch::algorithm
+ * Member 'algorithm' is the algorithm the rows are inverted onto the ellipsoid with.
+ */
+typedef struct {
+    const double* positions;
+    double* out;
+    double a;
+    double b;
+    GeodeticAlgorithm algorithm;
+} GeodeticBatch;
+
+/**
+ * @brief Converts rows [begin, end) of a geodetic batch. Runs on the thread pool without the GIL.
+ */
+static void geodetic_batch_rows(void* context, long long begin, long long end) {
+
+    GeodeticBatch* batch = (GeodeticBatch*)context;
+    geodetic_kernel_convert(batch->a, batch->b, batch->algorithm, batch->positions + 3 * begin, batch->out + 3 * begin,
+        end - begin);
+}
+
+/**
+ * @brief Converts a batch of itrf positions to geodetic coordinates with the double precision SIMD kernel, using the
+ * given geodetic algorithm or the model's when passed 0.
+ */
+static PyObject* itrf_to_geodetic_position_batch(PyObject *self, PyObject *args) {
+
+    PyObject* positions_obj;
+    PyObject* model_capsule;
+    PyObject* out_obj;
+    EarthModel* model;
+    Py_buffer positions, out;
+    Py_ssize_t npositions, nout;
+    int algorithm = 0;
+
+    if(!PyArg_ParseTuple(args, "OOO|i", &positions_obj, &model_capsule, &out_obj, &algorithm)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. itrf_to_geodetic_position_batch()");
+        return NULL;
+    }
+
+    if(algorithm != 0 && (algorithm < ClosedFormGeodeticAlgorithm || algorithm > FukushimaGeodeticAlgorithm)) {
+        PyErr_SetString(PyExc_ValueError, "Unknown geodetic algorithm.");
+        return NULL;
     }
 
     model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
     if(!model) {
         PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from Capsule.");
-        return PyErr_Occurred();
+        return NULL;
+    }
+
+    if(get_double_buffer(positions_obj, &positions, 0, &npositions) < 0) {
+        return NULL;
+    }
+    if(get_double_buffer(out_obj, &out, 1, &nout) < 0) {
+        PyBuffer_Release(&positions);
+        return NULL;
     }
 
-    StateVector* retval = (StateVector*)malloc(sizeof(StateVector));
+    if(npositions % 3 != 0 || nout != npositions) {
+        PyBuffer_Release(&positions);
+        PyBuffer_Release(&out);
+        PyErr_SetString(PyExc_ValueError,
+            "itrf_to_geodetic_position_batch() expects N*3 positions and an N*3 output buffer.");
+        return NULL;
+    }
 
-    long double e_2 = 1 - ((model->ellipsoid.b*model->ellipsoid.b)/(model->ellipsoid.a*model->ellipsoid.a));
-    long double sin_of_latitude = sinl((state_vector->r.x * M_PI/180));
-    long double n_phi = model->ellipsoid.a/(sqrt(1-(e_2 * (sin_of_latitude*sin_of_latitude))));
+    GeodeticBatch batch;
+    batch.positions = (const double*)positions.buf;
+    batch.out = (double*)out.buf;
+    batch.a = (double)model->ellipsoid.a;
+    batch.b = (double)model->ellipsoid.b;
+    batch.algorithm = algorithm ? (GeodeticAlgorithm)algorithm : model->geodetic_algorithm;
 
-    retval->r.x = (n_phi + state_vector->r.z) * cosl(state_vector->r.x * M_PI/180) * cosl(state_vector->r.y
-        * M_PI/180);
-    retval->r.y = (n_phi + state_vector->r.z) * cosl(state_vector->r.x * M_PI/180) * sinl(state_vector->r.y
-        * M_PI/180);
-    retval->r.z = ((1 - e_2) * n_phi + state_vector->r.z) * sinl(state_vector->r.x * M_PI/180);
+    Py_BEGIN_ALLOW_THREADS
+    parallel_for(npositions / 3, GEODETIC_BATCH_GRAIN, geodetic_batch_rows, &batch);
+    Py_END_ALLOW_THREADS
 
-    retval->v.x = state_vector->v.x;
-    retval->v.y = state_vector->v.y;
-    retval->v.z = state_vector->v.z;
-    retval->a.x = state_vector->a.x;
-    retval->a.y = state_vector->a.y;
-    retval->a.z = state_vector->a.z;
-    retval->time = state_vector->time;
-    retval->frame = InternationalTerrestrialReferenceFrame;
+    PyBuffer_Release(&positions);
+    PyBuffer_Release(&out);
+
+    return Py_BuildValue("n", npositions / 3);
+}
+
+/**
+ * @brief Get the double precision geodetic kernel in use and the best kernel the CPU supports.
+ */
+static PyObject* get_geodetic_kernel(PyObject *self, PyObject *args) {
+    return Py_BuildValue("ii", (int)geodetic_kernel(), (int)geodetic_kernel_supported());
+}
+
+/**
+ * @brief Force the double precision geodetic kernel batches are converted with.
+ */
+static PyObject* transform_set_geodetic_kernel(PyObject *self, PyObject *args) {
+
+    int kernel;
+
+    if(!PyArg_ParseTuple(args, "i", &kernel)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_geodetic_kernel()");
+        return NULL;
+    }
+
+    if(set_geodetic_kernel((GeodeticKernel)kernel) < 0) {
+        PyErr_SetString(PyExc_ValueError, "The geodetic kernel is not supported by this CPU.");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Evaluates the equation of origins with the given nutation strategy, used to compare the strategies.
+ */
+static PyObject* equation_of_origins_of_date(PyObject *self, PyObject *args) {
+
+    double t, nutation_longitude, mean_obliquity_date;
+    int strategy;
+    Real eo;
+
+    if(!PyArg_ParseTuple(args, "dddi", &t, &nutation_longitude, &mean_obliquity_date, &strategy)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. equation_of_origins()");
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    equation_of_origins(t, nutation_longitude, mean_obliquity_date, (NutationStrategy)strategy, &eo);
+    Py_END_ALLOW_THREADS
+
+    return Py_BuildValue("d", (double)eo);
+}
+
+/**
+ * @brief Converts itrf coordinates to the equivalent geodetic coordinates.
+ */
+static PyObject* itrf_to_geodetic(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "itrf_to_geodetic", itrf_to_geodetic_state_vector,
+        InternationalTerrestrialReferenceFrame, 0);
+}
+
+/**
+ * @brief Converts geodetic coordinates to the equivalent itrf coordinates.
+ */
+static PyObject* geodetic_to_itrf(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "geodetic_to_itrf", geodetic_to_itrf_state_vector,
+        GeodeticReferenceFrame, 0);
+}
+
+/**
+ * @brief Converts gcrf coordinates to the equivalent geodetic coordinates.
+ */
+static PyObject* gcrf_to_geodetic(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "gcrf_to_geodetic", gcrf_to_geodetic_state_vector,
+        GeocentricCelestialReferenceFrame, 1);
+}
+
+/**
+ * @brief Converts geodetic coordinates to the equivalent gcrf coordinates.
+ */
+static PyObject* geodetic_to_gcrf(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "geodetic_to_gcrf", geodetic_to_gcrf_state_vector,
+        GeodeticReferenceFrame, 1);
+}
 
-    return PyCapsule_New(retval, "StateVector", delete_StateVector);
+/**
+ * @brief Converts only the position of itrf coordinates to gcrf.
+ */
+static PyObject* itrf_to_gcrf_position(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "itrf_to_gcrf_position", itrf_to_gcrf_position_vector,
+        InternationalTerrestrialReferenceFrame, 1);
+}
+
+/**
+ * @brief Converts only the position of gcrf coordinates to itrf.
+ */
+static PyObject* gcrf_to_itrf_position(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "gcrf_to_itrf_position", gcrf_to_itrf_position_vector,
+        GeocentricCelestialReferenceFrame, 1);
+}
+
+/**
+ * @brief Converts only the position of gcrf coordinates to geodetic.
+ */
+static PyObject* gcrf_to_geodetic_position(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "gcrf_to_geodetic_position", gcrf_to_geodetic_position_vector,
+        GeocentricCelestialReferenceFrame, 1);
+}
+
+/**
+ * @brief Converts only the position of geodetic coordinates to gcrf.
+ */
+static PyObject* geodetic_to_gcrf_position(PyObject *self, PyObject *const *args, Py_ssize_t nargs) {
+    return transform_state_vector(args, nargs, "geodetic_to_gcrf_position", geodetic_to_gcrf_position_vector,
+        GeodeticReferenceFrame, 1);
+}
+
+/**
+ * @brief Set the number of threads batched transforms are split across, 0 for one per online processor.
+ */
+static PyObject* set_num_threads(PyObject *self, PyObject *args) {
+
+    int nthreads;
+
+    if(!PyArg_ParseTuple(args, "i", &nthreads)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_num_threads()");
+        return NULL;
+    }
+
+    int retval;
+    Py_BEGIN_ALLOW_THREADS
+    retval = set_thread_pool_size(nthreads);
+    Py_END_ALLOW_THREADS
+
+    if(retval != 0) {
+        PyErr_SetString(PyExc_ValueError, "The number of threads can not be negative.");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the number of threads batched transforms are split across.
+ */
+static PyObject* get_num_threads(PyObject *self, PyObject *args) {
+    return Py_BuildValue("i", thread_pool_size());
 }
 
 
 static PyMethodDef tolueneCoordinatesTransformMethods[] = {
-    {"itrf_to_gcrf", itrf_to_gcrf, METH_VARARGS, "Returns the equivalent coordinates in the GCRS frame."},
-    {"gcrf_to_itrf", gcrf_to_itrf, METH_VARARGS, "Returns the equivalent coordinates in the ITRS frame."},
-    {"itrf_to_geodetic", itrf_to_geodetic, METH_VARARGS, "Returns the equivalent coordinates in the Geodetic Datum."},
-    {"geodetic_to_itrf", geodetic_to_itrf, METH_VARARGS, "Returns the equivalent coordinates in the ITRS frame."},
+    {"itrf_to_gcrf", (PyCFunction)(void(*)(void))itrf_to_gcrf, METH_FASTCALL,
+        "Returns the equivalent coordinates in the GCRS frame, written to the optional output if given."},
+    {"gcrf_to_itrf", (PyCFunction)(void(*)(void))gcrf_to_itrf, METH_FASTCALL,
+        "Returns the equivalent coordinates in the ITRS frame, written to the optional output if given."},
+    {"itrf_to_gcrf_batch", itrf_to_gcrf_batch, METH_VARARGS,
+        "Converts a buffer of ITRS rows to the GCRS frame in the given output buffer."},
+    {"gcrf_to_itrf_batch", gcrf_to_itrf_batch, METH_VARARGS,
+        "Converts a buffer of GCRS rows to the ITRS frame in the given output buffer."},
+    {"equation_of_origins", equation_of_origins_of_date, METH_VARARGS,
+        "Returns the equation of origins evaluated with the given nutation strategy."},
+    {"itrf_to_geodetic", (PyCFunction)(void(*)(void))itrf_to_geodetic, METH_FASTCALL,
+        "Returns the equivalent coordinates in the Geodetic Datum, written to the optional output if given."},
+    {"geodetic_to_itrf", (PyCFunction)(void(*)(void))geodetic_to_itrf, METH_FASTCALL,
+        "Returns the equivalent coordinates in the ITRS frame, written to the optional output if given."},
+    {"gcrf_to_geodetic", (PyCFunction)(void(*)(void))gcrf_to_geodetic, METH_FASTCALL,
+        "Returns the equivalent coordinates in the Geodetic Datum, written to the optional output if given."},
+    {"geodetic_to_gcrf", (PyCFunction)(void(*)(void))geodetic_to_gcrf, METH_FASTCALL,
+        "Returns the equivalent coordinates in the GCRS frame, written to the optional output if given."},
+    {"itrf_to_gcrf_position", (PyCFunction)(void(*)(void))itrf_to_gcrf_position, METH_FASTCALL,
+        "Returns the equivalent position in the GCRS frame with zero velocity and acceleration."},
+    {"gcrf_to_itrf_position", (PyCFunction)(void(*)(void))gcrf_to_itrf_position, METH_FASTCALL,
+        "Returns the equivalent position in the ITRS frame with zero velocity and acceleration."},
+    {"gcrf_to_geodetic_position", (PyCFunction)(void(*)(void))gcrf_to_geodetic_position, METH_FASTCALL,
+        "Returns the equivalent position in the Geodetic Datum with zero velocity and acceleration."},
+    {"geodetic_to_gcrf_position", (PyCFunction)(void(*)(void))geodetic_to_gcrf_position, METH_FASTCALL,
+        "Returns the equivalent position in the GCRS frame with zero velocity and acceleration."},
+    {"itrf_to_gcrf_position_batch", itrf_to_gcrf_position_batch, METH_VARARGS,
+        "Converts a buffer of ITRS positions to the GCRS frame in the given output buffer."},
+    {"gcrf_to_itrf_position_batch", gcrf_to_itrf_position_batch, METH_VARARGS,
+        "Converts a buffer of GCRS positions to the ITRS frame in the given output buffer."},
+    {"itrf_to_geodetic_position_batch", itrf_to_geodetic_position_batch, METH_VARARGS,
+        "Converts a buffer of ITRS positions to the Geodetic Datum in the given output buffer, with the given geodetic "
+        "algorithm or the model's."},
+    {"get_geodetic_kernel", get_geodetic_kernel, METH_VARARGS,
+        "Gets the geodetic kernel in use and the best kernel the CPU supports."},
+    {"set_geodetic_kernel", transform_set_geodetic_kernel, METH_VARARGS,
+        "Forces the kernel batched geodetic conversions run on."},
+    {"set_num_threads", set_num_threads, METH_VARARGS, "Sets the number of threads batched transforms run on."},
+    {"get_num_threads", get_num_threads, METH_VARARGS, "Gets the number of threads batched transforms run on."},
     {NULL, NULL, 0, NULL}
 };
 
@@ -469,6 +1174,12 @@ static struct PyModuleDef coordinates_transform = {
 
 
 PyMODINIT_FUNC PyInit_transform(void) {
+
+    state_vector_api = import_state_vector_api();
+    if(!state_vector_api) {
+        return NULL;
+    }
+
     return PyModule_Create(&coordinates_transform);
 }
 
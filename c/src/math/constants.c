@@ -38,9 +38,9 @@ extern "C"
 {
 #endif /* __cplusplus */
 
-const long double ARCSECONDS_TO_RADIANS = M_PI / (180 * 3600);
+const Real ARCSECONDS_TO_RADIANS = M_PI / (180 * 3600);
 
-const long double ASTRO_UNIT_TO_METERS = 149597870691.0;
+const Real ASTRO_UNIT_TO_METERS = 149597870691.0;
 
 #ifdef __cplusplus
 } /* extern "C" */
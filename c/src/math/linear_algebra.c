@@ -69,6 +69,27 @@ void dot_product_transpose(Mat3* matrix, Vec3* vector, Vec3* product) {
     }
 }
 
+/**
+ * @brief Computes the product of two matrices
+ * @param left The left matrix
+ * @param right The right matrix
+ * @param product The matrix product left * right. May not alias either operand.
+ */
+void matrix_product(Mat3* left, Mat3* right, Mat3* product) {
+
+    if(left && right && product) {
+        product->w11 = left->w11 * right->w11 + left->w12 * right->w21 + left->w13 * right->w31;
+        product->w12 = left->w11 * right->w12 + left->w12 * right->w22 + left->w13 * right->w32;
+        product->w13 = left->w11 * right->w13 + left->w12 * right->w23 + left->w13 * right->w33;
+        product->w21 = left->w21 * right->w11 + left->w22 * right->w21 + left->w23 * right->w31;
+        product->w22 = left->w21 * right->w12 + left->w22 * right->w22 + left->w23 * right->w32;
+        product->w23 = left->w21 * right->w13 + left->w22 * right->w23 + left->w23 * right->w33;
+        product->w31 = left->w31 * right->w11 + left->w32 * right->w21 + left->w33 * right->w31;
+        product->w32 = left->w31 * right->w12 + left->w32 * right->w22 + left->w33 * right->w32;
+        product->w33 = left->w31 * right->w13 + left->w32 * right->w23 + left->w33 * right->w33;
+    }
+}
+
 /**
  * @brief Computes the cross product of two vectors
  * @param vector1 The first vector
@@ -91,7 +112,7 @@ void cross_product(Vec3* vector1, Vec3* vector2, Vec3* product) {
 void normalize(Vec3* vector) {
 
     if(vector) {
-        long double mag = 0;
+        Real mag = 0;
         magnitude(vector, &mag);
         vector->x /= mag;
         vector->y /= mag;
@@ -104,7 +125,7 @@ void normalize(Vec3* vector) {
  * @param vector The vector
  * @param mag The magnitude of the vector
  */
-void magnitude(Vec3* vector, long double* mag) {
+void magnitude(Vec3* vector, Real* mag) {
 
     if(vector && mag) {
         *mag = 0;
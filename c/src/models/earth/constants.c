@@ -41,21 +41,21 @@ extern "C"
 /**
  * These coefficients can be found here: https://aa.usno.navy.mil/downloads/Circular_179.pdf
  */
-const long double MEAN_OBLIQUITY_EARTH[6] = {84381.406, -46.836769, -0.0001831, 0.00200340, -5.76e-7, -4.34e-8};
+const Real MEAN_OBLIQUITY_EARTH[6] = {84381.406, -46.836769, -0.0001831, 0.00200340, -5.76e-7, -4.34e-8};
 
-const long double GENERAL_PRECESSION_LONGITUDE[3] = {0.0, 5028.82, 1.112022};
-const long double PRECESSION_EQUATOR[6] = {0.0, 5038.481507, -1.0790069, -0.00114045, 0.000132851, -0.0000000951};
-const long double OBLIQUITY_MEAN_EQUATOR[6] = {84381.406, -0.025754, 0.0512623, -0.00772503, -4.67e-7, -3.337e-7};
-const long double PRECESSION_ECLIPTIC_MEAN_EQUATOR[6] = {0.0, 10.556403, -2.3814292, -0.00121197, 0.000170663, -5.4e-8};
+const Real GENERAL_PRECESSION_LONGITUDE[3] = {0.0, 5028.82, 1.112022};
+const Real PRECESSION_EQUATOR[6] = {0.0, 5038.481507, -1.0790069, -0.00114045, 0.000132851, -0.0000000951};
+const Real OBLIQUITY_MEAN_EQUATOR[6] = {84381.406, -0.025754, 0.0512623, -0.00772503, -4.67e-7, -3.337e-7};
+const Real PRECESSION_ECLIPTIC_MEAN_EQUATOR[6] = {0.0, 10.556403, -2.3814292, -0.00121197, 0.000170663, -5.4e-8};
 
-const long double ICRS_X_POLE_OFFSET = 0.0;
-const long double ICRS_Y_POLE_OFFSET = 0.0;
-const long double ICRS_RIGHT_ASCENSION_OFFSET = 0.0;
+const Real ICRS_X_POLE_OFFSET = 0.0;
+const Real ICRS_Y_POLE_OFFSET = 0.0;
+const Real ICRS_RIGHT_ASCENSION_OFFSET = 0.0;
 
-const long double GMST_FUNCTION_JULIAN_DU[6] = {67310.54837708, 86636.555367405292, 6.9540371e-11, -6.02e-24,
+const Real GMST_FUNCTION_JULIAN_DU[6] = {67310.54837708, 86636.555367405292, 6.9540371e-11, -6.02e-24,
     -1.1221e-24, -3.774e-32};
-const long double ERA_DUT1[2] = {0.779057273264, 1.00273781191135448};
-const long double EQUATION_OF_ORIGINS[544] = {
+const Real ERA_DUT1[2] = {0.779057273264, 1.00273781191135448};
+const Real EQUATION_OF_ORIGINS[544] = {
     2640.96, -0.39, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     63.52, -0.02, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
     11.75, 0.01, 0, 0, 2, -2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -92,8 +92,8 @@ const long double EQUATION_OF_ORIGINS[544] = {
     -0.87, 0.00, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0
 };
 
-const long double CHANDLER_WOBBLE = 0.12;
-const long double ANNUAL_WOBBLE = 0.26;
+const Real CHANDLER_WOBBLE = 0.12;
+const Real ANNUAL_WOBBLE = 0.26;
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -25,7 +25,10 @@
 #include <Python.h>
 
 #define __compile_models_earth_earth__
+#define __compile_util_rcu__
 #include "models/earth/earth.h"
+#include "models/earth/snapshot.h"
+#include "util/mapped_file.h"
 
 #if defined(_WIN32) || defined(WIN32)
 
@@ -40,20 +43,37 @@ extern "C"
 #endif /* __cplusplus */
 
 
+/**
+ * @brief Invalidates every entry of the frame rotation cache. Needed whenever data feeding the rotation changes.
+ */
+static void invalidate_rotation_cache(FrameRotationCache* cache) {
+
+    mutex_lock(&cache->lock);
+    for(int i = 0; i < cache->nentries; ++i) {
+        cache->entries[i].valid = 0;
+    }
+    cache->generation++;
+    mutex_unlock(&cache->lock);
+}
+
 /**
  * @brief Creates a new Earth Model object and makes it available to Python
  */
 static PyObject* new_EarthModel(PyObject* self, PyObject* args) {
 
     EarthModel* model = (EarthModel*)malloc(sizeof(EarthModel));
+    EOPTable* earth_orientation_parameters = (EOPTable*)malloc(sizeof(EOPTable));
 
-    if(!model) {
+    if(!model || !earth_orientation_parameters) {
+        free(model);
+        free(earth_orientation_parameters);
         PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_EarthModel.");
         return PyErr_Occurred();
     }
 
     model->ellipsoid.a = 0.0;
     model->ellipsoid.b = 0.0;
+    model->geodetic_algorithm = ClosedFormGeodeticAlgorithm;
     model->geoid.interpolation_spacing = 0.0;
     model->geoid.interpolation = NULL;
     model->geoid.ncoefficients = 0;
@@ -62,9 +82,53 @@ static PyObject* new_EarthModel(PyObject* self, PyObject* args) {
     model->nutation_series.nrecords = 0;
     model->nutation_series.nrecords_allocated = 0;
     model->nutation_series.records = NULL;
-    model->earth_orientation_parameters.nrecords = 0;
-    model->earth_orientation_parameters.nrecords_allocated = 0;
-    model->earth_orientation_parameters.records = NULL;
+    model->nutation_series.strategy = DEFAULT_NUTATION_STRATEGY;
+    model->nutation_series.ncolumns = 0;
+    model->nutation_series.column_stride = 0;
+    model->nutation_series.columns = NULL;
+    model->truncated_nutation_series.nrecords = 0;
+    model->truncated_nutation_series.nrecords_allocated = 0;
+    model->truncated_nutation_series.records = NULL;
+    model->truncated_nutation_series.strategy = DEFAULT_NUTATION_STRATEGY;
+    model->truncated_nutation_series.ncolumns = 0;
+    model->truncated_nutation_series.column_stride = 0;
+    model->truncated_nutation_series.columns = NULL;
+    model->nutation_ephemeris.nsegments = 0;
+    model->nutation_ephemeris.ncoefficients = 0;
+    model->nutation_ephemeris.coefficients = NULL;
+    earth_orientation_parameters->nrecords = 0;
+    earth_orientation_parameters->nrecords_allocated = 0;
+    earth_orientation_parameters->records = NULL;
+    earth_orientation_parameters->start = 0.0;
+    earth_orientation_parameters->step = 0.0;
+    earth_orientation_parameters->nindexed = 0;
+    earth_orientation_parameters->interpolation = NearestEOPInterpolation;
+    earth_orientation_parameters->ncolumns = 0;
+    earth_orientation_parameters->column_stride = 0;
+    earth_orientation_parameters->columns = NULL;
+    rcu_init(&model->earth_orientation_parameters, earth_orientation_parameters);
+    model->delta_t_table.nrecords = 0;
+    model->delta_t_table.nrecords_allocated = 0;
+    model->delta_t_table.records = NULL;
+    model->delta_t_table.interpolation = LinearDeltaTInterpolation;
+    model->delta_t_table.extrapolation = PolynomialDeltaTExtrapolation;
+    model->snapshot.data = NULL;
+    model->snapshot.size = 0;
+
+    mutex_init(&model->rotation_cache.lock);
+    model->rotation_cache.hits = 0;
+    model->rotation_cache.misses = 0;
+    model->rotation_cache.generation = 0;
+    model->rotation_cache.nentries = DEFAULT_ROTATION_CACHE_SIZE;
+    model->rotation_cache.entries = (FrameRotation*)calloc(DEFAULT_ROTATION_CACHE_SIZE, sizeof(FrameRotation));
+    if(!model->rotation_cache.entries) {
+        mutex_destroy(&model->rotation_cache.lock);
+        rcu_destroy(&model->earth_orientation_parameters);
+        free(earth_orientation_parameters);
+        free(model);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the EarthModel rotation cache.");
+        return NULL;
+    }
 
     return PyCapsule_New(model, "EarthModel", delete_EarthModel);
 }
@@ -79,12 +143,40 @@ static void delete_EarthModel(PyObject* obj) {
     EarthModel* model = (EarthModel*)PyCapsule_GetPointer(obj, "EarthModel");
 
     if(model) {
-        if(model->nutation_series.records) {
+        if(model->nutation_series.records && !earth_model_snapshot_holds(model, model->nutation_series.records)) {
             free(model->nutation_series.records);
         }
-        if(model->earth_orientation_parameters.records) {
-            free(model->earth_orientation_parameters.records);
+        if(model->nutation_series.columns && !earth_model_snapshot_holds(model, model->nutation_series.columns)) {
+            free(model->nutation_series.columns);
+        }
+        if(model->truncated_nutation_series.records) {
+            free(model->truncated_nutation_series.records);
+        }
+        if(model->truncated_nutation_series.columns) {
+            free(model->truncated_nutation_series.columns);
+        }
+        if(model->nutation_ephemeris.coefficients) {
+            free(model->nutation_ephemeris.coefficients);
+        }
+        release_earth_model_eop_table(model, (EOPTable*)model->earth_orientation_parameters.value);
+        rcu_destroy(&model->earth_orientation_parameters);
+        if(model->delta_t_table.records && !earth_model_snapshot_holds(model, model->delta_t_table.records)) {
+            free(model->delta_t_table.records);
+        }
+        if(model->geoid.interpolation && !earth_model_snapshot_holds(model, model->geoid.interpolation)) {
+            free(model->geoid.interpolation);
         }
+        if(model->geoid.coefficients && !earth_model_snapshot_holds(model, model->geoid.coefficients)) {
+            free(model->geoid.coefficients);
+        }
+        /* Only now that no table points into it can the snapshot the model is attached to go. */
+        if(model->snapshot.data) {
+            unmap_file(&model->snapshot);
+        }
+        if(model->rotation_cache.entries) {
+            free(model->rotation_cache.entries);
+        }
+        mutex_destroy(&model->rotation_cache.lock);
         free(model);
     }
     model = NULL;
@@ -113,6 +205,58 @@ static PyObject* earth_model_set_ellipsoid(PyObject* self, PyObject* args) {
     Py_RETURN_NONE;
 }
 
+/**
+ * @brief Set the algorithm the Earth Model inverts positions onto its Ellipsoid with
+ */
+static PyObject* earth_model_set_geodetic_algorithm(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+    int algorithm;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &algorithm)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_geodetic_algorithm.");
+        return NULL;
+    }
+
+    if(algorithm < ClosedFormGeodeticAlgorithm || algorithm > FukushimaGeodeticAlgorithm) {
+        PyErr_SetString(PyExc_ValueError, "Unknown geodetic algorithm.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    model->geodetic_algorithm = (GeodeticAlgorithm)algorithm;
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the algorithm the Earth Model inverts positions onto its Ellipsoid with
+ */
+static PyObject* earth_model_get_geodetic_algorithm(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+
+    if(!PyArg_ParseTuple(args, "O", &capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_get_geodetic_algorithm.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    return Py_BuildValue("i", (int)model->geodetic_algorithm);
+}
+
 /**
  * @brief Set the Earth Model's Geoid
  */
@@ -166,17 +310,169 @@ static PyObject* earth_model_set_nutation_series(PyObject* self, PyObject* args)
     model->nutation_series.nrecords = series->nrecords;
     model->nutation_series.nrecords_allocated = series->nrecords_allocated;
     model->nutation_series.records = series->records;
+    model->nutation_series.strategy = series->strategy;
+    model->nutation_series.ncolumns = series->ncolumns;
+    model->nutation_series.column_stride = series->column_stride;
+    model->nutation_series.columns = series->columns;
 
     /* Kill their version of the series because now it's managed by earth model */
     series->nrecords = 0;
     series->nrecords_allocated = 0;
     series->records = NULL;
+    series->ncolumns = 0;
+    series->column_stride = 0;
+    series->columns = NULL;
+
+    invalidate_rotation_cache(&model->rotation_cache);
 
     Py_RETURN_NONE;
 }
 
 /**
- * @brief Set the Earth Model's Earth Orientation Parameters
+ * @brief Set the Earth Model's Nutation Ephemeris, or drop it when passed None
+ */
+static PyObject* earth_model_set_nutation_ephemeris(PyObject* self, PyObject* args) {
+
+    PyObject* model_capsule;
+    PyObject* ephemeris_capsule;
+    EarthModel* model;
+    NutationEphemeris* ephemeris;
+
+    if(!PyArg_ParseTuple(args, "OO", &model_capsule, &ephemeris_capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_nutation_ephemeris.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    if(model->nutation_ephemeris.coefficients) {
+        free(model->nutation_ephemeris.coefficients);
+        model->nutation_ephemeris.coefficients = NULL;
+        model->nutation_ephemeris.nsegments = 0;
+    }
+
+    if(ephemeris_capsule != Py_None) {
+        ephemeris = (NutationEphemeris*)PyCapsule_GetPointer(ephemeris_capsule, "NutationEphemeris");
+        if(!ephemeris) {
+            PyErr_SetString(PyExc_MemoryError, "Unable to get the NutationEphemeris from capsule.");
+            return NULL;
+        }
+
+        model->nutation_ephemeris = *ephemeris;
+
+        /* Kill their version of the ephemeris because now it's managed by earth model */
+        ephemeris->nsegments = 0;
+        ephemeris->coefficients = NULL;
+    }
+
+    invalidate_rotation_cache(&model->rotation_cache);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Set the truncated Nutation Series the Earth Model evaluates in place of its full series, or go back to the
+ * full series when passed None
+ */
+static PyObject* earth_model_set_truncated_nutation_series(PyObject* self, PyObject* args) {
+
+    PyObject* model_capsule;
+    PyObject* nutation_capsule;
+    EarthModel* model;
+    NutationSeries* series;
+
+    if(!PyArg_ParseTuple(args, "OO", &model_capsule, &nutation_capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_truncated_nutation_series.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    if(model->truncated_nutation_series.records) {
+        free(model->truncated_nutation_series.records);
+    }
+    if(model->truncated_nutation_series.columns) {
+        free(model->truncated_nutation_series.columns);
+    }
+    model->truncated_nutation_series.nrecords = 0;
+    model->truncated_nutation_series.nrecords_allocated = 0;
+    model->truncated_nutation_series.records = NULL;
+    model->truncated_nutation_series.ncolumns = 0;
+    model->truncated_nutation_series.column_stride = 0;
+    model->truncated_nutation_series.columns = NULL;
+
+    if(nutation_capsule != Py_None) {
+        series = (NutationSeries*)PyCapsule_GetPointer(nutation_capsule, "NutationSeries");
+        if(!series) {
+            PyErr_SetString(PyExc_MemoryError, "Unable to get the NutationSeries from capsule.");
+            return NULL;
+        }
+
+        model->truncated_nutation_series.nrecords = series->nrecords;
+        model->truncated_nutation_series.nrecords_allocated = series->nrecords_allocated;
+        model->truncated_nutation_series.records = series->records;
+        model->truncated_nutation_series.strategy = model->nutation_series.strategy;
+        model->truncated_nutation_series.ncolumns = series->ncolumns;
+        model->truncated_nutation_series.column_stride = series->column_stride;
+        model->truncated_nutation_series.columns = series->columns;
+
+        /* Kill their version of the series because now it's managed by earth model */
+        series->nrecords = 0;
+        series->nrecords_allocated = 0;
+        series->records = NULL;
+        series->ncolumns = 0;
+        series->column_stride = 0;
+        series->columns = NULL;
+    }
+
+    invalidate_rotation_cache(&model->rotation_cache);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Set how the Earth Model evaluates its Nutation Series
+ */
+static PyObject* earth_model_set_nutation_strategy(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+    int strategy;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &strategy)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_nutation_strategy.");
+        return NULL;
+    }
+
+    if(strategy < ExtendedNutationStrategy || strategy > RecurrenceNutationStrategy) {
+        PyErr_SetString(PyExc_ValueError, "Unknown nutation strategy.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    model->nutation_series.strategy = (NutationStrategy)strategy;
+    model->truncated_nutation_series.strategy = (NutationStrategy)strategy;
+
+    invalidate_rotation_cache(&model->rotation_cache);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Set the Earth Model's Earth Orientation Parameters, swapping the table in whole while other threads convert
  */
 static PyObject* earth_model_set_earth_orientation_parameters(PyObject* self, PyObject* args) {
 
@@ -184,27 +480,118 @@ static PyObject* earth_model_set_earth_orientation_parameters(PyObject* self, Py
     PyObject* earth_orientation_parameters_capsule;
     EarthModel* model;
     EOPTable* earth_orientation_parameters;
+    int keep_interpolation = 0;
 
-    if(!PyArg_ParseTuple(args, "OO", &model_capsule, &earth_orientation_parameters_capsule)) {
+    if(!PyArg_ParseTuple(args, "OO|p", &model_capsule, &earth_orientation_parameters_capsule, &keep_interpolation)) {
         PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_earth_orientation_parameters.");
         return PyErr_Occurred();
     }
 
     model = (EarthModel*)PyCapsule_GetPointer(model_capsule, "EarthModel");
     earth_orientation_parameters = (EOPTable*)PyCapsule_GetPointer(earth_orientation_parameters_capsule, "EOPTable");
+    if(!model || !earth_orientation_parameters) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel or EOPTable from capsule.");
+        return NULL;
+    }
 
-    model->earth_orientation_parameters.nrecords = earth_orientation_parameters->nrecords;
-    model->earth_orientation_parameters.nrecords_allocated = earth_orientation_parameters->nrecords_allocated;
-    model->earth_orientation_parameters.records = earth_orientation_parameters->records;
+    EOPTable* published = (EOPTable*)malloc(sizeof(EOPTable));
+    if(!published) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the EarthModel EOP table.");
+        return NULL;
+    }
+    *published = *earth_orientation_parameters;
 
     /* Kill their version of the table because now it's managed by earth model */
     earth_orientation_parameters->nrecords = 0;
     earth_orientation_parameters->nrecords_allocated = 0;
     earth_orientation_parameters->records = NULL;
+    earth_orientation_parameters->nindexed = 0;
+    earth_orientation_parameters->ncolumns = 0;
+    earth_orientation_parameters->column_stride = 0;
+    earth_orientation_parameters->columns = NULL;
+
+    /* Conversions already running finish on the table they started with, the wait for them is made without the GIL.
+     * Rotations cached from the previous table are tagged with its version and are not used again. */
+    EOPTable* previous;
+    Py_BEGIN_ALLOW_THREADS
+    previous = (EOPTable*)rcu_write_lock(&model->earth_orientation_parameters);
+    if(keep_interpolation) {
+        published->interpolation = previous->interpolation;
+    }
+    previous = (EOPTable*)rcu_write_unlock(&model->earth_orientation_parameters, published);
+    Py_END_ALLOW_THREADS
+
+    release_earth_model_eop_table(model, previous);
 
     Py_RETURN_NONE;
 }
 
+/**
+ * @brief Set how the Earth Model interpolates its Earth Orientation Parameters between records
+ */
+static PyObject* earth_model_set_eop_interpolation(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+    int interpolation;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &interpolation)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_eop_interpolation.");
+        return NULL;
+    }
+
+    if(interpolation < NearestEOPInterpolation || interpolation > LagrangeEOPInterpolation) {
+        PyErr_SetString(PyExc_ValueError, "Unknown EOP interpolation.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    EOPTable* published = (EOPTable*)malloc(sizeof(EOPTable));
+    if(!published) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the EarthModel EOP table.");
+        return NULL;
+    }
+
+    /* The published table is never changed in place, the copy shares its records and columns. */
+    EOPTable* previous;
+    Py_BEGIN_ALLOW_THREADS
+    *published = *(EOPTable*)rcu_write_lock(&model->earth_orientation_parameters);
+    published->interpolation = (EOPInterpolation)interpolation;
+    previous = (EOPTable*)rcu_write_unlock(&model->earth_orientation_parameters, published);
+    Py_END_ALLOW_THREADS
+
+    free(previous);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the version of the Earth Model's Earth Orientation Parameters, counting the tables swapped in
+ */
+static PyObject* earth_model_get_eop_version(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+
+    if(!PyArg_ParseTuple(args, "O", &capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_get_eop_version.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    return Py_BuildValue("l", rcu_version(&model->earth_orientation_parameters));
+}
+
 /**
  * @brief Set the Earth Model's Delta T
  */
@@ -226,12 +613,16 @@ static PyObject* earth_model_set_delta_t_table(PyObject* self, PyObject* args) {
     model->delta_t_table.nrecords = delta_t_table->nrecords;
     model->delta_t_table.nrecords_allocated = delta_t_table->nrecords_allocated;
     model->delta_t_table.records = delta_t_table->records;
+    model->delta_t_table.interpolation = delta_t_table->interpolation;
+    model->delta_t_table.extrapolation = delta_t_table->extrapolation;
 
     /* Kill their version of the table because now it's managed by earth model */
     delta_t_table->nrecords = 0;
     delta_t_table->nrecords_allocated = 0;
     delta_t_table->records = NULL;
 
+    invalidate_rotation_cache(&model->rotation_cache);
+
     Py_RETURN_NONE;
 }
 
@@ -263,16 +654,301 @@ static PyObject* earth_model_get_delta_t_table(PyObject* self, PyObject* args) {
     Py_RETURN_NONE;
 }
 
+/**
+ * @brief Resize the Earth Model's frame rotation cache, dropping all cached epochs.
+ */
+static PyObject* earth_model_set_rotation_cache_size(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+    int nentries;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &nentries)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_set_rotation_cache_size.");
+        return NULL;
+    }
+
+    if(nentries < 0) {
+        PyErr_SetString(PyExc_ValueError, "The rotation cache size can not be negative.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    FrameRotation* entries = NULL;
+    if(nentries > 0) {
+        entries = (FrameRotation*)calloc(nentries, sizeof(FrameRotation));
+        if(!entries) {
+            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the EarthModel rotation cache.");
+            return NULL;
+        }
+    }
+
+    mutex_lock(&model->rotation_cache.lock);
+    free(model->rotation_cache.entries);
+    model->rotation_cache.entries = entries;
+    model->rotation_cache.nentries = nentries;
+    mutex_unlock(&model->rotation_cache.lock);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the Earth Model's frame rotation cache size, hits and misses.
+ */
+static PyObject* earth_model_get_rotation_cache_statistics(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+
+    if(!PyArg_ParseTuple(args, "O", &capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_get_rotation_cache_statistics.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    mutex_lock(&model->rotation_cache.lock);
+    int nentries = model->rotation_cache.nentries;
+    unsigned long long hits = model->rotation_cache.hits, misses = model->rotation_cache.misses;
+    mutex_unlock(&model->rotation_cache.lock);
+
+    return Py_BuildValue("iKK", nentries, hits, misses);
+}
+
+/**
+ * @brief Drop all cached epochs from the Earth Model's frame rotation cache and reset its counters.
+ */
+static PyObject* earth_model_clear_rotation_cache(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EarthModel* model;
+
+    if(!PyArg_ParseTuple(args, "O", &capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_clear_rotation_cache.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    invalidate_rotation_cache(&model->rotation_cache);
+    mutex_lock(&model->rotation_cache.lock);
+    model->rotation_cache.hits = 0;
+    model->rotation_cache.misses = 0;
+    mutex_unlock(&model->rotation_cache.lock);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Drops the truncated series, the nutation ephemeris and the cached rotations, all derived from tables that
+ * were just replaced.
+ */
+static void drop_derived_tables(EarthModel* model) {
+
+    free(model->truncated_nutation_series.records);
+    free(model->truncated_nutation_series.columns);
+    model->truncated_nutation_series.nrecords = 0;
+    model->truncated_nutation_series.nrecords_allocated = 0;
+    model->truncated_nutation_series.records = NULL;
+    model->truncated_nutation_series.ncolumns = 0;
+    model->truncated_nutation_series.column_stride = 0;
+    model->truncated_nutation_series.columns = NULL;
+    free(model->nutation_ephemeris.coefficients);
+    model->nutation_ephemeris.coefficients = NULL;
+    model->nutation_ephemeris.nsegments = 0;
+
+    invalidate_rotation_cache(&model->rotation_cache);
+}
+
+/**
+ * @brief Save the Earth Model's tables to a snapshot file.
+ */
+static PyObject* earth_model_save(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* path;
+    EarthModel* model;
+
+    if(!PyArg_ParseTuple(args, "OO&", &capsule, PyUnicode_FSConverter, &path)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_save.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = write_earth_model_snapshot(model, PyBytes_AS_STRING(path));
+    Py_END_ALLOW_THREADS
+
+    if(status != 0) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+        Py_DECREF(path);
+        return NULL;
+    }
+    Py_DECREF(path);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Replace the Earth Model's tables with those of a snapshot file, dropping its truncated series, nutation
+ * ephemeris and cached rotations.
+ */
+static PyObject* earth_model_load(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* path;
+    EarthModel* model;
+    MappedFile file;
+
+    if(!PyArg_ParseTuple(args, "OO&", &capsule, PyUnicode_FSConverter, &path)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_load.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    if(map_file(PyBytes_AS_STRING(path), &file) != 0) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+        Py_DECREF(path);
+        return NULL;
+    }
+    Py_DECREF(path);
+
+    const char* error = NULL;
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = check_earth_model_snapshot(file.data, file.size, &error);
+    Py_END_ALLOW_THREADS
+
+    if(status != 0) {
+        unmap_file(&file);
+        PyErr_SetString(PyExc_ValueError, error);
+        return NULL;
+    }
+
+    /* The old tables are freed as the new ones go in, so that only happens with the GIL held. */
+    status = read_earth_model_snapshot(model, file.data);
+    unmap_file(&file);
+    if(status != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the EarthModel tables.");
+        return NULL;
+    }
+
+    /* None of the tables point into a snapshot the model was attached to any more. */
+    if(model->snapshot.data) {
+        unmap_file(&model->snapshot);
+    }
+    drop_derived_tables(model);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Point the Earth Model's tables into a read only mapping of a snapshot file shared with every other process
+ * attached to it, dropping its truncated series, nutation ephemeris and cached rotations.
+ */
+static PyObject* earth_model_attach(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* path;
+    EarthModel* model;
+    MappedFile file;
+
+    if(!PyArg_ParseTuple(args, "OO&", &capsule, PyUnicode_FSConverter, &path)) {
+        PyErr_SetString(PyExc_TypeError, "Invalid arguments passed to earth_model_attach.");
+        return NULL;
+    }
+
+    model = (EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel");
+    if(!model) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EarthModel from capsule.");
+        return NULL;
+    }
+
+    if(map_file(PyBytes_AS_STRING(path), &file) != 0) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+        Py_DECREF(path);
+        return NULL;
+    }
+    Py_DECREF(path);
+
+    const char* error = NULL;
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = check_earth_model_snapshot(file.data, file.size, &error);
+    Py_END_ALLOW_THREADS
+
+    if(status != 0) {
+        unmap_file(&file);
+        PyErr_SetString(PyExc_ValueError, error);
+        return NULL;
+    }
+
+    /* The tables of a snapshot attached before are released against its mapping, which goes once they are gone. */
+    if(attach_earth_model_snapshot(model, file.data) != 0) {
+        unmap_file(&file);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the EarthModel tables.");
+        return NULL;
+    }
+    if(model->snapshot.data) {
+        unmap_file(&model->snapshot);
+    }
+    keep_mapped_file(&file);
+    model->snapshot = file;
+    drop_derived_tables(model);
+
+    Py_RETURN_NONE;
+}
 
 
 
 static PyMethodDef tolueneModelsEarthEarthMethods[] = {
     {"new_EarthModel", new_EarthModel, METH_VARARGS, "Creates a new Earth Model object."},
     {"set_ellipsoid", earth_model_set_ellipsoid, METH_VARARGS, "Set the Earth Model's Ellipsoid."},
+    {"set_geodetic_algorithm", earth_model_set_geodetic_algorithm, METH_VARARGS,
+        "Set the algorithm the Earth Model inverts positions onto its Ellipsoid with."},
+    {"get_geodetic_algorithm", earth_model_get_geodetic_algorithm, METH_VARARGS,
+        "Get the algorithm the Earth Model inverts positions onto its Ellipsoid with."},
     {"set_nutation_series", earth_model_set_nutation_series, METH_VARARGS,
         "Set the Earth Model's Nutation Series."},
+    {"set_nutation_ephemeris", earth_model_set_nutation_ephemeris, METH_VARARGS,
+        "Set the Earth Model's Nutation Ephemeris."},
+    {"set_nutation_strategy", earth_model_set_nutation_strategy, METH_VARARGS,
+        "Set how the Earth Model evaluates its Nutation Series."},
+    {"set_truncated_nutation_series", earth_model_set_truncated_nutation_series, METH_VARARGS,
+        "Set the truncated Nutation Series the Earth Model uses in place of its full series."},
     {"set_earth_orientation_parameters", earth_model_set_earth_orientation_parameters, METH_VARARGS,
         "Set the Earth Model's Earth Orientation Parameters."},
+    {"set_eop_interpolation", earth_model_set_eop_interpolation, METH_VARARGS,
+        "Set how the Earth Model interpolates its Earth Orientation Parameters."},
+    {"get_eop_version", earth_model_get_eop_version, METH_VARARGS,
+        "Get the number of Earth Orientation Parameter tables swapped into the Earth Model."},
     {"set_delta_t_table", earth_model_set_delta_t_table, METH_VARARGS, "Set the Earth Model's Delta T."},
     {"get_ellipsoid", earth_model_get_ellipsoid, METH_VARARGS, "Get the Earth Model's Ellipsoid."},
     {"get_nutation_series", earth_model_get_nutation_series, METH_VARARGS,
@@ -280,6 +956,16 @@ static PyMethodDef tolueneModelsEarthEarthMethods[] = {
     {"get_earth_orientation_parameters", earth_model_get_earth_orientation_parameters, METH_VARARGS,
         "Get the Earth Model's Earth Orientation Parameters."},
     {"get_delta_t_table", earth_model_get_delta_t_table, METH_VARARGS, "Get the Earth Model's Delta T."},
+    {"set_rotation_cache_size", earth_model_set_rotation_cache_size, METH_VARARGS,
+        "Resize the Earth Model's frame rotation cache."},
+    {"get_rotation_cache_statistics", earth_model_get_rotation_cache_statistics, METH_VARARGS,
+        "Get the Earth Model's frame rotation cache size, hits and misses."},
+    {"clear_rotation_cache", earth_model_clear_rotation_cache, METH_VARARGS,
+        "Clear the Earth Model's frame rotation cache."},
+    {"save", earth_model_save, METH_VARARGS, "Save the Earth Model's tables to a snapshot file."},
+    {"load", earth_model_load, METH_VARARGS, "Replace the Earth Model's tables with those of a snapshot file."},
+    {"attach", earth_model_attach, METH_VARARGS,
+        "Point the Earth Model's tables into a read only mapping of a snapshot file shared between processes."},
     {NULL, NULL, 0, NULL}
 };
 
@@ -26,6 +26,9 @@
 
 #define __compile_models_earth_earth_orientation_parameters__
 #include "models/earth/earth_orientation_parameters.h"
+#include "util/buffer.h"
+#include "util/capacity.h"
+#include "util/mapped_file.h"
 
 #if defined(_WIN32) || defined(WIN32)     /* _Win32 is usually defined by compilers targeting 32 or 64 bit Windows systems */
 
@@ -40,22 +43,297 @@ extern "C"
 #endif
 
 /**
- * @brief Look up the EOP table record for a given timestamp
+ * @brief Find the record at or before a timestamp by binary search, clamped to the table.
+ *
+ * @param table The EOP table, must hold at least one record.
+ * @param timestamp Unix time
+ * @return The index of the record.
  */
-void eop_table_record_lookup(EOPTable* table, double timestamp, EOPTableRecord* record) {
+int eop_table_search(EOPTable* table, double timestamp) {
+
+    int lower = 0, upper = table->nrecords;
 
-    int lower = 0, upper = (table->nrecords)-1, pointer = upper;
+    const double* timestamps = table->columns;
 
+    /* timestamps[lower] <= timestamp < timestamps[upper] */
     while(upper - lower > 1) {
-        pointer = (upper + lower) / 2;
-        if(table->records[pointer].timestamp > timestamp) {
+        int pointer = (upper + lower) / 2;
+        if(timestamps[pointer] > timestamp) {
             upper = pointer;
         } else {
             lower = pointer;
         }
-        *record = table->records[pointer];
     }
 
+    return lower;
+}
+
+/**
+ * @brief Find the record at or before a timestamp, computing the slot directly for timestamps inside the uniformly
+ * spaced run of records and searching outside of it.
+ *
+ * @param table The EOP table, must hold at least one record.
+ * @param timestamp Unix time
+ * @return The index of the record.
+ */
+int eop_table_index(EOPTable* table, double timestamp) {
+
+    if(table->nindexed > 1) {
+        Real slot = (timestamp - table->start) / table->step;
+        if(slot >= 0.0 && slot < (Real)(table->nindexed - 1)) {
+            return (int)slot;
+        }
+    }
+
+    return eop_table_search(table, timestamp);
+}
+
+/**
+ * @brief Find the record at or before a timestamp starting from where the previous lookup landed. A time ordered run of
+ * epochs stays in the same interval or steps into the next one, anything else falls back to eop_table_index.
+ *
+ * @param table The EOP table, must hold at least one record.
+ * @param timestamp Unix time
+ * @param cursor The index of the previous lookup, updated to this one. Any value is safe, the table may have changed
+ * since it was set.
+ * @return The index of the record.
+ */
+int eop_table_cursor_index(EOPTable* table, double timestamp, int* cursor) {
+
+    const int nrecords = table->nrecords;
+    const double* timestamps = table->columns;
+
+    for(int i = *cursor; i >= 0 && i < nrecords && i <= *cursor + 1; ++i) {
+        if(i > 0 && timestamps[i] > timestamp) {
+            break;
+        }
+        if(i + 1 >= nrecords || timestamp < timestamps[i+1]) {
+            *cursor = i;
+            return i;
+        }
+    }
+
+    *cursor = eop_table_index(table, timestamp);
+    return *cursor;
+}
+
+/**
+ * @brief Recomputes the uniformly spaced run of records at the start of the table.
+ *
+ * @param table The EOP table.
+ */
+static void index_eop_table(EOPTable* table) {
+
+    table->nindexed = table->nrecords;
+    table->start = table->nrecords > 0 ? table->records[0].timestamp : 0.0;
+    table->step = table->nrecords > 1 ? table->records[1].timestamp - table->records[0].timestamp : 0.0;
+
+    if(table->step <= 0.0) {
+        table->nindexed = table->nrecords > 0 ? 1 : 0;
+        return;
+    }
+
+    for(int i = 2; i < table->nrecords; ++i) {
+        if(table->records[i].timestamp != table->start + i * table->step) {
+            table->nindexed = i;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Removes the leap seconds between two dUT1 values, so the second is continuous with the first.
+ *
+ * @param reference The dUT1 to be continuous with.
+ * @param dut1 The dUT1 of a neighbouring record.
+ * @return dut1 less the whole seconds it jumped by from reference.
+ */
+static Real continuous_dut1(Real reference, Real dut1) {
+
+    Real jump = dut1 - reference;
+    if(jump > EOP_LEAP_SECOND_THRESHOLD || jump < -EOP_LEAP_SECOND_THRESHOLD) {
+        dut1 -= round(jump);
+    }
+    return dut1;
+}
+
+/**
+ * @brief Look up polar motion, dUT1 and LOD for a given timestamp from the table's columns, interpolated between the
+ * records as set by the table's interpolation. All zero for an empty table.
+ */
+void eop_table_values_lookup(EOPTable* table, double timestamp, EOPValues* values) {
+    eop_table_values_lookup_from(table, timestamp, NULL, values);
+}
+
+/**
+ * @brief Look up polar motion, dUT1 and LOD for a given timestamp, finding the records from a cursor if given.
+ */
+void eop_table_values_lookup_from(EOPTable* table, double timestamp, int* cursor, EOPValues* values) {
+
+    if(table->nrecords < 1) {
+        values->PM_x = 0.0;
+        values->PM_y = 0.0;
+        values->dut1 = 0.0;
+        values->lod = 0.0;
+        return;
+    }
+
+    const int stride = table->column_stride;
+    const double* x = table->columns;
+    const double* pm_x = x + stride;
+    const double* pm_y = x + 2 * stride;
+    const double* dut1 = x + 3 * stride;
+    const double* lod = x + 4 * stride;
+
+    int i = cursor ? eop_table_cursor_index(table, timestamp, cursor) : eop_table_index(table, timestamp);
+
+    if(table->interpolation == NearestEOPInterpolation || i + 1 >= table->nrecords || timestamp <= x[i]) {
+        values->PM_x = pm_x[i];
+        values->PM_y = pm_y[i];
+        values->dut1 = dut1[i];
+        values->lod = lod[i];
+        return;
+    }
+
+    Real t = timestamp;
+
+    /* Leap seconds are inserted at the end of the day of record i at the earliest, so every dUT1 is taken continuous
+     * with that of record i, which holds for the whole interval. */
+    if(table->interpolation == LagrangeEOPInterpolation && i >= 1 && i + 2 < table->nrecords) {
+
+        Real w[4];
+        for(int j = 0; j < 4; ++j) {
+            w[j] = 1.0;
+            for(int k = 0; k < 4; ++k) {
+                if(k != j) w[j] *= (t - x[i-1+k]) / ((Real)x[i-1+j] - x[i-1+k]);
+            }
+        }
+
+        values->PM_x = 0.0;
+        values->PM_y = 0.0;
+        values->dut1 = 0.0;
+        values->lod = 0.0;
+        for(int j = 0; j < 4; ++j) {
+            values->PM_x += w[j] * pm_x[i-1+j];
+            values->PM_y += w[j] * pm_y[i-1+j];
+            values->dut1 += w[j] * continuous_dut1(dut1[i], dut1[i-1+j]);
+            values->lod += w[j] * lod[i-1+j];
+        }
+        return;
+    }
+
+    Real u = (t - x[i]) / ((Real)x[i+1] - x[i]);
+
+    values->PM_x = pm_x[i] + u * ((Real)pm_x[i+1] - pm_x[i]);
+    values->PM_y = pm_y[i] + u * ((Real)pm_y[i+1] - pm_y[i]);
+    values->dut1 = dut1[i] + u * (continuous_dut1(dut1[i], dut1[i+1]) - dut1[i]);
+    values->lod = lod[i] + u * ((Real)lod[i+1] - lod[i]);
+}
+
+/**
+ * @brief Look up the EOP table record for a given timestamp. Polar motion, dUT1 and LOD are interpolated between the
+ * records as set by the table's interpolation, the other members are those of the record at or before the timestamp.
+ */
+void eop_table_record_lookup(EOPTable* table, double timestamp, EOPTableRecord* record) {
+
+    if(table->nrecords < 1) {
+        return;
+    }
+
+    EOPValues values;
+    *record = table->records[eop_table_index(table, timestamp)];
+    eop_table_values_lookup(table, timestamp, &values);
+
+    record->bulletin_a_PM_x = values.PM_x;
+    record->bulletin_a_PM_y = values.PM_y;
+    record->bulletin_a_dut1 = values.dut1;
+    record->bulletin_a_lod = values.lod;
+}
+
+/**
+ * @brief Grow the columns to hold at least required records, keeping the records already copied into them.
+ *
+ * @param table The EOP table.
+ * @param required The number of records the columns must hold.
+ * @return 0 on success, -1 if the columns could not be grown, leaving them untouched.
+ */
+static int reserve_eop_columns(EOPTable* table, long long required) {
+
+    if(required <= table->column_stride) {
+        return 0;
+    }
+
+    long long stride = grow_capacity(table->column_stride, required);
+    if(stride < 0) {
+        return -1;
+    }
+
+    double* columns = (double*)malloc((size_t)stride * EOP_TABLE_NCOLUMNS * sizeof(double));
+    if(!columns) {
+        return -1;
+    }
+
+    for(int c = 0; c < EOP_TABLE_NCOLUMNS; ++c) {
+        if(table->ncolumns > 0) {
+            memcpy(columns + c * stride, table->columns + c * table->column_stride, table->ncolumns * sizeof(double));
+        }
+    }
+
+    free(table->columns);
+    table->columns = columns;
+    table->column_stride = (int)stride;
+
+    return 0;
+}
+
+/**
+ * @brief Copy the records from first on into the columns, which must already hold room for all of them.
+ *
+ * @param table The EOP table.
+ * @param first The index of the first record to copy.
+ */
+static void fill_eop_columns(EOPTable* table, int first) {
+
+    const int stride = table->column_stride;
+
+    for(int i = first; i < table->nrecords; ++i) {
+        const EOPTableRecord* record = &table->records[i];
+        table->columns[i] = (double)record->timestamp;
+        table->columns[stride + i] = (double)record->bulletin_a_PM_x;
+        table->columns[2 * stride + i] = (double)record->bulletin_a_PM_y;
+        table->columns[3 * stride + i] = (double)record->bulletin_a_dut1;
+        table->columns[4 * stride + i] = (double)record->bulletin_a_lod;
+    }
+    table->ncolumns = table->nrecords;
+}
+
+/**
+ * @brief Orders EOP table records by timestamp for qsort.
+ */
+static int compare_eop_records(const void* a, const void* b) {
+
+    Real lhs = ((const EOPTableRecord*)a)->timestamp, rhs = ((const EOPTableRecord*)b)->timestamp;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @brief Sorts the table once after records were appended from first on, if they broke the order, then brings the
+ * columns up to date and reindexes it. The columns must already hold room for every record.
+ *
+ * @param table The EOP table.
+ * @param first The index of the first appended record.
+ */
+static void sort_appended_eop_records(EOPTable* table, int first) {
+
+    for(int i = first > 0 ? first : 1; i < table->nrecords; ++i) {
+        if(table->records[i-1].timestamp > table->records[i].timestamp) {
+            qsort(table->records, table->nrecords, sizeof(EOPTableRecord), compare_eop_records);
+            first = 0;
+            break;
+        }
+    }
+    fill_eop_columns(table, first);
+    index_eop_table(table);
 }
 
 /**
@@ -92,16 +370,10 @@ static PyObject* eop_table_add_record(PyObject* self, PyObject* args) {
         return NULL;
     }
 
-    if (table->nrecords_allocated < table->nrecords+1) {
-        table->nrecords_allocated += 365;
-        EOPTableRecord* new_table = (EOPTableRecord*)malloc(table->nrecords_allocated * sizeof(EOPTableRecord));
-        if(!new_table) {
-            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for EOPTable records.");
-            return NULL;
-        }
-        memcpy(new_table, table->records, table->nrecords * sizeof(EOPTableRecord));
-        free(table->records);
-        table->records = new_table;
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + 1LL,
+        sizeof(EOPTableRecord)) != 0 || reserve_eop_columns(table, table->nrecords + 1LL) != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for EOPTable records.");
+        return NULL;
     }
 
     int insertion_point = table->nrecords;
@@ -111,24 +383,456 @@ static PyObject* eop_table_add_record(PyObject* self, PyObject* args) {
     }
     table->nrecords++;
 
-    table->records[insertion_point].timestamp = (long double)timestamp;
+    table->records[insertion_point].timestamp = (Real)timestamp;
     table->records[insertion_point].is_bulletin_a_PM_predicted = is_bulletin_a_PM_predicted;
-    table->records[insertion_point].bulletin_a_PM_x = (long double)bulletin_a_PM_x;
-    table->records[insertion_point].bulletin_a_PM_x_error = (long double)bulletin_a_PM_x_error;
-    table->records[insertion_point].bulletin_a_PM_y = (long double)bulletin_a_PM_y;
-    table->records[insertion_point].bulletin_a_PM_y_error = (long double)bulletin_a_PM_y_error;
+    table->records[insertion_point].bulletin_a_PM_x = (Real)bulletin_a_PM_x;
+    table->records[insertion_point].bulletin_a_PM_x_error = (Real)bulletin_a_PM_x_error;
+    table->records[insertion_point].bulletin_a_PM_y = (Real)bulletin_a_PM_y;
+    table->records[insertion_point].bulletin_a_PM_y_error = (Real)bulletin_a_PM_y_error;
     table->records[insertion_point].is_bulletin_a_dut1_predicted = is_bulletin_a_dut1_predicted;
-    table->records[insertion_point].bulletin_a_dut1 = (long double)bulletin_a_dut1;
+    table->records[insertion_point].bulletin_a_dut1 = (Real)bulletin_a_dut1;
     table->records[insertion_point].bulletin_a_dut1_error = bulletin_a_dut1_error;
-    table->records[insertion_point].bulletin_a_lod = (long double)bulletin_a_lod;
-    table->records[insertion_point].bulletin_a_lod_error = (long double)bulletin_a_lod_error;
-    table->records[insertion_point].bulletin_b_PM_x = (long double)bulletin_b_PM_x;
-    table->records[insertion_point].bulletin_b_PM_y = (long double)bulletin_b_PM_y;
-    table->records[insertion_point].bulletin_b_dut1 = (long double)bulletin_b_dut1;
+    table->records[insertion_point].bulletin_a_lod = (Real)bulletin_a_lod;
+    table->records[insertion_point].bulletin_a_lod_error = (Real)bulletin_a_lod_error;
+    table->records[insertion_point].bulletin_b_PM_x = (Real)bulletin_b_PM_x;
+    table->records[insertion_point].bulletin_b_PM_y = (Real)bulletin_b_PM_y;
+    table->records[insertion_point].bulletin_b_dut1 = (Real)bulletin_b_dut1;
+
+    fill_eop_columns(table, insertion_point);
+
+    /* Appending extends the uniformly spaced run if it lands on the next slot, anything else reindexes. */
+    if(insertion_point != table->nrecords-1 || table->nrecords <= 2) {
+        index_eop_table(table);
+    } else if(table->nindexed == insertion_point && (Real)timestamp == table->start + insertion_point * table->step) {
+        table->nindexed++;
+    }
 
     return Py_BuildValue("i", table->nrecords);
 }
 
+/**
+ * @brief The character at a column of a fixed width line, blank past the end of the line.
+ */
+static char column_of(const char* line, size_t length, size_t column) {
+    return column < length ? line[column] : ' ';
+}
+
+/**
+ * @brief Non-zero if the columns [begin, end) of a fixed width line are blank.
+ */
+static int columns_blank(const char* line, size_t length, size_t begin, size_t end) {
+
+    for(size_t column = begin; column < end && column < length; ++column) {
+        if(line[column] != ' ') return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Parse the number in the columns [begin, end) of a fixed width line, 0 if they are blank.
+ */
+static double parse_columns(const char* line, size_t length, size_t begin, size_t end) {
+
+    static const double powers_of_ten[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13,
+        1e14, 1e15};
+
+    char field[32];
+    size_t n = 0;
+    size_t column = begin;
+
+    if(end > length) end = length;
+    while(column < end && line[column] == ' ') ++column;
+
+    /* The columns hold plain decimals of at most 15 digits. Their digits as an integer and the power of ten are both
+     * exact doubles, so the one division rounds the same as strtod, which is left for anything else. */
+    int negative = column < end && line[column] == '-';
+    if(column < end && (line[column] == '-' || line[column] == '+')) ++column;
+
+    unsigned long long digits = 0;
+    int ndigits = 0, nfraction = 0, point = 0;
+    for(; column < end && line[column] != ' '; ++column) {
+        char c = line[column];
+        if(c >= '0' && c <= '9') {
+            digits = digits * 10 + (unsigned long long)(c - '0');
+            ++ndigits;
+            nfraction += point;
+        } else if(c == '.' && !point) {
+            point = 1;
+        } else {
+            break;
+        }
+    }
+    while(column < end && line[column] == ' ') ++column;
+
+    if(column == end && ndigits > 0 && ndigits <= 15) {
+        double value = (double)digits / powers_of_ten[nfraction];
+        return negative ? -value : value;
+    }
+
+    for(column = begin; column < end && n < sizeof(field) - 1; ++column) {
+        field[n++] = line[column];
+    }
+    field[n] = '\0';
+
+    return strtod(field, NULL);
+}
+
+/**
+ * @brief Parse a line of an IERS finals2000A file into a record, with the columns read by the Python parser.
+ *
+ * @param line The line, without its line break.
+ * @param length The length of the line.
+ * @param record The parsed record.
+ * @return 0 on success, -1 if the line has no Modified Julian Date.
+ */
+static int parse_finals_line(const char* line, size_t length, EOPTableRecord* record) {
+
+    if(columns_blank(line, length, 7, 15)) {
+        return -1;
+    }
+
+    memset(record, 0, sizeof(EOPTableRecord));
+
+    /* Taken as UTC, so every record is a whole day apart. */
+    record->timestamp = (parse_columns(line, length, 7, 15) - MJD_UNIX_EPOCH) * SECONDS_PER_DAY_UTC;
+
+    if(column_of(line, length, 16) == ' ') {
+        return 0;
+    }
+
+    record->is_bulletin_a_PM_predicted = column_of(line, length, 16) == 'P';
+    record->bulletin_a_PM_x = parse_columns(line, length, 18, 27);
+    record->bulletin_a_PM_x_error = parse_columns(line, length, 27, 36);
+    record->bulletin_a_PM_y = parse_columns(line, length, 37, 46);
+    record->bulletin_a_PM_y_error = parse_columns(line, length, 46, 55);
+    record->is_bulletin_a_dut1_predicted = column_of(line, length, 57) == 'P';
+    record->bulletin_a_dut1 = parse_columns(line, length, 58, 68);
+    record->bulletin_a_dut1_error = parse_columns(line, length, 68, 78);
+
+    if(!columns_blank(line, length, 79, 86)) {
+        record->bulletin_a_lod = parse_columns(line, length, 79, 86);
+        record->bulletin_a_lod_error = parse_columns(line, length, 86, 93);
+    }
+
+    if(!columns_blank(line, length, 134, 144)) {
+        record->bulletin_b_PM_x = parse_columns(line, length, 134, 144);
+        record->bulletin_b_PM_y = parse_columns(line, length, 144, 154);
+        record->bulletin_b_dut1 = parse_columns(line, length, 154, 165);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Parse a memory mapped IERS finals2000A file in one pass, appending its records to the EOP table and sorting
+ * them with the existing records once at the end.
+ *
+ * @param table The EOP table.
+ * @param file The mapped file.
+ * @return 0 on success, -1 if the records could not be allocated.
+ */
+static int load_finals(EOPTable* table, MappedFile* file) {
+
+    const char* data = file->data;
+    const char* end = file->data + file->size;
+    size_t nlines = 0;
+
+    for(const char* cursor = data; cursor && cursor < end; ++nlines) {
+        const char* newline = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+        cursor = newline ? newline + 1 : end;
+    }
+
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + (long long)nlines,
+        sizeof(EOPTableRecord)) != 0 || reserve_eop_columns(table, table->nrecords + (long long)nlines) != 0) {
+        return -1;
+    }
+
+    int first = table->nrecords;
+    for(const char* cursor = data; cursor && cursor < end;) {
+        const char* newline = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+        const char* line_end = newline ? newline : end;
+        size_t length = (size_t)(line_end - cursor);
+        if(length > 0 && cursor[length-1] == '\r') --length;
+
+        if(parse_finals_line(cursor, length, &table->records[table->nrecords]) == 0) {
+            table->nrecords++;
+        }
+
+        cursor = newline ? newline + 1 : end;
+    }
+
+    sort_appended_eop_records(table, first);
+
+    return 0;
+}
+
+/**
+ * @brief Move the records of a table parsed on its own into the EOP table. An empty table takes the parsed buffers
+ * over, otherwise they are appended and freed.
+ *
+ * @param table The EOP table.
+ * @param loaded The parsed table, its buffers are always taken over or freed.
+ * @return 0 on success, -1 if memory could not be allocated, leaving the EOP table as it was.
+ */
+static int merge_eop_table(EOPTable* table, EOPTable* loaded) {
+
+    if(table->nrecords == 0) {
+        EOPInterpolation interpolation = table->interpolation;
+        free(table->records);
+        free(table->columns);
+        *table = *loaded;
+        table->interpolation = interpolation;
+        return 0;
+    }
+
+    int retval = -1;
+    long long nrecords = table->nrecords + (long long)loaded->nrecords;
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, nrecords, sizeof(EOPTableRecord)) == 0 &&
+        reserve_eop_columns(table, nrecords) == 0) {
+        int first = table->nrecords;
+        if(loaded->nrecords > 0) {
+            memcpy(table->records + first, loaded->records, loaded->nrecords * sizeof(EOPTableRecord));
+        }
+        table->nrecords += loaded->nrecords;
+        sort_appended_eop_records(table, first);
+        retval = 0;
+    }
+    free(loaded->records);
+    free(loaded->columns);
+
+    return retval;
+}
+
+/**
+ * @brief Add a buffer of records to the EOP table, reserving room for all of them at once and sorting once at the end
+ */
+static PyObject* eop_table_add_records(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* rows_obj;
+    EOPTable* table;
+    Py_buffer rows;
+    Py_ssize_t nvalues;
+
+    if(!PyArg_ParseTuple(args, "OO", &capsule, &rows_obj)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. add_records()");
+        return NULL;
+    }
+
+    table = (EOPTable*)PyCapsule_GetPointer(capsule, "EOPTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EOPTable from capsule.");
+        return NULL;
+    }
+
+    if(get_double_buffer(rows_obj, &rows, 0, &nvalues) < 0) {
+        return NULL;
+    }
+
+    if(nvalues % EOP_RECORD_NVALUES != 0) {
+        PyBuffer_Release(&rows);
+        PyErr_Format(PyExc_ValueError, "add_records() expects N*%d values.", EOP_RECORD_NVALUES);
+        return NULL;
+    }
+
+    Py_ssize_t nrows = nvalues / EOP_RECORD_NVALUES;
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + (long long)nrows,
+        sizeof(EOPTableRecord)) != 0 || reserve_eop_columns(table, table->nrecords + (long long)nrows) != 0) {
+        PyBuffer_Release(&rows);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for EOPTable records.");
+        return NULL;
+    }
+
+    const double* row = (const double*)rows.buf;
+    int first = table->nrecords;
+    for(Py_ssize_t i = 0; i < nrows; ++i, row += EOP_RECORD_NVALUES) {
+        EOPTableRecord* record = &table->records[table->nrecords++];
+        record->timestamp = (Real)row[0];
+        record->is_bulletin_a_PM_predicted = row[1] != 0.0;
+        record->bulletin_a_PM_x = (Real)row[2];
+        record->bulletin_a_PM_x_error = (Real)row[3];
+        record->bulletin_a_PM_y = (Real)row[4];
+        record->bulletin_a_PM_y_error = (Real)row[5];
+        record->is_bulletin_a_dut1_predicted = row[6] != 0.0;
+        record->bulletin_a_dut1 = (Real)row[7];
+        record->bulletin_a_dut1_error = (Real)row[8];
+        record->bulletin_a_lod = (Real)row[9];
+        record->bulletin_a_lod_error = (Real)row[10];
+        record->bulletin_b_PM_x = (Real)row[11];
+        record->bulletin_b_PM_y = (Real)row[12];
+        record->bulletin_b_dut1 = (Real)row[13];
+    }
+    PyBuffer_Release(&rows);
+
+    sort_appended_eop_records(table, first);
+
+    return Py_BuildValue("i", table->nrecords);
+}
+
+/**
+ * @brief Load the records of an IERS finals2000A file into the EOP table
+ */
+static PyObject* eop_table_load_file(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* path;
+    EOPTable* table;
+    MappedFile file;
+    int retval;
+
+    if(!PyArg_ParseTuple(args, "OO&", &capsule, PyUnicode_FSConverter, &path)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. load_file()");
+        return NULL;
+    }
+
+    table = (EOPTable*)PyCapsule_GetPointer(capsule, "EOPTable");
+    if(!table) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EOPTable from capsule.");
+        return NULL;
+    }
+
+    if(map_file(PyBytes_AS_STRING(path), &file) != 0) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+        Py_DECREF(path);
+        return NULL;
+    }
+    Py_DECREF(path);
+
+    /* Parsed into a table of its own, other threads may use this one until it is merged in with the GIL held. */
+    EOPTable loaded;
+    memset(&loaded, 0, sizeof(EOPTable));
+    loaded.interpolation = NearestEOPInterpolation;
+
+    Py_BEGIN_ALLOW_THREADS
+    retval = load_finals(&loaded, &file);
+    unmap_file(&file);
+    Py_END_ALLOW_THREADS
+
+    if(retval != 0) {
+        free(loaded.records);
+        free(loaded.columns);
+    } else {
+        retval = merge_eop_table(table, &loaded);
+    }
+
+    if(retval != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for EOPTable records.");
+        return NULL;
+    }
+
+    return Py_BuildValue("i", table->nrecords);
+}
+
+/**
+ * @brief Set how an EOP table is interpolated between records
+ */
+static PyObject* eop_table_set_interpolation(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    EOPTable* table;
+    int interpolation;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &interpolation)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_interpolation()");
+        return NULL;
+    }
+
+    if(interpolation < NearestEOPInterpolation || interpolation > LagrangeEOPInterpolation) {
+        PyErr_SetString(PyExc_ValueError, "Unknown EOP interpolation.");
+        return NULL;
+    }
+
+    table = (EOPTable*)PyCapsule_GetPointer(capsule, "EOPTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EOPTable from capsule.");
+        return NULL;
+    }
+
+    table->interpolation = (EOPInterpolation)interpolation;
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Evaluate polar motion, dUT1 and LOD at a buffer of times, used to compare the lookups and interpolations
+ */
+static PyObject* eop_table_interpolate(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* times_obj;
+    PyObject* out_obj;
+    EOPTable* table;
+    int interpolation, search, use_cursor = 0;
+    Py_buffer times, out;
+
+    if(!PyArg_ParseTuple(args, "OOOip|p", &capsule, &times_obj, &out_obj, &interpolation, &search, &use_cursor)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. interpolate()");
+        return NULL;
+    }
+
+    if(interpolation < NearestEOPInterpolation || interpolation > LagrangeEOPInterpolation) {
+        PyErr_SetString(PyExc_ValueError, "Unknown EOP interpolation.");
+        return NULL;
+    }
+
+    table = (EOPTable*)PyCapsule_GetPointer(capsule, "EOPTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the EOPTable from capsule.");
+        return NULL;
+    }
+
+    if(table->nrecords < 1) {
+        PyErr_SetString(PyExc_ValueError, "The EOPTable has no records.");
+        return NULL;
+    }
+
+    if(PyObject_GetBuffer(times_obj, &times, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+        return NULL;
+    }
+    if(PyObject_GetBuffer(out_obj, &out, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) < 0) {
+        PyBuffer_Release(&times);
+        return NULL;
+    }
+
+    Py_ssize_t ntimes = times.len / (Py_ssize_t)sizeof(double);
+    if(times.itemsize != sizeof(double) || out.itemsize != sizeof(double) ||
+        out.len != 4 * ntimes * (Py_ssize_t)sizeof(double)) {
+        PyBuffer_Release(&times);
+        PyBuffer_Release(&out);
+        PyErr_SetString(PyExc_ValueError, "interpolate() expects N times and an N*4 output buffer of doubles.");
+        return NULL;
+    }
+
+    /* Searching forces the binary search over the whole table, to compare against the indexed lookup. */
+    EOPTable view = *table;
+    view.interpolation = (EOPInterpolation)interpolation;
+    if(search) {
+        view.nindexed = 0;
+    }
+
+    const double* t = (const double*)times.buf;
+    double* values = (double*)out.buf;
+    EOPValues parameters;
+    int cursor = 0;
+
+    /* The cursor carries each lookup over to the next time, as a time ordered stream of conversions does. */
+    Py_BEGIN_ALLOW_THREADS
+    for(Py_ssize_t i = 0; i < ntimes; ++i) {
+        eop_table_values_lookup_from(&view, t[i], use_cursor ? &cursor : NULL, &parameters);
+        values[4*i] = (double)parameters.PM_x;
+        values[4*i+1] = (double)parameters.PM_y;
+        values[4*i+2] = (double)parameters.dut1;
+        values[4*i+3] = (double)parameters.lod;
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&times);
+    PyBuffer_Release(&out);
+
+    Py_RETURN_NONE;
+}
+
 /**
  * @brief Create a new EOP table
  */
@@ -144,6 +848,13 @@ static PyObject* new_EOPTable(PyObject* self, PyObject* args)  {
     table->nrecords = 0;
     table->nrecords_allocated = 0;
     table->records = NULL;
+    table->start = 0.0;
+    table->step = 0.0;
+    table->nindexed = 0;
+    table->interpolation = NearestEOPInterpolation;
+    table->ncolumns = 0;
+    table->column_stride = 0;
+    table->columns = NULL;
 
     return PyCapsule_New(table, "EOPTable", delete_EOPTable);
 }
@@ -159,6 +870,9 @@ static void delete_EOPTable(PyObject* obj) {
         if(table->records) {
             free(table->records);
         }
+        if(table->columns) {
+            free(table->columns);
+        }
         free(table);
     }
 
@@ -168,6 +882,13 @@ static void delete_EOPTable(PyObject* obj) {
 static PyMethodDef tolueneModelsEarthEarthOrientationMethods[] = {
     {"add_record", eop_table_add_record, METH_VARARGS, "Add a record to the EOPTable"},
     {"new_EOPTable", new_EOPTable, METH_VARARGS, "Create a new EOPTable"},
+    {"add_records", eop_table_add_records, METH_VARARGS,
+        "Add a buffer of records to the EOPTable, N rows of the add_record values"},
+    {"load_file", eop_table_load_file, METH_VARARGS, "Load the records of an IERS finals2000A file into the EOPTable"},
+    {"set_interpolation", eop_table_set_interpolation, METH_VARARGS,
+        "Set how the EOPTable is interpolated between records"},
+    {"interpolate", eop_table_interpolate, METH_VARARGS,
+        "Evaluate polar motion, dUT1 and LOD of the EOPTable at a buffer of times"},
     {NULL, NULL, 0, NULL}
 };
 
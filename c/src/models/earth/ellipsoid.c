@@ -57,8 +57,8 @@ static PyObject* set_axes(PyObject* self, PyObject* args) {
         return PyErr_Occurred();
     }
 
-    ellipsoid->a = (long double)a;
-    ellipsoid->b = (long double)b;
+    ellipsoid->a = (Real)a;
+    ellipsoid->b = (Real)b;
 
     Py_RETURN_NONE;
 }
@@ -105,7 +105,7 @@ static PyObject* set_semi_major_axis(PyObject* self, PyObject* args) {
         return PyErr_Occurred();
     }
 
-    ellipsoid->a = (long double)a;
+    ellipsoid->a = (Real)a;
 
     Py_RETURN_NONE;
 }
@@ -154,7 +154,7 @@ static PyObject* set_semi_minor_axis(PyObject* self, PyObject* args) {
         return PyErr_Occurred();
     }
 
-    ellipsoid->b = (long double)b;
+    ellipsoid->b = (Real)b;
 
     Py_RETURN_NONE;
 }
@@ -252,12 +252,12 @@ static PyObject* get_ellipsoid_radius(PyObject* self, PyObject* args) {
         return PyErr_Occurred();
     }
 
-    long double f3 = ellipsoid->a * cos(latitude * M_PI/180);
-    long double f4 = ellipsoid->b * sin(latitude * M_PI/180);
-    long double f1 = ellipsoid->a * f3;
+    Real f3 = ellipsoid->a * cos(latitude * M_PI/180);
+    Real f4 = ellipsoid->b * sin(latitude * M_PI/180);
+    Real f1 = ellipsoid->a * f3;
     f1 = f1 * f1;
     f3 = f3 * f3;
-    long double f2 = ellipsoid->b * f4;
+    Real f2 = ellipsoid->b * f4;
     f2 = f2 * f2;
     f4 = f4 * f4;
 
@@ -285,8 +285,8 @@ static PyObject* new_Ellipsoid(PyObject* self, PyObject* args) {
         return PyErr_Occurred();
     }
 
-    ellipsoid->a = (long double)a;
-    ellipsoid->b = (long double)b;
+    ellipsoid->a = (Real)a;
+    ellipsoid->b = (Real)b;
 
     return PyCapsule_New(ellipsoid, "Ellipsoid", delete_Ellipsoid);
 }
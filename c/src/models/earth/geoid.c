@@ -26,6 +26,8 @@
 
 #define __compile_models_earth_geoid__
 #include "models/earth/geoid.h"
+#include "util/buffer.h"
+#include "util/capacity.h"
 
 #if defined(_WIN32) || defined(WIN32)
 
@@ -130,18 +132,10 @@ static PyObject* add_coefficient(PyObject* self, PyObject* args) {
             return NULL;
         }
 
-        if(geoid->ncoefficients_allocated < geoid->ncoefficients + 1) {
-            geoid->ncoefficients_allocated += degree + 1;
-            SurfaceSphericalHarmonicCoefficients* new_coefficients = (SurfaceSphericalHarmonicCoefficients*)malloc(
-                sizeof(SurfaceSphericalHarmonicCoefficients) * geoid->ncoefficients_allocated);
-            if(!new_coefficients) {
-                PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_coefficients.");
-                return PyErr_Occurred();
-            }
-            memcpy(new_coefficients, geoid->coefficients, sizeof(SurfaceSphericalHarmonicCoefficients) *
-                geoid->ncoefficients);
-            free(geoid->coefficients);
-            geoid->coefficients = new_coefficients;
+        if(reserve_capacity((void**)&geoid->coefficients, &geoid->ncoefficients_allocated,
+            geoid->ncoefficients + 1LL, sizeof(SurfaceSphericalHarmonicCoefficients)) != 0) {
+            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_coefficients.");
+            return PyErr_Occurred();
         }
 
         geoid->coefficients[geoid->ncoefficients].degree = degree;
@@ -155,10 +149,63 @@ static PyObject* add_coefficient(PyObject* self, PyObject* args) {
         return Py_BuildValue("");
 }
 
+static PyObject* add_coefficients(PyObject* self, PyObject* args) {
+
+        PyObject* capsule;
+        PyObject* rows_obj;
+        Py_buffer rows;
+        Py_ssize_t nvalues;
+
+        if(!PyArg_ParseTuple(args, "OO", &capsule, &rows_obj)) {
+            PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. add_coefficients()");
+            return NULL;
+        }
+
+        Geoid* geoid = (Geoid*)PyCapsule_GetPointer(capsule, "Geoid");
+        if(!geoid) {
+            PyErr_SetString(PyExc_TypeError, "Unable to get Geoid from capsule.");
+            return NULL;
+        }
+
+        if(get_double_buffer(rows_obj, &rows, 0, &nvalues) < 0) {
+            return NULL;
+        }
+
+        if(nvalues % 6 != 0) {
+            PyBuffer_Release(&rows);
+            PyErr_SetString(PyExc_ValueError, "add_coefficients() expects N*6 values, degree, order, C, S, C_dot "
+                "and S_dot.");
+            return NULL;
+        }
+
+        /* Reserved once for the whole buffer, a degree 2190 model is millions of coefficients. */
+        if(reserve_capacity((void**)&geoid->coefficients, &geoid->ncoefficients_allocated,
+            geoid->ncoefficients + (long long)nvalues / 6, sizeof(SurfaceSphericalHarmonicCoefficients)) != 0) {
+            PyBuffer_Release(&rows);
+            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_coefficients.");
+            return NULL;
+        }
+
+        const double* row = (const double*)rows.buf;
+        for(Py_ssize_t i = 0; i < nvalues; i += 6, row += 6) {
+            SurfaceSphericalHarmonicCoefficients* coefficient = &geoid->coefficients[geoid->ncoefficients++];
+            coefficient->degree = (int)row[0];
+            coefficient->order = (int)row[1];
+            coefficient->C = row[2];
+            coefficient->S = row[3];
+            coefficient->C_dot = row[4];
+            coefficient->S_dot = row[5];
+        }
+        PyBuffer_Release(&rows);
+
+        return Py_BuildValue("i", geoid->ncoefficients);
+}
+
 static PyMethodDef tolueneModelsEarthGeoidMethods[] = {
     {"new_Geoid", new_Geoid, METH_VARARGS, "Create a new Geoid."},
     {"add_interpolation", add_interpolation, METH_VARARGS, "Add an interpolation point to the Geoid."},
     {"add_coefficient", add_coefficient, METH_VARARGS, "Add a coefficient to the Geoid."},
+    {"add_coefficients", add_coefficients, METH_VARARGS, "Add a buffer of coefficients to the Geoid."},
     {NULL, NULL, 0, NULL}
 };
 
@@ -25,12 +25,17 @@
 #include <Python.h>
 
 #define __compile_models_earth_nutation__
+#define __compile_models_earth_nutation_kernel__
 #include "math/constants.h"
 #include "models/earth/nutation.h"
+#include "models/earth/nutation_kernel.h"
 #include "models/earth/constants.h"
+#include "models/earth/earth.h"
 #include "models/moon/constants.h"
 #include "models/sun/constants.h"
 #include "time/constants.h"
+#include "util/buffer.h"
+#include "util/capacity.h"
 
 #if defined(_WIN32) || defined(WIN32)
 
@@ -47,8 +52,8 @@ extern "C"
 /**
  * @brief Compute nutation values of date along with the equation of the equinoxes.
  */
-void nutation_values_of_date(long double t, NutationSeries* series, long double* nutation_longitude,
-    long double* nutation_obliquity, long double* mean_obliquity_date, long double* equation_of_the_equinoxes) {
+void nutation_values_of_date(Real t, NutationSeries* series, Real* nutation_longitude,
+    Real* nutation_obliquity, Real* mean_obliquity_date, Real* equation_of_the_equinoxes) {
 
     *nutation_longitude = 0.0;
     *nutation_obliquity = 0.0;
@@ -91,71 +96,432 @@ void nutation_values_of_date(long double t, NutationSeries* series, long double*
         + MEAN_LONGITUDE_MOON_MEAN_ASCENDING_NODE[1]) * t
         + MEAN_LONGITUDE_MOON_MEAN_ASCENDING_NODE[0];
 
+    /* The columns are built ahead of time with the GIL held, stale ones fall back to the extended precision loop */
+    if(series->strategy == VectorizedNutationStrategy && nutation_series_columns_current(series)) {
 
-    long double ai, sin_ai, cos_ai;
-    for(int i = 0; i < series->nrecords; ++i) {
-        ai = series->records[i].heliocentric_elliptical_longitude_mercury_coefficient
-                * nutation_critical_arguments[0] +
-             series->records[i].heliocentric_elliptical_longitude_venus_coefficient
-                * nutation_critical_arguments[1] +
-             series->records[i].heliocentric_elliptical_longitude_earth_coefficient
-                * nutation_critical_arguments[2] +
-             series->records[i].heliocentric_elliptical_longitude_mars_coefficient
-                * nutation_critical_arguments[3] +
-             series->records[i].heliocentric_elliptical_longitude_jupiter_coefficient
-                * nutation_critical_arguments[4] +
-             series->records[i].heliocentric_elliptical_longitude_saturn_coefficient
-                * nutation_critical_arguments[5] +
-             series->records[i].heliocentric_elliptical_longitude_uranus_coefficient
-                * nutation_critical_arguments[6] +
-             series->records[i].heliocentric_elliptical_longitude_neptune_coefficient
-                * nutation_critical_arguments[7] +
-             series->records[i].general_precession_in_longitude_coefficient
-                * nutation_critical_arguments[8] +
-             series->records[i].mean_anomaly_moon_coefficient
-                * nutation_critical_arguments[9] +
-             series->records[i].mean_anomaly_sun_coefficient
-                * nutation_critical_arguments[10] +
-             series->records[i].mean_argument_of_latitude_moon_coefficient
-                * nutation_critical_arguments[11] +
-             series->records[i].mean_elongation_moon_from_the_sun_coefficient
-                * nutation_critical_arguments[12] +
-             series->records[i].mean_longitude_of_moon_mean_ascending_node_coefficient
-                * nutation_critical_arguments[13];
-
-        sin_ai = sinl(ai * ARCSECONDS_TO_RADIANS);
-        cos_ai = cosl(ai * ARCSECONDS_TO_RADIANS);
-
-        *nutation_longitude += (series->records[i].S + series->records[i].S_dot * t) * sin_ai +
-            series->records[i].C_prime * cos_ai;
-        *nutation_obliquity += (series->records[i].C + series->records[i].C_dot * t) * cos_ai +
-            series->records[i].S_prime * sin_ai;
-        *equation_of_the_equinoxes += series->records[i].C_prime * sin_ai +
-            series->records[i].S_prime * cos_ai;
+        /* Reduce to a single turn so the double precision kernels only see small angles */
+        double arguments[14], sums[3];
+        for(int k = 0; k < 14; ++k) {
+            arguments[k] = fmod(nutation_critical_arguments[k], 1296000.0) * ARCSECONDS_TO_RADIANS;
+        }
+        nutation_kernel_sum(series, arguments, t, sums);
+
+        *nutation_longitude = sums[0];
+        *nutation_obliquity = sums[1];
+        *equation_of_the_equinoxes = sums[2];
+    }
+    else if(series->strategy == RecurrenceNutationStrategy) {
+
+        /* Every argument is an integer combination of the fundamental arguments, so only those need a sine and cosine */
+        Real arguments[14], sums[3] = {0.0, 0.0, 0.0};
+        Real table[14 * (NUTATION_RECURRENCE_MAX_MULTIPLE + 1) * 2];
+        Real ai, sin_ai, cos_ai;
+        int multipliers[14];
+
+        for(int k = 0; k < 14; ++k) {
+            arguments[k] = fmod(nutation_critical_arguments[k], 1296000.0) * ARCSECONDS_TO_RADIANS;
+        }
+        argument_multiple_table(arguments, 14, NUTATION_RECURRENCE_MAX_MULTIPLE, table);
+
+        for(int i = 0; i < series->nrecords; ++i) {
+            NutationSeriesRecord* record = &series->records[i];
+            multipliers[0] = record->heliocentric_elliptical_longitude_mercury_coefficient;
+            multipliers[1] = record->heliocentric_elliptical_longitude_venus_coefficient;
+            multipliers[2] = record->heliocentric_elliptical_longitude_earth_coefficient;
+            multipliers[3] = record->heliocentric_elliptical_longitude_mars_coefficient;
+            multipliers[4] = record->heliocentric_elliptical_longitude_jupiter_coefficient;
+            multipliers[5] = record->heliocentric_elliptical_longitude_saturn_coefficient;
+            multipliers[6] = record->heliocentric_elliptical_longitude_uranus_coefficient;
+            multipliers[7] = record->heliocentric_elliptical_longitude_neptune_coefficient;
+            multipliers[8] = record->general_precession_in_longitude_coefficient;
+            multipliers[9] = record->mean_anomaly_moon_coefficient;
+            multipliers[10] = record->mean_anomaly_sun_coefficient;
+            multipliers[11] = record->mean_argument_of_latitude_moon_coefficient;
+            multipliers[12] = record->mean_elongation_moon_from_the_sun_coefficient;
+            multipliers[13] = record->mean_longitude_of_moon_mean_ascending_node_coefficient;
+
+            if(!argument_combination(table, multipliers, 14, NUTATION_RECURRENCE_MAX_MULTIPLE, &cos_ai, &sin_ai)) {
+                ai = 0.0;
+                for(int k = 0; k < 14; ++k) ai += multipliers[k] * arguments[k];
+                sin_ai = sin(ai);
+                cos_ai = cos(ai);
+            }
+
+            sums[0] += (record->S + record->S_dot * t) * sin_ai + record->C_prime * cos_ai;
+            sums[1] += (record->C + record->C_dot * t) * cos_ai + record->S_prime * sin_ai;
+            sums[2] += record->C_prime * sin_ai + record->S_prime * cos_ai;
+        }
+
+        *nutation_longitude = sums[0];
+        *nutation_obliquity = sums[1];
+        *equation_of_the_equinoxes = sums[2];
+    }
+    else {
+        Real ai, sin_ai, cos_ai;
+        for(int i = 0; i < series->nrecords; ++i) {
+            ai = series->records[i].heliocentric_elliptical_longitude_mercury_coefficient
+                    * nutation_critical_arguments[0] +
+                 series->records[i].heliocentric_elliptical_longitude_venus_coefficient
+                    * nutation_critical_arguments[1] +
+                 series->records[i].heliocentric_elliptical_longitude_earth_coefficient
+                    * nutation_critical_arguments[2] +
+                 series->records[i].heliocentric_elliptical_longitude_mars_coefficient
+                    * nutation_critical_arguments[3] +
+                 series->records[i].heliocentric_elliptical_longitude_jupiter_coefficient
+                    * nutation_critical_arguments[4] +
+                 series->records[i].heliocentric_elliptical_longitude_saturn_coefficient
+                    * nutation_critical_arguments[5] +
+                 series->records[i].heliocentric_elliptical_longitude_uranus_coefficient
+                    * nutation_critical_arguments[6] +
+                 series->records[i].heliocentric_elliptical_longitude_neptune_coefficient
+                    * nutation_critical_arguments[7] +
+                 series->records[i].general_precession_in_longitude_coefficient
+                    * nutation_critical_arguments[8] +
+                 series->records[i].mean_anomaly_moon_coefficient
+                    * nutation_critical_arguments[9] +
+                 series->records[i].mean_anomaly_sun_coefficient
+                    * nutation_critical_arguments[10] +
+                 series->records[i].mean_argument_of_latitude_moon_coefficient
+                    * nutation_critical_arguments[11] +
+                 series->records[i].mean_elongation_moon_from_the_sun_coefficient
+                    * nutation_critical_arguments[12] +
+                 series->records[i].mean_longitude_of_moon_mean_ascending_node_coefficient
+                    * nutation_critical_arguments[13];
+
+            sin_ai = sin(ai * ARCSECONDS_TO_RADIANS);
+            cos_ai = cos(ai * ARCSECONDS_TO_RADIANS);
+
+            *nutation_longitude += (series->records[i].S + series->records[i].S_dot * t) * sin_ai +
+                series->records[i].C_prime * cos_ai;
+            *nutation_obliquity += (series->records[i].C + series->records[i].C_dot * t) * cos_ai +
+                series->records[i].S_prime * sin_ai;
+            *equation_of_the_equinoxes += series->records[i].C_prime * sin_ai +
+                series->records[i].S_prime * cos_ai;
+        }
     }
 
     *mean_obliquity_date = ((((MEAN_OBLIQUITY_EARTH[5] * t + MEAN_OBLIQUITY_EARTH[4]) * t
         + MEAN_OBLIQUITY_EARTH[3]) * t + MEAN_OBLIQUITY_EARTH[2]) * t + MEAN_OBLIQUITY_EARTH[1]) * t
         + MEAN_OBLIQUITY_EARTH[0];
-    *equation_of_the_equinoxes += *nutation_longitude * cosl(*nutation_obliquity * ARCSECONDS_TO_RADIANS) +
-        0.00000087 * t * sinl(nutation_critical_arguments[13] * ARCSECONDS_TO_RADIANS);
+    *equation_of_the_equinoxes += *nutation_longitude * cos(*nutation_obliquity * ARCSECONDS_TO_RADIANS) +
+        0.00000087 * t * sin(nutation_critical_arguments[13] * ARCSECONDS_TO_RADIANS);
+
+}
+
+/**
+ * @brief Tabulate the cosine and sine of the multiples of a set of angles by repeated complex multiplication.
+ */
+void argument_multiple_table(const Real* arguments, int narguments, int max_multiple, Real* table) {
+
+    for(int k = 0; k < narguments; ++k) {
+        Real* row = table + 2 * k * (max_multiple + 1);
+        /* The x87 sinl and cosl cost more than the whole recurrence. The arguments only carry double precision to
+         * begin with, so the base angles are taken in double and the multiples are built at full precision. */
+        Real cos_argument = cos((double)arguments[k]);
+        Real sin_argument = sin((double)arguments[k]);
+
+        row[0] = 1.0;
+        row[1] = 0.0;
+        for(int m = 1; m <= max_multiple; ++m) {
+            row[2 * m] = row[2 * m - 2] * cos_argument - row[2 * m - 1] * sin_argument;
+            row[2 * m + 1] = row[2 * m - 2] * sin_argument + row[2 * m - 1] * cos_argument;
+        }
+    }
+}
+
+/**
+ * @brief Cosine and sine of an integer combination of tabulated angles, built by complex multiplication.
+ */
+int argument_combination(const Real* table, const int* multipliers, int narguments, int max_multiple,
+    Real* cos_value, Real* sin_value) {
+
+    Real real = 1.0, imaginary = 0.0, power_real, power_imaginary, product;
+
+    for(int k = 0; k < narguments; ++k) {
+        int m = multipliers[k];
+        if(m == 0) continue;
+        if(m > max_multiple || m < -max_multiple) return 0;
+
+        /* Negative multiples are the conjugate of the positive ones */
+        const Real* power = table + 2 * (k * (max_multiple + 1) + (m < 0 ? -m : m));
+        power_real = power[0];
+        power_imaginary = m < 0 ? -power[1] : power[1];
+
+        product = real * power_real - imaginary * power_imaginary;
+        imaginary = real * power_imaginary + imaginary * power_real;
+        real = product;
+    }
+
+    *cos_value = real;
+    *sin_value = imaginary;
+    return 1;
+}
+
+/**
+ * @brief Evaluate a Chebyshev series at x in [-1, 1] using Clenshaw's recurrence.
+ */
+static Real chebyshev_evaluate(Real x, Real* coefficients, int ncoefficients) {
+
+    Real b0 = 0.0, b1 = 0.0, b2;
+    Real two_x = 2.0 * x;
+
+    for(int j = ncoefficients - 1; j > 0; --j) {
+        b2 = b1;
+        b1 = b0;
+        b0 = two_x * b1 - b2 + coefficients[j];
+    }
+
+    return x * b0 - b1 + coefficients[0];
+}
+
+/**
+ * @brief Fit a Chebyshev ephemeris of the nutation values of date to a series.
+ */
+int fit_nutation_ephemeris(NutationSeries* series, Real start, Real end, Real tolerance,
+    int degree, NutationEphemeris* ephemeris) {
+
+    int ncoefficients = degree + 1;
+    int nsegments = (int)ceil((end - start) / (4.0 * SECONDS_PER_DAY));
+    if(nsegments < 1) nsegments = 1;
+
+    Real* values = (Real*)malloc(3 * ncoefficients * sizeof(Real));
+    if(!values) return -1;
+
+    Real* coefficients = NULL;
+    Real interval, midpoint, half_interval, x, error, max_error, mean_obliquity_date;
+    Real fitted[3], expected[3];
+
+    while(1) {
+
+        free(coefficients);
+        coefficients = (Real*)malloc(nsegments * 3 * ncoefficients * sizeof(Real));
+        if(!coefficients) {
+            free(values);
+            return -1;
+        }
+
+        interval = (end - start) / nsegments;
+        half_interval = interval / 2.0;
+        max_error = 0.0;
+
+        for(int s = 0; s < nsegments; ++s) {
+
+            midpoint = start + (s + 0.5) * interval;
+            Real* segment = coefficients + s * 3 * ncoefficients;
+
+            /* Sample the series at the Chebyshev nodes of the segment */
+            for(int k = 0; k < ncoefficients; ++k) {
+                x = cos(M_PI * (k + 0.5) / ncoefficients);
+                nutation_values_of_date(midpoint + half_interval * x, series, &values[k],
+                    &values[ncoefficients + k], &mean_obliquity_date, &values[2 * ncoefficients + k]);
+            }
+
+            for(int q = 0; q < 3; ++q) {
+                for(int j = 0; j < ncoefficients; ++j) {
+                    Real sum = 0.0;
+                    for(int k = 0; k < ncoefficients; ++k) {
+                        sum += values[q * ncoefficients + k] * cos(M_PI * j * (k + 0.5) / ncoefficients);
+                    }
+                    segment[q * ncoefficients + j] = 2.0 * sum / ncoefficients;
+                }
+                segment[q * ncoefficients] *= 0.5;
+            }
+
+            /* Check the fit at the extrema of the highest order polynomial, which sit between the nodes */
+            for(int k = 0; k <= ncoefficients; ++k) {
+                x = cos(M_PI * k / ncoefficients);
+                nutation_values_of_date(midpoint + half_interval * x, series, &expected[0], &expected[1],
+                    &mean_obliquity_date, &expected[2]);
+                for(int q = 0; q < 3; ++q) {
+                    fitted[q] = chebyshev_evaluate(x, segment + q * ncoefficients, ncoefficients);
+                    error = fabs(fitted[q] - expected[q]);
+                    if(error > max_error) max_error = error;
+                }
+            }
+        }
+
+        if(max_error <= tolerance || half_interval < 60.0) break;
+        nsegments *= 2;
+    }
+
+    free(values);
+
+    ephemeris->start = start;
+    ephemeris->end = end;
+    ephemeris->interval = interval;
+    ephemeris->nsegments = nsegments;
+    ephemeris->ncoefficients = ncoefficients;
+    ephemeris->max_error = max_error;
+    ephemeris->coefficients = coefficients;
+
+    return max_error <= tolerance ? 0 : 1;
+}
+
+/**
+ * @brief Evaluate the nutation values of date from a Chebyshev ephemeris.
+ */
+int nutation_ephemeris_values_of_date(Real t, NutationEphemeris* ephemeris, Real* nutation_longitude,
+    Real* nutation_obliquity, Real* mean_obliquity_date, Real* equation_of_the_equinoxes) {
+
+    if(!ephemeris->coefficients || t < ephemeris->start || t > ephemeris->end) {
+        return 0;
+    }
+
+    int segment = (int)((t - ephemeris->start) / ephemeris->interval);
+    if(segment >= ephemeris->nsegments) segment = ephemeris->nsegments - 1;
+
+    int n = ephemeris->ncoefficients;
+    Real* coefficients = ephemeris->coefficients + segment * 3 * n;
+    Real x = 2.0 * (t - ephemeris->start - segment * ephemeris->interval) / ephemeris->interval - 1.0;
+
+    *nutation_longitude = chebyshev_evaluate(x, coefficients, n);
+    *nutation_obliquity = chebyshev_evaluate(x, coefficients + n, n);
+    *equation_of_the_equinoxes = chebyshev_evaluate(x, coefficients + 2 * n, n);
+
+    t = (t-J2000_UNIX_TIME)/ SECONDS_PER_JULIAN_CENTURY;
+    *mean_obliquity_date = ((((MEAN_OBLIQUITY_EARTH[5] * t + MEAN_OBLIQUITY_EARTH[4]) * t
+        + MEAN_OBLIQUITY_EARTH[3]) * t + MEAN_OBLIQUITY_EARTH[2]) * t + MEAN_OBLIQUITY_EARTH[1]) * t
+        + MEAN_OBLIQUITY_EARTH[0];
+
+    return 1;
+}
+
+/**
+ * @brief The largest of the amplitudes of a nutation term in arcseconds.
+ */
+static Real nutation_term_amplitude(NutationSeriesRecord* record) {
+
+    Real amplitude = fabs(record->S);
+    if(fabs(record->C) > amplitude) amplitude = fabs(record->C);
+    if(fabs(record->S_prime) > amplitude) amplitude = fabs(record->S_prime);
+    if(fabs(record->C_prime) > amplitude) amplitude = fabs(record->C_prime);
+    return amplitude;
+}
+
+/**
+ * @brief A term of a nutation series ranked by amplitude.
+ */
+typedef struct {
+    Real amplitude;
+    int index;
+} RankedNutationTerm;
+
+/**
+ * @brief Orders ranked terms by decreasing amplitude, then by series order.
+ */
+static int compare_ranked_nutation_terms(const void* left, const void* right) {
+
+    const RankedNutationTerm* a = (const RankedNutationTerm*)left;
+    const RankedNutationTerm* b = (const RankedNutationTerm*)right;
+
+    if(a->amplitude != b->amplitude) return a->amplitude > b->amplitude ? -1 : 1;
+    return a->index - b->index;
+}
+
+/**
+ * @brief Build a truncated copy of a nutation series keeping only its largest terms.
+ */
+int truncate_nutation_series(NutationSeries* series, Real threshold, int max_terms, NutationSeries* truncated,
+    Real* error_bound, Real* max_error) {
+
+    int nrecords = series->nrecords;
+    RankedNutationTerm* ranked = (RankedNutationTerm*)malloc((nrecords > 0 ? nrecords : 1) *
+        sizeof(RankedNutationTerm));
+    char* keep = (char*)calloc(nrecords > 0 ? nrecords : 1, sizeof(char));
+    if(!ranked || !keep) {
+        free(ranked);
+        free(keep);
+        return -1;
+    }
 
+    for(int i = 0; i < nrecords; ++i) {
+        ranked[i].amplitude = nutation_term_amplitude(&series->records[i]);
+        ranked[i].index = i;
+    }
+    qsort(ranked, nrecords, sizeof(RankedNutationTerm), compare_ranked_nutation_terms);
+
+    int nkept = 0;
+    while(nkept < nrecords && ranked[nkept].amplitude >= threshold && (max_terms <= 0 || nkept < max_terms)) {
+        keep[ranked[nkept++].index] = 1;
+    }
+    free(ranked);
+
+    NutationSeries remainder;
+    remainder.nrecords = 0;
+    remainder.nrecords_allocated = nrecords - nkept;
+    remainder.records = (NutationSeriesRecord*)malloc((remainder.nrecords_allocated > 0 ?
+        remainder.nrecords_allocated : 1) * sizeof(NutationSeriesRecord));
+    remainder.strategy = series->strategy;
+    remainder.ncolumns = 0;
+    remainder.column_stride = 0;
+    remainder.columns = NULL;
+    truncated->nrecords = 0;
+    truncated->nrecords_allocated = nkept;
+    truncated->records = (NutationSeriesRecord*)malloc((nkept > 0 ? nkept : 1) * sizeof(NutationSeriesRecord));
+    truncated->strategy = series->strategy;
+    truncated->ncolumns = 0;
+    truncated->column_stride = 0;
+    truncated->columns = NULL;
+    if(!remainder.records || !truncated->records) {
+        free(remainder.records);
+        free(truncated->records);
+        truncated->records = NULL;
+        free(keep);
+        return -1;
+    }
+
+    Real longitude_bound = 0.0, obliquity_bound = 0.0;
+    for(int i = 0; i < nrecords; ++i) {
+        if(keep[i]) {
+            truncated->records[truncated->nrecords++] = series->records[i];
+        } else {
+            remainder.records[remainder.nrecords++] = series->records[i];
+            longitude_bound += fabs(series->records[i].S) + fabs(series->records[i].S_dot) +
+                fabs(series->records[i].C_prime);
+            obliquity_bound += fabs(series->records[i].C) + fabs(series->records[i].C_dot) +
+                fabs(series->records[i].S_prime);
+        }
+    }
+    free(keep);
+
+    *error_bound = longitude_bound > obliquity_bound ? longitude_bound : obliquity_bound;
+
+    /* The difference from the full series is the series of dropped terms, so sample that directly */
+    *max_error = 0.0;
+    if(remainder.nrecords > 0) {
+        /* The remainder is private to this call, if its columns can not be built the extended loop samples it */
+        if(remainder.strategy == VectorizedNutationStrategy) nutation_series_columns(&remainder);
+        Real t, nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
+        Real first = J2000_UNIX_TIME - SECONDS_PER_JULIAN_CENTURY / 2.0;
+        int nsamples = 1024;
+        for(int i = 0; i <= nsamples; ++i) {
+            t = first + i * (SECONDS_PER_JULIAN_CENTURY / nsamples);
+            nutation_values_of_date(t, &remainder, &nutation_longitude, &nutation_obliquity, &mean_obliquity_date,
+                &equation_of_the_equinoxes);
+            if(fabs(nutation_longitude) > *max_error) *max_error = fabs(nutation_longitude);
+            if(fabs(nutation_obliquity) > *max_error) *max_error = fabs(nutation_obliquity);
+        }
+    }
+    free(remainder.records);
+    free(remainder.columns);
+
+    return 0;
 }
 
 /**
  * @brief Compute the nutation series.
  */
-void nutation_matrix(long double mean_obliquity_date, long double nutation_longitude, long double true_obliquity_date,
+void nutation_matrix(Real mean_obliquity_date, Real nutation_longitude, Real true_obliquity_date,
     Mat3* nutation_matrix) {
 
-    long double sin_delta_psi, cos_delta_psi, sin_epsilon_prime, cos_epsilon_prime, sin_epsilon, cos_epsilon;
+    Real sin_delta_psi, cos_delta_psi, sin_epsilon_prime, cos_epsilon_prime, sin_epsilon, cos_epsilon;
 
-    sin_epsilon = sinl(mean_obliquity_date * ARCSECONDS_TO_RADIANS);
-    cos_epsilon = cosl(mean_obliquity_date * ARCSECONDS_TO_RADIANS);
-    sin_delta_psi = -1 * sinl(nutation_longitude * ARCSECONDS_TO_RADIANS);
-    cos_delta_psi = cosl(nutation_longitude * ARCSECONDS_TO_RADIANS);
-    sin_epsilon_prime = -1 * sinl(true_obliquity_date * ARCSECONDS_TO_RADIANS);
-    cos_epsilon_prime = cosl(true_obliquity_date * ARCSECONDS_TO_RADIANS);
+    sin_epsilon = sin(mean_obliquity_date * ARCSECONDS_TO_RADIANS);
+    cos_epsilon = cos(mean_obliquity_date * ARCSECONDS_TO_RADIANS);
+    sin_delta_psi = -1 * sin(nutation_longitude * ARCSECONDS_TO_RADIANS);
+    cos_delta_psi = cos(nutation_longitude * ARCSECONDS_TO_RADIANS);
+    sin_epsilon_prime = -1 * sin(true_obliquity_date * ARCSECONDS_TO_RADIANS);
+    cos_epsilon_prime = cos(true_obliquity_date * ARCSECONDS_TO_RADIANS);
 
     if(nutation_matrix) {
         nutation_matrix->w11 = cos_delta_psi;
@@ -193,17 +559,10 @@ static PyObject* nutation_series_add_record(PyObject* self, PyObject* args) {
         return NULL;
     }
 
-    if (table->nrecords_allocated < table->nrecords+1) {
-        table->nrecords_allocated += 1365;
-        NutationSeriesRecord* new_table = (NutationSeriesRecord*)malloc(table->nrecords_allocated *
-            sizeof(NutationSeriesRecord));
-        if(!new_table) {
-            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for NutationSeries records.");
-            return NULL;
-        }
-        memcpy(new_table, table->records, table->nrecords * sizeof(NutationSeriesRecord));
-        free(table->records);
-        table->records = new_table;
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + 1LL,
+        sizeof(NutationSeriesRecord)) != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for NutationSeries records.");
+        return NULL;
     }
 
     table->records[table->nrecords].heliocentric_elliptical_longitude_mercury_coefficient = a;
@@ -220,12 +579,80 @@ static PyObject* nutation_series_add_record(PyObject* self, PyObject* args) {
     table->records[table->nrecords].mean_argument_of_latitude_moon_coefficient = n;
     table->records[table->nrecords].mean_elongation_moon_from_the_sun_coefficient = o;
     table->records[table->nrecords].mean_longitude_of_moon_mean_ascending_node_coefficient = r;
-    table->records[table->nrecords].S = (long double)S;
-    table->records[table->nrecords].S_dot = (long double)S_dot;
-    table->records[table->nrecords].C_prime = (long double)C_prime;
-    table->records[table->nrecords].C = (long double)C;
-    table->records[table->nrecords].C_dot = (long double)C_dot;
-    table->records[table->nrecords++].S_prime = (long double)S_prime;
+    table->records[table->nrecords].S = (Real)S;
+    table->records[table->nrecords].S_dot = (Real)S_dot;
+    table->records[table->nrecords].C_prime = (Real)C_prime;
+    table->records[table->nrecords].C = (Real)C;
+    table->records[table->nrecords].C_dot = (Real)C_dot;
+    table->records[table->nrecords++].S_prime = (Real)S_prime;
+
+    return Py_BuildValue("i", table->nrecords);
+}
+
+/**
+ * @brief Add a buffer of records to the nutation series, reserving room for all of them at once.
+ */
+static PyObject* nutation_series_add_records(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* rows_obj;
+    NutationSeries* table;
+    Py_buffer rows;
+    Py_ssize_t nvalues;
+
+    if(!PyArg_ParseTuple(args, "OO", &capsule, &rows_obj)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. add_records()");
+        return NULL;
+    }
+
+    table = (NutationSeries*)PyCapsule_GetPointer(capsule, "NutationSeries");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the NutationSeries from capsule.");
+        return NULL;
+    }
+
+    if(get_double_buffer(rows_obj, &rows, 0, &nvalues) < 0) {
+        return NULL;
+    }
+
+    if(nvalues % NUTATION_RECORD_NVALUES != 0) {
+        PyBuffer_Release(&rows);
+        PyErr_Format(PyExc_ValueError, "add_records() expects N*%d values.", NUTATION_RECORD_NVALUES);
+        return NULL;
+    }
+
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated,
+        table->nrecords + (long long)nvalues / NUTATION_RECORD_NVALUES, sizeof(NutationSeriesRecord)) != 0) {
+        PyBuffer_Release(&rows);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for NutationSeries records.");
+        return NULL;
+    }
+
+    const double* row = (const double*)rows.buf;
+    for(Py_ssize_t i = 0; i < nvalues; i += NUTATION_RECORD_NVALUES, row += NUTATION_RECORD_NVALUES) {
+        NutationSeriesRecord* record = &table->records[table->nrecords++];
+        record->heliocentric_elliptical_longitude_mercury_coefficient = (int)row[0];
+        record->heliocentric_elliptical_longitude_venus_coefficient = (int)row[1];
+        record->heliocentric_elliptical_longitude_earth_coefficient = (int)row[2];
+        record->heliocentric_elliptical_longitude_mars_coefficient = (int)row[3];
+        record->heliocentric_elliptical_longitude_jupiter_coefficient = (int)row[4];
+        record->heliocentric_elliptical_longitude_saturn_coefficient = (int)row[5];
+        record->heliocentric_elliptical_longitude_uranus_coefficient = (int)row[6];
+        record->heliocentric_elliptical_longitude_neptune_coefficient = (int)row[7];
+        record->general_precession_in_longitude_coefficient = (int)row[8];
+        record->mean_anomaly_moon_coefficient = (int)row[9];
+        record->mean_anomaly_sun_coefficient = (int)row[10];
+        record->mean_argument_of_latitude_moon_coefficient = (int)row[11];
+        record->mean_elongation_moon_from_the_sun_coefficient = (int)row[12];
+        record->mean_longitude_of_moon_mean_ascending_node_coefficient = (int)row[13];
+        record->S = (Real)row[14];
+        record->S_dot = (Real)row[15];
+        record->C_prime = (Real)row[16];
+        record->C = (Real)row[17];
+        record->C_dot = (Real)row[18];
+        record->S_prime = (Real)row[19];
+    }
+    PyBuffer_Release(&rows);
 
     return Py_BuildValue("i", table->nrecords);
 }
@@ -245,6 +672,10 @@ static PyObject* new_NutationSeries(PyObject* self, PyObject* args) {
     table->nrecords = 0;
     table->nrecords_allocated = 0;
     table->records = NULL;
+    table->strategy = DEFAULT_NUTATION_STRATEGY;
+    table->ncolumns = 0;
+    table->column_stride = 0;
+    table->columns = NULL;
 
     return PyCapsule_New(table, "NutationSeries", delete_NutationSeries);
 }
@@ -257,14 +688,308 @@ static void delete_NutationSeries(PyObject* obj) {
     NutationSeries* table = (NutationSeries*)PyCapsule_GetPointer(obj, "NutationSeries");
     if(table) {
         if(table->records) free(table->records);
+        if(table->columns) free(table->columns);
         free(table);
     }
 }
 
+/**
+ * @brief Set how a nutation series is evaluated.
+ */
+static PyObject* set_nutation_strategy(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    NutationSeries* series;
+    int strategy;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &strategy)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_nutation_strategy()");
+        return NULL;
+    }
+
+    if(strategy < ExtendedNutationStrategy || strategy > RecurrenceNutationStrategy) {
+        PyErr_SetString(PyExc_ValueError, "Unknown nutation strategy.");
+        return NULL;
+    }
+
+    series = (NutationSeries*)PyCapsule_GetPointer(capsule, "NutationSeries");
+    if(!series) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the NutationSeries from capsule.");
+        return NULL;
+    }
+
+    series->strategy = (NutationStrategy)strategy;
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the double precision kernel in use and the best kernel the CPU supports.
+ */
+static PyObject* get_nutation_kernel(PyObject* self, PyObject* args) {
+    return Py_BuildValue("ii", (int)nutation_kernel(), (int)nutation_kernel_supported());
+}
+
+/**
+ * @brief Force the double precision kernel this module evaluates nutation series with.
+ */
+static PyObject* nutation_set_kernel(PyObject* self, PyObject* args) {
+
+    int kernel;
+
+    if(!PyArg_ParseTuple(args, "i", &kernel)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_nutation_kernel()");
+        return NULL;
+    }
+
+    if(set_nutation_kernel((NutationKernel)kernel) < 0) {
+        PyErr_SetString(PyExc_ValueError, "The nutation kernel is not supported by this CPU.");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Get the number of terms in a nutation series.
+ */
+static PyObject* nutation_series_size(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    NutationSeries* series;
+
+    if(!PyArg_ParseTuple(args, "O", &capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. nutation_series_size()");
+        return NULL;
+    }
+
+    series = (NutationSeries*)PyCapsule_GetPointer(capsule, "NutationSeries");
+    if(!series) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the NutationSeries from capsule.");
+        return NULL;
+    }
+
+    return Py_BuildValue("i", series->nrecords);
+}
+
+/**
+ * @brief Build the columns a vectorized series fills in lazily, so the series can be evaluated with the GIL released.
+ */
+static int prepare_nutation_series(NutationSeries* series) {
+
+    nutation_kernel();
+    if(series->strategy == VectorizedNutationStrategy) {
+        return nutation_series_columns(series);
+    }
+    return 0;
+}
+
+/**
+ * @brief Create a truncated copy of a nutation series or an Earth model's series.
+ */
+static PyObject* truncate_NutationSeries(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    NutationSeries* series;
+    double threshold;
+    int max_terms;
+    Real error_bound, max_error;
+
+    if(!PyArg_ParseTuple(args, "Odi", &capsule, &threshold, &max_terms)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. truncate_NutationSeries()");
+        return NULL;
+    }
+
+    if(PyCapsule_IsValid(capsule, "EarthModel")) {
+        series = &((EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel"))->nutation_series;
+    } else if(PyCapsule_IsValid(capsule, "NutationSeries")) {
+        series = (NutationSeries*)PyCapsule_GetPointer(capsule, "NutationSeries");
+    } else {
+        PyErr_SetString(PyExc_TypeError, "Expected a NutationSeries or EarthModel capsule.");
+        return NULL;
+    }
+
+    NutationSeries* truncated = (NutationSeries*)malloc(sizeof(NutationSeries));
+    if(!truncated) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for truncate_NutationSeries.");
+        return NULL;
+    }
+
+    int retval;
+    Py_BEGIN_ALLOW_THREADS
+    retval = truncate_nutation_series(series, threshold, max_terms, truncated, &error_bound, &max_error);
+    Py_END_ALLOW_THREADS
+
+    if(retval < 0) {
+        free(truncated);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for NutationSeries records.");
+        return NULL;
+    }
+
+    PyObject* truncated_capsule = PyCapsule_New(truncated, "NutationSeries", delete_NutationSeries);
+    if(!truncated_capsule) {
+        free(truncated->records);
+        free(truncated);
+        return NULL;
+    }
+
+    return Py_BuildValue("Ndd", truncated_capsule, (double)error_bound, (double)max_error);
+}
+
+/**
+ * @brief Create a new nutation ephemeris fitted to a nutation series or an Earth model's series.
+ */
+static PyObject* new_NutationEphemeris(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    NutationSeries* series;
+    double start, end, tolerance;
+    int degree;
+
+    if(!PyArg_ParseTuple(args, "Odddi", &capsule, &start, &end, &tolerance, &degree)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. new_NutationEphemeris()");
+        return NULL;
+    }
+
+    if(PyCapsule_IsValid(capsule, "EarthModel")) {
+        series = &((EarthModel*)PyCapsule_GetPointer(capsule, "EarthModel"))->nutation_series;
+    } else if(PyCapsule_IsValid(capsule, "NutationSeries")) {
+        series = (NutationSeries*)PyCapsule_GetPointer(capsule, "NutationSeries");
+    } else {
+        PyErr_SetString(PyExc_TypeError, "Expected a NutationSeries or EarthModel capsule.");
+        return NULL;
+    }
+
+    if(!(end > start) || !(tolerance > 0.0) || degree < 1) {
+        PyErr_SetString(PyExc_ValueError, "The ephemeris needs end > start, a positive tolerance and degree >= 1.");
+        return NULL;
+    }
+
+    if(series->nrecords == 0) {
+        PyErr_SetString(PyExc_ValueError, "Can not fit a nutation ephemeris to an empty series.");
+        return NULL;
+    }
+
+    NutationEphemeris* ephemeris = (NutationEphemeris*)malloc(sizeof(NutationEphemeris));
+    if(!ephemeris) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_NutationEphemeris.");
+        return NULL;
+    }
+
+    int retval = prepare_nutation_series(series);
+    if(retval == 0) {
+        Py_BEGIN_ALLOW_THREADS
+        retval = fit_nutation_ephemeris(series, start, end, tolerance, degree, ephemeris);
+        Py_END_ALLOW_THREADS
+    }
+
+    if(retval < 0) {
+        free(ephemeris);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for NutationEphemeris coefficients.");
+        return NULL;
+    }
+
+    return PyCapsule_New(ephemeris, "NutationEphemeris", delete_NutationEphemeris);
+}
+
+/**
+ * @brief Delete a nutation ephemeris object available in Python.
+ */
+static void delete_NutationEphemeris(PyObject* obj) {
+
+    NutationEphemeris* ephemeris = (NutationEphemeris*)PyCapsule_GetPointer(obj, "NutationEphemeris");
+    if(ephemeris) {
+        if(ephemeris->coefficients) free(ephemeris->coefficients);
+        free(ephemeris);
+    }
+}
+
+/**
+ * @brief Get the span, number of segments, degree and fitting error of a nutation ephemeris.
+ */
+static PyObject* nutation_ephemeris_info(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    NutationEphemeris* ephemeris;
+
+    if(!PyArg_ParseTuple(args, "O", &capsule)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. nutation_ephemeris_info()");
+        return NULL;
+    }
+
+    ephemeris = (NutationEphemeris*)PyCapsule_GetPointer(capsule, "NutationEphemeris");
+    if(!ephemeris) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the NutationEphemeris from capsule.");
+        return NULL;
+    }
+
+    return Py_BuildValue("ddiid", (double)ephemeris->start, (double)ephemeris->end, ephemeris->nsegments,
+        ephemeris->ncoefficients - 1, (double)ephemeris->max_error);
+}
+
+/**
+ * @brief Get the nutation values of date from a nutation series or a nutation ephemeris.
+ */
+static PyObject* get_nutation_values(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    double t;
+    Real nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
+
+    if(!PyArg_ParseTuple(args, "Od", &capsule, &t)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. get_nutation_values()");
+        return NULL;
+    }
+
+    if(PyCapsule_IsValid(capsule, "NutationEphemeris")) {
+        NutationEphemeris* ephemeris = (NutationEphemeris*)PyCapsule_GetPointer(capsule, "NutationEphemeris");
+        int found;
+        Py_BEGIN_ALLOW_THREADS
+        found = nutation_ephemeris_values_of_date(t, ephemeris, &nutation_longitude, &nutation_obliquity,
+            &mean_obliquity_date, &equation_of_the_equinoxes);
+        Py_END_ALLOW_THREADS
+        if(!found) {
+            PyErr_SetString(PyExc_ValueError, "Time is outside the span of the NutationEphemeris.");
+            return NULL;
+        }
+    } else if(PyCapsule_IsValid(capsule, "NutationSeries")) {
+        NutationSeries* series = (NutationSeries*)PyCapsule_GetPointer(capsule, "NutationSeries");
+        if(prepare_nutation_series(series) != 0) {
+            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for the NutationSeries columns.");
+            return NULL;
+        }
+        Py_BEGIN_ALLOW_THREADS
+        nutation_values_of_date(t, series, &nutation_longitude, &nutation_obliquity, &mean_obliquity_date,
+            &equation_of_the_equinoxes);
+        Py_END_ALLOW_THREADS
+    } else {
+        PyErr_SetString(PyExc_TypeError, "Expected a NutationSeries or NutationEphemeris capsule.");
+        return NULL;
+    }
+
+    return Py_BuildValue("dddd", (double)nutation_longitude, (double)nutation_obliquity, (double)mean_obliquity_date,
+        (double)equation_of_the_equinoxes);
+}
+
 
 static PyMethodDef tolueneModelsEarthNutationMethods[] = {
     {"add_record", nutation_series_add_record, METH_VARARGS, "Add a record to the NutationSeries"},
+    {"add_records", nutation_series_add_records, METH_VARARGS,
+        "Add a buffer of records to the NutationSeries, N rows of the add_record values"},
     {"new_NutationSeries", new_NutationSeries, METH_VARARGS, "Create a new NutationSeries"},
+    {"set_nutation_strategy", set_nutation_strategy, METH_VARARGS, "Set how a NutationSeries is evaluated"},
+    {"get_nutation_kernel", get_nutation_kernel, METH_VARARGS,
+        "Get the nutation kernel in use and the best kernel the CPU supports"},
+    {"set_nutation_kernel", nutation_set_kernel, METH_VARARGS, "Force the nutation kernel this module uses"},
+    {"nutation_series_size", nutation_series_size, METH_VARARGS, "Get the number of terms in a NutationSeries"},
+    {"truncate_NutationSeries", truncate_NutationSeries, METH_VARARGS,
+        "Create a truncated copy of a NutationSeries or an EarthModel's series"},
+    {"new_NutationEphemeris", new_NutationEphemeris, METH_VARARGS,
+        "Fit a new NutationEphemeris to a NutationSeries or EarthModel"},
+    {"nutation_ephemeris_info", nutation_ephemeris_info, METH_VARARGS,
+        "Get the span, segments, degree and fitting error of a NutationEphemeris"},
+    {"get_nutation_values", get_nutation_values, METH_VARARGS,
+        "Get the nutation values of date from a NutationSeries or NutationEphemeris"},
     {NULL, NULL, 0, NULL}
 };
 
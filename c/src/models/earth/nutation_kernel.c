@@ -0,0 +1,372 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define __compile_models_earth_nutation_kernel__
+#include "models/earth/nutation_kernel.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NUTATION_KERNEL_X86
+#include <immintrin.h>
+#endif /* __GNUC__ && x86 */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/* Cody-Waite split of pi/2 and the sine and cosine kernels on [-pi/4, pi/4], from fdlibm. */
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050650619224932e-11
+#define PIO2_3 2.02226624879595063154e-21
+#define TWO_OVER_PI 6.36619772367581382433e-01
+#define SIN_1 -1.66666666666666324348e-01
+#define SIN_2 8.33333333332248946124e-03
+#define SIN_3 -1.98412698298579493134e-04
+#define SIN_4 2.75573137070700676789e-06
+#define SIN_5 -2.50507602534068634195e-08
+#define SIN_6 1.58969099521155010221e-10
+#define COS_1 4.16666666666666019037e-02
+#define COS_2 -1.38888888888741095749e-03
+#define COS_3 2.48015872894767294178e-05
+#define COS_4 -2.75573143513906633035e-07
+#define COS_5 2.08757232129817482790e-09
+#define COS_6 -1.13596475577881948265e-11
+
+/* Adding this to a double holding an integer below 2^51 leaves the integer in the low bits of the mantissa. */
+#define ROUNDING_MAGIC 6755399441055744.0
+
+static NutationKernel selected_kernel = 0;
+
+/**
+ * @brief Check whether the double precision columns of a nutation series match its records.
+ */
+int nutation_series_columns_current(const NutationSeries* series) {
+    return series->columns && series->ncolumns == series->nrecords;
+}
+
+/**
+ * @brief Bring the double precision columns of a nutation series up to date with its records.
+ */
+int nutation_series_columns(NutationSeries* series) {
+
+    if(nutation_series_columns_current(series)) {
+        return 0;
+    }
+
+    int stride = (series->nrecords + 7) & ~7;
+    double* columns = (double*)calloc((stride > 0 ? stride : 8) * NUTATION_SERIES_NCOLUMNS, sizeof(double));
+    if(!columns) return -1;
+
+    for(int i = 0; i < series->nrecords; ++i) {
+        NutationSeriesRecord* record = &series->records[i];
+        columns[0 * stride + i] = record->heliocentric_elliptical_longitude_mercury_coefficient;
+        columns[1 * stride + i] = record->heliocentric_elliptical_longitude_venus_coefficient;
+        columns[2 * stride + i] = record->heliocentric_elliptical_longitude_earth_coefficient;
+        columns[3 * stride + i] = record->heliocentric_elliptical_longitude_mars_coefficient;
+        columns[4 * stride + i] = record->heliocentric_elliptical_longitude_jupiter_coefficient;
+        columns[5 * stride + i] = record->heliocentric_elliptical_longitude_saturn_coefficient;
+        columns[6 * stride + i] = record->heliocentric_elliptical_longitude_uranus_coefficient;
+        columns[7 * stride + i] = record->heliocentric_elliptical_longitude_neptune_coefficient;
+        columns[8 * stride + i] = record->general_precession_in_longitude_coefficient;
+        columns[9 * stride + i] = record->mean_anomaly_moon_coefficient;
+        columns[10 * stride + i] = record->mean_anomaly_sun_coefficient;
+        columns[11 * stride + i] = record->mean_argument_of_latitude_moon_coefficient;
+        columns[12 * stride + i] = record->mean_elongation_moon_from_the_sun_coefficient;
+        columns[13 * stride + i] = record->mean_longitude_of_moon_mean_ascending_node_coefficient;
+        columns[14 * stride + i] = (double)record->S;
+        columns[15 * stride + i] = (double)record->S_dot;
+        columns[16 * stride + i] = (double)record->C_prime;
+        columns[17 * stride + i] = (double)record->C;
+        columns[18 * stride + i] = (double)record->C_dot;
+        columns[19 * stride + i] = (double)record->S_prime;
+    }
+
+    free(series->columns);
+    series->columns = columns;
+    series->column_stride = stride;
+    series->ncolumns = series->nrecords;
+
+    return 0;
+}
+
+/**
+ * @brief Sum the nutation terms one at a time with the C library's sine and cosine.
+ */
+static void nutation_kernel_sum_scalar(const double* columns, int stride, const double* arguments, double t,
+    double* sums) {
+
+    double nutation_longitude = 0.0, nutation_obliquity = 0.0, equation_of_the_equinoxes = 0.0;
+    double argument, sin_argument, cos_argument;
+
+    for(int i = 0; i < stride; ++i) {
+        argument = 0.0;
+        for(int k = 0; k < 14; ++k) {
+            argument += columns[k * stride + i] * arguments[k];
+        }
+        sin_argument = sin(argument);
+        cos_argument = cos(argument);
+
+        nutation_longitude += (columns[14 * stride + i] + columns[15 * stride + i] * t) * sin_argument +
+            columns[16 * stride + i] * cos_argument;
+        nutation_obliquity += (columns[17 * stride + i] + columns[18 * stride + i] * t) * cos_argument +
+            columns[19 * stride + i] * sin_argument;
+        equation_of_the_equinoxes += columns[16 * stride + i] * sin_argument +
+            columns[19 * stride + i] * cos_argument;
+    }
+
+    sums[0] = nutation_longitude;
+    sums[1] = nutation_obliquity;
+    sums[2] = equation_of_the_equinoxes;
+}
+
+#ifdef NUTATION_KERNEL_X86
+
+/**
+ * @brief Sum the nutation terms four at a time with AVX2 and FMA.
+ */
+__attribute__((target("avx2,fma")))
+static void nutation_kernel_sum_avx2(const double* columns, int stride, const double* arguments, double t,
+    double* sums) {
+
+    __m256d nutation_longitude = _mm256_setzero_pd();
+    __m256d nutation_obliquity = _mm256_setzero_pd();
+    __m256d equation_of_the_equinoxes = _mm256_setzero_pd();
+    __m256d time = _mm256_set1_pd(t);
+    __m256d fundamental[14];
+    for(int k = 0; k < 14; ++k) {
+        fundamental[k] = _mm256_set1_pd(arguments[k]);
+    }
+
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i two = _mm256_set1_epi64x(2);
+
+    for(int i = 0; i < stride; i += 4) {
+
+        __m256d argument = _mm256_setzero_pd();
+        for(int k = 0; k < 14; ++k) {
+            argument = _mm256_fmadd_pd(_mm256_loadu_pd(columns + k * stride + i), fundamental[k], argument);
+        }
+
+        /* Reduce to [-pi/4, pi/4] keeping the quadrant */
+        __m256d quadrant = _mm256_round_pd(_mm256_mul_pd(argument, _mm256_set1_pd(TWO_OVER_PI)),
+            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256d r = _mm256_fnmadd_pd(quadrant, _mm256_set1_pd(PIO2_1), argument);
+        r = _mm256_fnmadd_pd(quadrant, _mm256_set1_pd(PIO2_2), r);
+        r = _mm256_fnmadd_pd(quadrant, _mm256_set1_pd(PIO2_3), r);
+        __m256i q = _mm256_castpd_si256(_mm256_add_pd(quadrant, _mm256_set1_pd(ROUNDING_MAGIC)));
+
+        __m256d z = _mm256_mul_pd(r, r);
+        __m256d sin_r = _mm256_fmadd_pd(z, _mm256_set1_pd(SIN_6), _mm256_set1_pd(SIN_5));
+        sin_r = _mm256_fmadd_pd(z, sin_r, _mm256_set1_pd(SIN_4));
+        sin_r = _mm256_fmadd_pd(z, sin_r, _mm256_set1_pd(SIN_3));
+        sin_r = _mm256_fmadd_pd(z, sin_r, _mm256_set1_pd(SIN_2));
+        sin_r = _mm256_fmadd_pd(z, sin_r, _mm256_set1_pd(SIN_1));
+        sin_r = _mm256_fmadd_pd(_mm256_mul_pd(z, r), sin_r, r);
+        __m256d cos_r = _mm256_fmadd_pd(z, _mm256_set1_pd(COS_6), _mm256_set1_pd(COS_5));
+        cos_r = _mm256_fmadd_pd(z, cos_r, _mm256_set1_pd(COS_4));
+        cos_r = _mm256_fmadd_pd(z, cos_r, _mm256_set1_pd(COS_3));
+        cos_r = _mm256_fmadd_pd(z, cos_r, _mm256_set1_pd(COS_2));
+        cos_r = _mm256_fmadd_pd(z, cos_r, _mm256_set1_pd(COS_1));
+        cos_r = _mm256_fmadd_pd(_mm256_mul_pd(z, z), cos_r,
+            _mm256_fnmadd_pd(_mm256_set1_pd(0.5), z, _mm256_set1_pd(1.0)));
+
+        /* Odd quadrants swap sine and cosine, quadrants 2 and 3 negate the sine, 1 and 2 negate the cosine */
+        __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+        __m256d sin_argument = _mm256_blendv_pd(sin_r, cos_r, swap);
+        __m256d cos_argument = _mm256_blendv_pd(cos_r, sin_r, swap);
+        sin_argument = _mm256_xor_pd(sin_argument,
+            _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, two), 62)));
+        cos_argument = _mm256_xor_pd(cos_argument,
+            _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(_mm256_add_epi64(q, one), two), 62)));
+
+        __m256d S = _mm256_loadu_pd(columns + 14 * stride + i);
+        __m256d S_dot = _mm256_loadu_pd(columns + 15 * stride + i);
+        __m256d C_prime = _mm256_loadu_pd(columns + 16 * stride + i);
+        __m256d C = _mm256_loadu_pd(columns + 17 * stride + i);
+        __m256d C_dot = _mm256_loadu_pd(columns + 18 * stride + i);
+        __m256d S_prime = _mm256_loadu_pd(columns + 19 * stride + i);
+
+        nutation_longitude = _mm256_fmadd_pd(_mm256_fmadd_pd(S_dot, time, S), sin_argument, nutation_longitude);
+        nutation_longitude = _mm256_fmadd_pd(C_prime, cos_argument, nutation_longitude);
+        nutation_obliquity = _mm256_fmadd_pd(_mm256_fmadd_pd(C_dot, time, C), cos_argument, nutation_obliquity);
+        nutation_obliquity = _mm256_fmadd_pd(S_prime, sin_argument, nutation_obliquity);
+        equation_of_the_equinoxes = _mm256_fmadd_pd(C_prime, sin_argument, equation_of_the_equinoxes);
+        equation_of_the_equinoxes = _mm256_fmadd_pd(S_prime, cos_argument, equation_of_the_equinoxes);
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, nutation_longitude);
+    sums[0] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm256_storeu_pd(lanes, nutation_obliquity);
+    sums[1] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    _mm256_storeu_pd(lanes, equation_of_the_equinoxes);
+    sums[2] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+/**
+ * @brief Sum the nutation terms eight at a time with AVX-512.
+ */
+__attribute__((target("avx512f")))
+static void nutation_kernel_sum_avx512(const double* columns, int stride, const double* arguments, double t,
+    double* sums) {
+
+    __m512d nutation_longitude = _mm512_setzero_pd();
+    __m512d nutation_obliquity = _mm512_setzero_pd();
+    __m512d equation_of_the_equinoxes = _mm512_setzero_pd();
+    __m512d time = _mm512_set1_pd(t);
+    __m512d fundamental[14];
+    for(int k = 0; k < 14; ++k) {
+        fundamental[k] = _mm512_set1_pd(arguments[k]);
+    }
+
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i two = _mm512_set1_epi64(2);
+
+    for(int i = 0; i < stride; i += 8) {
+
+        __m512d argument = _mm512_setzero_pd();
+        for(int k = 0; k < 14; ++k) {
+            argument = _mm512_fmadd_pd(_mm512_loadu_pd(columns + k * stride + i), fundamental[k], argument);
+        }
+
+        /* Reduce to [-pi/4, pi/4] keeping the quadrant */
+        __m512d quadrant = _mm512_roundscale_pd(_mm512_mul_pd(argument, _mm512_set1_pd(TWO_OVER_PI)),
+            _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m512d r = _mm512_fnmadd_pd(quadrant, _mm512_set1_pd(PIO2_1), argument);
+        r = _mm512_fnmadd_pd(quadrant, _mm512_set1_pd(PIO2_2), r);
+        r = _mm512_fnmadd_pd(quadrant, _mm512_set1_pd(PIO2_3), r);
+        __m512i q = _mm512_castpd_si512(_mm512_add_pd(quadrant, _mm512_set1_pd(ROUNDING_MAGIC)));
+
+        __m512d z = _mm512_mul_pd(r, r);
+        __m512d sin_r = _mm512_fmadd_pd(z, _mm512_set1_pd(SIN_6), _mm512_set1_pd(SIN_5));
+        sin_r = _mm512_fmadd_pd(z, sin_r, _mm512_set1_pd(SIN_4));
+        sin_r = _mm512_fmadd_pd(z, sin_r, _mm512_set1_pd(SIN_3));
+        sin_r = _mm512_fmadd_pd(z, sin_r, _mm512_set1_pd(SIN_2));
+        sin_r = _mm512_fmadd_pd(z, sin_r, _mm512_set1_pd(SIN_1));
+        sin_r = _mm512_fmadd_pd(_mm512_mul_pd(z, r), sin_r, r);
+        __m512d cos_r = _mm512_fmadd_pd(z, _mm512_set1_pd(COS_6), _mm512_set1_pd(COS_5));
+        cos_r = _mm512_fmadd_pd(z, cos_r, _mm512_set1_pd(COS_4));
+        cos_r = _mm512_fmadd_pd(z, cos_r, _mm512_set1_pd(COS_3));
+        cos_r = _mm512_fmadd_pd(z, cos_r, _mm512_set1_pd(COS_2));
+        cos_r = _mm512_fmadd_pd(z, cos_r, _mm512_set1_pd(COS_1));
+        cos_r = _mm512_fmadd_pd(_mm512_mul_pd(z, z), cos_r,
+            _mm512_fnmadd_pd(_mm512_set1_pd(0.5), z, _mm512_set1_pd(1.0)));
+
+        /* Odd quadrants swap sine and cosine, quadrants 2 and 3 negate the sine, 1 and 2 negate the cosine */
+        __mmask8 swap = _mm512_test_epi64_mask(q, one);
+        __m512d sin_argument = _mm512_mask_blend_pd(swap, sin_r, cos_r);
+        __m512d cos_argument = _mm512_mask_blend_pd(swap, cos_r, sin_r);
+        sin_argument = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(sin_argument),
+            _mm512_slli_epi64(_mm512_and_si512(q, two), 62)));
+        cos_argument = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(cos_argument),
+            _mm512_slli_epi64(_mm512_and_si512(_mm512_add_epi64(q, one), two), 62)));
+
+        __m512d S = _mm512_loadu_pd(columns + 14 * stride + i);
+        __m512d S_dot = _mm512_loadu_pd(columns + 15 * stride + i);
+        __m512d C_prime = _mm512_loadu_pd(columns + 16 * stride + i);
+        __m512d C = _mm512_loadu_pd(columns + 17 * stride + i);
+        __m512d C_dot = _mm512_loadu_pd(columns + 18 * stride + i);
+        __m512d S_prime = _mm512_loadu_pd(columns + 19 * stride + i);
+
+        nutation_longitude = _mm512_fmadd_pd(_mm512_fmadd_pd(S_dot, time, S), sin_argument, nutation_longitude);
+        nutation_longitude = _mm512_fmadd_pd(C_prime, cos_argument, nutation_longitude);
+        nutation_obliquity = _mm512_fmadd_pd(_mm512_fmadd_pd(C_dot, time, C), cos_argument, nutation_obliquity);
+        nutation_obliquity = _mm512_fmadd_pd(S_prime, sin_argument, nutation_obliquity);
+        equation_of_the_equinoxes = _mm512_fmadd_pd(C_prime, sin_argument, equation_of_the_equinoxes);
+        equation_of_the_equinoxes = _mm512_fmadd_pd(S_prime, cos_argument, equation_of_the_equinoxes);
+    }
+
+    sums[0] = _mm512_reduce_add_pd(nutation_longitude);
+    sums[1] = _mm512_reduce_add_pd(nutation_obliquity);
+    sums[2] = _mm512_reduce_add_pd(equation_of_the_equinoxes);
+}
+
+#endif /* NUTATION_KERNEL_X86 */
+
+/**
+ * @brief Get the best kernel the CPU supports.
+ */
+NutationKernel nutation_kernel_supported(void) {
+
+#ifdef NUTATION_KERNEL_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f")) return AVX512NutationKernel;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return AVX2NutationKernel;
+#endif /* NUTATION_KERNEL_X86 */
+
+    return ScalarNutationKernel;
+}
+
+/**
+ * @brief Get the kernel sums are currently computed with.
+ */
+NutationKernel nutation_kernel(void) {
+
+    if(!selected_kernel) {
+        selected_kernel = nutation_kernel_supported();
+    }
+    return selected_kernel;
+}
+
+/**
+ * @brief Force the kernel sums are computed with, used to compare kernels against one another.
+ */
+int set_nutation_kernel(NutationKernel kernel) {
+
+    if(kernel < ScalarNutationKernel || kernel > nutation_kernel_supported()) {
+        return -1;
+    }
+    selected_kernel = kernel;
+    return 0;
+}
+
+/**
+ * @brief Sum the nutation terms held in a series' columns.
+ */
+void nutation_kernel_sum(NutationSeries* series, const double* arguments, double t, double* sums) {
+
+    switch(nutation_kernel()) {
+#ifdef NUTATION_KERNEL_X86
+        case AVX512NutationKernel:
+            nutation_kernel_sum_avx512(series->columns, series->column_stride, arguments, t, sums);
+            break;
+        case AVX2NutationKernel:
+            nutation_kernel_sum_avx2(series->columns, series->column_stride, arguments, t, sums);
+            break;
+#endif /* NUTATION_KERNEL_X86 */
+        default:
+            nutation_kernel_sum_scalar(series->columns, series->column_stride, arguments, t, sums);
+            break;
+    }
+}
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
@@ -47,21 +47,34 @@ extern "C"
  * @param t Time in seconds since J2000.0.
  * @param matrix Output matrix.
  * */
-void wobble(long double t, EOPTable* earth_orientation_parameter_table, Mat3* matrix) {
+void wobble(Real t, EOPTable* earth_orientation_parameter_table, Mat3* matrix) {
 
     if (matrix && earth_orientation_parameter_table) {
-        EOPTableRecord record;
-        eop_table_record_lookup(earth_orientation_parameter_table, t, &record);
+        EOPValues eop;
+        eop_table_values_lookup(earth_orientation_parameter_table, t, &eop);
+        polar_motion_matrix(t, &eop, matrix);
+    }
+}
+
+/**
+ * @brief Polar motion matrix for time T from Earth orientation parameters already looked up.
+ *
+ * @param t Unix time
+ * @param eop The Earth orientation parameters at t.
+ * @param matrix Output matrix.
+ * */
+void polar_motion_matrix(Real t, const EOPValues* eop, Mat3* matrix) {
 
+    if (matrix) {
         t = (t-J2000_UNIX_TIME)/ SECONDS_PER_JULIAN_CENTURY;
-        long double s_prime = -0.0015 * (CHANDLER_WOBBLE/1.2 + ANNUAL_WOBBLE) * t;
+        Real s_prime = -0.0015 * (CHANDLER_WOBBLE/1.2 + ANNUAL_WOBBLE) * t;
 
-        long double sin_x = sin(record.bulletin_a_PM_x * ARCSECONDS_TO_RADIANS);
-        long double cos_x = cos(record.bulletin_a_PM_x * ARCSECONDS_TO_RADIANS);
-        long double sin_y = sin(record.bulletin_a_PM_y * ARCSECONDS_TO_RADIANS);
-        long double cos_y = cos(record.bulletin_a_PM_y * ARCSECONDS_TO_RADIANS);
-        long double sin_s = sin(s_prime * ARCSECONDS_TO_RADIANS);
-        long double cos_s = cos(s_prime * ARCSECONDS_TO_RADIANS);
+        Real sin_x = sin(eop->PM_x * ARCSECONDS_TO_RADIANS);
+        Real cos_x = cos(eop->PM_x * ARCSECONDS_TO_RADIANS);
+        Real sin_y = sin(eop->PM_y * ARCSECONDS_TO_RADIANS);
+        Real cos_y = cos(eop->PM_y * ARCSECONDS_TO_RADIANS);
+        Real sin_s = sin(s_prime * ARCSECONDS_TO_RADIANS);
+        Real cos_s = cos(s_prime * ARCSECONDS_TO_RADIANS);
 
         matrix->w11 = cos_x * cos_s;
         matrix->w12 = -cos_y* sin_s + sin_y * sin_x * cos_s;
@@ -47,28 +47,28 @@ extern "C"
  * @param t Time in seconds since J2000.0.
  * @param matrix Output matrix.
  * */
-void iau_2000a_precession(long double t, Mat3* matrix) {
+void iau_2000a_precession(Real t, Mat3* matrix) {
 
     if (matrix) {
         t = (t-J2000_UNIX_TIME)/ SECONDS_PER_JULIAN_CENTURY;
-        long double mean_obliquity_j2000 = MEAN_OBLIQUITY_EARTH[0];
-        long double precession_equator = ((((PRECESSION_EQUATOR[5] * t + PRECESSION_EQUATOR[4]) * t +
+        Real mean_obliquity_j2000 = MEAN_OBLIQUITY_EARTH[0];
+        Real precession_equator = ((((PRECESSION_EQUATOR[5] * t + PRECESSION_EQUATOR[4]) * t +
             PRECESSION_EQUATOR[3]) * t + PRECESSION_EQUATOR[2]) * t + PRECESSION_EQUATOR[1]) * t;
-        long double obliquity_mean_equator = ((((OBLIQUITY_MEAN_EQUATOR[5] * t + OBLIQUITY_MEAN_EQUATOR[4]) * t +
+        Real obliquity_mean_equator = ((((OBLIQUITY_MEAN_EQUATOR[5] * t + OBLIQUITY_MEAN_EQUATOR[4]) * t +
             OBLIQUITY_MEAN_EQUATOR[3]) * t + OBLIQUITY_MEAN_EQUATOR[2]) * t + OBLIQUITY_MEAN_EQUATOR[1]) * t +
             OBLIQUITY_MEAN_EQUATOR[0];
-        long double precession_ecliptic_mean_equator = ((((PRECESSION_ECLIPTIC_MEAN_EQUATOR[5] * t +
+        Real precession_ecliptic_mean_equator = ((((PRECESSION_ECLIPTIC_MEAN_EQUATOR[5] * t +
             PRECESSION_ECLIPTIC_MEAN_EQUATOR[4]) * t + PRECESSION_ECLIPTIC_MEAN_EQUATOR[3]) * t +
             PRECESSION_ECLIPTIC_MEAN_EQUATOR[2]) * t + PRECESSION_ECLIPTIC_MEAN_EQUATOR[1]) * t;
 
-        long double sin_epsilon_0 = sin(mean_obliquity_j2000 * ARCSECONDS_TO_RADIANS);
-        long double cos_epsilon_0 = cos(mean_obliquity_j2000 * ARCSECONDS_TO_RADIANS);
-        long double sin_psi_a = -1 * sin(precession_equator * ARCSECONDS_TO_RADIANS);
-        long double cos_psi_a = cos(precession_equator * ARCSECONDS_TO_RADIANS);
-        long double sin_omega_a = -1 * sin(obliquity_mean_equator * ARCSECONDS_TO_RADIANS);
-        long double cos_omega_a = cos(obliquity_mean_equator * ARCSECONDS_TO_RADIANS);
-        long double sin_chi_a = sin(precession_ecliptic_mean_equator * ARCSECONDS_TO_RADIANS);
-        long double cos_chi_a = cos(precession_ecliptic_mean_equator * ARCSECONDS_TO_RADIANS);
+        Real sin_epsilon_0 = sin(mean_obliquity_j2000 * ARCSECONDS_TO_RADIANS);
+        Real cos_epsilon_0 = cos(mean_obliquity_j2000 * ARCSECONDS_TO_RADIANS);
+        Real sin_psi_a = -1 * sin(precession_equator * ARCSECONDS_TO_RADIANS);
+        Real cos_psi_a = cos(precession_equator * ARCSECONDS_TO_RADIANS);
+        Real sin_omega_a = -1 * sin(obliquity_mean_equator * ARCSECONDS_TO_RADIANS);
+        Real cos_omega_a = cos(obliquity_mean_equator * ARCSECONDS_TO_RADIANS);
+        Real sin_chi_a = sin(precession_ecliptic_mean_equator * ARCSECONDS_TO_RADIANS);
+        Real cos_chi_a = cos(precession_ecliptic_mean_equator * ARCSECONDS_TO_RADIANS);
 
         matrix->w11 = cos_chi_a * cos_psi_a - sin_psi_a * sin_chi_a * cos_omega_a;
         matrix->w12 = cos_chi_a * sin_psi_a * cos_epsilon_0 + sin_chi_a * cos_omega_a * cos_psi_a * cos_epsilon_0 -
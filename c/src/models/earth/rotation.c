@@ -24,12 +24,21 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
+#define __compile_math_linear_algebra__
 #define __compile_models_earth_earth_orientation_parameters__
+#define __compile_models_earth_nutation__
+#define __compile_models_earth_nutation_kernel__
 #define __compile_time_delta_t__
 
 #include "math/constants.h"
+#include "math/linear_algebra.h"
+#include "models/earth/bias.h"
 #include "models/earth/constants.h"
 #include "models/earth/earth_orientation_parameters.h"
+#include "models/earth/nutation.h"
+#include "models/earth/nutation_kernel.h"
+#include "models/earth/polar_motion.h"
+#include "models/earth/precession.h"
 #include "models/earth/rotation.h"
 #include "models/moon/constants.h"
 #include "models/sun/constants.h"
@@ -48,24 +57,54 @@ extern "C"
 {
 #endif /* __cplusplus */
 
+/**
+ * @brief Look up the Earth orientation parameters for an epoch in the EOP table the Earth model publishes.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the lookup starts from, NULL to search the table.
+ * @param[out] eop the Earth orientation parameters at t.
+ * @return the version of the table the parameters were looked up in.
+ */
+static long earth_orientation_of_date(Real t, EarthModel* model, int* cursor, EOPValues* eop) {
+
+    long version;
+    EOPTable* table = (EOPTable*)rcu_read_lock(&model->earth_orientation_parameters, &version);
+    eop_table_values_lookup_from(table, t, cursor, eop);
+    rcu_read_unlock(&model->earth_orientation_parameters, version);
+
+    return version;
+}
+
 /**
  * @brief Calculate the Greenwich Mean Sidereal Time (GMST).
  *
  * @param[in] t seconds since J2000.0.
  */
-void gmst(long double t, EarthModel* model, long double* gmst) {
+void gmst(Real t, EarthModel* model, Real* gmst) {
+
+    EOPValues eop;
+    earth_orientation_of_date(t, model, NULL, &eop);
 
-    EOPTableRecord record;
-    DeltaTTableRecord delta_t_record;
-    eop_table_record_lookup(&model->earth_orientation_parameters, t, &record);
-    delta_t_record_lookup(&model->delta_t_table, t, &delta_t_record);
+    gmst_of_values(t, eop.dut1, delta_t_of_date(&model->delta_t_table, t, NULL), gmst);
+}
+
+/**
+ * @brief Calculate the Greenwich Mean Sidereal Time (GMST) from dUT1 and Delta T already looked up.
+ *
+ * @param[in] t Unix time
+ * @param[in] dut1 UT1-UTC at t in ms.
+ * @param[in] delta_t TT-UT1 at t in s.
+ * @param[out] gmst the Greenwich Mean Sidereal Time in s.
+ */
+void gmst_of_values(Real t, Real dut1, Real delta_t, Real* gmst) {
 
-    long double du = (t - J2000_UNIX_TIME + record.bulletin_a_dut1/1000.0) / SECONDS_PER_DAY;
+    Real du = (t - J2000_UNIX_TIME + dut1/1000.0) / SECONDS_PER_DAY;
     *gmst = ((((GMST_FUNCTION_JULIAN_DU[5] * du + GMST_FUNCTION_JULIAN_DU[4])* du + GMST_FUNCTION_JULIAN_DU[3]) * du +
         GMST_FUNCTION_JULIAN_DU[2]) * du + GMST_FUNCTION_JULIAN_DU[1]) * du + GMST_FUNCTION_JULIAN_DU[0];
-    *gmst +=  GMST_DELTA_T * delta_t_record.deltaT/SECONDS_PER_DAY;
+    *gmst +=  GMST_DELTA_T * delta_t/SECONDS_PER_DAY;
 
-    *gmst = fmodl(*gmst, 86400.0);
+    *gmst = fmod(*gmst, 86400.0);
 }
 
 /**
@@ -75,12 +114,12 @@ void gmst(long double t, EarthModel* model, long double* gmst) {
  * @param[in] model Earth model
  * @param[out] era the Earth rotation angle in rad.
  */
-void earth_rotation_angle(long double t, EarthModel* model, long double* era) {
+void earth_rotation_angle(Real t, EarthModel* model, Real* era) {
 
-    EOPTableRecord record;
-    eop_table_record_lookup(&model->earth_orientation_parameters, t, &record);
+    EOPValues eop;
+    earth_orientation_of_date(t, model, NULL, &eop);
 
-    t = (t - J2000_UNIX_TIME + record.bulletin_a_dut1/1000.0) / SECONDS_PER_DAY;
+    t = (t - J2000_UNIX_TIME + eop.dut1/1000.0) / SECONDS_PER_DAY;
     *era = (ERA_DUT1[0] + ERA_DUT1[1] * t) * 2.0 * M_PI;
 }
 
@@ -88,10 +127,12 @@ void earth_rotation_angle(long double t, EarthModel* model, long double* era) {
  * @brief Calculate the equation of origins.
  *
  * @param[in] t Unix time
+ * @param[in] strategy RecurrenceNutationStrategy builds the sines and cosines of the terms from those of the
+ * fundamental arguments, any other strategy evaluates every term directly.
  * @param[out] eo the equation of origins in rad.
  */
-void equation_of_origins(long double t, long double nutation_longitude, long double mean_obliquity_date,
-    long double* eo) {
+void equation_of_origins(Real t, Real nutation_longitude, Real mean_obliquity_date,
+    NutationStrategy strategy, Real* eo) {
 
     t = (t-J2000_UNIX_TIME)/ SECONDS_PER_JULIAN_CENTURY;
     double nutation_critical_arguments[14];
@@ -130,11 +171,40 @@ void equation_of_origins(long double t, long double nutation_longitude, long dou
     nutation_critical_arguments[13] = (GENERAL_PRECESSION_LONGITUDE[2] * t + GENERAL_PRECESSION_LONGITUDE[1]) * t;
 
     *eo = ((((-3.68e-8 * t - 0.000029956) * t + 4.4e-7) * t - 1.391581) * t - 4612.156534) * t - 0.014506 -
-        nutation_longitude*cosl(mean_obliquity_date * ARCSECONDS_TO_RADIANS);
+        nutation_longitude*cos(mean_obliquity_date * ARCSECONDS_TO_RADIANS);
 
     int i = 0;
-    for(i = 0; i < 33; ++i) {
-        long double ai = EQUATION_OF_ORIGINS[i*16+2] * nutation_critical_arguments[0] +
+    if(strategy == RecurrenceNutationStrategy) {
+
+        Real arguments[14], table[14 * (NUTATION_RECURRENCE_MAX_MULTIPLE + 1) * 2];
+        Real cos_ai, sin_ai;
+        int multipliers[14], max_multiple = 0;
+
+        /* These terms take the arguments as radians. Reducing them to a single turn up front is far cheaper than
+         * leaving sinl and cosl to reduce arguments of up to 1e9, and loses less than the arguments' own precision. */
+        for(int k = 0; k < 14; ++k) {
+            arguments[k] = remainder(nutation_critical_arguments[k], 6.283185307179586476925286766559005768L);
+        }
+        for(int j = 0; j < 33 * 16; ++j) {
+            if(j % 16 > 1 && fabs(EQUATION_OF_ORIGINS[j]) > max_multiple) {
+                max_multiple = (int)fabs(EQUATION_OF_ORIGINS[j]);
+            }
+        }
+        if(max_multiple > NUTATION_RECURRENCE_MAX_MULTIPLE) max_multiple = NUTATION_RECURRENCE_MAX_MULTIPLE;
+        argument_multiple_table(arguments, 14, max_multiple, table);
+
+        /* Terms with multiples beyond the table are left to the direct loop below */
+        for(i = 0; i < 33; ++i) {
+            for(int k = 0; k < 14; ++k) {
+                multipliers[k] = (int)EQUATION_OF_ORIGINS[i*16+2+k];
+            }
+            if(!argument_combination(table, multipliers, 14, max_multiple, &cos_ai, &sin_ai)) break;
+            *eo -= (EQUATION_OF_ORIGINS[i*16] * sin_ai + EQUATION_OF_ORIGINS[i*16+1] * cos_ai);
+        }
+    }
+
+    for(; i < 33; ++i) {
+        Real ai = EQUATION_OF_ORIGINS[i*16+2] * nutation_critical_arguments[0] +
             EQUATION_OF_ORIGINS[i*16+3] * nutation_critical_arguments[1] +
             EQUATION_OF_ORIGINS[i*16+4] * nutation_critical_arguments[2] +
             EQUATION_OF_ORIGINS[i*16+5] * nutation_critical_arguments[3] +
@@ -149,10 +219,10 @@ void equation_of_origins(long double t, long double nutation_longitude, long dou
             EQUATION_OF_ORIGINS[i*16+14] * nutation_critical_arguments[12] +
             EQUATION_OF_ORIGINS[i*16+15] * nutation_critical_arguments[13];
 
-           *eo -= (EQUATION_OF_ORIGINS[i*16] * sinl(ai) + EQUATION_OF_ORIGINS[i*16+1] * cosl(ai));
+           *eo -= (EQUATION_OF_ORIGINS[i*16] * sin(ai) + EQUATION_OF_ORIGINS[i*16+1] * cos(ai));
     }
 
-    long double ai = EQUATION_OF_ORIGINS[i*16+2] * nutation_critical_arguments[0] +
+    Real ai = EQUATION_OF_ORIGINS[i*16+2] * nutation_critical_arguments[0] +
             EQUATION_OF_ORIGINS[i*16+3] * nutation_critical_arguments[1] +
             EQUATION_OF_ORIGINS[i*16+4] * nutation_critical_arguments[2] +
             EQUATION_OF_ORIGINS[i*16+5] * nutation_critical_arguments[3] +
@@ -167,8 +237,8 @@ void equation_of_origins(long double t, long double nutation_longitude, long dou
             EQUATION_OF_ORIGINS[i*16+14] * nutation_critical_arguments[12] +
             EQUATION_OF_ORIGINS[i*16+15] * nutation_critical_arguments[13];
 
-    *eo -= (EQUATION_OF_ORIGINS[i*16] * sinl(ai * ARCSECONDS_TO_RADIANS) +
-        EQUATION_OF_ORIGINS[i*16+1] * cosl(ai * ARCSECONDS_TO_RADIANS));
+    *eo -= (EQUATION_OF_ORIGINS[i*16] * sin(ai * ARCSECONDS_TO_RADIANS) +
+        EQUATION_OF_ORIGINS[i*16+1] * cos(ai * ARCSECONDS_TO_RADIANS));
 
 }
 
@@ -179,14 +249,14 @@ void equation_of_origins(long double t, long double nutation_longitude, long dou
  * @param[in] model Earth model
  * @param[out] gast the Greenwich Apparent Sidereal Time in rad.
  */
-void gast_2000(long double t, EarthModel* model, long double nutation_longitude, long double mean_obliquity_date,
-    long double* gast) {
+void gast_2000(Real t, EarthModel* model, Real nutation_longitude, Real mean_obliquity_date,
+    Real* gast) {
 
     *gast = 0;
     earth_rotation_angle(t, model, gast);
 
-    long double eo;
-    equation_of_origins(t, nutation_longitude, mean_obliquity_date, &eo);
+    Real eo;
+    equation_of_origins(t, nutation_longitude, mean_obliquity_date, model->nutation_series.strategy, &eo);
     *gast -= eo * ARCSECONDS_TO_RADIANS;
 
 }
@@ -197,15 +267,15 @@ void gast_2000(long double t, EarthModel* model, long double nutation_longitude,
  * @param[in] angle angle of rotation.
  * @param[out] matrix rotation matrix.
  */
-void earth_rotation_matrix(long double angle, Mat3* matrix) {
+void earth_rotation_matrix(Real angle, Mat3* matrix) {
 
     if (matrix) {
 
-        matrix->w11 = cosl(angle);
-        matrix->w12 = sinl(angle);
+        matrix->w11 = cos(angle);
+        matrix->w12 = sin(angle);
         matrix->w13 = 0.0;
-        matrix->w21 = -sinl(angle);
-        matrix->w22 = cosl(angle);
+        matrix->w21 = -sin(angle);
+        matrix->w22 = cos(angle);
         matrix->w23 = 0.0;
         matrix->w31 = 0.0;
         matrix->w32 = 0.0;
@@ -215,6 +285,49 @@ void earth_rotation_matrix(long double angle, Mat3* matrix) {
 
 }
 
+/**
+ * @brief Calculate the first and second time derivatives of the Earth rotation matrix.
+ *
+ * @param[in] angle angle of rotation.
+ * @param[in] rate rate of rotation in rad/s.
+ * @param[out] first the first time derivative.
+ * @param[out] second the second time derivative.
+ */
+void earth_rotation_matrix_derivatives(Real angle, Real rate, Mat3* first, Mat3* second) {
+
+    Real sin_angle = sin(angle);
+    Real cos_angle = cos(angle);
+
+    if (first) {
+
+        first->w11 = -rate * sin_angle;
+        first->w12 = rate * cos_angle;
+        first->w13 = 0.0;
+        first->w21 = -rate * cos_angle;
+        first->w22 = -rate * sin_angle;
+        first->w23 = 0.0;
+        first->w31 = 0.0;
+        first->w32 = 0.0;
+        first->w33 = 0.0;
+
+    }
+
+    if (second) {
+
+        second->w11 = -rate * rate * cos_angle;
+        second->w12 = -rate * rate * sin_angle;
+        second->w13 = 0.0;
+        second->w21 = rate * rate * sin_angle;
+        second->w22 = -rate * rate * cos_angle;
+        second->w23 = 0.0;
+        second->w31 = 0.0;
+        second->w32 = 0.0;
+        second->w33 = 0.0;
+
+    }
+
+}
+
 /**
  * @brief Calculate the Earth rotation matrix.
  *
@@ -222,16 +335,199 @@ void earth_rotation_matrix(long double angle, Mat3* matrix) {
  * @param[in] model Earth model
  * @param[out] rate the rotation rate in rad/s.
  */
-void rate_of_earth_rotation(long double t, EarthModel* model, long double* rate) {
+void rate_of_earth_rotation(Real t, EarthModel* model, Real* rate) {
+
+    EOPValues eop;
+    earth_orientation_of_date(t, model, NULL, &eop);
+
+    *rate = 2.0 * M_PI / (SECONDS_PER_DAY + eop.lod/1000.0);
+
+}
+
+/**
+ * @brief Compose the GCRF to ITRF rotation for an epoch, with its derivatives if asked for.
+ *
+ * The EOP and Delta T tables are looked up once for the epoch and the values shared by GMST, the polar motion and the
+ * rate of Earth rotation.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the table lookups start from, NULL to search the tables.
+ * @param[in] derivatives non-zero to compose the derivatives as well.
+ * @param[out] rotation the composed frame rotation.
+ */
+static void compose_frame_rotation(Real t, EarthModel* model, EarthModelCursor* cursor, int derivatives,
+    FrameRotation* rotation) {
+
+    Mat3 stage, celestial, product, wobble_matrix;
+    Mat3 rotation_matrix, rotation_rate, rotation_acceleration;
+
+    EOPValues eop;
+    long version = earth_orientation_of_date(t, model, cursor ? &cursor->eop : NULL, &eop);
+    Real delta_t = delta_t_of_date(&model->delta_t_table, t, cursor ? &cursor->delta_t : NULL);
+
+    Real gast;
+    gmst_of_values(t, eop.dut1, delta_t, &gast);
+
+    Real nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
+    if(!nutation_ephemeris_values_of_date(t, &model->nutation_ephemeris, &nutation_longitude, &nutation_obliquity,
+        &mean_obliquity_date, &equation_of_the_equinoxes)) {
+        nutation_values_of_date(t, model->truncated_nutation_series.records ? &model->truncated_nutation_series :
+            &model->nutation_series, &nutation_longitude, &nutation_obliquity, &mean_obliquity_date,
+            &equation_of_the_equinoxes);
+    }
+
+    gast += equation_of_the_equinoxes/15.0;
+
+    /* Celestial part, nutation * precession * bias */
+    iau_2000a_precession(t, &stage);
+    icrs_frame_bias(&product);
+    matrix_product(&stage, &product, &celestial);
+
+    nutation_matrix(mean_obliquity_date, nutation_longitude, mean_obliquity_date-nutation_obliquity, &stage);
+    matrix_product(&stage, &celestial, &product);
+    celestial = product;
+
+    earth_rotation_matrix(gast/SECONDS_PER_DAY * 2.0 * M_PI, &rotation_matrix);
+    polar_motion_matrix(t, &eop, &wobble_matrix);
+
+    matrix_product(&rotation_matrix, &celestial, &product);
+    matrix_product(&wobble_matrix, &product, &rotation->matrix);
+
+    /* Only the earth rotation stage varies fast enough for its derivatives to matter. */
+    if(derivatives) {
+        rotation->rate = 2.0 * M_PI / (SECONDS_PER_DAY + eop.lod/1000.0);
+        earth_rotation_matrix_derivatives(gast/SECONDS_PER_DAY * 2.0 * M_PI, rotation->rate, &rotation_rate,
+            &rotation_acceleration);
+
+        matrix_product(&rotation_rate, &celestial, &product);
+        matrix_product(&wobble_matrix, &product, &rotation->derivative);
+        matrix_product(&rotation_acceleration, &celestial, &product);
+        matrix_product(&wobble_matrix, &product, &rotation->second_derivative);
+    }
+
+    rotation->timestamp = t;
+    rotation->valid = 1;
+    rotation->derivatives = derivatives;
+    rotation->version = version;
+}
+
+/**
+ * @brief Compose the full GCRF to ITRF rotation for an epoch.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[out] rotation the composed frame rotation.
+ */
+void frame_rotation_of_date(Real t, EarthModel* model, FrameRotation* rotation) {
+    compose_frame_rotation(t, model, NULL, 1, rotation);
+}
+
+/**
+ * @brief Compose only the GCRF to ITRF rotation matrix for an epoch, for converting positions.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[out] rotation the composed frame rotation without its derivatives.
+ */
+void frame_rotation_matrix_of_date(Real t, EarthModel* model, FrameRotation* rotation) {
+    compose_frame_rotation(t, model, NULL, 0, rotation);
+}
+
+/**
+ * @brief Look up the frame rotation for an epoch in the Earth model's cache, composing it on a miss.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the table lookups of a miss start from, NULL to search the tables.
+ * @param[in] derivatives non-zero if the derivatives are needed, entries without them are then misses.
+ * @param[out] rotation the composed frame rotation.
+ */
+static void lookup_frame_rotation(Real t, EarthModel* model, EarthModelCursor* cursor, int derivatives,
+    FrameRotation* rotation) {
+
+    FrameRotationCache* cache = &model->rotation_cache;
+
+    double key = (double)t;
+    unsigned long long bits;
+    memcpy(&bits, &key, sizeof(bits));
+    bits ^= bits >> 29;
+    bits *= 0x9E3779B97F4A7C15ULL;
+
+    /* Entries composed with an EOP table since swapped out are misses. */
+    long version = rcu_version(&model->earth_orientation_parameters);
+
+    mutex_lock(&cache->lock);
+    unsigned long long generation = cache->generation;
+    if(cache->nentries > 0) {
+        FrameRotation* entry = &cache->entries[(bits >> 32) % (unsigned long long)cache->nentries];
+        if(entry->valid && entry->timestamp == t && entry->version == version && (entry->derivatives || !derivatives)) {
+            cache->hits++;
+            *rotation = *entry;
+            mutex_unlock(&cache->lock);
+            return;
+        }
+    }
+    cache->misses++;
+    mutex_unlock(&cache->lock);
 
-    EOPTableRecord record;
-    eop_table_record_lookup(&model->earth_orientation_parameters, t, &record);
+    /* The rotation is composed outside the lock so misses on other threads are not held up behind it. */
+    compose_frame_rotation(t, model, cursor, derivatives, rotation);
 
-    *rate = 2.0 * M_PI / (SECONDS_PER_DAY + record.bulletin_a_lod/1000.0);
+    /* A setter that invalidated the cache meanwhile may have changed what the rotation was composed from. */
+    mutex_lock(&cache->lock);
+    if(cache->nentries > 0 && cache->generation == generation) {
+        cache->entries[(bits >> 32) % (unsigned long long)cache->nentries] = *rotation;
+    }
+    mutex_unlock(&cache->lock);
+}
 
+/**
+ * @brief Look up the composed frame rotation for an epoch in the Earth model's cache, computing it on a miss.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the table lookups of a miss start from, NULL to search the tables.
+ * @param[out] rotation the composed frame rotation.
+ */
+void cached_frame_rotation(Real t, EarthModel* model, EarthModelCursor* cursor, FrameRotation* rotation) {
+    lookup_frame_rotation(t, model, cursor, 1, rotation);
+}
+
+/**
+ * @brief Look up the frame rotation matrix for an epoch in the Earth model's cache, composing only the matrix on a
+ * miss.
+ *
+ * @param[in] t Unix time
+ * @param[in] model Earth model
+ * @param[in,out] cursor where the table lookups of a miss start from, NULL to search the tables.
+ * @param[out] rotation the composed frame rotation, its derivatives only valid if 'derivatives' is set.
+ */
+void cached_frame_rotation_matrix(Real t, EarthModel* model, EarthModelCursor* cursor,
+    FrameRotation* rotation) {
+    lookup_frame_rotation(t, model, cursor, 0, rotation);
 }
 
 
+/**
+ * @brief Build everything the frame rotation fills in lazily, so the rotation can be composed with the GIL released.
+ */
+int prepare_frame_rotation(EarthModel* model) {
+
+    nutation_kernel();
+
+    if(model->nutation_series.strategy == VectorizedNutationStrategy &&
+        nutation_series_columns(&model->nutation_series) != 0) {
+        return -1;
+    }
+    if(model->truncated_nutation_series.strategy == VectorizedNutationStrategy &&
+        nutation_series_columns(&model->truncated_nutation_series) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
\ No newline at end of file
@@ -0,0 +1,709 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#define __compile_util_rcu__
+#include "models/earth/snapshot.h"
+#include "models/earth/nutation_kernel.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(WIN32)
+
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+
+#else
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif /* _WIN32 */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @brief Most sections a snapshot can hold, one of each kind.
+ */
+#define SNAPSHOT_MAX_SECTIONS 8
+
+/**
+ * @brief Room for the suffix of a temporary snapshot name, the process id, a counter and ".tmp" or ".old".
+ */
+#define SNAPSHOT_TEMPORARY_SUFFIX_SIZE 32
+
+#if defined(_WIN32) || defined(WIN32)
+
+/**
+ * @brief Counter that keeps the temporary names a process picks apart.
+ */
+static volatile LONG snapshot_name_counter = 0;
+
+#endif /* _WIN32 */
+
+/**
+ * @brief Round a size up to the section alignment.
+ */
+static uint64_t align_section(uint64_t size) {
+    return (size + EARTH_MODEL_SNAPSHOT_ALIGNMENT - 1) & ~(uint64_t)(EARTH_MODEL_SNAPSHOT_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Number of points of a geoid grid of the given spacing in degrees.
+ */
+static long long geoid_interpolation_size(double spacing) {
+    return spacing > 0.0 ? (long long)(int)((360/spacing + 1) * (180/spacing + 1)) : 0;
+}
+
+/**
+ * @brief Checksum of a snapshot, 64 bit FNV-1a taken a word at a time with the header's checksum read as zero.
+ *
+ * Every step is a bijection of the running hash, so any change to a single word changes the checksum. Hashing words
+ * rather than bytes keeps the check of a snapshot of several megabytes to a millisecond or two.
+ */
+static uint64_t snapshot_checksum(const char* data, size_t size) {
+
+    const size_t skip = offsetof(EarthModelSnapshotHeader, checksum);
+    uint64_t hash = 14695981039346656037ULL;
+    size_t i = 0;
+
+    for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        if(i != skip) {
+            memcpy(&word, data + i, sizeof(uint64_t));
+        }
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    for(; i < size; ++i) {
+        hash = (hash ^ (unsigned char)data[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Size of each element of a section of the given kind in this build, 0 for an unknown kind.
+ */
+static uint32_t snapshot_element_size(uint32_t kind) {
+
+    switch(kind) {
+        case EllipsoidSnapshotSection: return sizeof(Ellipsoid);
+        case NutationRecordsSnapshotSection: return sizeof(NutationSeriesRecord);
+        case NutationColumnsSnapshotSection: return sizeof(double);
+        case EOPRecordsSnapshotSection: return sizeof(EOPTableRecord);
+        case EOPColumnsSnapshotSection: return sizeof(double);
+        case DeltaTRecordsSnapshotSection: return sizeof(DeltaTTableRecord);
+        case GeoidInterpolationSnapshotSection: return sizeof(double);
+        case GeoidCoefficientsSnapshotSection: return sizeof(SurfaceSphericalHarmonicCoefficients);
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Append an entry to the section table unless the section is empty.
+ */
+static void add_snapshot_section(EarthModelSnapshotSection* sections, const void** contents, uint32_t* nsections,
+    uint32_t kind, long long count, const void* data) {
+
+    if(count <= 0) {
+        return;
+    }
+
+    sections[*nsections].kind = kind;
+    sections[*nsections].element_size = snapshot_element_size(kind);
+    sections[*nsections].count = (uint64_t)count;
+    sections[*nsections].offset = 0;
+    contents[*nsections] = data;
+    ++*nsections;
+}
+
+/**
+ * @brief Create and open a file next to path that no other writer is given, so concurrent saves to one path never
+ * write to the same temporary file.
+ *
+ * @param path The path the file is later renamed over.
+ * @param temporary Receives the name of the file, to be freed by the caller.
+ * @return The file open for writing, NULL with errno set otherwise.
+ */
+static FILE* open_temporary_file(const char* path, char** temporary) {
+
+    size_t length = strlen(path);
+    *temporary = (char*)malloc(length + SNAPSHOT_TEMPORARY_SUFFIX_SIZE);
+    if(!*temporary) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    FILE* file = NULL;
+    int saved_errno;
+
+#if defined(_WIN32) || defined(WIN32)
+    int descriptor = -1;
+
+    /* A name left behind by a process that crashed holds the same id, so names in use are skipped. */
+    for(int attempt = 0; attempt < 100 && descriptor < 0; ++attempt) {
+        snprintf(*temporary, length + SNAPSHOT_TEMPORARY_SUFFIX_SIZE, "%s.%lu.%ld.tmp", path,
+            (unsigned long)GetCurrentProcessId(), (long)InterlockedIncrement(&snapshot_name_counter));
+        descriptor = _open(*temporary, _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+        if(descriptor < 0 && errno != EEXIST) {
+            break;
+        }
+    }
+    if(descriptor >= 0) {
+        file = _fdopen(descriptor, "wb");
+        if(!file) {
+            saved_errno = errno;
+            _close(descriptor);
+            remove(*temporary);
+            errno = saved_errno;
+        }
+    }
+#else
+    memcpy(*temporary, path, length);
+    memcpy(*temporary + length, ".XXXXXX", 8);
+    int descriptor = mkstemp(*temporary);
+    if(descriptor >= 0) {
+        /* mkstemp creates the file for its owner alone, a snapshot is read by every process attaching to it. */
+        if(fchmod(descriptor, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH) == 0) {
+            file = fdopen(descriptor, "wb");
+        }
+        if(!file) {
+            saved_errno = errno;
+            close(descriptor);
+            remove(*temporary);
+            errno = saved_errno;
+        }
+    }
+#endif /* _WIN32 */
+
+    if(!file) {
+        saved_errno = errno;
+        free(*temporary);
+        *temporary = NULL;
+        errno = saved_errno;
+    }
+
+    return file;
+}
+
+#if defined(_WIN32) || defined(WIN32)
+
+/**
+ * @brief Move a finished temporary file over path.
+ *
+ * Windows will not replace a file that is open, and an attached snapshot keeps its file open while it is mapped.
+ * map_file shares delete access, so such a file is renamed aside and deleted instead. Windows only removes it once
+ * the last model attached to it lets go, until then it stays next to path under a ".old" name.
+ *
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+static int move_over_file(const char* temporary, const char* path) {
+
+    if(MoveFileExA(temporary, path, MOVEFILE_REPLACE_EXISTING)) {
+        return 0;
+    }
+
+    DWORD error = GetLastError();
+    if(error != ERROR_ACCESS_DENIED && error != ERROR_SHARING_VIOLATION && error != ERROR_USER_MAPPED_FILE) {
+        errno = windows_errno(error);
+        return -1;
+    }
+
+    size_t length = strlen(path);
+    char* aside = (char*)malloc(length + SNAPSHOT_TEMPORARY_SUFFIX_SIZE);
+    if(!aside) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    BOOL moved = FALSE;
+    for(int attempt = 0; attempt < 100 && !moved; ++attempt) {
+        snprintf(aside, length + SNAPSHOT_TEMPORARY_SUFFIX_SIZE, "%s.%lu.%ld.old", path,
+            (unsigned long)GetCurrentProcessId(), (long)InterlockedIncrement(&snapshot_name_counter));
+        moved = MoveFileExA(path, aside, 0);
+        if(!moved) {
+            error = GetLastError();
+            if(error != ERROR_ALREADY_EXISTS && error != ERROR_FILE_EXISTS) {
+                break;
+            }
+        }
+    }
+
+    if(moved && !MoveFileExA(temporary, path, MOVEFILE_REPLACE_EXISTING)) {
+        error = GetLastError();
+        /* Put the old snapshot back so a failed save leaves path as it was. */
+        MoveFileExA(aside, path, 0);
+        moved = FALSE;
+    } else if(moved) {
+        DeleteFileA(aside);
+    }
+    free(aside);
+
+    if(!moved) {
+        errno = windows_errno(error);
+        return -1;
+    }
+
+    return 0;
+}
+
+#endif /* _WIN32 */
+
+/**
+ * @brief Write a whole buffer to a file of its own next to path and rename it over path.
+ */
+static int replace_file(const char* path, const char* data, size_t size) {
+
+    char* temporary;
+    FILE* file = open_temporary_file(path, &temporary);
+    if(!file) {
+        return -1;
+    }
+
+    int status = fwrite(data, 1, size, file) == size ? 0 : -1;
+    int saved_errno = errno;
+    if(fclose(file) != 0 && status == 0) {
+        status = -1;
+        saved_errno = errno;
+    }
+
+    if(status == 0) {
+#if defined(_WIN32) || defined(WIN32)
+        if(move_over_file(temporary, path) != 0) {
+            status = -1;
+            saved_errno = errno;
+        }
+#else
+        if(rename(temporary, path) != 0) {
+            status = -1;
+            saved_errno = errno;
+        }
+#endif /* _WIN32 */
+    }
+
+    if(status != 0) {
+        remove(temporary);
+    }
+    free(temporary);
+    errno = saved_errno;
+
+    return status;
+}
+
+/**
+ * @brief Write the tables of an Earth Model, with the EOP table it publishes, to a snapshot file.
+ */
+static int write_snapshot(EarthModel* model, const EOPTable* eop, const char* path) {
+
+    EarthModelSnapshotSection sections[SNAPSHOT_MAX_SECTIONS];
+    const void* contents[SNAPSHOT_MAX_SECTIONS];
+    uint32_t nsections = 0;
+
+    NutationSeries* series = &model->nutation_series;
+    int nutation_columns = series->columns && series->nrecords > 0 && series->ncolumns == series->nrecords;
+
+    add_snapshot_section(sections, contents, &nsections, EllipsoidSnapshotSection, 1, &model->ellipsoid);
+    add_snapshot_section(sections, contents, &nsections, NutationRecordsSnapshotSection, series->nrecords,
+        series->records);
+    if(nutation_columns) {
+        add_snapshot_section(sections, contents, &nsections, NutationColumnsSnapshotSection,
+            (long long)series->column_stride * NUTATION_SERIES_NCOLUMNS, series->columns);
+    }
+    add_snapshot_section(sections, contents, &nsections, EOPRecordsSnapshotSection, eop->nrecords, eop->records);
+    /* Written without the spare room of each column, so the columns are nrecords apart in the file. */
+    add_snapshot_section(sections, contents, &nsections, EOPColumnsSnapshotSection,
+        eop->ncolumns == eop->nrecords ? (long long)eop->nrecords * EOP_TABLE_NCOLUMNS : 0, NULL);
+    add_snapshot_section(sections, contents, &nsections, DeltaTRecordsSnapshotSection, model->delta_t_table.nrecords,
+        model->delta_t_table.records);
+    if(model->geoid.interpolation) {
+        add_snapshot_section(sections, contents, &nsections, GeoidInterpolationSnapshotSection,
+            geoid_interpolation_size(model->geoid.interpolation_spacing), model->geoid.interpolation);
+    }
+    add_snapshot_section(sections, contents, &nsections, GeoidCoefficientsSnapshotSection, model->geoid.ncoefficients,
+        model->geoid.coefficients);
+
+    uint64_t size = align_section(sizeof(EarthModelSnapshotHeader) + nsections * sizeof(EarthModelSnapshotSection));
+    for(uint32_t i = 0; i < nsections; ++i) {
+        sections[i].offset = size;
+        size = align_section(size + sections[i].count * sections[i].element_size);
+    }
+
+    if(size > (uint64_t)(size_t)-1) {
+        errno = EFBIG;
+        return -1;
+    }
+
+    /* Zeroed so the padding between sections, and so the checksum, is the same for the same tables. */
+    char* image = (char*)calloc((size_t)size, 1);
+    if(!image) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for(uint32_t i = 0; i < nsections; ++i) {
+        char* section = image + sections[i].offset;
+        if(sections[i].kind == EOPColumnsSnapshotSection) {
+            for(int c = 0; c < EOP_TABLE_NCOLUMNS; ++c) {
+                memcpy(section + (size_t)c * eop->nrecords * sizeof(double), eop->columns + (size_t)c *
+                    eop->column_stride, (size_t)eop->nrecords * sizeof(double));
+            }
+        } else {
+            memcpy(section, contents[i], (size_t)(sections[i].count * sections[i].element_size));
+        }
+    }
+    memcpy(image + sizeof(EarthModelSnapshotHeader), sections, nsections * sizeof(EarthModelSnapshotSection));
+
+    EarthModelSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EARTH_MODEL_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = EARTH_MODEL_SNAPSHOT_VERSION;
+    header.real_size = sizeof(Real);
+    header.size = size;
+    header.nsections = nsections;
+    header.nutation_strategy = series->strategy;
+    header.nutation_column_stride = nutation_columns ? series->column_stride : 0;
+    header.eop_interpolation = eop->interpolation;
+    header.eop_nindexed = eop->nindexed;
+    header.eop_start = (double)eop->start;
+    header.eop_step = (double)eop->step;
+    header.delta_t_interpolation = model->delta_t_table.interpolation;
+    header.delta_t_extrapolation = model->delta_t_table.extrapolation;
+    header.geodetic_algorithm = model->geodetic_algorithm;
+    header.geoid_interpolation_spacing = model->geoid.interpolation ? model->geoid.interpolation_spacing : 0.0;
+    memcpy(image, &header, sizeof(header));
+
+    header.checksum = snapshot_checksum(image, (size_t)size);
+    memcpy(image, &header, sizeof(header));
+
+    int status = replace_file(path, image, (size_t)size);
+    int saved_errno = errno;
+    free(image);
+    errno = saved_errno;
+
+    return status;
+}
+
+/**
+ * @brief Write the tables of an Earth Model to a snapshot file.
+ */
+int write_earth_model_snapshot(EarthModel* model, const char* path) {
+
+    /* Read for the whole write, so an EOP table swapped in meanwhile does not free the one being written. */
+    long version;
+    EOPTable* eop = (EOPTable*)rcu_read_lock(&model->earth_orientation_parameters, &version);
+    int status = write_snapshot(model, eop, path);
+    rcu_read_unlock(&model->earth_orientation_parameters, version);
+
+    return status;
+}
+
+/**
+ * @brief Find a section of a checked snapshot by kind.
+ *
+ * @return The section, NULL if the snapshot has none of that kind.
+ */
+static const EarthModelSnapshotSection* find_snapshot_section(const char* data, uint32_t kind,
+    EarthModelSnapshotSection* section) {
+
+    EarthModelSnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    for(uint32_t i = 0; i < header.nsections; ++i) {
+        memcpy(section, data + sizeof(header) + i * sizeof(EarthModelSnapshotSection), sizeof(*section));
+        if(section->kind == kind) {
+            return section;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Number of elements of a section of a checked snapshot, 0 if it has none of that kind.
+ */
+static long long snapshot_section_count(const char* data, uint32_t kind) {
+
+    EarthModelSnapshotSection section;
+    return find_snapshot_section(data, kind, &section) ? (long long)section.count : 0;
+}
+
+/**
+ * @brief Check a snapshot held in memory.
+ */
+int check_earth_model_snapshot(const char* data, size_t size, const char** error) {
+
+    EarthModelSnapshotHeader header;
+    EarthModelSnapshotSection section;
+    unsigned int seen = 0;
+
+    if(size < sizeof(header)) {
+        *error = "The file is too short to be an Earth Model snapshot.";
+        return -1;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    if(memcmp(header.magic, EARTH_MODEL_SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        *error = "The file is not an Earth Model snapshot.";
+        return -1;
+    }
+    if(header.version != EARTH_MODEL_SNAPSHOT_VERSION) {
+        *error = "The Earth Model snapshot was written by an incompatible version of toluene.";
+        return -1;
+    }
+    if(header.real_size != sizeof(Real)) {
+        *error = "The Earth Model snapshot was written by a build of toluene of a different precision.";
+        return -1;
+    }
+    if(header.size != size) {
+        *error = "The Earth Model snapshot is truncated.";
+        return -1;
+    }
+    if(snapshot_checksum(data, size) != header.checksum) {
+        *error = "The Earth Model snapshot checksum does not match, the file is corrupt.";
+        return -1;
+    }
+    if(header.nsections > SNAPSHOT_MAX_SECTIONS ||
+        sizeof(header) + header.nsections * sizeof(EarthModelSnapshotSection) > size) {
+        *error = "The Earth Model snapshot section table is malformed.";
+        return -1;
+    }
+
+    for(uint32_t i = 0; i < header.nsections; ++i) {
+        memcpy(&section, data + sizeof(header) + i * sizeof(EarthModelSnapshotSection), sizeof(section));
+        uint32_t element_size = snapshot_element_size(section.kind);
+        if(!element_size || element_size != section.element_size || (seen & (1u << section.kind)) ||
+            section.offset % EARTH_MODEL_SNAPSHOT_ALIGNMENT != 0 || section.offset > size ||
+            section.count > (size - section.offset) / element_size || section.count > 0x7fffffff) {
+            *error = "The Earth Model snapshot section table is malformed.";
+            return -1;
+        }
+        seen |= 1u << section.kind;
+    }
+
+    /* The sections that describe others must agree with them. */
+    long long nutation_columns = snapshot_section_count(data, NutationColumnsSnapshotSection);
+    long long eop_columns = snapshot_section_count(data, EOPColumnsSnapshotSection);
+    long long geoid_interpolation = snapshot_section_count(data, GeoidInterpolationSnapshotSection);
+    if(snapshot_section_count(data, EllipsoidSnapshotSection) != 1 ||
+        (nutation_columns && (header.nutation_column_stride < snapshot_section_count(data,
+            NutationRecordsSnapshotSection) || nutation_columns != (long long)header.nutation_column_stride *
+            NUTATION_SERIES_NCOLUMNS)) ||
+        eop_columns != snapshot_section_count(data, EOPRecordsSnapshotSection) * EOP_TABLE_NCOLUMNS ||
+        (header.eop_nindexed < 0 || header.eop_nindexed > snapshot_section_count(data, EOPRecordsSnapshotSection)) ||
+        geoid_interpolation != geoid_interpolation_size(header.geoid_interpolation_spacing)) {
+        *error = "The Earth Model snapshot sections do not agree with one another.";
+        return -1;
+    }
+
+    if(header.nutation_strategy < ExtendedNutationStrategy || header.nutation_strategy > RecurrenceNutationStrategy ||
+        header.eop_interpolation < NearestEOPInterpolation || header.eop_interpolation > LagrangeEOPInterpolation ||
+        header.delta_t_interpolation < StepDeltaTInterpolation ||
+        header.delta_t_interpolation > LinearDeltaTInterpolation ||
+        header.delta_t_extrapolation < ClampDeltaTExtrapolation ||
+        header.delta_t_extrapolation > PolynomialDeltaTExtrapolation ||
+        header.geodetic_algorithm < ClosedFormGeodeticAlgorithm ||
+        header.geodetic_algorithm > FukushimaGeodeticAlgorithm) {
+        *error = "The Earth Model snapshot settings are out of range.";
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Copy a section of a checked snapshot into a new array.
+ *
+ * @param array Receives the copy, NULL for a missing section.
+ * @param count Receives the number of elements.
+ * @return 0 on success, -1 if the copy could not be allocated.
+ */
+static int copy_snapshot_section(const char* data, uint32_t kind, void** array, int* count) {
+
+    EarthModelSnapshotSection section;
+
+    *array = NULL;
+    *count = 0;
+    if(!find_snapshot_section(data, kind, &section) || section.count == 0) {
+        return 0;
+    }
+
+    size_t size = (size_t)section.count * section.element_size;
+    *array = malloc(size);
+    if(!*array) {
+        return -1;
+    }
+    memcpy(*array, data + section.offset, size);
+    *count = (int)section.count;
+
+    return 0;
+}
+
+/**
+ * @brief Free a table of an Earth Model unless it lies in the snapshot the model is attached to.
+ */
+static void release_table(EarthModel* model, void* table) {
+
+    if(table && !earth_model_snapshot_holds(model, table)) {
+        free(table);
+    }
+}
+
+/**
+ * @brief Free an EOP table an Earth Model no longer publishes, with those of its arrays not in the model's snapshot.
+ */
+void release_earth_model_eop_table(EarthModel* model, EOPTable* table) {
+
+    if(table) {
+        release_table(model, table->records);
+        release_table(model, table->columns);
+        free(table);
+    }
+}
+
+/**
+ * @brief Replace the tables of an Earth Model with the arrays of each section of a checked snapshot, indexed by kind
+ * less one, releasing its previous tables. The EOP arrays go into eop, which is published in place of the model's
+ * EOP table.
+ */
+static void set_snapshot_tables(EarthModel* model, const char* data, void** arrays, int* counts, EOPTable* eop) {
+
+    EarthModelSnapshotHeader header;
+    EarthModelSnapshotSection section;
+    memcpy(&header, data, sizeof(header));
+
+    find_snapshot_section(data, EllipsoidSnapshotSection, &section);
+    memcpy(&model->ellipsoid, data + section.offset, sizeof(Ellipsoid));
+
+    NutationSeries* series = &model->nutation_series;
+    release_table(model, series->records);
+    release_table(model, series->columns);
+    series->records = (NutationSeriesRecord*)arrays[NutationRecordsSnapshotSection - 1];
+    series->nrecords = counts[NutationRecordsSnapshotSection - 1];
+    series->nrecords_allocated = series->nrecords;
+    series->strategy = (NutationStrategy)header.nutation_strategy;
+    series->columns = (double*)arrays[NutationColumnsSnapshotSection - 1];
+    series->column_stride = series->columns ? header.nutation_column_stride : 0;
+    series->ncolumns = series->columns ? series->nrecords : 0;
+
+    eop->records = (EOPTableRecord*)arrays[EOPRecordsSnapshotSection - 1];
+    eop->nrecords = counts[EOPRecordsSnapshotSection - 1];
+    eop->nrecords_allocated = eop->nrecords;
+    eop->columns = (double*)arrays[EOPColumnsSnapshotSection - 1];
+    eop->column_stride = eop->columns ? eop->nrecords : 0;
+    eop->ncolumns = eop->columns ? eop->nrecords : 0;
+    eop->start = header.eop_start;
+    eop->step = header.eop_step;
+    eop->nindexed = header.eop_nindexed;
+    eop->interpolation = (EOPInterpolation)header.eop_interpolation;
+    rcu_write_lock(&model->earth_orientation_parameters);
+    release_earth_model_eop_table(model, (EOPTable*)rcu_write_unlock(&model->earth_orientation_parameters, eop));
+
+    release_table(model, model->delta_t_table.records);
+    model->delta_t_table.records = (DeltaTTableRecord*)arrays[DeltaTRecordsSnapshotSection - 1];
+    model->delta_t_table.nrecords = counts[DeltaTRecordsSnapshotSection - 1];
+    model->delta_t_table.nrecords_allocated = model->delta_t_table.nrecords;
+    model->delta_t_table.interpolation = (DeltaTInterpolation)header.delta_t_interpolation;
+    model->delta_t_table.extrapolation = (DeltaTExtrapolation)header.delta_t_extrapolation;
+    model->geodetic_algorithm = (GeodeticAlgorithm)header.geodetic_algorithm;
+
+    release_table(model, model->geoid.interpolation);
+    release_table(model, model->geoid.coefficients);
+    model->geoid.interpolation = (double*)arrays[GeoidInterpolationSnapshotSection - 1];
+    model->geoid.interpolation_spacing = header.geoid_interpolation_spacing;
+    model->geoid.coefficients = (SurfaceSphericalHarmonicCoefficients*)arrays[GeoidCoefficientsSnapshotSection - 1];
+    model->geoid.ncoefficients = counts[GeoidCoefficientsSnapshotSection - 1];
+    model->geoid.ncoefficients_allocated = model->geoid.ncoefficients;
+}
+
+/**
+ * @brief Replace the tables of an Earth Model with copies of those of a checked snapshot.
+ */
+int read_earth_model_snapshot(EarthModel* model, const char* data) {
+
+    void* arrays[SNAPSHOT_MAX_SECTIONS];
+    int counts[SNAPSHOT_MAX_SECTIONS];
+    EOPTable* eop = (EOPTable*)malloc(sizeof(EOPTable));
+    int failed = !eop;
+
+    /* Every copy is made before the model is touched so running out of memory leaves it as it was. */
+    for(uint32_t kind = NutationRecordsSnapshotSection; kind <= GeoidCoefficientsSnapshotSection; ++kind) {
+        failed |= copy_snapshot_section(data, kind, &arrays[kind - 1], &counts[kind - 1]);
+    }
+    if(failed) {
+        for(uint32_t kind = NutationRecordsSnapshotSection; kind <= GeoidCoefficientsSnapshotSection; ++kind) {
+            free(arrays[kind - 1]);
+        }
+        free(eop);
+        return -1;
+    }
+
+    set_snapshot_tables(model, data, arrays, counts, eop);
+
+    return 0;
+}
+
+/**
+ * @brief Point the tables of an Earth Model into a checked snapshot held in memory.
+ */
+int attach_earth_model_snapshot(EarthModel* model, const char* data) {
+
+    void* arrays[SNAPSHOT_MAX_SECTIONS];
+    int counts[SNAPSHOT_MAX_SECTIONS];
+    EarthModelSnapshotSection section;
+
+    EOPTable* eop = (EOPTable*)malloc(sizeof(EOPTable));
+    if(!eop) {
+        return -1;
+    }
+
+    for(uint32_t kind = NutationRecordsSnapshotSection; kind <= GeoidCoefficientsSnapshotSection; ++kind) {
+        int found = find_snapshot_section(data, kind, &section) && section.count > 0;
+        arrays[kind - 1] = found ? (void*)(data + section.offset) : NULL;
+        counts[kind - 1] = found ? (int)section.count : 0;
+    }
+
+    set_snapshot_tables(model, data, arrays, counts, eop);
+
+    return 0;
+}
+
+/**
+ * @brief Non-zero if a table lies in the snapshot an Earth Model is attached to.
+ */
+int earth_model_snapshot_holds(const EarthModel* model, const void* table) {
+
+    const char* address = (const char*)table;
+    return model->snapshot.data && address >= model->snapshot.data &&
+        address < model->snapshot.data + model->snapshot.size;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
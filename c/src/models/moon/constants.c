@@ -41,14 +41,14 @@ extern "C"
 /**
  * These coefficients can be found here: https://aa.usno.navy.mil/downloads/Circular_179.pdf
  */
-const long double MEAN_ANOMALY_MOON[5] = {485868.249036, 1717915923.2178, 31.8792, 0.051635, -0.00024470};
-const long double MEAN_ARGUMENT_LATITUDE_MOON[5] = {335779.526232, 1739527262.8478, -12.7512, -0.001037, 0.00000417};
-const long double MEAN_ELONGATION_MOON_FROM_SUN[5] = {1072260.703692, 1602961601.2090, -6.3706, 0.006593, -0.00003169};
-const long double MEAN_LONGITUDE_MOON_MEAN_ASCENDING_NODE[5] = {450160.398036, -6962890.5431, 7.4722, 0.007702,
+const Real MEAN_ANOMALY_MOON[5] = {485868.249036, 1717915923.2178, 31.8792, 0.051635, -0.00024470};
+const Real MEAN_ARGUMENT_LATITUDE_MOON[5] = {335779.526232, 1739527262.8478, -12.7512, -0.001037, 0.00000417};
+const Real MEAN_ELONGATION_MOON_FROM_SUN[5] = {1072260.703692, 1602961601.2090, -6.3706, 0.006593, -0.00003169};
+const Real MEAN_LONGITUDE_MOON_MEAN_ASCENDING_NODE[5] = {450160.398036, -6962890.5431, 7.4722, 0.007702,
     -0.00005939};
-const long double MEAN_LONGITUDE_MOON[3] = {785938.211998, 1732564371.16289, -4.06};
+const Real MEAN_LONGITUDE_MOON[3] = {785938.211998, 1732564371.16289, -4.06};
 
-const long double MEAN_LUNAR_HORIZONTAL_PARALLAX = 0.9508;
+const Real MEAN_LUNAR_HORIZONTAL_PARALLAX = 0.9508;
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -53,43 +53,43 @@ extern "C"
  * @param y The y position of the moon
  * @param z The z position of the moon
  */
-void moon_position(long double t, long double* x, long double* y, long double* z) {
+void moon_position(Real t, Real* x, Real* y, Real* z) {
 
     t = (t-J2000_UNIX_TIME)/ SECONDS_PER_JULIAN_CENTURY;
 
-    long double mean_anomaly_moon = ((((MEAN_ANOMALY_MOON[4] * t + MEAN_ANOMALY_MOON[3]) * t + MEAN_ANOMALY_MOON[2]) * t
+    Real mean_anomaly_moon = ((((MEAN_ANOMALY_MOON[4] * t + MEAN_ANOMALY_MOON[3]) * t + MEAN_ANOMALY_MOON[2]) * t
         + MEAN_ANOMALY_MOON[1]) * t + MEAN_ANOMALY_MOON[0]) * ARCSECONDS_TO_RADIANS;
-    long double mean_anomaly_sun = ((((MEAN_ANOMALY_SUN[4] * t + MEAN_ANOMALY_SUN[3]) * t + MEAN_ANOMALY_SUN[2]) * t
+    Real mean_anomaly_sun = ((((MEAN_ANOMALY_SUN[4] * t + MEAN_ANOMALY_SUN[3]) * t + MEAN_ANOMALY_SUN[2]) * t
         + MEAN_ANOMALY_SUN[1]) * t + MEAN_ANOMALY_SUN[0]) * ARCSECONDS_TO_RADIANS;
-    long double mean_argument_latitude_moon = ((((MEAN_ARGUMENT_LATITUDE_MOON[4] * t + MEAN_ARGUMENT_LATITUDE_MOON[3]) *
+    Real mean_argument_latitude_moon = ((((MEAN_ARGUMENT_LATITUDE_MOON[4] * t + MEAN_ARGUMENT_LATITUDE_MOON[3]) *
         t + MEAN_ARGUMENT_LATITUDE_MOON[2]) * t + MEAN_ARGUMENT_LATITUDE_MOON[1]) * t + MEAN_ARGUMENT_LATITUDE_MOON[0])
         * ARCSECONDS_TO_RADIANS;
-    long double mean_elongation_moon = ((((MEAN_ELONGATION_MOON_FROM_SUN[4] * t + MEAN_ELONGATION_MOON_FROM_SUN[3]) * t
+    Real mean_elongation_moon = ((((MEAN_ELONGATION_MOON_FROM_SUN[4] * t + MEAN_ELONGATION_MOON_FROM_SUN[3]) * t
         + MEAN_ELONGATION_MOON_FROM_SUN[2]) * t + MEAN_ELONGATION_MOON_FROM_SUN[1]) * t +
         MEAN_ELONGATION_MOON_FROM_SUN[0]) * ARCSECONDS_TO_RADIANS;
-    long double e = (((((OBLIQUITY_MEAN_EQUATOR[5] * t + OBLIQUITY_MEAN_EQUATOR[4]) * t + OBLIQUITY_MEAN_EQUATOR[3]) * t
+    Real e = (((((OBLIQUITY_MEAN_EQUATOR[5] * t + OBLIQUITY_MEAN_EQUATOR[4]) * t + OBLIQUITY_MEAN_EQUATOR[3]) * t
         + OBLIQUITY_MEAN_EQUATOR[2]) * t + OBLIQUITY_MEAN_EQUATOR[1]) * t + OBLIQUITY_MEAN_EQUATOR[0]) *
         ARCSECONDS_TO_RADIANS;
 
-    long double eliptic_longitude = ((((MEAN_LONGITUDE_MOON[2] * t + MEAN_LONGITUDE_MOON[1]) * t +
+    Real eliptic_longitude = ((((MEAN_LONGITUDE_MOON[2] * t + MEAN_LONGITUDE_MOON[1]) * t +
         MEAN_LONGITUDE_MOON[0]) * ARCSECONDS_TO_RADIANS * 180/M_PI) +
-        6.29 * sinl(mean_anomaly_moon) - 1.27 * sinl(mean_anomaly_moon - 2 * mean_elongation_moon) +
-        0.66 * sinl(2*mean_elongation_moon) + 0.21 * sinl(2*mean_anomaly_moon) -
-        0.19 * sinl(mean_anomaly_sun) - 0.11 * sinl(2*mean_argument_latitude_moon)) * M_PI / 180.0;
-    long double eliptic_latitude = (5.13 * sinl(mean_argument_latitude_moon) +
-        0.28 * sinl(mean_anomaly_moon + mean_argument_latitude_moon) -
-        0.28 * sinl(mean_argument_latitude_moon- mean_anomaly_moon) -
-        0.17 * sinl(mean_argument_latitude_moon - 2*mean_elongation_moon)) * M_PI / 180.0;
-    long double horizontal_parallax = (MEAN_LUNAR_HORIZONTAL_PARALLAX +
-        0.0518 * cosl(mean_anomaly_moon) +
-        0.0095 * cosl(mean_anomaly_moon - 2*mean_elongation_moon) +
-        0.0078 * cosl(2*mean_elongation_moon) + 0.0028 * cosl(2*mean_anomaly_moon)) * M_PI / 180.0;
-
-    long double magnitude = 1.0/ sinl(horizontal_parallax);
-
-    *x = cosl(eliptic_latitude) * cosl(eliptic_longitude) * magnitude;
-    *y = (cosl(e) * cosl(eliptic_latitude) * sinl(eliptic_longitude) - sinl(e) * sinl(eliptic_latitude)) * magnitude;
-    *z = (sinl(e) * cosl(eliptic_latitude) * sinl(eliptic_longitude) + cosl(e) * sinl(eliptic_latitude)) * magnitude;
+        6.29 * sin(mean_anomaly_moon) - 1.27 * sin(mean_anomaly_moon - 2 * mean_elongation_moon) +
+        0.66 * sin(2*mean_elongation_moon) + 0.21 * sin(2*mean_anomaly_moon) -
+        0.19 * sin(mean_anomaly_sun) - 0.11 * sin(2*mean_argument_latitude_moon)) * M_PI / 180.0;
+    Real eliptic_latitude = (5.13 * sin(mean_argument_latitude_moon) +
+        0.28 * sin(mean_anomaly_moon + mean_argument_latitude_moon) -
+        0.28 * sin(mean_argument_latitude_moon- mean_anomaly_moon) -
+        0.17 * sin(mean_argument_latitude_moon - 2*mean_elongation_moon)) * M_PI / 180.0;
+    Real horizontal_parallax = (MEAN_LUNAR_HORIZONTAL_PARALLAX +
+        0.0518 * cos(mean_anomaly_moon) +
+        0.0095 * cos(mean_anomaly_moon - 2*mean_elongation_moon) +
+        0.0078 * cos(2*mean_elongation_moon) + 0.0028 * cos(2*mean_anomaly_moon)) * M_PI / 180.0;
+
+    Real magnitude = 1.0/ sin(horizontal_parallax);
+
+    *x = cos(eliptic_latitude) * cos(eliptic_longitude) * magnitude;
+    *y = (cos(e) * cos(eliptic_latitude) * sin(eliptic_longitude) - sin(e) * sin(eliptic_latitude)) * magnitude;
+    *z = (sin(e) * cos(eliptic_latitude) * sin(eliptic_longitude) + cos(e) * sin(eliptic_latitude)) * magnitude;
 
 }
 
@@ -101,7 +101,7 @@ static PyObject* get_moon_position(PyObject* self, PyObject* args) {
     PyObject* capsule;
     EarthModel* model;
     double time;
-    long double x, y, z;
+    Real x, y, z;
 
     if (!PyArg_ParseTuple(args, "Od", &capsule, &time)) {
         PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. get_moon_position(double time)");
@@ -114,7 +114,9 @@ static PyObject* get_moon_position(PyObject* self, PyObject* args) {
         return NULL;
     }
 
+    Py_BEGIN_ALLOW_THREADS
     moon_position(time, &x, &y, &z);
+    Py_END_ALLOW_THREADS
     x *= model->ellipsoid.a;
     y *= model->ellipsoid.a;
     z *= model->ellipsoid.a;
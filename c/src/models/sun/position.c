@@ -51,23 +51,23 @@ extern "C"
  * @param y The y position of the sun
  * @param z The z position of the sun
  */
-void sun_position(long double t, long double* x, long double* y, long double* z) {
+void sun_position(Real t, Real* x, Real* y, Real* z) {
 
     t = (t-J2000_UNIX_TIME)/ SECONDS_PER_JULIAN_CENTURY;
 
-    long double L = ((MEAN_LONGITUDE_SUN[2] * t + MEAN_LONGITUDE_SUN[1]) * t + MEAN_LONGITUDE_SUN[0]) * M_PI / 180.0;
-    long double M = ((((MEAN_ANOMALY_SUN[4] * t + MEAN_ANOMALY_SUN[3]) * t + MEAN_ANOMALY_SUN[2]) * t +
+    Real L = ((MEAN_LONGITUDE_SUN[2] * t + MEAN_LONGITUDE_SUN[1]) * t + MEAN_LONGITUDE_SUN[0]) * M_PI / 180.0;
+    Real M = ((((MEAN_ANOMALY_SUN[4] * t + MEAN_ANOMALY_SUN[3]) * t + MEAN_ANOMALY_SUN[2]) * t +
         MEAN_ANOMALY_SUN[1]) * t + MEAN_ANOMALY_SUN[0]) * ARCSECONDS_TO_RADIANS;
-    long double e = (((((OBLIQUITY_MEAN_EQUATOR[5] * t + OBLIQUITY_MEAN_EQUATOR[4]) * t + OBLIQUITY_MEAN_EQUATOR[3]) * t
+    Real e = (((((OBLIQUITY_MEAN_EQUATOR[5] * t + OBLIQUITY_MEAN_EQUATOR[4]) * t + OBLIQUITY_MEAN_EQUATOR[3]) * t
         + OBLIQUITY_MEAN_EQUATOR[2]) * t + OBLIQUITY_MEAN_EQUATOR[1]) * t + OBLIQUITY_MEAN_EQUATOR[0]) *
         ARCSECONDS_TO_RADIANS;
 
     L += 0.033423055 * sin(M) + 0.0003490659 * sin(2 * M);
-    long double magnitude = (1.000140612 - 0.016708617 * cosl(M) - 0.000139589 * cosl(2*M)) * ASTRO_UNIT_TO_METERS;
+    Real magnitude = (1.000140612 - 0.016708617 * cos(M) - 0.000139589 * cos(2*M)) * ASTRO_UNIT_TO_METERS;
 
-    *x = magnitude * cosl(L);
-    *y = magnitude * cosl(e) * sinl(L);
-    *z = magnitude * sinl(e) * sinl(L);
+    *x = magnitude * cos(L);
+    *y = magnitude * cos(e) * sin(L);
+    *z = magnitude * sin(e) * sin(L);
 
 }
 
@@ -77,14 +77,16 @@ void sun_position(long double t, long double* x, long double* y, long double* z)
 static PyObject* get_sun_position(PyObject* self, PyObject* args) {
 
     double time;
-    long double x, y, z;
+    Real x, y, z;
 
     if (!PyArg_ParseTuple(args, "d", &time)) {
         PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. get_sun_position(double time)");
         return NULL;
     }
 
+    Py_BEGIN_ALLOW_THREADS
     sun_position(time, &x, &y, &z);
+    Py_END_ALLOW_THREADS
 
     return Py_BuildValue("ddd", (double)x, (double)y, (double)z);
 }
@@ -37,7 +37,6 @@ extern "C"
 {
 #endif
 
-#define __compile_coordinates_state_vector__
 #define __compile_math_linear_algebra__
 #define __compile_models_earth_nutation__
 
@@ -54,19 +53,22 @@ extern "C"
 #include "opencl/context.h"
 #include "time/constants.h"
 
+/* The StateVector type, imported from the state vector extension when the module is initialised. */
+static StateVectorAPI* state_vector_api = NULL;
+
 /**
  * @brief Converts itrf coordinates to the equivalent gcrf coordinates.
  */
 static PyObject* opencl_itrf_to_gcrf(PyObject *self, PyObject *args) {
 
     PyObject* opencl_kernel;
-    PyObject* state_vector_capsule;
+    PyObject* state_vector_object;
     PyObject* model_capsule;
     OpenCLKernel* kernel;
     StateVector* state_vector;
     EarthModel* model;
 
-    if(!PyArg_ParseTuple(args, "OOO", &opencl_kernel, &state_vector_capsule, &model_capsule)) {
+    if(!PyArg_ParseTuple(args, "OOO", &opencl_kernel, &state_vector_object, &model_capsule)) {
         PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. itrf_to_geodetic()");
         return PyErr_Occurred();
     }
@@ -77,10 +79,9 @@ static PyObject* opencl_itrf_to_gcrf(PyObject *self, PyObject *args) {
         return PyErr_Occurred();
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(state_vector_capsule, "StateVector");
+    state_vector = state_vector_from_object(state_vector_api, state_vector_object, "itrf_to_gcrf");
     if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from Capsule.");
-        return PyErr_Occurred();
+        return NULL;
     }
 
     if(state_vector->frame != InternationalTerrestrialReferenceFrame) {
@@ -99,11 +100,11 @@ static PyObject* opencl_itrf_to_gcrf(PyObject *self, PyObject *args) {
     Vec3 coriolis_acceleration, coriolis_acceleration_prime;
     Vec3 centrifugal_acceleration, centrifugal_acceleration_prime;
 
-    StateVector* retval = (StateVector*)malloc(sizeof(StateVector));
-    if(!retval) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_StateVector.");
-        return PyErr_Occurred();
+    StateVectorObject* retval_object = state_vector_api->new_object(Py_TYPE(state_vector_object));
+    if(!retval_object) {
+        return NULL;
     }
+    StateVector* retval = &retval_object->state_vector;
     StateVector temp;
 
     temp.r.x = coriolis_velocity.x = state_vector->r.x;
@@ -119,23 +120,26 @@ static PyObject* opencl_itrf_to_gcrf(PyObject *self, PyObject *args) {
     retval->time = state_vector->time;
     retval->frame = GeocentricCelestialReferenceFrame;
 
-    long double gast;
+    Real gast;
     gmst(state_vector->time, model, &gast);
 
-    long double nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
+    Real nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
     nutation_values_of_date_opencl(kernel, state_vector->time, &model->nutation_series, &nutation_longitude, &nutation_obliquity,
         &mean_obliquity_date, &equation_of_the_equinoxes);
 
     gast += equation_of_the_equinoxes/15.0;
 
-    wobble(state_vector->time, &model->earth_orientation_parameters, &matrix);
+    long version;
+    EOPTable* eop_table = (EOPTable*)rcu_read_lock(&model->earth_orientation_parameters, &version);
+    wobble(state_vector->time, eop_table, &matrix);
+    rcu_read_unlock(&model->earth_orientation_parameters, version);
     dot_product(&matrix, &temp.r, &retval->r);
     dot_product(&matrix, &temp.v, &retval->v);
     dot_product(&matrix, &temp.a, &retval->a);
     dot_product(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
     dot_product(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
 
-    long double rate;
+    Real rate;
     Vec3 coriolis_rotation;
     rate_of_earth_rotation(state_vector->time, model, &rate);
     coriolis_rotation.x = 0.0;
@@ -190,7 +194,7 @@ static PyObject* opencl_itrf_to_gcrf(PyObject *self, PyObject *args) {
     retval->a.y += coriolis_acceleration.y + centrifugal_acceleration.y;
     retval->a.z += coriolis_acceleration.z + centrifugal_acceleration.z;
 
-    return PyCapsule_New(retval, "StateVector", delete_StateVector);
+    return (PyObject*)retval_object;
 }
 
 /**
@@ -198,20 +202,19 @@ static PyObject* opencl_itrf_to_gcrf(PyObject *self, PyObject *args) {
  */
 static PyObject* opencl_gcrf_to_itrf(PyObject *self, PyObject *args) {
 
-    PyObject* state_vector_capsule;
+    PyObject* state_vector_object;
     PyObject* model_capsule;
     StateVector* state_vector;
     EarthModel* model;
 
-    if(!PyArg_ParseTuple(args, "OO", &state_vector_capsule, &model_capsule)) {
+    if(!PyArg_ParseTuple(args, "OO", &state_vector_object, &model_capsule)) {
         PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. itrf_to_geodetic()");
         return PyErr_Occurred();
     }
 
-    state_vector = (StateVector*)PyCapsule_GetPointer(state_vector_capsule, "StateVector");
+    state_vector = state_vector_from_object(state_vector_api, state_vector_object, "gcrf_to_itrf");
     if(!state_vector) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to get the StateVector from Capsule.");
-        return PyErr_Occurred();
+        return NULL;
     }
 
     if(state_vector->frame != GeocentricCelestialReferenceFrame) {
@@ -230,11 +233,11 @@ static PyObject* opencl_gcrf_to_itrf(PyObject *self, PyObject *args) {
     Vec3 coriolis_acceleration, coriolis_acceleration_prime;
     Vec3 centrifugal_acceleration, centrifugal_acceleration_prime;
 
-    StateVector* retval = (StateVector*)malloc(sizeof(StateVector));
-    if(!retval) {
-        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for new_StateVector.");
-        return PyErr_Occurred();
+    StateVectorObject* retval_object = state_vector_api->new_object(Py_TYPE(state_vector_object));
+    if(!retval_object) {
+        return NULL;
     }
+    StateVector* retval = &retval_object->state_vector;
     StateVector temp;
 
     temp.r.x = coriolis_velocity.x = state_vector->r.x;
@@ -250,10 +253,10 @@ static PyObject* opencl_gcrf_to_itrf(PyObject *self, PyObject *args) {
     retval->time = state_vector->time;
     retval->frame = InternationalTerrestrialReferenceFrame;
 
-    long double gast;
+    Real gast;
     gmst(state_vector->time, model, &gast);
 
-    long double nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
+    Real nutation_longitude, nutation_obliquity, mean_obliquity_date, equation_of_the_equinoxes;
     nutation_values_of_date_opencl(state_vector->time, &model->nutation_series, &nutation_longitude, &nutation_obliquity,
         &mean_obliquity_date, &equation_of_the_equinoxes);
 
@@ -280,7 +283,7 @@ static PyObject* opencl_gcrf_to_itrf(PyObject *self, PyObject *args) {
     dot_product_transpose(&matrix, &coriolis_velocity, &coriolis_velocity_prime);
     dot_product_transpose(&matrix, &centrifugal_acceleration, &centrifugal_acceleration_prime);
 
-    long double rate;
+    Real rate;
     Vec3 coriolis_rotation;
     rate_of_earth_rotation(state_vector->time, model, &rate);
     coriolis_rotation.x = 0.0;
@@ -304,7 +307,10 @@ static PyObject* opencl_gcrf_to_itrf(PyObject *self, PyObject *args) {
     dot_product_transpose(&matrix, &coriolis_acceleration, &coriolis_acceleration_prime);
     dot_product_transpose(&matrix, &centrifugal_acceleration, &centrifugal_acceleration_prime);
 
-    wobble(state_vector->time, &model->earth_orientation_parameters, &matrix);
+    long version;
+    EOPTable* eop_table = (EOPTable*)rcu_read_lock(&model->earth_orientation_parameters, &version);
+    wobble(state_vector->time, eop_table, &matrix);
+    rcu_read_unlock(&model->earth_orientation_parameters, version);
     dot_product_transpose(&matrix, &temp.r, &retval->r);
     dot_product_transpose(&matrix, &temp.v, &retval->v);
     dot_product_transpose(&matrix, &temp.a, &retval->a);
@@ -319,7 +325,7 @@ static PyObject* opencl_gcrf_to_itrf(PyObject *self, PyObject *args) {
     retval->a.y -= coriolis_acceleration.y - centrifugal_acceleration.y;
     retval->a.z -= coriolis_acceleration.z - centrifugal_acceleration.z;
 
-    return PyCapsule_New(retval, "StateVector", delete_StateVector);
+    return (PyObject*)retval_object;
 }
 
 
@@ -340,6 +346,12 @@ static struct PyModuleDef coordinates_transform = {
 
 
 PyMODINIT_FUNC PyInit_transform(void) {
+
+    state_vector_api = import_state_vector_api();
+    if(!state_vector_api) {
+        return NULL;
+    }
+
     return PyModule_Create(&coordinates_transform);
 }
 
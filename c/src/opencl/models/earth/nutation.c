@@ -48,9 +48,9 @@ extern "C"
 /**
  * @brief Compute nutation values of date along with the equation of the equinoxes.
  */
-void nutation_values_of_date_opencl(OpenCLKernel* kernel, long double t, NutationSeries* series,
-        long double* nutation_longitude, long double* nutation_obliquity, long double* mean_obliquity_date,
-        long double* equation_of_the_equinoxes) {
+void nutation_values_of_date_opencl(OpenCLKernel* kernel, Real t, NutationSeries* series,
+        Real* nutation_longitude, Real* nutation_obliquity, Real* mean_obliquity_date,
+        Real* equation_of_the_equinoxes) {
     *nutation_longitude = 0.0;
     *nutation_obliquity = 0.0;
     *mean_obliquity_date = 0.0;
@@ -155,8 +155,8 @@ void nutation_values_of_date_opencl(OpenCLKernel* kernel, long double t, Nutatio
     *mean_obliquity_date = ((((MEAN_OBLIQUITY_EARTH[5] * t + MEAN_OBLIQUITY_EARTH[4]) * t
         + MEAN_OBLIQUITY_EARTH[3]) * t + MEAN_OBLIQUITY_EARTH[2]) * t + MEAN_OBLIQUITY_EARTH[1]) * t
         + MEAN_OBLIQUITY_EARTH[0];
-    *equation_of_the_equinoxes = nutation_values[2] + *nutation_longitude * cosl(*nutation_obliquity * ARCSECONDS_TO_RADIANS) +
-        0.00000087 * t * sinl(nutation_critical_arguments[13] * ARCSECONDS_TO_RADIANS);
+    *equation_of_the_equinoxes = nutation_values[2] + *nutation_longitude * cos(*nutation_obliquity * ARCSECONDS_TO_RADIANS) +
+        0.00000087 * t * sin(nutation_critical_arguments[13] * ARCSECONDS_TO_RADIANS);
 
     if (nutation_values) {
         free(nutation_values);
@@ -24,8 +24,15 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
 #define __compile_time_delta_t__
 #include "time/delta_t.h"
+#include "util/buffer.h"
+#include "util/capacity.h"
+#include "util/mapped_file.h"
 
 #if defined(_WIN32) || defined(WIN32)     /* _Win32 is usually defined by compilers targeting 32 or 64 bit Windows systems */
 
@@ -40,20 +47,184 @@ extern "C"
 #endif
 
 
-void delta_t_record_lookup(DeltaTTable* table, long double timestamp, DeltaTTableRecord* record) {
+/** @struct
+ * @brief A piece of the Delta T polynomial model, sum of coefficients[k] * ((year - origin) / scale)^k.
+ */
+typedef struct {
+    double end_year;
+    double origin;
+    double scale;
+    int ncoefficients;
+    double coefficients[8];
+} DeltaTPolynomial;
+
+/* Espenak and Meeus, Five Millennium Canon of Solar Eclipses (2006), in order of the year each piece ends. The piece
+ * from 2050 to 2150 is their parabola less 0.5628 (2150 - year) expanded in the same u. */
+static const DeltaTPolynomial delta_t_polynomials[] = {
+    {-500.0, 1820.0, 100.0, 3, {-20.0, 0.0, 32.0}},
+    {500.0, 0.0, 100.0, 7, {10583.6, -1014.41, 33.78311, -5.952053, -0.1798452, 0.022174192, 0.0090316521}},
+    {1600.0, 1000.0, 100.0, 7, {1574.2, -556.01, 71.23472, 0.319781, -0.8503463, -0.005050998, 0.0083572073}},
+    {1700.0, 1600.0, 1.0, 4, {120.0, -0.9808, -0.01532, 1.0 / 7129.0}},
+    {1800.0, 1700.0, 1.0, 5, {8.83, 0.1603, -0.0059285, 0.00013336, -1.0 / 1174000.0}},
+    {1860.0, 1800.0, 1.0, 8, {13.72, -0.332447, 0.0068612, 0.0041116, -0.00037436, 0.0000121272, -0.0000001699,
+        0.000000000875}},
+    {1900.0, 1860.0, 1.0, 6, {7.62, 0.5737, -0.251754, 0.01680668, -0.0004473624, 1.0 / 233174.0}},
+    {1920.0, 1900.0, 1.0, 5, {-2.79, 1.494119, -0.0598939, 0.0061966, -0.000197}},
+    {1941.0, 1920.0, 1.0, 4, {21.20, 0.84493, -0.076100, 0.0020936}},
+    {1961.0, 1950.0, 1.0, 4, {29.07, 0.407, -1.0 / 233.0, 1.0 / 2547.0}},
+    {1986.0, 1975.0, 1.0, 4, {45.45, 1.067, -1.0 / 260.0, -1.0 / 718.0}},
+    {2005.0, 2000.0, 1.0, 6, {63.86, 0.3345, -0.060374, 0.0017275, 0.000651814, 0.00002373599}},
+    {2050.0, 2000.0, 1.0, 3, {62.92, 0.32217, 0.005589}},
+    {2150.0, 1820.0, 100.0, 3, {-205.724, 56.28, 32.0}},
+    {DBL_MAX, 1820.0, 100.0, 3, {-20.0, 0.0, 32.0}},
+};
+
 
-    int lower = 0, upper = (table->nrecords)-1, pointer = upper;
+/**
+ * @brief Set up an empty Delta T table, interpolated linearly and extrapolated with the polynomial model.
+ */
+void init_delta_t_table(DeltaTTable* table) {
 
+    table->nrecords = 0;
+    table->nrecords_allocated = 0;
+    table->records = NULL;
+    table->interpolation = LinearDeltaTInterpolation;
+    table->extrapolation = PolynomialDeltaTExtrapolation;
+}
+
+/**
+ * @brief Find the record at or before a timestamp, clamped to the table. Starts from where the previous lookup landed
+ * if given a cursor, a time ordered run of epochs stays in the same interval or steps into the next one and anything
+ * else falls back to a binary search.
+ */
+int delta_t_table_index(DeltaTTable* table, Real timestamp, int* cursor) {
+
+    const int nrecords = table->nrecords;
+    const DeltaTTableRecord* records = table->records;
+
+    if(cursor) {
+        for(int i = *cursor; i >= 0 && i < nrecords && i <= *cursor + 1; ++i) {
+            if(i > 0 && records[i].timestamp > timestamp) {
+                break;
+            }
+            if(i + 1 >= nrecords || timestamp < records[i+1].timestamp) {
+                *cursor = i;
+                return i;
+            }
+        }
+    }
+
+    int lower = 0, upper = nrecords;
+
+    /* records[lower] <= timestamp < records[upper] */
     while(upper - lower > 1) {
-        pointer = (upper + lower) / 2;
-        if(table->records[pointer].timestamp > timestamp) {
+        int pointer = (upper + lower) / 2;
+        if(records[pointer].timestamp > timestamp) {
             upper = pointer;
         } else {
             lower = pointer;
         }
-        *record = table->records[pointer];
     }
 
+    if(cursor) {
+        *cursor = lower;
+    }
+    return lower;
+}
+
+/**
+ * @brief Look up the Delta T record at or before a timestamp. Zero for an empty table.
+ */
+void delta_t_record_lookup(DeltaTTable* table, Real timestamp, DeltaTTableRecord* record) {
+    delta_t_record_lookup_from(table, timestamp, NULL, record);
+}
+
+/**
+ * @brief Look up the Delta T record at or before a timestamp, finding it from a cursor if given.
+ */
+void delta_t_record_lookup_from(DeltaTTable* table, Real timestamp, int* cursor, DeltaTTableRecord* record) {
+
+    if(table->nrecords < 1) {
+        record->timestamp = timestamp;
+        record->deltaT = 0.0;
+        return;
+    }
+
+    *record = table->records[delta_t_table_index(table, timestamp, cursor)];
+}
+
+/**
+ * @brief The polynomial model of Delta T of Espenak and Meeus, used past the ends of the table.
+ */
+Real delta_t_polynomial(Real timestamp) {
+
+    Real year = DELTA_T_UNIX_EPOCH_YEAR + timestamp / DELTA_T_SECONDS_PER_YEAR;
+
+    /* Bounded by the table rather than by its last piece ending at DBL_MAX, an infinite year runs past that too. */
+    const DeltaTPolynomial* piece = delta_t_polynomials;
+    const DeltaTPolynomial* last = delta_t_polynomials + sizeof(delta_t_polynomials) / sizeof(*delta_t_polynomials) - 1;
+    while(piece < last && year >= piece->end_year) ++piece;
+
+    Real u = (year - piece->origin) / piece->scale;
+    Real value = piece->coefficients[piece->ncoefficients - 1];
+    for(int k = piece->ncoefficients - 2; k >= 0; --k) {
+        value = value * u + piece->coefficients[k];
+    }
+
+    return value;
+}
+
+/**
+ * @brief Delta T past an end of the table, either held at the end record or from the polynomial model offset to meet
+ * the end record and fading back to the bare model over DELTA_T_EXTRAPOLATION_BLEND_YEARS.
+ */
+static Real extrapolate_delta_t(const DeltaTTable* table, const DeltaTTableRecord* end, Real timestamp) {
+
+    if(table->extrapolation != PolynomialDeltaTExtrapolation) {
+        return end->deltaT;
+    }
+
+    Real value = delta_t_polynomial(timestamp);
+    Real blend = 1.0 - fabs(timestamp - end->timestamp) / (DELTA_T_EXTRAPOLATION_BLEND_YEARS *
+        DELTA_T_SECONDS_PER_YEAR);
+    if(blend > 0.0) {
+        value += (end->deltaT - delta_t_polynomial(end->timestamp)) * blend;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Evaluate Delta T at a timestamp as set by the table's interpolation and extrapolation.
+ */
+Real delta_t_of_date(DeltaTTable* table, Real timestamp, int* cursor) {
+
+    const int nrecords = table->nrecords;
+    const DeltaTTableRecord* records = table->records;
+
+    if(nrecords < 1) {
+        return 0.0;
+    }
+    if(isnan(timestamp)) {
+        return timestamp;
+    }
+    if(timestamp < records[0].timestamp) {
+        return extrapolate_delta_t(table, &records[0], timestamp);
+    }
+    if(timestamp > records[nrecords-1].timestamp) {
+        return extrapolate_delta_t(table, &records[nrecords-1], timestamp);
+    }
+
+    int i = delta_t_table_index(table, timestamp, cursor);
+    if(table->interpolation == LinearDeltaTInterpolation && i + 1 < nrecords) {
+        Real span = records[i+1].timestamp - records[i].timestamp;
+        if(span > 0.0) {
+            return records[i].deltaT + (records[i+1].deltaT - records[i].deltaT) * (timestamp - records[i].timestamp) /
+                span;
+        }
+    }
+
+    return records[i].deltaT;
 }
 
 
@@ -76,22 +247,408 @@ static PyObject* delta_t_add_record(PyObject* self, PyObject* args) {
         return PyErr_Occurred();
     }
 
-    if (table->nrecords_allocated < table->nrecords+1) {
-        table->nrecords_allocated += 100;
-        DeltaTTableRecord* new_table = (DeltaTTableRecord*)malloc(table->nrecords_allocated * sizeof(DeltaTTableRecord));
-        if(!new_table) {
-            PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for DeltaTTable records.");
-            return PyErr_Occurred();
-        }
-        memcpy(new_table, table->records, table->nrecords * sizeof(DeltaTTableRecord));
-        free(table->records);
-        table->records = new_table;
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + 1LL,
+        sizeof(DeltaTTableRecord)) != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for DeltaTTable records.");
+        return PyErr_Occurred();
     }
 
     table->records[table->nrecords].timestamp = timestamp;
     table->records[table->nrecords++].deltaT = deltaT;
 
-    return Py_BuildValue("i", table->records[table->nrecords].timestamp);
+    return Py_BuildValue("i", table->nrecords);
+}
+
+/**
+ * @brief Orders Delta T table records by timestamp for qsort.
+ */
+static int compare_delta_t_records(const void* a, const void* b) {
+
+    Real lhs = ((const DeltaTTableRecord*)a)->timestamp, rhs = ((const DeltaTTableRecord*)b)->timestamp;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @brief Restore the time order of the table after records were appended from first on, sorting only if they broke it.
+ */
+static void sort_appended_delta_t_records(DeltaTTable* table, int first) {
+
+    for(int i = first > 0 ? first : 1; i < table->nrecords; ++i) {
+        if(table->records[i-1].timestamp > table->records[i].timestamp) {
+            qsort(table->records, table->nrecords, sizeof(DeltaTTableRecord), compare_delta_t_records);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Add a buffer of timestamp, Delta T pairs to the table, reserving room for all of them at once and sorting the
+ * table once at the end if they broke its order.
+ */
+static PyObject* delta_t_add_records(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* rows_obj;
+    DeltaTTable* table;
+    Py_buffer rows;
+    Py_ssize_t nvalues;
+
+    if(!PyArg_ParseTuple(args, "OO", &capsule, &rows_obj)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. add_records()");
+        return NULL;
+    }
+
+    table = (DeltaTTable*)PyCapsule_GetPointer(capsule, "DeltaTTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the DeltaTTable from capsule.");
+        return NULL;
+    }
+
+    if(get_double_buffer(rows_obj, &rows, 0, &nvalues) < 0) {
+        return NULL;
+    }
+
+    if(nvalues % 2 != 0) {
+        PyBuffer_Release(&rows);
+        PyErr_SetString(PyExc_ValueError, "add_records() expects N*2 values.");
+        return NULL;
+    }
+
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + (long long)nvalues / 2,
+        sizeof(DeltaTTableRecord)) != 0) {
+        PyBuffer_Release(&rows);
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for DeltaTTable records.");
+        return NULL;
+    }
+
+    const double* values = (const double*)rows.buf;
+    int first = table->nrecords;
+    for(Py_ssize_t i = 0; i < nvalues; i += 2) {
+        DeltaTTableRecord* record = &table->records[table->nrecords++];
+        record->timestamp = (Real)values[i];
+        record->deltaT = (Real)values[i+1];
+    }
+    PyBuffer_Release(&rows);
+
+    sort_appended_delta_t_records(table, first);
+
+    return Py_BuildValue("i", table->nrecords);
+}
+
+/**
+ * @brief Days from the UNIX epoch to a date of the proleptic Gregorian calendar.
+ */
+static long long days_from_civil(long long year, int month, int day) {
+
+    year -= month <= 2;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    long long year_of_era = year - era * 400;
+    long long day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    long long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+    return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * @brief Parse the next whitespace separated field of a line as a number.
+ *
+ * @param cursor Where the field is looked for, moved past it.
+ * @param end The end of the line.
+ * @param value The parsed number.
+ * @return 0 on success, -1 if the line has no more fields or the field is not a number.
+ */
+static int parse_field(const char** cursor, const char* end, double* value) {
+
+    char field[32];
+    size_t n = 0;
+    const char* column = *cursor;
+    char* parsed;
+
+    while(column < end && (*column == ' ' || *column == '\t')) ++column;
+    while(column < end && *column != ' ' && *column != '\t') {
+        if(n == sizeof(field) - 1) return -1;
+        field[n++] = *column++;
+    }
+    if(n == 0) return -1;
+    field[n] = '\0';
+
+    *value = strtod(field, &parsed);
+    *cursor = column;
+
+    return *parsed == '\0' ? 0 : -1;
+}
+
+/**
+ * @brief Parse a "year month day Delta T" line of a deltat.data file into a record stamped with the UNIX time of the
+ * date at midnight UTC.
+ *
+ * @param line The line, without its line break.
+ * @param length The length of the line.
+ * @param record The parsed record.
+ * @return 0 on success, -1 if the line is not a record.
+ */
+static int parse_delta_t_line(const char* line, size_t length, DeltaTTableRecord* record) {
+
+    const char* cursor = line;
+    const char* end = line + length;
+    double year, month, day, deltaT;
+
+    if(parse_field(&cursor, end, &year) != 0 || parse_field(&cursor, end, &month) != 0 ||
+        parse_field(&cursor, end, &day) != 0 || parse_field(&cursor, end, &deltaT) != 0 ||
+        year != (long long)year || month < 1 || month > 12 || month != (int)month || day < 1 || day > 31 ||
+        day != (int)day) {
+        return -1;
+    }
+
+    record->timestamp = (Real)days_from_civil((long long)year, (int)month, (int)day) * 86400.0;
+    record->deltaT = deltaT;
+
+    return 0;
+}
+
+/**
+ * @brief Parse a memory mapped deltat.data file in one pass, appending its records to the Delta T table and sorting
+ * them with the existing records once at the end.
+ *
+ * @param table The Delta T table.
+ * @param file The mapped file.
+ * @return 0 on success, -1 if the records could not be allocated.
+ */
+static int load_delta_t(DeltaTTable* table, MappedFile* file) {
+
+    const char* data = file->data;
+    const char* end = file->data + file->size;
+    size_t nlines = 0;
+
+    for(const char* cursor = data; cursor && cursor < end; ++nlines) {
+        const char* newline = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+        cursor = newline ? newline + 1 : end;
+    }
+
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated, table->nrecords + (long long)nlines,
+        sizeof(DeltaTTableRecord)) != 0) {
+        return -1;
+    }
+
+    int first = table->nrecords;
+    for(const char* cursor = data; cursor && cursor < end;) {
+        const char* newline = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+        const char* line_end = newline ? newline : end;
+        size_t length = (size_t)(line_end - cursor);
+        if(length > 0 && cursor[length-1] == '\r') --length;
+
+        if(parse_delta_t_line(cursor, length, &table->records[table->nrecords]) == 0) {
+            table->nrecords++;
+        }
+
+        cursor = newline ? newline + 1 : end;
+    }
+
+    sort_appended_delta_t_records(table, first);
+
+    return 0;
+}
+
+/**
+ * @brief Move the records of a table parsed on its own into the Delta T table. An empty table takes the parsed records
+ * over, otherwise they are appended and freed.
+ *
+ * @param table The Delta T table.
+ * @param loaded The parsed table, its records are always taken over or freed.
+ * @return 0 on success, -1 if memory could not be allocated, leaving the Delta T table as it was.
+ */
+static int merge_delta_t_table(DeltaTTable* table, DeltaTTable* loaded) {
+
+    if(table->nrecords == 0) {
+        free(table->records);
+        table->nrecords = loaded->nrecords;
+        table->nrecords_allocated = loaded->nrecords_allocated;
+        table->records = loaded->records;
+        return 0;
+    }
+
+    int retval = -1;
+    if(reserve_capacity((void**)&table->records, &table->nrecords_allocated,
+        table->nrecords + (long long)loaded->nrecords, sizeof(DeltaTTableRecord)) == 0) {
+        int first = table->nrecords;
+        if(loaded->nrecords > 0) {
+            memcpy(table->records + first, loaded->records, loaded->nrecords * sizeof(DeltaTTableRecord));
+        }
+        table->nrecords += loaded->nrecords;
+        sort_appended_delta_t_records(table, first);
+        retval = 0;
+    }
+    free(loaded->records);
+
+    return retval;
+}
+
+/**
+ * @brief Load the records of a deltat.data file into the Delta T table
+ */
+static PyObject* delta_t_load_file(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* path;
+    DeltaTTable* table;
+    MappedFile file;
+    int retval;
+
+    if(!PyArg_ParseTuple(args, "OO&", &capsule, PyUnicode_FSConverter, &path)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. load_file()");
+        return NULL;
+    }
+
+    table = (DeltaTTable*)PyCapsule_GetPointer(capsule, "DeltaTTable");
+    if(!table) {
+        Py_DECREF(path);
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the DeltaTTable from capsule.");
+        return NULL;
+    }
+
+    if(map_file(PyBytes_AS_STRING(path), &file) != 0) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_OSError, path);
+        Py_DECREF(path);
+        return NULL;
+    }
+    Py_DECREF(path);
+
+    /* Parsed into a table of its own, other threads may use this one until it is merged in with the GIL held. */
+    DeltaTTable loaded;
+    init_delta_t_table(&loaded);
+
+    Py_BEGIN_ALLOW_THREADS
+    retval = load_delta_t(&loaded, &file);
+    unmap_file(&file);
+    Py_END_ALLOW_THREADS
+
+    if(retval != 0) {
+        free(loaded.records);
+    } else {
+        retval = merge_delta_t_table(table, &loaded);
+    }
+
+    if(retval != 0) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to allocate memory for DeltaTTable records.");
+        return NULL;
+    }
+
+    return Py_BuildValue("i", table->nrecords);
+}
+
+/**
+ * @brief Set how a Delta T table is interpolated between records
+ */
+static PyObject* delta_t_set_interpolation(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    DeltaTTable* table;
+    int interpolation;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &interpolation)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_interpolation()");
+        return NULL;
+    }
+
+    if(interpolation < StepDeltaTInterpolation || interpolation > LinearDeltaTInterpolation) {
+        PyErr_SetString(PyExc_ValueError, "Unknown Delta T interpolation.");
+        return NULL;
+    }
+
+    table = (DeltaTTable*)PyCapsule_GetPointer(capsule, "DeltaTTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the DeltaTTable from capsule.");
+        return NULL;
+    }
+
+    table->interpolation = (DeltaTInterpolation)interpolation;
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Set how a Delta T table is extrapolated outside its records
+ */
+static PyObject* delta_t_set_extrapolation(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    DeltaTTable* table;
+    int extrapolation;
+
+    if(!PyArg_ParseTuple(args, "Oi", &capsule, &extrapolation)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. set_extrapolation()");
+        return NULL;
+    }
+
+    if(extrapolation < ClampDeltaTExtrapolation || extrapolation > PolynomialDeltaTExtrapolation) {
+        PyErr_SetString(PyExc_ValueError, "Unknown Delta T extrapolation.");
+        return NULL;
+    }
+
+    table = (DeltaTTable*)PyCapsule_GetPointer(capsule, "DeltaTTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the DeltaTTable from capsule.");
+        return NULL;
+    }
+
+    table->extrapolation = (DeltaTExtrapolation)extrapolation;
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * @brief Evaluate Delta T at a buffer of times in one call.
+ */
+static PyObject* delta_t_lookup(PyObject* self, PyObject* args) {
+
+    PyObject* capsule;
+    PyObject* times_obj;
+    PyObject* out_obj;
+    DeltaTTable* table;
+    Py_buffer times, out;
+    Py_ssize_t ntimes, nout;
+
+    if(!PyArg_ParseTuple(args, "OOO", &capsule, &times_obj, &out_obj)) {
+        PyErr_SetString(PyExc_TypeError, "Unable to parse arguments. lookup()");
+        return NULL;
+    }
+
+    table = (DeltaTTable*)PyCapsule_GetPointer(capsule, "DeltaTTable");
+    if(!table) {
+        PyErr_SetString(PyExc_MemoryError, "Unable to get the DeltaTTable from capsule.");
+        return NULL;
+    }
+
+    if(get_double_buffer(times_obj, &times, 0, &ntimes) < 0) {
+        return NULL;
+    }
+    if(get_double_buffer(out_obj, &out, 1, &nout) < 0) {
+        PyBuffer_Release(&times);
+        return NULL;
+    }
+
+    if(nout != ntimes) {
+        PyBuffer_Release(&times);
+        PyBuffer_Release(&out);
+        PyErr_SetString(PyExc_ValueError, "lookup() expects N times and an N output buffer of doubles.");
+        return NULL;
+    }
+
+    const double* t = (const double*)times.buf;
+    double* values = (double*)out.buf;
+    int cursor = 0;
+
+    /* The cursor walks a time ordered batch through the table without searching it for every time. */
+    Py_BEGIN_ALLOW_THREADS
+    for(Py_ssize_t i = 0; i < ntimes; ++i) {
+        values[i] = (double)delta_t_of_date(table, t[i], &cursor);
+    }
+    Py_END_ALLOW_THREADS
+
+    PyBuffer_Release(&times);
+    PyBuffer_Release(&out);
+
+    Py_RETURN_NONE;
 }
 
 
@@ -104,9 +661,7 @@ static PyObject* new_DeltaTTable(PyObject* self, PyObject* args)  {
         return PyErr_Occurred();
     }
 
-    table->nrecords = 0;
-    table->nrecords_allocated = 0;
-    table->records = NULL;
+    init_delta_t_table(table);
 
     return PyCapsule_New(table, "DeltaTTable", delete_DeltaTTable);
 }
@@ -128,6 +683,11 @@ static void delete_DeltaTTable(PyObject* obj) {
 
 static PyMethodDef tolueneTimeDeltaTMethods[] = {
     {"add_record", delta_t_add_record, METH_VARARGS, "Add a record to the DeltaTTable"},
+    {"add_records", delta_t_add_records, METH_VARARGS, "Add a buffer of timestamp, Delta T pairs to the DeltaTTable"},
+    {"load_file", delta_t_load_file, METH_VARARGS, "Load the records of a deltat.data file into the DeltaTTable"},
+    {"set_interpolation", delta_t_set_interpolation, METH_VARARGS, "Set how the DeltaTTable is interpolated"},
+    {"set_extrapolation", delta_t_set_extrapolation, METH_VARARGS, "Set how the DeltaTTable is extrapolated"},
+    {"lookup", delta_t_lookup, METH_VARARGS, "Evaluate Delta T at a buffer of times"},
     {"new_DeltaTTable", new_DeltaTTable, METH_VARARGS, "Create a new DeltaTTable"},
     {NULL, NULL, 0, NULL}
 };
@@ -0,0 +1,237 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#include "util/mapped_file.h"
+
+#include <errno.h>
+
+#if !defined(_WIN32) && !defined(WIN32)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif /* _WIN32 */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#if defined(_WIN32) || defined(WIN32)
+
+/**
+ * @brief Translate a Windows error code, as returned by GetLastError, to the nearest errno value.
+ */
+int windows_errno(DWORD error) {
+
+    switch(error) {
+        case ERROR_FILE_NOT_FOUND:
+        case ERROR_PATH_NOT_FOUND:
+        case ERROR_INVALID_DRIVE:
+            return ENOENT;
+        case ERROR_ACCESS_DENIED:
+        case ERROR_WRITE_PROTECT:
+            return EACCES;
+        case ERROR_SHARING_VIOLATION:
+        case ERROR_LOCK_VIOLATION:
+        case ERROR_USER_MAPPED_FILE:
+            return EBUSY;
+        case ERROR_FILE_EXISTS:
+        case ERROR_ALREADY_EXISTS:
+            return EEXIST;
+        case ERROR_DISK_FULL:
+        case ERROR_HANDLE_DISK_FULL:
+            return ENOSPC;
+        case ERROR_NOT_ENOUGH_MEMORY:
+        case ERROR_OUTOFMEMORY:
+            return ENOMEM;
+        case ERROR_INVALID_NAME:
+        case ERROR_FILENAME_EXCED_RANGE:
+            return EINVAL;
+        case ERROR_NOT_SAME_DEVICE:
+            return EXDEV;
+        default:
+            return EIO;
+    }
+}
+
+/**
+ * @brief Map a file read only into memory.
+ *
+ * @param path The path of the file.
+ * @param file The mapping, released with unmap_file on success.
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int map_file(const char* path, MappedFile* file) {
+
+    LARGE_INTEGER size;
+
+    file->data = NULL;
+    file->size = 0;
+    file->mapping = NULL;
+    /* Sharing delete access lets a snapshot be saved over while models are still attached to it. */
+    file->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file->file == INVALID_HANDLE_VALUE) {
+        errno = windows_errno(GetLastError());
+        return -1;
+    }
+
+    if(!GetFileSizeEx(file->file, &size)) {
+        errno = windows_errno(GetLastError());
+        CloseHandle(file->file);
+        return -1;
+    }
+
+    /* Empty files can not be mapped, and callers only unmap a file with data, so nothing is kept open. */
+    if(size.QuadPart == 0) {
+        CloseHandle(file->file);
+        file->file = NULL;
+        return 0;
+    }
+
+    file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(!file->mapping) {
+        errno = windows_errno(GetLastError());
+        CloseHandle(file->file);
+        return -1;
+    }
+
+    file->data = (const char*)MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!file->data) {
+        CloseHandle(file->mapping);
+        CloseHandle(file->file);
+        errno = ENOMEM;
+        return -1;
+    }
+    file->size = (size_t)size.QuadPart;
+
+    return 0;
+}
+
+/**
+ * @brief Advise that a mapping is kept and read at random for its whole life rather than once front to back.
+ *
+ * @param file The mapping.
+ */
+void keep_mapped_file(MappedFile* file) {
+    (void)file;
+}
+
+/**
+ * @brief Release a file mapped with map_file.
+ *
+ * @param file The mapping.
+ */
+void unmap_file(MappedFile* file) {
+
+    if(file->data) UnmapViewOfFile(file->data);
+    if(file->mapping) CloseHandle(file->mapping);
+    if(file->file) CloseHandle(file->file);
+    file->data = NULL;
+    file->size = 0;
+    file->mapping = NULL;
+    file->file = NULL;
+}
+
+#else
+
+/**
+ * @brief Map a file read only into memory.
+ *
+ * @param path The path of the file.
+ * @param file The mapping, released with unmap_file on success.
+ * @return 0 on success, -1 with errno set otherwise.
+ */
+int map_file(const char* path, MappedFile* file) {
+
+    struct stat status;
+
+    file->data = NULL;
+    file->size = 0;
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) {
+        return -1;
+    }
+
+    if(fstat(fd, &status) != 0) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+
+    /* Empty files can not be mapped. */
+    if(status.st_size > 0) {
+        void* data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            errno = error;
+            return -1;
+        }
+        /* The file is read once front to back. */
+        madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);
+        file->data = (const char*)data;
+        file->size = (size_t)status.st_size;
+    }
+
+    /* The mapping holds its own reference to the file. */
+    close(fd);
+
+    return 0;
+}
+
+/**
+ * @brief Advise that a mapping is kept and read at random for its whole life rather than once front to back.
+ *
+ * @param file The mapping.
+ */
+void keep_mapped_file(MappedFile* file) {
+
+    if(file->data) {
+        madvise((void*)file->data, file->size, MADV_NORMAL);
+    }
+}
+
+/**
+ * @brief Release a file mapped with map_file.
+ *
+ * @param file The mapping.
+ */
+void unmap_file(MappedFile* file) {
+
+    if(file->data) munmap((void*)file->data, file->size);
+    file->data = NULL;
+    file->size = 0;
+}
+
+#endif /* _WIN32 */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
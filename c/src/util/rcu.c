@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#define __compile_util_rcu__
+#include "util/rcu.h"
+
+#if !defined(_WIN32) && !defined(WIN32)
+
+#include <sched.h>
+
+#endif /* _WIN32 */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/**
+ * @brief Let another thread run while waiting on readers.
+ */
+static void yield_thread(void) {
+#if defined(_WIN32) || defined(WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif /* _WIN32 */
+}
+
+/**
+ * @brief Initialise a published pointer with its first value.
+ */
+void rcu_init(RCUPointer* pointer, void* value) {
+
+    pointer->value = value;
+    pointer->version = 0;
+    pointer->readers[0] = 0;
+    pointer->readers[1] = 0;
+    mutex_init(&pointer->writer);
+}
+
+/**
+ * @brief Release what the published pointer holds, other than its value.
+ */
+void rcu_destroy(RCUPointer* pointer) {
+    mutex_destroy(&pointer->writer);
+}
+
+/**
+ * @brief Take the published value to copy, holding off other writers until rcu_write_unlock.
+ */
+void* rcu_write_lock(RCUPointer* pointer) {
+
+    mutex_lock(&pointer->writer);
+    return atomic_load_pointer(&pointer->value);
+}
+
+/**
+ * @brief Publish a value and let other writers in, once no reader can still hold the previous value.
+ */
+void* rcu_write_unlock(RCUPointer* pointer, void* value) {
+
+    void* previous = atomic_exchange_pointer(&pointer->value, value);
+    if(previous == value) {
+        mutex_unlock(&pointer->writer);
+        return NULL;
+    }
+
+    /* Readers entering on the next version take the new value. Those inside a section entered on this one may hold
+     * either and are waited out, the readers of the version before were waited out by the previous writer. */
+    long retired = atomic_load_long(&pointer->version);
+    atomic_add_long(&pointer->version, 1);
+    while(atomic_load_long(&pointer->readers[retired & 1]) != 0) {
+        yield_thread();
+    }
+
+    mutex_unlock(&pointer->writer);
+    return previous;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif /* __cplusplus */
@@ -0,0 +1,326 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 Tri-Nitro
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * */
+#include <stdlib.h>
+
+#define __compile_util_thread_pool__
+#include "util/thread_pool.h"
+
+#if defined(_WIN32) || defined(WIN32)
+
+typedef CONDITION_VARIABLE Condition;
+typedef HANDLE Thread;
+
+#define MUTEX_INITIALIZER SRWLOCK_INIT
+#define CONDITION_INITIALIZER CONDITION_VARIABLE_INIT
+
+#else
+
+#include <unistd.h>
+
+typedef pthread_cond_t Condition;
+typedef pthread_t Thread;
+
+#define MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#define CONDITION_INITIALIZER PTHREAD_COND_INITIALIZER
+
+#endif /* _WIN32 */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/** @struct
+ * @brief A thread of the pool.
+ * @var Worker::index
+ * Member 'index' is the part of each loop the worker runs, the caller always runs part 0.
+ * @var Worker::generation
+ * Member 'generation' is the last loop the worker has seen.
+ * @var Worker::thread
+ * Member 'thread' is the handle of the thread.
+ */
+typedef struct {
+    int index;
+    unsigned long generation;
+    Thread thread;
+} Worker;
+
+/* Guards all of the pool state below. */
+static Mutex pool_lock = MUTEX_INITIALIZER;
+/* Held by the caller for the whole of a loop, so only one loop runs on the pool at a time. */
+static Mutex loop_lock = MUTEX_INITIALIZER;
+static Condition work_ready = CONDITION_INITIALIZER;
+static Condition work_done = CONDITION_INITIALIZER;
+
+static int nthreads = 0;
+static int nworkers = 0;
+static Worker* workers = NULL;
+static int stopping = 0;
+static unsigned long generation = 0;
+static int pending = 0;
+
+static ParallelTask loop_task = NULL;
+static void* loop_context = NULL;
+static long long loop_size = 0;
+static int loop_nparts = 0;
+
+static void worker_loop(Worker* worker);
+
+#if defined(_WIN32) || defined(WIN32)
+
+static int mutex_try_lock(Mutex* mutex) { return TryAcquireSRWLockExclusive(mutex) ? 0 : -1; }
+static void condition_wait(Condition* condition, Mutex* mutex) {
+    SleepConditionVariableSRW(condition, mutex, INFINITE, 0);
+}
+static void condition_signal(Condition* condition) { WakeConditionVariable(condition); }
+static void condition_broadcast(Condition* condition) { WakeAllConditionVariable(condition); }
+
+static int online_processors(void) {
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+static DWORD WINAPI worker_entry(LPVOID worker) {
+
+    worker_loop((Worker*)worker);
+    return 0;
+}
+
+static int thread_start(Worker* worker) {
+
+    worker->thread = CreateThread(NULL, 0, worker_entry, worker, 0, NULL);
+    return worker->thread ? 0 : -1;
+}
+
+static void thread_join(Worker* worker) {
+
+    WaitForSingleObject(worker->thread, INFINITE);
+    CloseHandle(worker->thread);
+}
+
+#else
+
+static int mutex_try_lock(Mutex* mutex) { return pthread_mutex_trylock(mutex) == 0 ? 0 : -1; }
+static void condition_wait(Condition* condition, Mutex* mutex) { pthread_cond_wait(condition, mutex); }
+static void condition_signal(Condition* condition) { pthread_cond_signal(condition); }
+static void condition_broadcast(Condition* condition) { pthread_cond_broadcast(condition); }
+
+static int online_processors(void) {
+
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (int)count : 1;
+}
+
+static void* worker_entry(void* worker) {
+
+    worker_loop((Worker*)worker);
+    return NULL;
+}
+
+static int thread_start(Worker* worker) {
+    return pthread_create(&worker->thread, NULL, worker_entry, worker) == 0 ? 0 : -1;
+}
+
+static void thread_join(Worker* worker) {
+    pthread_join(worker->thread, NULL);
+}
+
+/**
+ * @brief Only the forking thread survives into the child, so the child starts over with no workers.
+ */
+static void reset_after_fork(void) {
+
+    pthread_mutex_init(&pool_lock, NULL);
+    pthread_mutex_init(&loop_lock, NULL);
+    pthread_cond_init(&work_ready, NULL);
+    pthread_cond_init(&work_done, NULL);
+    workers = NULL;
+    nworkers = 0;
+    stopping = 0;
+    pending = 0;
+}
+
+#endif /* _WIN32 */
+
+/**
+ * @brief Run one of the contiguous parts the current loop is split into.
+ */
+static void run_part(int part) {
+
+    long long begin = loop_size * part / loop_nparts;
+    long long end = loop_size * (part + 1) / loop_nparts;
+
+    if(begin < end) {
+        loop_task(loop_context, begin, end);
+    }
+}
+
+/**
+ * @brief Body of every worker, waits for a new loop, runs its part and reports back.
+ */
+static void worker_loop(Worker* worker) {
+
+    mutex_lock(&pool_lock);
+    for(;;) {
+        while(!stopping && worker->generation == generation) {
+            condition_wait(&work_ready, &pool_lock);
+        }
+        if(stopping) break;
+
+        worker->generation = generation;
+        if(worker->index < loop_nparts) {
+            mutex_unlock(&pool_lock);
+            run_part(worker->index);
+            mutex_lock(&pool_lock);
+            if(--pending == 0) {
+                condition_signal(&work_done);
+            }
+        }
+    }
+    mutex_unlock(&pool_lock);
+}
+
+/**
+ * @brief Start workers until the pool holds nthreads - 1 of them. Called with pool_lock held.
+ */
+static void start_workers(void) {
+
+#if !defined(_WIN32) && !defined(WIN32)
+    static int registered = 0;
+    if(!registered) {
+        pthread_atfork(NULL, NULL, reset_after_fork);
+        registered = 1;
+    }
+#endif /* _WIN32 */
+
+    if(!workers) {
+        workers = (Worker*)calloc(nthreads > 1 ? nthreads - 1 : 1, sizeof(Worker));
+        if(!workers) return;
+    }
+
+    while(nworkers < nthreads - 1) {
+        Worker* worker = &workers[nworkers];
+        worker->index = nworkers + 1;
+        worker->generation = generation;
+        if(thread_start(worker) != 0) break;
+        ++nworkers;
+    }
+}
+
+/**
+ * @brief Stop and join every worker. Called with loop_lock held so no loop is running.
+ */
+static void stop_workers(void) {
+
+    mutex_lock(&pool_lock);
+    stopping = 1;
+    condition_broadcast(&work_ready);
+    mutex_unlock(&pool_lock);
+
+    for(int i = 0; i < nworkers; ++i) {
+        thread_join(&workers[i]);
+    }
+
+    mutex_lock(&pool_lock);
+    free(workers);
+    workers = NULL;
+    nworkers = 0;
+    stopping = 0;
+    mutex_unlock(&pool_lock);
+}
+
+/**
+ * @brief Get the number of threads, the caller included, parallel loops are split across.
+ */
+int thread_pool_size(void) {
+
+    if(nthreads <= 0) {
+        nthreads = online_processors();
+    }
+    return nthreads;
+}
+
+/**
+ * @brief Set the number of threads parallel loops are split across. The workers are started on the next loop.
+ */
+int set_thread_pool_size(int size) {
+
+    if(size < 0) {
+        return -1;
+    }
+
+    mutex_lock(&loop_lock);
+    stop_workers();
+    nthreads = size > 0 ? size : online_processors();
+    mutex_unlock(&loop_lock);
+
+    return 0;
+}
+
+/**
+ * @brief Run a task over [0, n) split into contiguous ranges across the pool, the calling thread included.
+ */
+void parallel_for(long long n, long long grain, ParallelTask task, void* context) {
+
+    if(n <= 0) return;
+    if(grain < 1) grain = 1;
+
+    long long nparts = n / grain;
+    if(nparts > thread_pool_size()) nparts = thread_pool_size();
+
+    if(nparts < 2 || mutex_try_lock(&loop_lock) != 0) {
+        task(context, 0, n);
+        return;
+    }
+
+    mutex_lock(&pool_lock);
+    start_workers();
+    if(nparts > nworkers + 1) nparts = nworkers + 1;
+
+    loop_task = task;
+    loop_context = context;
+    loop_size = n;
+    loop_nparts = (int)nparts;
+    pending = loop_nparts - 1;
+    ++generation;
+    condition_broadcast(&work_ready);
+    mutex_unlock(&pool_lock);
+
+    run_part(0);
+
+    mutex_lock(&pool_lock);
+    while(pending > 0) {
+        condition_wait(&work_done, &pool_lock);
+    }
+    mutex_unlock(&pool_lock);
+
+    mutex_unlock(&loop_lock);
+}
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
@@ -14,7 +14,7 @@ extensions = [
     Extension(
         'toluene_extensions.coordinates.transform',
         [
-            'c/src/coordinates/state_vector.c',
+            'c/src/coordinates/geodetic_kernel.c',
             'c/src/coordinates/transform.c',
             'c/src/math/constants.c',
             'c/src/math/linear_algebra.c',
@@ -22,6 +22,7 @@ extensions = [
             'c/src/models/earth/constants.c',
             'c/src/models/earth/earth_orientation_parameters.c',
             'c/src/models/earth/nutation.c',
+            'c/src/models/earth/nutation_kernel.c',
             'c/src/models/earth/polar_motion.c',
             'c/src/models/earth/precession.c',
             'c/src/models/earth/rotation.c',
@@ -29,6 +30,8 @@ extensions = [
             'c/src/models/sun/constants.c',
             'c/src/time/constants.c',
             'c/src/time/delta_t.c',
+            'c/src/util/mapped_file.c',
+            'c/src/util/thread_pool.c',
         ],
         include_dirs=['c/include']
     ),
@@ -37,6 +40,9 @@ extensions = [
         [
             'c/src/models/earth/ellipsoid.c',
             'c/src/models/earth/earth.c',
+            'c/src/models/earth/snapshot.c',
+            'c/src/util/mapped_file.c',
+            'c/src/util/rcu.c',
         ],
         include_dirs=['c/include'],
     ),
@@ -51,6 +57,7 @@ extensions = [
         'toluene_extensions.models.earth.earth_orientation_parameters',
         [
             'c/src/models/earth/earth_orientation_parameters.c',
+            'c/src/util/mapped_file.c',
         ],
         include_dirs=['c/include'],
     ),
@@ -67,6 +74,7 @@ extensions = [
             'c/src/math/constants.c',
             'c/src/models/earth/constants.c',
             'c/src/models/earth/nutation.c',
+            'c/src/models/earth/nutation_kernel.c',
             'c/src/models/moon/constants.c',
             'c/src/models/sun/constants.c',
             'c/src/time/constants.c',
@@ -100,11 +108,24 @@ extensions = [
         'toluene_extensions.time.delta_t',
         [
             'c/src/time/delta_t.c',
+            'c/src/util/mapped_file.c',
         ],
         include_dirs=['c/include'],
     ),
 ]
 
+# The fast build compiles the same sources with double in place of long double. toluene picks one of the two builds
+# at import, see toluene/__init__.py.
+extensions += [
+    Extension(
+        extension.name.replace('toluene_extensions.', 'toluene_extensions_fast.', 1),
+        extension.sources,
+        include_dirs=extension.include_dirs,
+        define_macros=[('TOLUENE_DOUBLE_PRECISION', None)],
+    )
+    for extension in list(extensions)
+]
+
 found_opencl = False
 opencl_include_dir = []
 opencl_library_dir = []
@@ -144,13 +165,13 @@ else:
         Extension(
             'toluene_extensions.opencl.coordinates.transform',
             [
-                'c/src/coordinates/state_vector.c',
                 'c/src/math/constants.c',
                 'c/src/math/linear_algebra.c',
                 'c/src/models/earth/bias.c',
                 'c/src/models/earth/constants.c',
                 'c/src/models/earth/earth_orientation_parameters.c',
                 'c/src/models/earth/nutation.c',
+                'c/src/models/earth/nutation_kernel.c',
                 'c/src/models/earth/polar_motion.c',
                 'c/src/models/earth/precession.c',
                 'c/src/models/earth/rotation.c',
@@ -160,6 +181,7 @@ else:
                 'c/src/opencl/models/earth/nutation.c',
                 'c/src/time/constants.c',
                 'c/src/time/delta_t.c',
+                'c/src/util/mapped_file.c',
             ],
             include_dirs=['c/include'] + opencl_include_dir,
             library_dirs=opencl_library_dir,
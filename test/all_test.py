@@ -1,2 +1,8 @@
-from coordinates.state_vector import TestStateVectorTransform
+from coordinates.state_vector import TestNativeStateVector, TestStateVectorArray, TestStateVectorTransform
+from coordinates.transform import TestBatchTransform, TestFusedTransform, TestGeodeticCelestialTransform, \
+    TestGeodeticKernel, TestInPlaceTransform, TestPositionOnlyTransform, TestPrecisionBuilds, TestThreadedTransform
+from models.earth.earth_orientation_table import TestEOPBulkAppend, TestEOPInterpolation, TestEOPLoader
 from models.earth.ellipsoid import TestEllipsoid
+from models.earth.model import TestDeltaTTable, TestEarthModel, TestEarthModelSnapshot, TestEOPHotSwap
+from models.earth.nutation import TestNutationBulkAppend, TestNutationEphemeris, TestNutationTruncation, \
+    TestVectorizedNutation
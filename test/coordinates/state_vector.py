@@ -1,9 +1,14 @@
+import copy
+import ctypes
+import sys
+
 import pytest
 from datetime import datetime, timezone
 
 from toluene.coordinates.reference_frame import ReferenceFrame
-from toluene.coordinates.state_vector import StateVector
+from toluene.coordinates.state_vector import StateVector, StateVectorArray
 from toluene.models.earth.model import EarthModel
+from toluene_extensions.coordinates import state_vector, transform
 
 geodetic_test_points = [
     StateVector(31.2304, 121.4737, 4, frame=ReferenceFrame.GeodeticReferenceFrame),  # Shanghai, China
@@ -172,3 +177,156 @@ class TestStateVectorTransform:
             assert itrf_point.acceleration[0] == pytest.approx(itrf_test_points[idx].acceleration[0], abs=3)
             assert itrf_point.acceleration[1] == pytest.approx(itrf_test_points[idx].acceleration[1], abs=3)
             assert itrf_point.acceleration[2] == pytest.approx(itrf_test_points[idx].acceleration[2], abs=3)
+
+
+class TestNativeStateVector:
+    def test_attribute_access(self):
+        point = StateVector(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, time=10.0,
+                            frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        assert isinstance(point, state_vector.StateVector)
+        assert point.position == (1.0, 2.0, 3.0)
+        assert point.velocity == (4.0, 5.0, 6.0)
+        assert point.acceleration == (7.0, 8.0, 9.0)
+        assert point.time == 10.0
+        assert point.reference_frame is ReferenceFrame.InternationalTerrestrialReferenceFrame
+
+        point.position = [11.0, 12.0, 13.0]
+        point.velocity = (14.0, 15.0, 16.0)
+        point.time = 17.0
+        point.frame = ReferenceFrame.GeocentricCelestialReferenceFrame
+        assert point.position == (11.0, 12.0, 13.0)
+        assert point.velocity == (14.0, 15.0, 16.0)
+        assert point.acceleration == (7.0, 8.0, 9.0)
+        assert point.time == 17.0
+        assert point.reference_frame is ReferenceFrame.GeocentricCelestialReferenceFrame
+
+        duplicate = copy.copy(point)
+        assert type(duplicate) is StateVector
+        assert duplicate is not point
+        assert duplicate.position == point.position
+
+        native = state_vector.StateVector(1.0, 2.0, az=3.0)
+        assert native.position == (1.0, 2.0, 0.0)
+        assert native.acceleration == (0.0, 0.0, 3.0)
+        assert native.frame == int(ReferenceFrame.GeodeticReferenceFrame)
+
+    def test_invalid_arguments(self):
+        with pytest.raises(TypeError):
+            StateVector(1.0)
+        with pytest.raises(TypeError):
+            StateVector(1.0, 2.0, w=3.0)
+        with pytest.raises(TypeError):
+            state_vector.StateVector(1.0, 2.0, x=3.0)
+        with pytest.raises(ValueError):
+            StateVector(1.0, 2.0, frame=9)
+        with pytest.raises(ValueError):
+            StateVector(1.0, 2.0).position = (1.0, 2.0)
+        with pytest.raises(TypeError):
+            transform.itrf_to_geodetic((1.0, 2.0, 3.0), EarthModel().capsule)
+
+    def test_deprecated_capsule(self):
+        real = ctypes.c_longdouble if state_vector.real_size == ctypes.sizeof(ctypes.c_longdouble) else ctypes.c_double
+
+        class CStateVector(ctypes.Structure):
+            _fields_ = [('values', real * 10), ('frame', ctypes.c_int)]
+
+        # A capsule laid out as the ones StateVector wrapped before it was a native type.
+        wrapped = CStateVector((real * 10)(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0),
+                               int(ReferenceFrame.InternationalTerrestrialReferenceFrame))
+        new_capsule = ctypes.pythonapi.PyCapsule_New
+        new_capsule.restype = ctypes.py_object
+        new_capsule.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_void_p]
+        name = ctypes.c_char_p(b'StateVector')
+        capsule = new_capsule(ctypes.addressof(wrapped), name, None)
+        with pytest.warns(DeprecationWarning):
+            point = StateVector(None, None, capsule=capsule)
+        assert type(point) is StateVector
+        assert point.position == (1.0, 2.0, 3.0)
+        assert point.velocity == (4.0, 5.0, 6.0)
+        assert point.acceleration == (7.0, 8.0, 9.0)
+        assert point.time == 10.0
+        assert point.reference_frame is ReferenceFrame.InternationalTerrestrialReferenceFrame
+        with pytest.warns(DeprecationWarning), pytest.raises(TypeError):
+            StateVector(None, None, capsule=EarthModel().capsule)
+
+    def test_transforms_keep_type(self):
+        earth_model = EarthModel()
+        point = itrf_test_points[0]
+        assert type(point.get_gcrs(earth_model)) is StateVector
+        assert type(point.get_geodetic(earth_model)) is StateVector
+        native = state_vector.new_StateVector(*point.position, *point.velocity, *point.acceleration, point.time,
+                                              point.frame)
+        assert type(native) is state_vector.StateVector
+        gcrf = transform.itrf_to_gcrf(native, earth_model.capsule)
+        assert type(gcrf) is state_vector.StateVector
+        assert gcrf.position == point.get_gcrs(earth_model).position
+
+    def test_free_list_reference_counts(self):
+        earth_model = EarthModel()
+        point = itrf_test_points[0]
+        references = sys.getrefcount(StateVector)
+        for _ in range(1000):
+            points = [StateVector(1.0, 2.0, 3.0) for _ in range(8)]
+            points += [point.get_gcrs(earth_model), state_vector.StateVector(1.0, 2.0)]
+            del points
+        assert sys.getrefcount(StateVector) == references
+
+
+class TestStateVectorArray:
+    def test_columns_are_views(self):
+        states = StateVectorArray(itrf_test_points)
+        assert len(states) == len(itrf_test_points)
+        assert type(states[0]) is StateVector
+        assert states[-1].position == itrf_test_points[-1].position
+        assert states.reference_frame is ReferenceFrame.InternationalTerrestrialReferenceFrame
+
+        position = states.position
+        assert position.shape == (len(itrf_test_points), 3)
+        assert position.format == 'd'
+        assert states.time.shape == (len(itrf_test_points),)
+        assert states.frame.format == 'i'
+
+        position[1, 2] = 42.0
+        states.time[1] = 7.0
+        assert states[1].position[2] == 42.0
+        assert states[1].time == 7.0
+        states[2] = StateVector(1.0, 2.0, 3.0)
+        assert position.tolist()[2] == [1.0, 2.0, 3.0]
+        assert states.frame[2] == int(ReferenceFrame.GeodeticReferenceFrame)
+
+        del states
+        assert position[1, 2] == 42.0
+
+        zeros = state_vector.StateVectorArray(4, frame=ReferenceFrame.GeocentricCelestialReferenceFrame)
+        assert zeros.frame.tolist() == [int(ReferenceFrame.GeocentricCelestialReferenceFrame)] * 4
+        assert type(zeros[0]) is state_vector.StateVector
+        with pytest.raises(IndexError):
+            zeros[4]
+        with pytest.raises(TypeError):
+            zeros[0] = (1.0, 2.0, 3.0)
+
+    def test_transforms_match_state_vectors(self):
+        earth_model = EarthModel()
+        states = StateVectorArray(itrf_test_points)
+        for convert, expected in ((states.get_gcrs, lambda point: point.get_gcrs(earth_model)),
+                                  (states.get_geodetic, lambda point: point.get_geodetic(earth_model))):
+            converted = convert(earth_model)
+            assert type(converted) is StateVectorArray
+            for idx, point in enumerate(itrf_test_points):
+                assert converted[idx].position == expected(point).position
+                assert converted[idx].velocity == expected(point).velocity
+                assert converted[idx].reference_frame == expected(point).reference_frame
+
+        round_trip = states.get_gcrs(earth_model).get_itrs(earth_model)
+        for idx, point in enumerate(itrf_test_points):
+            assert round_trip[idx].position == pytest.approx(point.position, abs=1e-3)
+        geodetic = StateVectorArray(geodetic_test_points).get_itrs(earth_model)
+        for idx, point in enumerate(geodetic_test_points):
+            assert geodetic[idx].position == point.get_itrs(earth_model).position
+
+    def test_mixed_frames(self):
+        earth_model = EarthModel()
+        states = StateVectorArray(itrf_test_points[:2] + geodetic_test_points[:1])
+        assert states.reference_frame is None
+        with pytest.raises(TypeError):
+            transform.itrf_to_gcrf(states, earth_model.capsule)
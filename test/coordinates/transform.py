@@ -0,0 +1,446 @@
+import ctypes
+import json
+import os
+import pytest
+import subprocess
+import sys
+import threading
+import tracemalloc
+from array import array
+from datetime import datetime, timezone
+
+import toluene
+
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector, StateVectorArray
+from toluene.coordinates import transform
+from toluene.models.earth.ellipsoid import GeodeticAlgorithm
+from toluene.models.earth.model import EarthModel
+from toluene_extensions.coordinates import transform as transform_extension
+
+batch_time = datetime(2023, 11, 20, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+
+batch_states = [
+    (-2850075.294343253, 4655695.796924158, 3287765.2299773037, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0),  # Shanghai, China
+    (1334000.5446860846, -4654052.12920688, 4138306.7613726556, 10.0, -20.0, 5.0, 0.1, 0.2, -0.3),  # New York City
+    (7000000.0, 0.0, 0.0, 0.0, 7500.0, 0.0, -8.0, 0.0, 0.0),  # Low Earth Orbit
+]
+
+batch_times = [batch_time, batch_time + 3600.0, batch_time + 86400.0]
+
+# GCRS states of batch_states at batch_time as produced by the five stage wobble, earth rotation, nutation,
+# precession and frame bias chain. batch_time is past the end of deltat.data, so Delta T is extrapolated.
+five_stage_gcrf_states = [
+    (-5451189.395093331, 7193.185384553217, 3300350.7663999703,
+     -0.5340900616564981, -396.9739640129894, -0.016943279092579047,
+     0.028868684587120975, -3.8837181292368976e-05, -6.655868553077514e-05),
+    (4673631.440587004, -1298633.8892643997, 4127476.311867964,
+     116.71287999148, 337.23961560312245, 4.746336146520005,
+     -0.14318517549170534, 0.19998880726444634, -0.2996614173246455),
+    (3662767.6337318546, 5965238.163978332, -8179.749547834041,
+     -6825.112370327698, 4190.768306336243, 15.93578480215498,
+     -4.776170645217367, -7.778542960098336, 0.010664877088156655),
+]
+
+
+# Position, velocity and acceleration tolerances against five_stage_gcrf_states for each build. The fast build is
+# limited by a double holding the UNIX time, 2.4e-7 s near 2023, which is about 1e-4 m of Earth rotation.
+build_tolerances = {
+    'extended': (1e-6, 1e-9, 1e-12),
+    'fast': (1e-3, 1e-6, 1e-9),
+}
+
+# Run in a fresh interpreter because the build is picked once, when toluene is first imported.
+build_script = """
+import json
+import toluene
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector, StateVectorArray
+from toluene.models.earth.ellipsoid import GeodeticAlgorithm
+from toluene.models.earth.model import EarthModel
+from toluene_extensions.coordinates import transform as transform_extension
+from toluene_extensions.coordinates import state_vector
+
+earth_model = EarthModel()
+states, round_trip_error = [], 0.0
+for state, time in json.loads(input()):
+    itrf = StateVector(*state, time=time, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+    gcrf = itrf.get_gcrs(earth_model)
+    states.append(list(gcrf.position) + list(gcrf.velocity) + list(gcrf.acceleration))
+    itrf = itrf.get_geodetic(earth_model).get_itrs(earth_model)
+    round_trip_error = max([round_trip_error] + [abs(a - b) for a, b in zip(itrf.position, state[0:3])])
+print(json.dumps([toluene.precision, state_vector.real_size, states, round_trip_error]))
+"""
+
+
+class TestFusedTransform:
+    def test_matches_five_stage_chain(self):
+        earth_model = EarthModel()
+        position, velocity, acceleration = build_tolerances[toluene.precision]
+        for idx in range(len(batch_states)):
+            gcrf = StateVector(*batch_states[idx], time=batch_time,
+                               frame=ReferenceFrame.InternationalTerrestrialReferenceFrame).get_gcrs(earth_model)
+            assert gcrf.position == pytest.approx(five_stage_gcrf_states[idx][0:3], abs=position)
+            assert gcrf.velocity == pytest.approx(five_stage_gcrf_states[idx][3:6], abs=velocity)
+            assert gcrf.acceleration == pytest.approx(five_stage_gcrf_states[idx][6:9], abs=acceleration)
+
+    def test_round_trip_preserves_motion(self):
+        earth_model = EarthModel()
+        for state in batch_states:
+            itrf = StateVector(*state, time=batch_time, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+            round_trip = itrf.get_gcrs(earth_model).get_itrs(earth_model)
+            assert round_trip.position == pytest.approx(state[0:3], abs=1e-6)
+            assert round_trip.velocity == pytest.approx(state[3:6], abs=1e-9)
+            assert round_trip.acceleration == pytest.approx(state[6:9], abs=1e-12)
+
+    def test_gcrf_to_itrf_inverts_itrf_to_gcrf(self):
+        # The five stage chain's gcrf_to_itrf read an uninitialised centrifugal term and took the Coriolis term in the
+        # wrong order, so the inverse is pinned against the ITRS states the GCRS states came from instead.
+        earth_model = EarthModel()
+        position, velocity, acceleration = build_tolerances[toluene.precision]
+        for idx in range(len(batch_states)):
+            itrf = StateVector(*five_stage_gcrf_states[idx], time=batch_time,
+                               frame=ReferenceFrame.GeocentricCelestialReferenceFrame).get_itrs(earth_model)
+            assert itrf.position == pytest.approx(batch_states[idx][0:3], abs=position)
+            assert itrf.velocity == pytest.approx(batch_states[idx][3:6], abs=velocity)
+            assert itrf.acceleration == pytest.approx(batch_states[idx][6:9], abs=acceleration)
+            round_trip = itrf.get_gcrs(earth_model)
+            assert round_trip.position == pytest.approx(five_stage_gcrf_states[idx][0:3], abs=position)
+            assert round_trip.velocity == pytest.approx(five_stage_gcrf_states[idx][3:6], abs=velocity)
+            assert round_trip.acceleration == pytest.approx(five_stage_gcrf_states[idx][6:9], abs=acceleration)
+
+
+class TestBatchTransform:
+    def test_itrf_to_gcrf_batch(self):
+        earth_model = EarthModel()
+        states = array('d', [value for state in batch_states for value in state])
+        out = transform.itrf_to_gcrf(states, array('d', batch_times), earth_model)
+        for idx in range(len(batch_states)):
+            expected = StateVector(*batch_states[idx], time=batch_times[idx],
+                                   frame=ReferenceFrame.InternationalTerrestrialReferenceFrame).get_gcrs(earth_model)
+            row = out[idx * 9:idx * 9 + 9]
+            assert tuple(row[0:3]) == pytest.approx(expected.position, abs=1e-6)
+            assert tuple(row[3:6]) == pytest.approx(expected.velocity, abs=1e-9)
+            assert tuple(row[6:9]) == pytest.approx(expected.acceleration, abs=1e-12)
+
+    def test_gcrf_to_itrf_batch(self):
+        earth_model = EarthModel()
+        states = array('d', [value for state in batch_states for value in state])
+        times = array('d', batch_times)
+        out = array('d', bytes(len(states) * 8))
+        transform.gcrf_to_itrf(transform.itrf_to_gcrf(states, times, earth_model), times, earth_model, out)
+        for idx in range(len(states)):
+            if idx % 9 < 3:
+                assert out[idx] == pytest.approx(states[idx], abs=1e-3)
+
+    def test_batch_rejects_mismatched_buffers(self):
+        earth_model = EarthModel()
+        with pytest.raises(ValueError):
+            transform.itrf_to_gcrf(array('d', [0.0] * 9), array('d', [0.0, 1.0]), earth_model)
+
+
+class TestGeodeticCelestialTransform:
+    def test_gcrf_to_geodetic_matches_chain(self):
+        earth_model = EarthModel()
+        for idx in range(len(batch_states)):
+            gcrf = StateVector(*five_stage_gcrf_states[idx], time=batch_times[idx],
+                               frame=ReferenceFrame.GeocentricCelestialReferenceFrame)
+            chained = gcrf.get_itrs(earth_model).get_geodetic(earth_model)
+            fused = gcrf.get_geodetic(earth_model)
+            assert fused.reference_frame is ReferenceFrame.GeodeticReferenceFrame
+            assert fused.position == chained.position
+            assert fused.velocity == chained.velocity
+            assert fused.acceleration == chained.acceleration
+
+    def test_geodetic_to_gcrf_matches_chain(self):
+        earth_model = EarthModel()
+        geodetic = StateVector(31.2304, 121.4737, 4, time=batch_time, frame=ReferenceFrame.GeodeticReferenceFrame)
+        chained = geodetic.get_itrs(earth_model).get_gcrs(earth_model)
+        fused = geodetic.get_gcrs(earth_model)
+        assert fused.reference_frame is ReferenceFrame.GeocentricCelestialReferenceFrame
+        assert fused.position == chained.position
+        assert fused.velocity == chained.velocity
+        assert fused.acceleration == chained.acceleration
+
+        round_trip = fused.get_geodetic(earth_model)
+        assert round_trip.position == pytest.approx(geodetic.position, abs=1e-6)
+
+    def test_state_vector_array(self):
+        earth_model = EarthModel()
+        states = StateVectorArray([StateVector(*five_stage_gcrf_states[idx], time=batch_times[idx],
+                                               frame=ReferenceFrame.GeocentricCelestialReferenceFrame)
+                                   for idx in range(len(batch_states))])
+        geodetic = states.get_geodetic(earth_model)
+        assert geodetic.reference_frame is ReferenceFrame.GeodeticReferenceFrame
+        for idx in range(len(batch_states)):
+            assert geodetic[idx].position == states[idx].get_geodetic(earth_model).position
+        gcrf = geodetic.get_gcrs(earth_model)
+        for idx in range(len(batch_states)):
+            assert gcrf[idx].position == pytest.approx(states[idx].position, abs=1e-6)
+
+
+class TestPositionOnlyTransform:
+    def test_matches_full_transform(self):
+        earth_model = EarthModel()
+        position, velocity, acceleration = build_tolerances[toluene.precision]
+        for idx in range(len(batch_states)):
+            itrf = StateVector(*batch_states[idx], time=batch_time,
+                               frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+            gcrf = itrf.get_gcrs(earth_model, position_only=True)
+            assert gcrf.reference_frame is ReferenceFrame.GeocentricCelestialReferenceFrame
+            assert gcrf.position == pytest.approx(five_stage_gcrf_states[idx][0:3], abs=position)
+            assert gcrf.velocity == (0.0, 0.0, 0.0)
+            assert gcrf.acceleration == (0.0, 0.0, 0.0)
+            # The rotation cached without its derivatives must not stand in for the full transform.
+            full = itrf.get_gcrs(earth_model)
+            assert full.position == gcrf.position
+            assert full.velocity == pytest.approx(five_stage_gcrf_states[idx][3:6], abs=velocity)
+            assert full.acceleration == pytest.approx(five_stage_gcrf_states[idx][6:9], abs=acceleration)
+
+            itrf = full.get_itrs(earth_model, position_only=True)
+            assert itrf.position == pytest.approx(batch_states[idx][0:3], abs=1e-6)
+            assert itrf.velocity == (0.0, 0.0, 0.0)
+
+    def test_geodetic(self):
+        earth_model = EarthModel()
+        geodetic = StateVector(31.2304, 121.4737, 4, time=batch_time, frame=ReferenceFrame.GeodeticReferenceFrame)
+        gcrf = geodetic.get_gcrs(earth_model, position_only=True)
+        assert gcrf.position == geodetic.get_gcrs(earth_model).position
+        assert gcrf.get_geodetic(earth_model, position_only=True).position == pytest.approx(geodetic.position,
+                                                                                           abs=1e-6)
+
+    def test_state_vector_array(self):
+        earth_model = EarthModel()
+        states = StateVectorArray([StateVector(*batch_states[idx], time=batch_times[idx],
+                                               frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                                   for idx in range(len(batch_states))])
+        gcrf = states.get_gcrs(earth_model, position_only=True)
+        for idx in range(len(batch_states)):
+            assert gcrf[idx].position == states[idx].get_gcrs(earth_model).position
+            assert gcrf[idx].velocity == (0.0, 0.0, 0.0)
+
+    def test_batch(self):
+        earth_model = EarthModel()
+        positions = array('d', [value for state in batch_states for value in state[0:3]])
+        times = array('d', batch_times)
+        out = transform.itrf_to_gcrf_position(positions, times, earth_model)
+        for idx in range(len(batch_states)):
+            expected = StateVector(*batch_states[idx], time=batch_times[idx],
+                                   frame=ReferenceFrame.InternationalTerrestrialReferenceFrame).get_gcrs(earth_model)
+            assert tuple(out[idx * 3:idx * 3 + 3]) == pytest.approx(expected.position, abs=1e-6)
+        transform.gcrf_to_itrf_position(out, times, earth_model, out)
+        assert tuple(out) == pytest.approx(tuple(positions), abs=1e-6)
+        with pytest.raises(ValueError):
+            transform.itrf_to_gcrf_position(array('d', [0.0] * 9), array('d', [0.0, 1.0]), earth_model)
+
+
+class TestGeodeticKernel:
+    @staticmethod
+    def positions(earth_model):
+        # Surface points to GEO with the poles, both sides of the antimeridian and the centre of the Earth, 45 rows so
+        # every kernel also runs its remainder.
+        geodetic = [(latitude, longitude, height) for latitude in (-89.9, -45.0, 0.0, 30.0, 89.9)
+                    for longitude in (-179.9, -60.0, 179.9) for height in (-10000.0, 400000.0, 35786000.0)]
+        positions = [StateVector(*point, frame=ReferenceFrame.GeodeticReferenceFrame).get_itrs(earth_model).position
+                     for point in geodetic]
+        positions[0:6] = [(0.0, 0.0, 6356752.3), (0.0, 0.0, -6356752.3), (-6378137.0, 0.0, 0.0),
+                          (-6378137.0, -0.0, 0.0), (0.0, -6378137.0, 0.0), (0.0, 0.0, 0.0)]
+        return positions
+
+    def test_kernels_match_closed_form(self):
+        earth_model = EarthModel()
+        positions = self.positions(earth_model)
+        expected = [StateVector(*position, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                    .get_geodetic(earth_model).position for position in positions]
+        flat = array('d', [value for position in positions for value in position])
+        selected, supported = transform.get_geodetic_kernel()
+        try:
+            for kernel in transform.GeodeticKernel:
+                if kernel > supported:
+                    continue
+                transform.set_geodetic_kernel(kernel)
+                out = transform.itrf_to_geodetic_position(flat, earth_model)
+                for idx in range(len(positions)):
+                    assert tuple(out[idx * 3:idx * 3 + 2]) == pytest.approx(expected[idx][0:2], abs=1e-11)
+                    assert out[idx * 3 + 2] == pytest.approx(expected[idx][2], abs=1e-6)
+                in_place = array('d', flat)
+                transform.itrf_to_geodetic_position(in_place, earth_model, in_place)
+                assert in_place == out
+        finally:
+            transform.set_geodetic_kernel(selected)
+        with pytest.raises(ValueError):
+            transform.itrf_to_geodetic_position(array('d', [0.0] * 4), earth_model)
+
+    def test_algorithms_match_closed_form(self):
+        earth_model = EarthModel()
+        # The alternatives only hold outside the evolute, so the centre of the Earth is left out.
+        positions = self.positions(earth_model)[0:5] + self.positions(earth_model)[6:]
+        expected = [StateVector(*position, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                    .get_geodetic(earth_model).position for position in positions]
+        flat = array('d', [value for position in positions for value in position])
+        # One iteration of Bowring's method is good to about 1e-7 degrees at GEO and a single Halley step to 1e-9.
+        tolerances = {GeodeticAlgorithm.ClosedForm: 1e-11, GeodeticAlgorithm.Bowring: 1e-6,
+                      GeodeticAlgorithm.Bowring2: 1e-11, GeodeticAlgorithm.Vermeille: 1e-11,
+                      GeodeticAlgorithm.Fukushima: 1e-8}
+        selected, supported = transform.get_geodetic_kernel()
+        try:
+            for algorithm, tolerance in tolerances.items():
+                for kernel in transform.GeodeticKernel:
+                    if kernel > supported:
+                        continue
+                    transform.set_geodetic_kernel(kernel)
+                    out = transform.itrf_to_geodetic_position(flat, earth_model, algorithm=algorithm)
+                    for idx in range(len(positions)):
+                        assert tuple(out[idx * 3:idx * 3 + 2]) == pytest.approx(expected[idx][0:2], abs=tolerance)
+                        assert out[idx * 3 + 2] == pytest.approx(expected[idx][2], abs=1e-6)
+
+                earth_model.set_geodetic_algorithm(algorithm)
+                assert earth_model.geodetic_algorithm is algorithm
+                assert transform.itrf_to_geodetic_position(flat, earth_model) == out
+                for idx in range(len(positions)):
+                    state = StateVector(*positions[idx], frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                    geodetic = state.get_geodetic(earth_model).position
+                    assert tuple(geodetic[0:2]) == pytest.approx(expected[idx][0:2], abs=tolerance)
+                    assert geodetic[2] == pytest.approx(expected[idx][2], abs=1e-6)
+                earth_model.set_geodetic_algorithm(GeodeticAlgorithm.ClosedForm)
+        finally:
+            transform.set_geodetic_kernel(selected)
+        with pytest.raises(ValueError):
+            earth_model.set_geodetic_algorithm(6)
+        with pytest.raises(ValueError):
+            transform.itrf_to_geodetic_position(flat, earth_model, algorithm=6)
+
+
+class TestInPlaceTransform:
+    def test_state_vector_output(self):
+        earth_model = EarthModel()
+        itrf = StateVector(*batch_states[2], time=batch_time, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        expected = itrf.get_gcrs(earth_model)
+
+        out = StateVector(0.0, 0.0)
+        assert itrf.get_gcrs(earth_model, out) is out
+        assert out.position == expected.position
+        assert out.acceleration == expected.acceleration
+        assert out.reference_frame is ReferenceFrame.GeocentricCelestialReferenceFrame
+
+        assert out.get_gcrs(earth_model, out) is out
+        assert out.position == expected.position
+
+        assert itrf.get_gcrs(earth_model, itrf) is itrf
+        assert itrf.position == expected.position
+        assert itrf.velocity == expected.velocity
+        assert itrf.get_itrs(earth_model, itrf) is itrf
+        assert itrf.position == pytest.approx(batch_states[2][0:3], abs=1e-6)
+        assert itrf.reference_frame is ReferenceFrame.InternationalTerrestrialReferenceFrame
+
+    def test_state_vector_array_output(self):
+        earth_model = EarthModel()
+        states = StateVectorArray([StateVector(*batch_states[idx], time=batch_times[idx],
+                                               frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+                                   for idx in range(len(batch_states))])
+        expected = states.get_gcrs(earth_model)
+
+        out = StateVectorArray(len(batch_states))
+        assert states.get_gcrs(earth_model, out) is out
+        assert out.position.tolist() == expected.position.tolist()
+
+        assert states.get_gcrs(earth_model, states) is states
+        assert states.position.tolist() == expected.position.tolist()
+        assert states.acceleration.tolist() == expected.acceleration.tolist()
+        assert states.reference_frame is ReferenceFrame.GeocentricCelestialReferenceFrame
+
+        with pytest.raises(ValueError):
+            transform_extension.gcrf_to_itrf(states, earth_model.capsule, StateVectorArray(1))
+        with pytest.raises(TypeError):
+            transform_extension.gcrf_to_itrf(states, earth_model.capsule, StateVector(0.0, 0.0))
+        with pytest.raises(TypeError):
+            transform_extension.gcrf_to_itrf(states[0], earth_model.capsule, out)
+
+    def test_steady_state_does_not_allocate(self):
+        earth_model = EarthModel()
+        capsule = earth_model.capsule
+        itrf = StateVector(*batch_states[0], time=batch_time, frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        gcrf = StateVector(0.0, 0.0)
+        states = StateVectorArray([itrf] * 16)
+        out = StateVectorArray(16)
+        itrf_to_gcrf = transform_extension.itrf_to_gcrf
+        itrf_to_gcrf(itrf, capsule, gcrf)
+        itrf_to_gcrf(states, capsule, out)
+        iterations = [None] * 1000
+
+        def traced_growth(loop):
+            tracemalloc.start()
+            try:
+                start, _ = tracemalloc.get_traced_memory()
+                tracemalloc.reset_peak()
+                loop()
+                current, peak = tracemalloc.get_traced_memory()
+            finally:
+                tracemalloc.stop()
+            return current - start, peak - start
+
+        def empty_loop():
+            for _ in iterations:
+                pass
+
+        def transform_loop():
+            for _ in iterations:
+                itrf_to_gcrf(itrf, capsule, gcrf)
+                itrf_to_gcrf(states, capsule, out)
+
+        # The loop's own iterator is the only allocation either loop may make.
+        assert traced_growth(transform_loop) == traced_growth(empty_loop)
+
+
+class TestThreadedTransform:
+    def test_thread_pool_matches_serial(self):
+        earth_model = EarthModel()
+        states = array('d', [value for state in batch_states for value in state] * 200)
+        times = array('d', [batch_time + idx * 30.0 for idx in range(len(batch_states) * 200)])
+        nthreads = toluene.get_num_threads()
+        try:
+            toluene.set_num_threads(1)
+            serial = transform.itrf_to_gcrf(states, times, earth_model)
+            toluene.set_num_threads(4)
+            assert toluene.get_num_threads() == 4
+            earth_model.clear_rotation_cache()
+            assert transform.itrf_to_gcrf(states, times, earth_model) == serial
+        finally:
+            toluene.set_num_threads(nthreads)
+
+    def test_concurrent_python_threads(self):
+        earth_model = EarthModel()
+        states = array('d', [value for state in batch_states for value in state] * 50)
+        times = array('d', [batch_time + idx * 30.0 for idx in range(len(batch_states) * 50)])
+        expected = transform.itrf_to_gcrf(states, times, earth_model)
+        earth_model.clear_rotation_cache()
+        results = [None] * 4
+
+        def run(idx):
+            results[idx] = transform.itrf_to_gcrf(states, times, earth_model)
+
+        threads = [threading.Thread(target=run, args=(idx,)) for idx in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert all(result == expected for result in results)
+
+
+class TestPrecisionBuilds:
+    @pytest.mark.parametrize('precision, real_size', [('extended', ctypes.sizeof(ctypes.c_longdouble)),
+                                                      ('fast', ctypes.sizeof(ctypes.c_double))])
+    def test_build_accuracy(self, precision, real_size):
+        environment = dict(os.environ, TOLUENE_PRECISION=precision, PYTHONPATH=os.pathsep.join(sys.path))
+        result = subprocess.run([sys.executable, '-c', build_script], env=environment, capture_output=True, text=True,
+                                input=json.dumps([[state, batch_time] for state in batch_states]))
+        assert result.returncode == 0, result.stderr
+        loaded, size, states, round_trip_error = json.loads(result.stdout)
+        assert loaded == precision
+        assert size == real_size
+        position, velocity, acceleration = build_tolerances[precision]
+        for state, expected in zip(states, five_stage_gcrf_states):
+            assert state[0:3] == pytest.approx(expected[0:3], abs=position)
+            assert state[3:6] == pytest.approx(expected[3:6], abs=velocity)
+            assert state[6:9] == pytest.approx(expected[6:9], abs=acceleration)
+        assert round_trip_error < position
@@ -0,0 +1,164 @@
+import os
+import pytest
+from array import array
+from datetime import datetime, timezone
+
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector
+from toluene.models.earth.earth_orientation_table import EarthOrientationTable, EOPInterpolation
+from toluene.models.earth.model import EarthModel
+from toluene.util.file import datadir
+from toluene_extensions.models.earth.earth_orientation_parameters import add_record
+
+day = 86400.0
+table_time = datetime(2023, 11, 20, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+# The leap second at the end of 2016, dUT1 steps from about -0.41 s to 0.59 s between these records.
+leap_second_time = datetime(2016, 12, 31, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+
+
+def parse_with_python(path):
+    # The fixed width columns as read by the Python parser the C loader replaced.
+    records = []
+    with open(path, 'r') as file:
+        for line in file:
+            values = [False, 0.0, 0.0, 0.0, 0.0, False, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0]
+            if line[16] != ' ':
+                values[0:9] = [line[16] == 'P', float(line[18:27]), float(line[27:36]), float(line[37:46]),
+                               float(line[46:55]), line[57] == 'P', float(line[58:68]), float(line[68:78]), 0.0]
+                if line[79:86] != '       ':
+                    values[8:10] = [float(line[79:86]), float(line[86:93])]
+                if line[134:144] != '          ':
+                    values[10:13] = [float(line[134:144]), float(line[144:154]), float(line[154:165])]
+            records.append(((float(line[7:15]) - 40587) * day, *values))
+    return records
+
+
+def load_with_python(table, path):
+    for record in parse_with_python(path):
+        add_record(table.capsule, *record)
+
+
+def evaluate(table, times, interpolation, search=False, cursor=False):
+    out = array('d', bytes(len(times) * 4 * 8))
+    table.interpolate(array('d', times), out, interpolation, search, cursor)
+    return [tuple(out[idx * 4:idx * 4 + 4]) for idx in range(len(times))]
+
+
+class TestEOPInterpolation:
+    table = EarthOrientationTable(datadir + '/finals2000A.all')
+
+    def test_indexed_lookup_matches_search(self):
+        times = [table_time + idx * 3607.3 for idx in range(-2000, 2000)] + [0.0, 1e12]
+        for interpolation in EOPInterpolation:
+            assert evaluate(self.table, times, interpolation) == evaluate(self.table, times, interpolation, True)
+
+    def test_cursor_lookup_matches_search(self):
+        # Ordered streams step through the table, a jump back or out of the table makes the cursor search again.
+        ordered = [table_time + idx * 3607.3 for idx in range(-2000, 2000)]
+        times = [0.0] + ordered + ordered[::-1] + ordered[::97] + [1e12, table_time]
+        for interpolation in EOPInterpolation:
+            assert evaluate(self.table, times, interpolation, cursor=True) == \
+                evaluate(self.table, times, interpolation, True)
+
+    def test_interpolation_between_records(self):
+        start, end = evaluate(self.table, [table_time, table_time + day], EOPInterpolation.Nearest)
+        assert evaluate(self.table, [table_time + day / 2], EOPInterpolation.Nearest)[0] == start
+        middle = evaluate(self.table, [table_time + day / 2], EOPInterpolation.Linear)[0]
+        assert middle == pytest.approx([(a + b) / 2 for a, b in zip(start, end)], abs=1e-12)
+        for interpolation in (EOPInterpolation.Linear, EOPInterpolation.Lagrange):
+            assert evaluate(self.table, [table_time], interpolation)[0] == pytest.approx(start, abs=1e-12)
+        cubic = evaluate(self.table, [table_time + day / 2], EOPInterpolation.Lagrange)[0]
+        assert cubic[0:3] == pytest.approx(middle[0:3], abs=1e-3)
+
+    def test_leap_second_guard(self):
+        before, after = evaluate(self.table, [leap_second_time, leap_second_time + day], EOPInterpolation.Nearest)
+        assert after[2] - before[2] == pytest.approx(1.0, abs=0.01)
+        for interpolation in (EOPInterpolation.Linear, EOPInterpolation.Lagrange):
+            for fraction in (0.25, 0.5, 0.99):
+                dut1 = evaluate(self.table, [leap_second_time + fraction * day], interpolation)[0][2]
+                assert dut1 == pytest.approx(before[2], abs=0.01)
+
+    def test_earth_model_interpolation(self):
+        earth_model = EarthModel()
+        point = StateVector(7000000.0, 0.0, 0.0, time=table_time + day / 2,
+                            frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        nearest = point.get_gcrs(earth_model)
+        earth_model.set_eop_interpolation(EOPInterpolation.Linear)
+        linear = point.get_gcrs(earth_model)
+        assert linear.position != nearest.position
+        assert linear.position == pytest.approx(nearest.position, abs=10.0)
+        earth_model.set_eop_interpolation(EOPInterpolation.Nearest)
+        assert point.get_gcrs(earth_model).position == nearest.position
+        with pytest.raises(ValueError):
+            earth_model.set_eop_interpolation(0)
+
+    def test_out_of_order_inserts(self):
+        records = parse_with_python(datadir + '/finals2000A.all')[18500:18700]
+        inserted = EarthOrientationTable()
+        for record in records[::2] + records[1::2][::-1]:
+            add_record(inserted.capsule, *record)
+        appended = EarthOrientationTable()
+        for record in records:
+            add_record(appended.capsule, *record)
+        times = [records[0][0] + idx * day / 3 for idx in range(-3, 3 * len(records) + 3)]
+        for interpolation in EOPInterpolation:
+            assert evaluate(inserted, times, interpolation) == evaluate(appended, times, interpolation)
+
+
+class TestEOPLoader:
+    def test_matches_python_parser(self):
+        loaded = EarthOrientationTable(datadir + '/finals2000A.all')
+        parsed = EarthOrientationTable()
+        load_with_python(parsed, datadir + '/finals2000A.all')
+        start = datetime(1973, 1, 2, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+        times = [start + idx * day / 2 for idx in range(2 * 19025)]
+        for interpolation in EOPInterpolation:
+            assert evaluate(loaded, times, interpolation) == evaluate(parsed, times, interpolation)
+
+    def test_line_endings_and_order(self, tmp_path):
+        with open(datadir + '/finals2000A.all', 'r') as file:
+            lines = [line.rstrip('\n') for line in file][18560:18610]
+        path = tmp_path / 'finals.all'
+        path.write_bytes(('\r\n'.join(reversed(lines)) + '\r\n\r\n').encode())
+        table = EarthOrientationTable(str(path))
+        expected = EarthOrientationTable(datadir + '/finals2000A.all')
+        times = [table_time + idx * day / 3 for idx in range(-30, 30)]
+        for interpolation in EOPInterpolation:
+            assert evaluate(table, times, interpolation) == evaluate(expected, times, interpolation)
+
+    def test_loads_append(self, tmp_path):
+        with open(datadir + '/finals2000A.all', 'r') as file:
+            lines = [line for line in file][18560:18610]
+        # The later half is loaded first, so the second load both appends and has to restore the order.
+        (tmp_path / 'early.all').write_text(''.join(lines[:25]))
+        (tmp_path / 'late.all').write_text(''.join(lines[25:]))
+        table = EarthOrientationTable(str(tmp_path / 'late.all'))
+        table.load_from_file(str(tmp_path / 'early.all'))
+        expected = EarthOrientationTable(datadir + '/finals2000A.all')
+        times = [table_time + idx * day / 3 for idx in range(-30, 30)]
+        for interpolation in EOPInterpolation:
+            assert evaluate(table, times, interpolation) == evaluate(expected, times, interpolation)
+
+    def test_missing_file(self, tmp_path):
+        with pytest.raises(FileNotFoundError):
+            EarthOrientationTable(os.fspath(tmp_path / 'missing.all'))
+
+
+class TestEOPBulkAppend:
+    def test_matches_single_appends(self):
+        records = parse_with_python(datadir + '/finals2000A.all')
+        single = EarthOrientationTable()
+        load_with_python(single, datadir + '/finals2000A.all')
+        bulk = EarthOrientationTable()
+        assert bulk.add_records([value for record in records[:100] for value in record]) == 100
+        # Out of order rows are sorted and the table reindexed once for the buffer.
+        assert bulk.add_records([value for record in reversed(records[100:]) for value in record]) == len(records)
+        start = datetime(1973, 1, 2, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+        times = [start + idx * day / 2 for idx in range(2 * 19025)]
+        for interpolation in EOPInterpolation:
+            assert evaluate(bulk, times, interpolation) == evaluate(single, times, interpolation)
+            assert evaluate(bulk, times, interpolation, search=True) == evaluate(single, times, interpolation)
+
+    def test_partial_record(self):
+        with pytest.raises(ValueError):
+            EarthOrientationTable().add_records(array('d', [0.0] * 15))
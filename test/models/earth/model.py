@@ -0,0 +1,324 @@
+import math
+import os
+import pytest
+import shutil
+import threading
+import time
+from array import array
+from datetime import datetime, timezone
+
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector
+from toluene.models.earth.earth_orientation_table import EarthOrientationTable, EOPInterpolation
+from toluene.models.earth.ellipsoid import GeodeticAlgorithm
+from toluene.models.earth.model import EarthModel
+from toluene.time.delta_t import DeltaTExtrapolation, DeltaTInterpolation, DeltaTTable
+from toluene.util.file import datadir
+from toluene_extensions.coordinates import transform
+
+cache_time = datetime(2023, 11, 20, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+
+
+class TestEarthModel:
+    def test_rotation_cache_counters(self):
+        earth_model = EarthModel()
+        earth_model.clear_rotation_cache()
+        point = StateVector(-2850075.294343253, 4655695.796924158, 3287765.2299773037, time=cache_time,
+                            frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        first = point.get_gcrs(earth_model)
+        for _ in range(9):
+            assert point.get_gcrs(earth_model).position == first.position
+        assert earth_model.rotation_cache_misses == 1
+        assert earth_model.rotation_cache_hits == 9
+
+    def test_rotation_cache_disabled(self):
+        earth_model = EarthModel()
+        cached = StateVector(7000000.0, 0.0, 0.0, 0.0, 7500.0, 0.0, time=cache_time,
+                             frame=ReferenceFrame.InternationalTerrestrialReferenceFrame).get_gcrs(earth_model)
+        earth_model.set_rotation_cache_size(0)
+        assert earth_model.rotation_cache_size == 0
+        for _ in range(3):
+            uncached = StateVector(7000000.0, 0.0, 0.0, 0.0, 7500.0, 0.0, time=cache_time,
+                                   frame=ReferenceFrame.InternationalTerrestrialReferenceFrame).get_gcrs(earth_model)
+            assert uncached.position == pytest.approx(cached.position, abs=0.0)
+            assert uncached.velocity == pytest.approx(cached.velocity, abs=0.0)
+        assert earth_model.rotation_cache_hits == 0
+        assert earth_model.rotation_cache_misses == 4
+
+
+class TestEarthModelSnapshot:
+    @staticmethod
+    def transform(earth_model):
+        states = []
+        for day in range(0, 3650, 73):
+            point = StateVector(-2850075.294343253, 4655695.796924158, 3287765.2299773037, 10.0, -20.0, 5.0,
+                                time=cache_time - day * 86400.0 + 1234.5,
+                                frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+            gcrs = point.get_gcrs(earth_model)
+            states.append(tuple(gcrs.position) + tuple(gcrs.velocity))
+        return states
+
+    def test_round_trip(self, tmp_path):
+        built = EarthModel()
+        built.set_eop_interpolation(EOPInterpolation.Lagrange)
+        built.set_geodetic_algorithm(GeodeticAlgorithm.Vermeille)
+        # Transforming first builds the nutation columns, so they are saved as well.
+        expected = self.transform(built)
+        built.save(str(tmp_path / 'earth.model'))
+        loaded = EarthModel.load(str(tmp_path / 'earth.model'))
+        assert self.transform(loaded) == expected
+        assert loaded.geodetic_algorithm is GeodeticAlgorithm.Vermeille
+
+    def test_attach(self, tmp_path):
+        path = tmp_path / 'earth.model'
+        built = EarthModel()
+        expected = self.transform(built)
+        built.save(str(path))
+        attached = EarthModel.attach(str(path))
+        assert self.transform(attached) == expected
+        # Saving over the snapshot renames a new file into place, the attached model keeps its own mapping.
+        EarthModel().save(str(path))
+        assert self.transform(attached) == expected
+        assert self.transform(EarthModel.attach(str(path))) == expected
+
+    @pytest.mark.skipif(not os.path.exists('/proc/self/maps'), reason='Needs /proc/self/maps to list mappings.')
+    def test_delete_unmaps(self, tmp_path):
+        path = tmp_path / 'earth.model'
+        EarthModel().save(str(path))
+
+        def mappings():
+            with open('/proc/self/maps') as f:
+                return sum(1 for line in f if line.rstrip().endswith(str(path)))
+
+        for _ in range(5):
+            attached = EarthModel.attach(str(path))
+            assert mappings() == 1
+            del attached
+        assert mappings() == 0
+
+    def test_saving_is_deterministic(self, tmp_path):
+        earth_model = EarthModel()
+        earth_model.save(str(tmp_path / 'first.model'))
+        EarthModel.load(str(tmp_path / 'first.model')).save(str(tmp_path / 'second.model'))
+        assert (tmp_path / 'first.model').read_bytes() == (tmp_path / 'second.model').read_bytes()
+
+    def test_concurrent_saves(self, tmp_path):
+        earth_model = EarthModel()
+        expected = self.transform(earth_model)
+        path = tmp_path / 'earth.model'
+        errors = []
+
+        # Saving releases the GIL, so every thread writes its own temporary file at the same time.
+        def save():
+            try:
+                for _ in range(25):
+                    earth_model.save(str(path))
+            except OSError as error:
+                errors.append(error)
+
+        threads = [threading.Thread(target=save) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        assert errors == []
+        assert os.listdir(str(tmp_path)) == ['earth.model']
+        assert self.transform(EarthModel.attach(str(path))) == expected
+
+    def test_rejects_damaged_snapshots(self, tmp_path):
+        path = tmp_path / 'earth.model'
+        EarthModel().save(str(path))
+        snapshot = bytearray(path.read_bytes())
+
+        damaged = bytearray(snapshot)
+        damaged[len(damaged) // 2] ^= 0x10
+        path.write_bytes(damaged)
+        with pytest.raises(ValueError, match='checksum'):
+            EarthModel.load(str(path))
+
+        path.write_bytes(snapshot[:len(snapshot) - 64])
+        with pytest.raises(ValueError, match='truncated'):
+            EarthModel.load(str(path))
+
+        damaged = bytearray(snapshot)
+        damaged[8] += 1
+        path.write_bytes(damaged)
+        with pytest.raises(ValueError, match='version'):
+            EarthModel.load(str(path))
+
+        path.write_bytes(b'finals2000A')
+        with pytest.raises(ValueError):
+            EarthModel.load(str(path))
+        with pytest.raises(ValueError):
+            EarthModel.attach(str(path))
+
+        with pytest.raises(FileNotFoundError):
+            EarthModel.load(str(tmp_path / 'missing.model'))
+
+
+class TestDeltaTTable:
+    table = DeltaTTable(datadir + '/deltat.data')
+    year = 365.2425 * 86400.0
+
+    @staticmethod
+    def parse_with_python(path):
+        # The columns as read by the Python parser the C loader replaced.
+        records = array('d')
+        with open(path, 'r') as file:
+            for line in file:
+                timestamp = datetime(int(line[1:5]), int(line[6:8]), int(line[9:11]), tzinfo=timezone.utc).timestamp()
+                records.extend((timestamp, float(line[12:])))
+        return records
+
+    def test_loader_matches_python(self):
+        records = self.parse_with_python(datadir + '/deltat.data')
+        table = DeltaTTable()
+        assert table.add_records(records) == len(records) // 2
+        loaded = DeltaTTable()
+        assert loaded.load_from_file(datadir + '/deltat.data') == len(records) // 2
+        for stepped in (table, loaded):
+            stepped.set_interpolation(DeltaTInterpolation.Step)
+        times = [time + offset for time in records[0::2] for offset in (0.0, 1000.0)]
+        assert list(table.lookup(times)) == list(loaded.lookup(times))
+        assert list(loaded.lookup(records[0::2])) == list(records[1::2])
+
+    def test_loads_append(self, tmp_path):
+        with open(datadir + '/deltat.data', 'r') as file:
+            lines = file.readlines()
+        # The later half is loaded first, so the second load both appends and has to restore the order.
+        (tmp_path / 'early.data').write_text(''.join(lines[:len(lines) // 2]))
+        (tmp_path / 'late.data').write_text(''.join(lines[len(lines) // 2:]))
+        loaded = DeltaTTable(str(tmp_path / 'late.data'))
+        assert loaded.load_from_file(str(tmp_path / 'early.data')) == len(lines)
+        records = self.parse_with_python(datadir + '/deltat.data')
+        assert list(loaded.lookup(records[0::2])) == list(self.table.lookup(records[0::2]))
+
+    def test_interpolation_between_records(self):
+        records = self.parse_with_python(datadir + '/deltat.data')
+        for idx in range(0, len(records) - 2, 50):
+            start, end = records[idx:idx + 2], records[idx + 2:idx + 4]
+            middle = self.table.lookup([(start[0] + end[0]) / 2])[0]
+            assert middle == pytest.approx((start[1] + end[1]) / 2, abs=1e-12)
+        assert DeltaTTable().lookup([0.0, 1e9]) == array('d', [0.0, 0.0])
+
+    def test_extrapolation(self):
+        records = self.parse_with_python(datadir + '/deltat.data')
+        first, last = records[0:2], records[-2:]
+        # The polynomials meet the table at both ends and take over from it a century out.
+        assert self.table.lookup([first[0] - 1.0, last[0] + 1.0]) == \
+            pytest.approx([first[1], last[1]], abs=1e-6)
+        assert self.table.lookup([(2300.0 - 1970.0) * self.year])[0] == pytest.approx(-20.0 + 32.0 * 4.8 ** 2)
+        assert self.table.lookup([(1000.0 - 1970.0) * self.year])[0] == pytest.approx(1574.2, abs=1e-6)
+        # The extrapolation changes smoothly on both sides of the table.
+        past = self.table.lookup([first[0] - idx * self.year for idx in range(200)])
+        future = self.table.lookup([last[0] + idx * self.year for idx in range(200)])
+        for values in (past, future):
+            assert max(abs(b - a) for a, b in zip(values, values[1:])) < 5.0
+        table = DeltaTTable(datadir + '/deltat.data')
+        table.set_extrapolation(DeltaTExtrapolation.Clamp)
+        assert list(table.lookup([-1e11, 1e11])) == [first[1], last[1]]
+
+    def test_non_finite_times(self):
+        records = self.parse_with_python(datadir + '/deltat.data')
+        extrapolated = self.table.lookup([math.inf, -math.inf, math.nan])
+        assert extrapolated[0:2] == array('d', [math.inf, math.inf])
+        assert math.isnan(extrapolated[2])
+        table = DeltaTTable(datadir + '/deltat.data')
+        table.set_extrapolation(DeltaTExtrapolation.Clamp)
+        clamped = table.lookup([math.inf, -math.inf, math.nan])
+        assert clamped[0:2] == array('d', [records[-1], records[1]])
+        assert math.isnan(clamped[2])
+
+    def test_snapshot_keeps_settings(self, tmp_path):
+        table = DeltaTTable(datadir + '/deltat.data')
+        table.set_interpolation(DeltaTInterpolation.Step)
+        table.set_extrapolation(DeltaTExtrapolation.Clamp)
+        built = EarthModel(delta_t_table=table)
+        # Far past the table Delta T is held at 69 s rather than extrapolated to about 440 s.
+        point = StateVector(7000000.0, 0.0, 0.0, time=(2200.0 - 1970.0) * self.year,
+                            frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        expected = point.get_gcrs(built).position
+        assert expected != point.get_gcrs(EarthModel()).position
+        built.save(str(tmp_path / 'earth.model'))
+        assert point.get_gcrs(EarthModel.load(str(tmp_path / 'earth.model'))).position == expected
+
+
+class TestEOPHotSwap:
+    def test_swap(self):
+        earth_model = EarthModel()
+        expected = TestEarthModelSnapshot.transform(earth_model)
+        version = earth_model.eop_version
+        earth_model.set_eop_table(EarthOrientationTable())
+        assert earth_model.eop_version == version + 1
+        assert TestEarthModelSnapshot.transform(earth_model) != expected
+        # The rotations cached from the empty table are not served once the full table is back.
+        earth_model.set_eop_table(EarthOrientationTable(datadir + '/finals2000A.all'))
+        assert earth_model.eop_version == version + 2
+        assert TestEarthModelSnapshot.transform(earth_model) == expected
+
+    def test_keep_interpolation(self):
+        earth_model = EarthModel()
+        earth_model.set_eop_interpolation(EOPInterpolation.Lagrange)
+        expected = TestEarthModelSnapshot.transform(earth_model)
+        earth_model.set_eop_table(EarthOrientationTable(datadir + '/finals2000A.all'), keep_interpolation=True)
+        assert TestEarthModelSnapshot.transform(earth_model) == expected
+
+    def test_swap_while_converting(self):
+        npoints = 4096
+        positions = array('d', [-2850075.29, 4655695.79, 3287765.22] * npoints)
+        times = array('d', [cache_time + idx * 60.0 for idx in range(npoints)])
+        earth_model = EarthModel()
+        earth_model.set_rotation_cache_size(0)
+        expected = []
+        for table in (EarthOrientationTable(datadir + '/finals2000A.all'), EarthOrientationTable()):
+            earth_model.set_eop_table(table)
+            out = array('d', bytes(len(positions) * 8))
+            transform.itrf_to_gcrf_position_batch(positions, times, earth_model.capsule, out)
+            expected.append(out)
+
+        failures = []
+        stopping = threading.Event()
+
+        def convert():
+            out = array('d', bytes(len(positions) * 8))
+            while not stopping.is_set():
+                transform.itrf_to_gcrf_position_batch(positions, times, earth_model.capsule, out)
+                # Every point is converted whole with one of the two tables.
+                for idx in range(0, len(out), 3):
+                    if out[idx:idx + 3] not in (expected[0][idx:idx + 3], expected[1][idx:idx + 3]):
+                        failures.append(idx // 3)
+                        return
+
+        threads = [threading.Thread(target=convert) for _ in range(2)]
+        for thread in threads:
+            thread.start()
+        for swap in range(20):
+            earth_model.set_eop_table(EarthOrientationTable() if swap % 2 else
+                                      EarthOrientationTable(datadir + '/finals2000A.all'))
+            time.sleep(0.01)
+        stopping.set()
+        for thread in threads:
+            thread.join()
+        assert not failures
+
+    def test_watcher(self, tmp_path):
+        path = tmp_path / 'finals.all'
+        with open(datadir + '/finals2000A.all', 'r') as file:
+            lines = file.readlines()
+        path.write_text(''.join(lines[:100]))
+        earth_model = EarthModel()
+        expected = TestEarthModelSnapshot.transform(earth_model)
+        with earth_model.watch_eop_file(str(path), interval=0.01) as watcher:
+            version = earth_model.eop_version
+            # Written beside the file and renamed over it, as a download should be.
+            shutil.copyfile(datadir + '/finals2000A.all', tmp_path / 'finals.new')
+            os.replace(tmp_path / 'finals.new', path)
+            deadline = time.monotonic() + 10.0
+            while watcher.reloads == 0 and time.monotonic() < deadline:
+                time.sleep(0.01)
+            assert watcher.reloads == 1
+            assert earth_model.eop_version == version + 1
+            assert TestEarthModelSnapshot.transform(earth_model) == expected
+            os.remove(path)
+            assert not watcher.check()
+        assert earth_model.eop_version == version + 1
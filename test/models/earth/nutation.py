@@ -0,0 +1,148 @@
+import pytest
+import toluene
+import yaml
+from datetime import datetime, timezone
+
+from toluene.coordinates.reference_frame import ReferenceFrame
+from toluene.coordinates.state_vector import StateVector
+from toluene.models.earth.model import EarthModel, PrecisionTier
+from toluene.models.earth.nutation import NutationEphemeris, NutationKernel, NutationSeries, NutationStrategy, \
+    get_nutation_kernel, set_nutation_kernel
+from toluene.util.file import configdir
+from toluene_extensions.models.earth.nutation import add_record
+
+ephemeris_start = datetime(2023, 11, 20, 0, 0, 0, tzinfo=timezone.utc).timestamp()
+ephemeris_end = ephemeris_start + 10 * 86400.0
+
+
+class TestNutationEphemeris:
+    def test_ephemeris_matches_series(self):
+        with open(configdir + '/nutation.yml') as f:
+            series = NutationSeries(yaml.safe_load(f)['nutation']['series'])
+        ephemeris = NutationEphemeris(series, ephemeris_start, ephemeris_end, tolerance=1e-7)
+        assert ephemeris.max_error <= 1e-7
+        assert ephemeris.degree == 12
+        for step in range(100):
+            t = ephemeris_start + step * (ephemeris_end - ephemeris_start) / 100 + 1234.5
+            assert ephemeris.values(t) == pytest.approx(series.values(t), abs=1e-7)
+
+    def test_ephemeris_outside_span(self):
+        earth_model = EarthModel()
+        ephemeris = NutationEphemeris(earth_model, ephemeris_start, ephemeris_end)
+        with pytest.raises(ValueError):
+            ephemeris.values(ephemeris_end + 1.0)
+
+    def test_model_uses_ephemeris(self):
+        series_model = EarthModel()
+        ephemeris_model = EarthModel()
+        assert ephemeris_model.fit_nutation_ephemeris(ephemeris_start, ephemeris_end) <= 1e-6
+        for t in (ephemeris_start, ephemeris_start + 3.5 * 86400.0, ephemeris_end + 86400.0):
+            point = StateVector(7000000.0, 0.0, 0.0, 0.0, 7500.0, 0.0, time=t,
+                                frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+            expected = point.get_gcrs(series_model)
+            fitted = point.get_gcrs(ephemeris_model)
+            assert fitted.position == pytest.approx(expected.position, abs=1e-6)
+            assert fitted.velocity == pytest.approx(expected.velocity, abs=1e-9)
+
+
+class TestNutationTruncation:
+    def test_truncated_series_within_error(self):
+        with open(configdir + '/nutation.yml') as f:
+            series = NutationSeries(yaml.safe_load(f)['nutation']['series'])
+        truncated = series.truncated(threshold=1e-4)
+        assert 0 < truncated.terms < series.terms
+        assert 0.0 < truncated.truncation_error <= truncated.truncation_error_bound
+        for step in range(20):
+            t = ephemeris_start + step * 86400.0 * 37
+            full, fitted = series.values(t), truncated.values(t)
+            assert abs(full[0] - fitted[0]) <= truncated.truncation_error * 1.01
+            assert abs(full[1] - fitted[1]) <= truncated.truncation_error * 1.01
+        assert series.truncated(max_terms=77).terms == 77
+        assert series.truncated().terms == series.terms
+        assert series.truncated().truncation_error == 0.0
+
+    def test_model_precision_tier(self):
+        earth_model = EarthModel()
+        point = StateVector(7000000.0, 0.0, 0.0, 0.0, 7500.0, 0.0, time=ephemeris_start,
+                            frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        full = point.get_gcrs(earth_model)
+        error = earth_model.set_precision(PrecisionTier.Low)
+        assert earth_model.precision == PrecisionTier.Low
+        assert 0.0 < error <= earth_model.nutation_truncation_error_bound
+        low = point.get_gcrs(earth_model)
+        assert low.position != full.position
+        # An arcsecond is 34 m at 7000 km
+        assert low.position == pytest.approx(full.position, abs=34.0 * error * 2)
+        earth_model.set_precision(PrecisionTier.Full)
+        assert point.get_gcrs(earth_model).position == full.position
+
+
+class TestVectorizedNutation:
+    def test_kernels_match_extended(self):
+        with open(configdir + '/nutation.yml') as f:
+            series = NutationSeries(yaml.safe_load(f)['nutation']['series'])
+        times = [ephemeris_start + step * 86400.0 * 91.3 for step in range(-200, 200, 7)]
+        series.set_strategy(NutationStrategy.Extended)
+        extended = [series.values(t) for t in times]
+        series.set_strategy(NutationStrategy.Vectorized)
+        selected, supported = get_nutation_kernel()
+        assert selected == supported
+        try:
+            for kernel in NutationKernel:
+                if kernel > supported:
+                    continue
+                set_nutation_kernel(kernel)
+                for t, expected in zip(times, extended):
+                    assert series.values(t) == pytest.approx(expected, abs=1e-9)
+        finally:
+            set_nutation_kernel(supported)
+
+    def test_default_strategy_follows_build(self):
+        with open(configdir + '/nutation.yml') as f:
+            series = NutationSeries(yaml.safe_load(f)['nutation']['series'])
+        times = [ephemeris_start + step * 86400.0 * 91.3 for step in range(-200, 200, 7)]
+        default = [series.values(t) for t in times]
+        # The extended build must keep its long double sums unless a caller opts into the double precision kernels
+        if toluene.precision == 'extended':
+            series.set_strategy(NutationStrategy.Extended)
+        else:
+            series.set_strategy(NutationStrategy.Vectorized)
+        assert [series.values(t) for t in times] == default
+
+    def test_recurrence_matches_extended(self):
+        with open(configdir + '/nutation.yml') as f:
+            series = NutationSeries(yaml.safe_load(f)['nutation']['series'])
+        times = [ephemeris_start + step * 86400.0 * 91.3 for step in range(-200, 200, 7)]
+        series.set_strategy(NutationStrategy.Extended)
+        extended = [series.values(t) for t in times]
+        series.set_strategy(NutationStrategy.Recurrence)
+        for t, expected in zip(times, extended):
+            assert series.values(t) == pytest.approx(expected, abs=1e-9)
+
+    def test_model_strategy(self):
+        earth_model = EarthModel()
+        point = StateVector(7000000.0, 0.0, 0.0, 0.0, 7500.0, 0.0, time=ephemeris_start,
+                            frame=ReferenceFrame.InternationalTerrestrialReferenceFrame)
+        default = point.get_gcrs(earth_model)
+        earth_model.set_nutation_strategy(NutationStrategy.Extended)
+        extended = point.get_gcrs(earth_model)
+        assert default.position == pytest.approx(extended.position, abs=1e-6)
+        assert default.velocity == pytest.approx(extended.velocity, abs=1e-9)
+
+
+class TestNutationBulkAppend:
+    def test_matches_single_appends(self):
+        with open(configdir + '/nutation.yml') as f:
+            rows = yaml.safe_load(f)['nutation']['series']
+        bulk = NutationSeries(rows)
+        single = NutationSeries()
+        for idx in range(0, len(rows), 21):
+            add_record(single.capsule, *rows[idx + 1:idx + 21])
+        assert bulk.terms == single.terms == len(rows) // 21
+        for step in range(10):
+            t = ephemeris_start + step * 86400.0 * 365.25
+            assert bulk.values(t) == single.values(t)
+
+    def test_partial_record(self):
+        with pytest.raises(ValueError):
+            NutationSeries().add_records([0.0] * 21)
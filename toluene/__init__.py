@@ -1 +1,39 @@
-__version__ = '0.0.0'
\ No newline at end of file
+import importlib
+import os
+import sys
+
+__version__ = '0.0.0'
+
+# The C core is built twice, an extended build on long double and a fast build on double. The build is picked once
+# here, before any extension is imported, from the TOLUENE_PRECISION environment variable.
+precision = os.environ.get('TOLUENE_PRECISION', 'extended')
+if precision not in ('extended', 'fast'):
+    raise ImportError("TOLUENE_PRECISION must be 'extended' or 'fast', not %r" % precision)
+if precision == 'fast':
+    if 'toluene_extensions' in sys.modules and sys.modules['toluene_extensions'].__name__ != 'toluene_extensions_fast':
+        raise ImportError('The extended toluene_extensions were imported before toluene, the fast build can not be '
+                          'selected.')
+    sys.modules['toluene_extensions'] = importlib.import_module('toluene_extensions_fast')
+
+
+def set_num_threads(nthreads: int):
+    """
+    Sets the number of native threads batched transforms are split across, the calling thread included. Every
+    extension releases the GIL while it computes, so Python threads calling into toluene run in parallel regardless.
+
+    :param nthreads: The number of threads, 0 for one per online processor.
+    :type nthreads: int
+    """
+    from toluene_extensions.coordinates import transform
+    transform.set_num_threads(nthreads)
+
+
+def get_num_threads():
+    """
+    Gets the number of native threads batched transforms are split across.
+
+    :return: The number of threads, the calling thread included.
+    :rtype: int
+    """
+    from toluene_extensions.coordinates import transform
+    return transform.get_num_threads()
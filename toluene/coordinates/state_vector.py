@@ -32,7 +32,7 @@ from toluene.models.earth.model import EarthModel
 from toluene_extensions.coordinates import state_vector, transform
 
 
-class StateVector:
+class StateVector(state_vector.StateVector):
     """
     StateVector representation in Python. State Vectors are used to represent coordinates in various implemented
     reference frames. The three most common being Geodetic which is Latitude, Longitude, and altitude. These require
@@ -42,6 +42,9 @@ class StateVector:
     earth rotates under them. This requires the UTC timestamp of the coordinates to mean anything to an observer on
     earth. This is the backbone to anything to do with position, velocity, and/or acceleration data.
 
+    The state is held inline by the C extension type this class extends, position, velocity, acceleration, time and
+    frame are read and written directly on it without going through Python.
+
     :param x: x-axis displacement this is in meters for cartisian coordinates or latitude for spherical coordinates.
     :type x: float
     :param y: y-axis displacement this is in meters for cartisian coordinates or longitude for spherical
@@ -58,60 +61,11 @@ class StateVector:
     :type time: float
     :param frame: The reference frame of the coordinates.
     :type frame: :class:`ReferenceFrame`
+    :param capsule: Deprecated and removed in the next release. A StateVector capsule from before StateVector was a
+        native type, its state is copied and the other arguments are ignored. Emits a DeprecationWarning.
     """
 
-    def __init__(self, x: float, y: float, z: float = 0.0, vx: float = 0.0, vy: float = 0.0, vz: float = 0.0,
-                 ax: float = 0.0, ay: float = 0.0, az: float = 0.0,
-                 time: float = 0.0, frame: ReferenceFrame = ReferenceFrame.GeodeticReferenceFrame,
-                 capsule: py_object = None):
-        if capsule is None:
-            self.__state_vector = state_vector.new_StateVector(x, y, z, vx, vy, vz, ax, ay, az, time, int(frame))
-        else:
-            self.__state_vector = capsule
-
-    """
-    Gets the position vector as a tuple of floats.
-    
-    :return: The position vector.
-    :rtype: tuple(float, float, float)
-    """
-
-    @property
-    def position(self) -> (float, float, float):
-        return state_vector.get_position(self.__state_vector)
-
-    """
-    Gets the velocity vector as a tuple of floats.
-    
-    :return: The velocity vector.
-    :rtype: tuple(float, float, float)
-    """
-
-    @property
-    def velocity(self) -> (float, float, float):
-        return state_vector.get_velocity(self.__state_vector)
-
-    """
-    Gets the acceleration vector as a tuple of floats.
-    
-    :return: The acceleration vector.
-    :rtype: tuple(float, float, float)
-    """
-
-    @property
-    def acceleration(self) -> (float, float, float):
-        return state_vector.get_acceleration(self.__state_vector)
-
-    """
-    Gets the time of the vector. This is the time since the UNIX epoch not since J2000.0.
-    
-    :return: The time of the vector.
-    :rtype: float
-    """
-
-    @property
-    def time(self) -> float:
-        return state_vector.get_time(self.__state_vector)
+    __slots__ = ()
 
     """
     Gets the frame the vector is in.
@@ -122,46 +76,48 @@ class StateVector:
 
     @property
     def reference_frame(self) -> ReferenceFrame:
-        return ReferenceFrame(state_vector.get_frame(self.__state_vector))
+        return ReferenceFrame(self.frame)
 
     """
-    Creates a copy of the vector.
+    Copies the vector into out, or into a new copy when out is None.
     
-    :return: A new instance of the vector in it's current state.
+    :param out: The StateVector to copy into.
+    :type out: :class:`StateVector`
+    :return: out or the new copy.
     :rtype: :class:`StateVector`
     """
-
-    @property
-    def __copy(self) -> StateVector:
-        frame = state_vector.get_frame(self.__state_vector)
-        position = state_vector.get_position(self.__state_vector)
-        velocity = state_vector.get_velocity(self.__state_vector)
-        acceleration = state_vector.get_acceleration(self.__state_vector)
-        time = state_vector.get_time(self.__state_vector)
-        retval = state_vector.new_StateVector(position[0], position[1], position[2],
-                                              velocity[0], velocity[1], velocity[2], acceleration[0], acceleration[1],
-                                              acceleration[2], time, frame)
-        return StateVector(None, None, capsule=retval)
+    def __copy(self, out: StateVector = None) -> StateVector:
+        if out is None:
+            return self.__copy__()
+        out.assign(self)
+        return out
 
     """
     Creates a copy of the current vector but doing the appropriate translation to be in the GeodeticReferenceFrame.
     
     :param model: The earth model to use for the conversion.
     :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: Written to and returned in place of a new copy, may be this object itself.
+    :type out: :class:`StateVector`
+    :param position_only: Only rotate the position between the terrestrial and celestial frames, skipping the
+        velocity and acceleration terms and the rate of Earth rotation lookup. The rotated velocity and acceleration
+        are zero.
+    :type position_only: bool
     :return: A copy of the state vector in the GeodeticReferenceFrame.
     :rtype: :class:`StateVector`
     """
-    def get_geodetic(self, model: EarthModel) -> StateVector:
-        frame = state_vector.get_frame(self.__state_vector)
-        if frame is int(ReferenceFrame.InternationalTerrestrialReferenceFrame):
-            return StateVector(None, None,
-                               capsule=transform.itrf_to_geodetic(self.__state_vector, model.capsule))
-        elif frame is int(ReferenceFrame.InternationalCelestialReferenceFrame):
+    def get_geodetic(self, model: EarthModel, out: StateVector = None, position_only: bool = False) -> StateVector:
+        frame = self.frame
+        if frame == ReferenceFrame.InternationalTerrestrialReferenceFrame:
+            return transform.itrf_to_geodetic(self, model.capsule, out)
+        elif frame == ReferenceFrame.InternationalCelestialReferenceFrame:
             return None
-        elif frame is int(ReferenceFrame.GeocentricCelestialReferenceFrame):
-            return None
-        elif frame is int(ReferenceFrame.GeodeticReferenceFrame):
-            return self.__copy
+        elif frame == ReferenceFrame.GeocentricCelestialReferenceFrame:
+            if position_only:
+                return transform.gcrf_to_geodetic_position(self, model.capsule, out)
+            return transform.gcrf_to_geodetic(self, model.capsule, out)
+        elif frame == ReferenceFrame.GeodeticReferenceFrame:
+            return self.__copy(out)
         return None
 
     """
@@ -170,21 +126,27 @@ class StateVector:
 
     :param model: The earth model to use for the conversion.
     :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: Written to and returned in place of a new copy, may be this object itself.
+    :type out: :class:`StateVector`
+    :param position_only: Only rotate the position between the terrestrial and celestial frames, skipping the
+        velocity and acceleration terms and the rate of Earth rotation lookup. The rotated velocity and acceleration
+        are zero.
+    :type position_only: bool
     :return: A copy of the state vector in the GeodeticReferenceFrame.
     :rtype: :class:`StateVector`
     """
-    def get_itrs(self, model: EarthModel) -> StateVector:
-        frame = state_vector.get_frame(self.__state_vector)
-        if frame is int(ReferenceFrame.InternationalTerrestrialReferenceFrame):
-            return self.__copy
-        elif frame is int(ReferenceFrame.InternationalCelestialReferenceFrame):
+    def get_itrs(self, model: EarthModel, out: StateVector = None, position_only: bool = False) -> StateVector:
+        frame = self.frame
+        if frame == ReferenceFrame.InternationalTerrestrialReferenceFrame:
+            return self.__copy(out)
+        elif frame == ReferenceFrame.InternationalCelestialReferenceFrame:
             return None
-        elif frame is int(ReferenceFrame.GeocentricCelestialReferenceFrame):
-            return StateVector(None, None,
-                               capsule=transform.gcrf_to_itrf(self.__state_vector, model.capsule))
-        elif frame is int(ReferenceFrame.GeodeticReferenceFrame):
-            return StateVector(None, None,
-                               capsule=transform.geodetic_to_itrf(self.__state_vector, model.capsule))
+        elif frame == ReferenceFrame.GeocentricCelestialReferenceFrame:
+            if position_only:
+                return transform.gcrf_to_itrf_position(self, model.capsule, out)
+            return transform.gcrf_to_itrf(self, model.capsule, out)
+        elif frame == ReferenceFrame.GeodeticReferenceFrame:
+            return transform.geodetic_to_itrf(self, model.capsule, out)
         return None
 
 
@@ -195,21 +157,167 @@ class StateVector:
     
     :param model: The earth model to use for the conversion.
     :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: Written to and returned in place of a new copy, may be this object itself.
+    :type out: :class:`StateVector`
+    :param position_only: Only rotate the position between the terrestrial and celestial frames, skipping the
+        velocity and acceleration terms and the rate of Earth rotation lookup. The rotated velocity and acceleration
+        are zero.
+    :type position_only: bool
     :return: A copy of the state vector in the GeodeticReferenceFrame.
     :rtype: :class:`StateVector`
     """
-    def get_gcrs(self, model: EarthModel) -> StateVector:
-        frame = state_vector.get_frame(self.__state_vector)
-        if frame is int(ReferenceFrame.InternationalTerrestrialReferenceFrame):
-            return StateVector(None, None,
-                                 capsule=transform.itrf_to_gcrf(self.__state_vector, model.capsule))
-        elif frame is int(ReferenceFrame.InternationalCelestialReferenceFrame):
-            return None
-        elif frame is int(ReferenceFrame.GeocentricCelestialReferenceFrame):
-            return self.__copy
-        elif frame is int(ReferenceFrame.GeodeticReferenceFrame):
+    def get_gcrs(self, model: EarthModel, out: StateVector = None, position_only: bool = False) -> StateVector:
+        frame = self.frame
+        if frame == ReferenceFrame.InternationalTerrestrialReferenceFrame:
+            if position_only:
+                return transform.itrf_to_gcrf_position(self, model.capsule, out)
+            return transform.itrf_to_gcrf(self, model.capsule, out)
+        elif frame == ReferenceFrame.InternationalCelestialReferenceFrame:
             return None
+        elif frame == ReferenceFrame.GeocentricCelestialReferenceFrame:
+            return self.__copy(out)
+        elif frame == ReferenceFrame.GeodeticReferenceFrame:
+            if position_only:
+                return transform.geodetic_to_gcrf_position(self, model.capsule, out)
+            return transform.geodetic_to_gcrf(self, model.capsule, out)
+
+    """
+    The object handed to the C extensions. The extensions work on the StateVector itself, this is kept for callers
+    that still pass the capsule.
+    
+    :return: The state vector.
+    :rtype: :class:`StateVector`
+    """
 
     @property
     def capsule(self) -> py_object:
-        return self.__state_vector
+        return self
+
+
+class StateVectorArray(state_vector.StateVectorArray):
+    """
+    Many state vectors stored as contiguous columns, for catalogs and tracks too large to hold as separate
+    :class:`StateVector` objects. The position, velocity, acceleration, time and frame columns are memoryviews over
+    the array's own memory so ``numpy.asarray`` views them without copying, and writes through them change the states.
+    The frame transforms accept the array directly and convert every state in one call.
+
+    :param states: The number of states, zeroed, or a sequence of :class:`StateVector` to copy in.
+    :type states: int or list(:class:`StateVector`)
+    :param frame: The reference frame of the states when created from a number.
+    :type frame: :class:`ReferenceFrame`
+    """
+
+    __slots__ = ()
+
+    _item_type = StateVector
+
+    """
+    Gets the frame of the states, every state has to be in the same frame for the conversions.
+    
+    :return: The frame of the states or None if they are in different frames or there are none.
+    :rtype: :class:`ReferenceFrame`
+    """
+
+    @property
+    def reference_frame(self) -> ReferenceFrame:
+        frames = set(self.frame.tolist())
+        if len(frames) != 1:
+            return None
+        return ReferenceFrame(frames.pop())
+
+    """
+    Copies the states into out, or into a new copy when out is None.
+    
+    :param out: The StateVectorArray to copy into.
+    :type out: :class:`StateVectorArray`
+    :return: out or the new copy.
+    :rtype: :class:`StateVectorArray`
+    """
+    def __copy(self, out: StateVectorArray = None) -> StateVectorArray:
+        if out is None:
+            return self.__copy__()
+        out.assign(self)
+        return out
+
+    """
+    Creates a copy of the states translated to the GeodeticReferenceFrame.
+    
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: Written to and returned in place of a new copy, may be this object itself.
+    :type out: :class:`StateVectorArray`
+    :param position_only: Only rotate the position between the terrestrial and celestial frames, skipping the
+        velocity and acceleration terms and the rate of Earth rotation lookup. The rotated velocity and acceleration
+        are zero.
+    :type position_only: bool
+    :return: A copy of the states in the GeodeticReferenceFrame.
+    :rtype: :class:`StateVectorArray`
+    """
+    def get_geodetic(self, model: EarthModel, out: StateVectorArray = None,
+                     position_only: bool = False) -> StateVectorArray:
+        frame = self.reference_frame
+        if frame == ReferenceFrame.InternationalTerrestrialReferenceFrame:
+            return transform.itrf_to_geodetic(self, model.capsule, out)
+        elif frame == ReferenceFrame.GeocentricCelestialReferenceFrame:
+            if position_only:
+                return transform.gcrf_to_geodetic_position(self, model.capsule, out)
+            return transform.gcrf_to_geodetic(self, model.capsule, out)
+        elif frame == ReferenceFrame.GeodeticReferenceFrame:
+            return self.__copy(out)
+        return None
+
+    """
+    Creates a copy of the states translated to the InternationalTerrestrialReferenceFrame.
+
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: Written to and returned in place of a new copy, may be this object itself.
+    :type out: :class:`StateVectorArray`
+    :param position_only: Only rotate the position between the terrestrial and celestial frames, skipping the
+        velocity and acceleration terms and the rate of Earth rotation lookup. The rotated velocity and acceleration
+        are zero.
+    :type position_only: bool
+    :return: A copy of the states in the InternationalTerrestrialReferenceFrame.
+    :rtype: :class:`StateVectorArray`
+    """
+    def get_itrs(self, model: EarthModel, out: StateVectorArray = None,
+                 position_only: bool = False) -> StateVectorArray:
+        frame = self.reference_frame
+        if frame == ReferenceFrame.InternationalTerrestrialReferenceFrame:
+            return self.__copy(out)
+        elif frame == ReferenceFrame.GeocentricCelestialReferenceFrame:
+            if position_only:
+                return transform.gcrf_to_itrf_position(self, model.capsule, out)
+            return transform.gcrf_to_itrf(self, model.capsule, out)
+        elif frame == ReferenceFrame.GeodeticReferenceFrame:
+            return transform.geodetic_to_itrf(self, model.capsule, out)
+        return None
+
+    """
+    Creates a copy of the states translated to the GeocentricCelestialReferenceFrame.
+
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: Written to and returned in place of a new copy, may be this object itself.
+    :type out: :class:`StateVectorArray`
+    :param position_only: Only rotate the position between the terrestrial and celestial frames, skipping the
+        velocity and acceleration terms and the rate of Earth rotation lookup. The rotated velocity and acceleration
+        are zero.
+    :type position_only: bool
+    :return: A copy of the states in the GeocentricCelestialReferenceFrame.
+    :rtype: :class:`StateVectorArray`
+    """
+    def get_gcrs(self, model: EarthModel, out: StateVectorArray = None,
+                 position_only: bool = False) -> StateVectorArray:
+        frame = self.reference_frame
+        if frame == ReferenceFrame.InternationalTerrestrialReferenceFrame:
+            if position_only:
+                return transform.itrf_to_gcrf_position(self, model.capsule, out)
+            return transform.itrf_to_gcrf(self, model.capsule, out)
+        elif frame == ReferenceFrame.GeocentricCelestialReferenceFrame:
+            return self.__copy(out)
+        elif frame == ReferenceFrame.GeodeticReferenceFrame:
+            if position_only:
+                return transform.geodetic_to_gcrf_position(self, model.capsule, out)
+            return transform.geodetic_to_gcrf(self, model.capsule, out)
+        return None
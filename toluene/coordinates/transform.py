@@ -0,0 +1,159 @@
+# # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+#                                                                                   #
+#   MIT License                                                                     #
+#                                                                                   #
+#   Copyright (c) 2023 Tri-Nitro                                                    #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#                                                                                   #
+from array import array
+from enum import IntEnum
+
+from toluene.models.earth.ellipsoid import GeodeticAlgorithm
+from toluene.models.earth.model import EarthModel
+from toluene_extensions.coordinates import transform
+
+# Instruction sets the double precision ITRS to geodetic kernel of itrf_to_geodetic_position runs on. AVX2 converts
+# four rows per instruction and AVX512 eight, Scalar one at a time with the C library's cbrt and atan.
+GeodeticKernel = IntEnum('GeodeticKernel', [
+    'Scalar',
+    'AVX2',
+    'AVX512',
+])
+
+
+def _output_buffer(states, out):
+    if out is None:
+        out = array('d', bytes(memoryview(states).nbytes))
+    return out
+
+
+def itrf_to_gcrf(states, times, model: EarthModel, out=None):
+    """
+    Converts a batch of InternationalTerrestrialReferenceFrame states to the GeocentricCelestialReferenceFrame in a
+    single call into C. States are given as N rows of 9 doubles (x, y, z, vx, vy, vz, ax, ay, az) in any object
+    supporting the buffer protocol such as an :class:`array.array` or a numpy array, alongside N timestamps.
+
+    :param states: A buffer of N*9 doubles in the ITRS frame.
+    :param times: A buffer of N doubles holding the time of each row in seconds since the UNIX epoch.
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: A writable buffer of N*9 doubles that receives the GCRS rows. Allocated if not given, may be states
+        itself to convert in place.
+    :return: The output buffer.
+    """
+    out = _output_buffer(states, out)
+    transform.itrf_to_gcrf_batch(states, times, model.capsule, out)
+    return out
+
+
+def gcrf_to_itrf(states, times, model: EarthModel, out=None):
+    """
+    Converts a batch of GeocentricCelestialReferenceFrame states to the InternationalTerrestrialReferenceFrame in a
+    single call into C. See :func:`itrf_to_gcrf` for the buffer layout.
+
+    :param states: A buffer of N*9 doubles in the GCRS frame.
+    :param times: A buffer of N doubles holding the time of each row in seconds since the UNIX epoch.
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: A writable buffer of N*9 doubles that receives the ITRS rows. Allocated if not given, may be states
+        itself to convert in place.
+    :return: The output buffer.
+    """
+    out = _output_buffer(states, out)
+    transform.gcrf_to_itrf_batch(states, times, model.capsule, out)
+    return out
+
+
+def itrf_to_gcrf_position(positions, times, model: EarthModel, out=None):
+    """
+    Converts a batch of InternationalTerrestrialReferenceFrame positions to the GeocentricCelestialReferenceFrame,
+    skipping the velocity and acceleration terms and the rate of Earth rotation lookup of :func:`itrf_to_gcrf`.
+
+    :param positions: A buffer of N*3 doubles (x, y, z) in the ITRS frame.
+    :param times: A buffer of N doubles holding the time of each row in seconds since the UNIX epoch.
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: A writable buffer of N*3 doubles that receives the GCRS positions. Allocated if not given, may be
+        positions itself to convert in place.
+    :return: The output buffer.
+    """
+    out = _output_buffer(positions, out)
+    transform.itrf_to_gcrf_position_batch(positions, times, model.capsule, out)
+    return out
+
+
+def gcrf_to_itrf_position(positions, times, model: EarthModel, out=None):
+    """
+    Converts a batch of GeocentricCelestialReferenceFrame positions to the InternationalTerrestrialReferenceFrame,
+    skipping the velocity and acceleration terms and the rate of Earth rotation lookup of :func:`gcrf_to_itrf`.
+
+    :param positions: A buffer of N*3 doubles (x, y, z) in the GCRS frame.
+    :param times: A buffer of N doubles holding the time of each row in seconds since the UNIX epoch.
+    :param model: The earth model to use for the conversion.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: A writable buffer of N*3 doubles that receives the ITRS positions. Allocated if not given, may be
+        positions itself to convert in place.
+    :return: The output buffer.
+    """
+    out = _output_buffer(positions, out)
+    transform.gcrf_to_itrf_position_batch(positions, times, model.capsule, out)
+    return out
+
+
+def itrf_to_geodetic_position(positions, model: EarthModel, out=None, algorithm: GeodeticAlgorithm = None):
+    """
+    Converts a batch of InternationalTerrestrialReferenceFrame positions to latitude, longitude and height on the
+    model's ellipsoid. Runs the algorithms of the single state conversion in double precision, four or eight rows at a
+    time on the widest SIMD kernel the CPU supports. The closed form agrees with the single state conversion to about
+    1e-13 degrees and 1e-8 m.
+
+    :param positions: A buffer of N*3 doubles (x, y, z) in the ITRS frame.
+    :param model: The earth model whose ellipsoid the heights are taken on.
+    :type model: :class:`toluene.models.earth.EarthModel`
+    :param out: A writable buffer of N*3 doubles that receives latitude and longitude in degrees and height in meters.
+        Allocated if not given, may be positions itself to convert in place.
+    :param algorithm: The algorithm the positions are inverted onto the ellipsoid with, the model's if not given.
+    :type algorithm: :class:`toluene.models.earth.ellipsoid.GeodeticAlgorithm`
+    :return: The output buffer.
+    """
+    out = _output_buffer(positions, out)
+    transform.itrf_to_geodetic_position_batch(positions, model.capsule, out, int(algorithm or 0))
+    return out
+
+
+def get_geodetic_kernel():
+    """
+    Gets the kernel :func:`itrf_to_geodetic_position` runs on and the best kernel the CPU supports.
+
+    :return: The kernel in use and the best supported kernel.
+    :rtype: tuple
+    """
+    kernel, supported = transform.get_geodetic_kernel()
+    return GeodeticKernel(kernel), GeodeticKernel(supported)
+
+
+def set_geodetic_kernel(kernel: GeodeticKernel):
+    """
+    Forces the kernel :func:`itrf_to_geodetic_position` runs on. Used to compare the kernels against one another.
+
+    :param kernel: The kernel to use, it must be supported by the CPU.
+    :type kernel: :class:`GeodeticKernel`
+    """
+    transform.set_geodetic_kernel(int(kernel))
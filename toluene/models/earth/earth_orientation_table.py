@@ -23,9 +23,20 @@
 #   SOFTWARE.                                                                       #
 #                                                                                   #
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
-from toluene_extensions.models.earth.earth_orientation_parameters import new_EOPTable, add_record
+from array import array
+from enum import IntEnum
 
-from datetime import datetime
+from toluene_extensions.models.earth.earth_orientation_parameters import new_EOPTable, load_file, add_records, \
+    set_interpolation, interpolate
+
+# Nearest holds each daily record until the next, so dUT1 and polar motion step once a day. Linear interpolates
+# between the two records around the time and Lagrange fits a cubic through the four around it. Both take dUT1
+# across a leap second as continuous with the record before the time.
+EOPInterpolation = IntEnum('EOPInterpolation', [
+    'Nearest',
+    'Linear',
+    'Lagrange',
+])
 
 
 class EarthOrientationTable:
@@ -38,58 +49,59 @@ class EarthOrientationTable:
         if path is not None:
             self.load_from_file(path)
 
+    """
+    Loads the records of an IERS finals2000A file, parsed in one pass over the memory mapped file in C. Each record
+    is stamped with the UNIX time of its Modified Julian Date taken as UTC.
+
+    :param path: The path of the file.
+    :type path: str
+    """
     def load_from_file(self, path: str):
-        with open(path, 'r') as file:
-            for line in file:
-                year = int(line[0:2])
-                month = int(line[2:4])
-                day = int(line[4:6])
-                if line[16] != ' ':
-                    is_bulletin_a_PM_predicted = line[16] == 'P'
-                    bulletin_a_PM_x = float(line[18:27])
-                    bulletin_a_PM_x_error = float(line[27:36])
-                    bulletin_a_PM_y = float(line[37:46])
-                    bulletin_a_PM_y_error = float(line[46:55])
-                    is_bulletin_a_dut1_predicted = line[57] == 'P'
-                    bulletin_a_dut1 = float(line[58:68])
-                    bulletin_a_dut1_error = float(line[68:78])
-                    if line[79:86] != '       ':
-                        bulletin_a_lod = float(line[79:86])
-                        bulletin_a_lod_error = float(line[86:93])
-                    else:
-                        bulletin_a_lod = 0.0
-                        bulletin_a_lod_error = 0.0
-                    if line[134:144] != '          ':
-                        bulletin_b_PM_x = float(line[134:144])
-                        bulletin_b_PM_y = float(line[144:154])
-                        bulletin_b_dut1 = float(line[154:165])
-                    else:
-                        bulletin_b_PM_x = 0.0
-                        bulletin_b_PM_y = 0.0
-                        bulletin_b_dut1 = 0.0
-                else:
-                    is_bulletin_a_PM_predicted = False
-                    bulletin_a_PM_x = 0.0
-                    bulletin_a_PM_x_error = 0.0
-                    bulletin_a_PM_y = 0.0
-                    bulletin_a_PM_y_error = 0.0
-                    is_bulletin_a_dut1_predicted = False
-                    bulletin_a_dut1 = 0.0
-                    bulletin_a_dut1_error = 0.0
-                    bulletin_a_lod = 0.0
-                    bulletin_a_lod_error = 0.0
-                    bulletin_b_PM_x = 0.0
-                    bulletin_b_PM_y = 0.0
-                    bulletin_b_dut1 = 0.0
-                if year <= 73:
-                    year += 2000
-                else:
-                    year += 1900
-                timestamp = datetime(year, month, day, 0, 0, 0, 0).timestamp()
-                add_record(self.__eop_table, timestamp, is_bulletin_a_PM_predicted, bulletin_a_PM_x,
-                           bulletin_a_PM_x_error, bulletin_a_PM_y, bulletin_a_PM_y_error,
-                           is_bulletin_a_dut1_predicted, bulletin_a_dut1, bulletin_a_dut1_error, bulletin_a_lod,
-                           bulletin_a_lod_error, bulletin_b_PM_x, bulletin_b_PM_y, bulletin_b_dut1)
+        load_file(self.__eop_table, path)
+
+    """
+    Appends a flat buffer of records in one call, 14 doubles per record in the order of the C record: the time in
+    seconds since the UNIX epoch, the Bulletin A polar motion predicted flag, x, x error, y and y error, the dUT1
+    predicted flag, dUT1 and its error, LOD and its error, then the Bulletin B polar motion x, y and dUT1. The flags are
+    0 or 1. Room for the whole buffer is reserved at once and the table is sorted and reindexed once if the records
+    arrive out of order.
+
+    :return: The number of records in the table.
+    :rtype: int
+    """
+    def add_records(self, records) -> int:
+        if not isinstance(records, (array, memoryview)):
+            records = array('d', records)
+        return add_records(self.__eop_table, records)
+
+    """
+    Sets how the table is interpolated between its daily records. Nearest is the default.
+
+    :param interpolation: The interpolation.
+    :type interpolation: :class:`EOPInterpolation`
+    """
+    def set_interpolation(self, interpolation: EOPInterpolation):
+        set_interpolation(self.__eop_table, int(interpolation))
+
+    """
+    Evaluates polar motion, dUT1 and LOD at many times in one call into C.
+
+    :param times: A buffer of N doubles holding the times in seconds since the UNIX epoch.
+    :param out: A writable buffer of N*4 doubles receiving PM x, PM y, dUT1 and LOD for each time.
+    :param interpolation: The interpolation to evaluate with.
+    :type interpolation: :class:`EOPInterpolation`
+    :param search: Binary search the table for every time instead of computing the record's slot, to compare the
+        two.
+    :type search: bool
+    :param cursor: Start each lookup from the record the previous time landed on, as the frame transforms do for a
+        stream of times.
+    :type cursor: bool
+    :return: The output buffer.
+    """
+    def interpolate(self, times, out, interpolation: EOPInterpolation = EOPInterpolation.Nearest,
+                    search: bool = False, cursor: bool = False):
+        interpolate(self.__eop_table, times, out, int(interpolation), search, cursor)
+        return out
 
     @property
     def capsule(self):
@@ -23,10 +23,24 @@
 #   SOFTWARE.                                                                       #
 #                                                                                   #
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+from enum import IntEnum
+
 from toluene_extensions.models.earth import ellipsoid
 
 from ctypes import py_object
 
+# Algorithms inverting a position onto the ellipsoid for its geodetic latitude and height. ClosedForm is Heikkinen's
+# solution and the default. Bowring takes one iteration of Bowring's method and Bowring2 two, Vermeille is Vermeille's
+# closed form and Fukushima a single Halley step of Fukushima's method. The alternatives hold outside the ellipsoid's
+# evolute, a few tens of kilometers around the center.
+GeodeticAlgorithm = IntEnum('GeodeticAlgorithm', [
+    'ClosedForm',
+    'Bowring',
+    'Bowring2',
+    'Vermeille',
+    'Fukushima',
+])
+
 
 class Ellipsoid:
     """
@@ -23,6 +23,7 @@
 #   SOFTWARE.                                                                       #
 #                                                                                   #
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+from array import array
 from typing import List
 
 from toluene_extensions.models.earth import geoid
@@ -36,3 +37,12 @@ class Geoid:
 
     def add_coefficient(self, degree, order, c, s, c_dot=0.0, s_dot=0.0):
         geoid.add_coefficient(self.__geoid, degree, order, c, s, c_dot, s_dot)
+
+    """
+    Appends a flat buffer of coefficients in one call, N*6 doubles of degree, order, C, S, C_dot and S_dot. Storage is
+    reserved once for the whole buffer instead of growing per coefficient. Returns the number of coefficients held.
+    """
+    def add_coefficients(self, coefficients) -> int:
+        if not isinstance(coefficients, (array, memoryview)):
+            coefficients = array('d', coefficients)
+        return geoid.add_coefficients(self.__geoid, coefficients)
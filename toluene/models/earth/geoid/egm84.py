@@ -24,6 +24,8 @@
 #                                                                                   #
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
 
+from array import array
+
 from toluene.models.earth.geoid import Geoid
 
 
@@ -46,13 +48,16 @@ class EGM84(Geoid):
         self.add_interpolation(0.5, height_list)
 
     def coefficients_from_file(self, file_path: str):
+        coefficients = array('d')
         with open(file_path, 'r') as file:
             for line in file:
                 degree = int(line[:5])
                 order = int(line[6:10])
                 c = float(line[11:25])
                 s = float(line[26:])
-                self.add_coefficient(degree, order, c, s)
+                coefficients.extend((degree, order, c, s, 0.0, 0.0))
+
+        self.add_coefficients(coefficients)
 
 
 
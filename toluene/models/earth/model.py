@@ -23,19 +23,37 @@
 #   SOFTWARE.                                                                       #
 #                                                                                   #
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+import os
+import threading
 import yaml
+from enum import IntEnum
 
-from toluene.models.earth.earth_orientation_table import EarthOrientationTable
-from toluene.models.earth.ellipsoid import Ellipsoid
-from toluene.models.earth.nutation import NutationSeries
+from toluene.models.earth.earth_orientation_table import EarthOrientationTable, EOPInterpolation
+from toluene.models.earth.ellipsoid import Ellipsoid, GeodeticAlgorithm
+from toluene.models.earth.nutation import NutationEphemeris, NutationSeries, NutationStrategy
 from toluene.time.delta_t import DeltaTTable
 from toluene.util.file import configdir, datadir
-from toluene_extensions.models.earth import earth
+from toluene_extensions.models.earth import earth, nutation
 
 # Default is set to the WGS84 ellipsoid.
 # This is global and can be overwritten with by redefining this tuple to the desired semi-major and semi-minor axes.
 default_ellipsoid = (6378137.0, 6356752.314245)
 
+PrecisionTier = IntEnum('PrecisionTier', [
+    'Full',
+    'High',
+    'Medium',
+    'Low',
+])
+
+# Smallest nutation term amplitude kept at each precision tier in arcseconds. Low keeps about a hundred terms, close to
+# IAU 2000B, and stays within a few milliarcseconds of the full series.
+precision_thresholds = {
+    PrecisionTier.High: 1e-6,
+    PrecisionTier.Medium: 1e-5,
+    PrecisionTier.Low: 1e-4,
+}
+
 
 class EarthModel:
     """
@@ -59,6 +77,8 @@ class EarthModel:
     """
     def __init__(self, ellipsoid: Ellipsoid = None, nutation_series: NutationSeries = None,
                  eop_table: EarthOrientationTable = None, delta_t_table: DeltaTTable = None, capsule=None):
+        self.__precision = PrecisionTier.Full
+        self.__truncation_error = (0.0, 0.0)
         if capsule is None:
             self.__model = earth.new_EarthModel()
 
@@ -83,6 +103,266 @@ class EarthModel:
                 delta_t_table = DeltaTTable()
                 delta_t_table.load_from_file(datadir + '/deltat.data')
             earth.set_delta_t_table(self.__model, delta_t_table.capsule)
+        else:
+            self.__model = capsule
+
+    """
+    Saves the model's ellipsoid, nutation series, Earth Orientation Parameters, Delta T table and geoid to a binary
+    snapshot that load reads back without parsing any of the source files. The snapshot holds the tables as they sit
+    in memory behind a versioned header and a checksum of the whole file, so it only loads into a build of the same
+    precision on a machine of the same byte order. The file is written beside the path and renamed over it, readers
+    never see a partial snapshot. The precision tier and nutation ephemeris are derived from the tables and are not
+    saved. On Windows a snapshot that models are attached to is first renamed aside with a .old suffix, and it is only
+    removed once the last of those models lets go of it.
+
+    :param path: The path of the snapshot.
+    :type path: str
+    """
+    def save(self, path: str):
+        earth.save(self.__model, path)
+
+    """
+    Creates a model from a snapshot written by save. The snapshot is checked in full before it is used, a snapshot of
+    another version or precision or one that fails its checksum raises a ValueError.
+
+    :param path: The path of the snapshot.
+    :type path: str
+    :return: The model.
+    :rtype: :class:`toluene.models.earth.model.EarthModel`
+    """
+    @classmethod
+    def load(cls, path: str) -> 'EarthModel':
+        capsule = earth.new_EarthModel()
+        earth.load(capsule, path)
+        return cls(capsule=capsule)
+
+    """
+    Creates a model whose tables are read in place from a read only mapping of a snapshot written by save, rather than
+    copied. Every process attached to the same file shares one copy of the nutation series, Earth Orientation
+    Parameters, Delta T table and geoid in the page cache, so the model data adds next to nothing to each worker's
+    private memory. Keeping the snapshot on a memory backed file system such as /dev/shm makes it a named shared
+    memory segment. The snapshot is checked as by load. Saving over the path later replaces the file rather than
+    rewriting it, so attached models keep reading the snapshot they attached to.
+
+    :param path: The path of the snapshot.
+    :type path: str
+    :return: The model.
+    :rtype: :class:`toluene.models.earth.model.EarthModel`
+    """
+    @classmethod
+    def attach(cls, path: str) -> 'EarthModel':
+        capsule = earth.new_EarthModel()
+        earth.attach(capsule, path)
+        return cls(capsule=capsule)
+
+    """
+    Sets the algorithm the model inverts positions onto its ellipsoid with, for every conversion to the
+    GeodeticReferenceFrame that does not pick its own. ClosedForm is the default.
+
+    :param algorithm: The geodetic algorithm.
+    :type algorithm: :class:`toluene.models.earth.ellipsoid.GeodeticAlgorithm`
+    """
+    def set_geodetic_algorithm(self, algorithm: GeodeticAlgorithm):
+        earth.set_geodetic_algorithm(self.__model, int(algorithm))
+
+    """
+    Gets the algorithm the model inverts positions onto its ellipsoid with.
+
+    :return: The geodetic algorithm.
+    :rtype: :class:`toluene.models.earth.ellipsoid.GeodeticAlgorithm`
+    """
+    @property
+    def geodetic_algorithm(self) -> GeodeticAlgorithm:
+        return GeodeticAlgorithm(earth.get_geodetic_algorithm(self.__model))
+
+    """
+    Sets how the model evaluates its nutation series. Extended is the default, Vectorized on the fast build.
+
+    :param strategy: The evaluation strategy.
+    :type strategy: :class:`toluene.models.earth.nutation.NutationStrategy`
+    """
+    def set_nutation_strategy(self, strategy: NutationStrategy):
+        earth.set_nutation_strategy(self.__model, int(strategy))
+
+    """
+    Sets how the model interpolates its Earth Orientation Parameters between the daily records. Nearest is the
+    default.
+
+    :param interpolation: The interpolation.
+    :type interpolation: :class:`toluene.models.earth.earth_orientation_table.EOPInterpolation`
+    """
+    def set_eop_interpolation(self, interpolation: EOPInterpolation):
+        earth.set_eop_interpolation(self.__model, int(interpolation))
+
+    """
+    Swaps the model's Earth Orientation Parameters for those of a table, whole, while other threads keep converting.
+    Conversions already running finish with the table they started with and every one after sees the new table, none
+    waits on the swap or sees a table half replaced. Rotations cached from the previous table are not used again. The
+    Earth Model takes ownership of the table as it does in the constructor.
+
+    :param eop_table: The Earth Orientation Table to use.
+    :type eop_table: :class:`toluene.models.earth.EarthOrientationTable`
+    :param keep_interpolation: Keep the model's interpolation rather than take the table's.
+    :type keep_interpolation: bool
+    """
+    def set_eop_table(self, eop_table: EarthOrientationTable, keep_interpolation: bool = False):
+        earth.set_earth_orientation_parameters(self.__model, eop_table.capsule, keep_interpolation)
+
+    """
+    Gets the number of Earth Orientation Parameter tables swapped into the model after the first, including those
+    swapped in by a change of interpolation.
+
+    :return: The version of the model's Earth Orientation Parameters.
+    :rtype: int
+    """
+    @property
+    def eop_version(self) -> int:
+        return earth.get_eop_version(self.__model)
+
+    """
+    Starts reloading the model's Earth Orientation Parameters from a finals2000A file whenever it changes on disk.
+
+    :param path: The path of the file.
+    :type path: str
+    :param interval: Seconds between checks of the file.
+    :type interval: float
+    :return: The watcher, stop it to stop reloading.
+    :rtype: :class:`toluene.models.earth.model.EarthOrientationWatcher`
+    """
+    def watch_eop_file(self, path: str, interval: float = 60.0) -> 'EarthOrientationWatcher':
+        return EarthOrientationWatcher(self, path, interval)
+
+    """
+    Sets the nutation ephemeris the model evaluates instead of the full nutation series for times inside the
+    ephemeris span. The Earth Model takes ownership of the ephemeris. Passing None drops the current ephemeris.
+
+    :param ephemeris: The nutation ephemeris to use.
+    :type ephemeris: :class:`toluene.models.earth.NutationEphemeris`
+    """
+    def set_nutation_ephemeris(self, ephemeris: NutationEphemeris = None):
+        earth.set_nutation_ephemeris(self.__model, None if ephemeris is None else ephemeris.capsule)
+
+    """
+    Fits a nutation ephemeris to the model's nutation series and sets it on the model.
+
+    :param start: The Unix time the ephemeris starts at.
+    :type start: float
+    :param end: The Unix time the ephemeris ends at.
+    :type end: float
+    :param tolerance: The largest acceptable error in arcseconds.
+    :type tolerance: float
+    :param degree: The degree of the Chebyshev polynomial of each segment.
+    :type degree: int
+    :return: The largest error against the series seen while fitting in arcseconds.
+    :rtype: float
+    """
+    def fit_nutation_ephemeris(self, start: float, end: float, tolerance: float = 1e-6, degree: int = 12) -> float:
+        ephemeris = NutationEphemeris(self, start, end, tolerance, degree)
+        max_error = ephemeris.max_error
+        self.set_nutation_ephemeris(ephemeris)
+        return max_error
+
+    """
+    Sets the precision tier conversions through this model run at. Every tier but Full swaps the nutation series for a
+    truncated copy holding only the terms above the tier's amplitude threshold, trading accuracy for speed in bulk
+    work where milliarcseconds do not matter. Passing a threshold or max_terms overrides the tier's default
+    truncation. A nutation ephemeris set on the model still takes precedence for times inside its span.
+
+    :param tier: The precision tier to use.
+    :type tier: :class:`toluene.models.earth.model.PrecisionTier`
+    :param threshold: The smallest nutation term amplitude kept in arcseconds.
+    :type threshold: float
+    :param max_terms: The largest number of nutation terms kept, 0 keeps every term above the threshold.
+    :type max_terms: int
+    :return: The largest error of the nutation in longitude and obliquity against the full series in arcseconds.
+    :rtype: float
+    """
+    def set_precision(self, tier: PrecisionTier, threshold: float = None, max_terms: int = 0) -> float:
+        if tier == PrecisionTier.Full:
+            earth.set_truncated_nutation_series(self.__model, None)
+            self.__truncation_error = (0.0, 0.0)
+        else:
+            if threshold is None:
+                threshold = precision_thresholds[tier]
+            capsule, bound, error = nutation.truncate_NutationSeries(self.__model, threshold, max_terms)
+            earth.set_truncated_nutation_series(self.__model, capsule)
+            self.__truncation_error = (error, bound)
+        self.__precision = tier
+        return self.nutation_truncation_error
+
+    """
+    Gets the precision tier conversions through this model run at.
+
+    :return: The precision tier.
+    :rtype: :class:`toluene.models.earth.model.PrecisionTier`
+    """
+    @property
+    def precision(self) -> PrecisionTier:
+        return self.__precision
+
+    """
+    Gets the largest error of the nutation in longitude and obliquity of the current precision tier against the full
+    series, sampled between 1950 and 2050, in arcseconds.
+    """
+    @property
+    def nutation_truncation_error(self) -> float:
+        return self.__truncation_error[0]
+
+    """
+    Gets the sum of the nutation amplitudes the current precision tier drops, a hard bound on its error in longitude
+    and obliquity within a century of J2000, in arcseconds.
+    """
+    @property
+    def nutation_truncation_error_bound(self) -> float:
+        return self.__truncation_error[1]
+
+    """
+    Sets the number of epochs held in the model's frame rotation cache. Every conversion composes the wobble, earth
+    rotation, nutation, precession and frame bias matrices for its timestamp; the cache keeps the composed result so
+    states sharing a timestamp only pay for a single rotation. Resizing drops every cached epoch and a size of 0
+    disables the cache.
+
+    :param size: The number of epochs to cache.
+    :type size: int
+    """
+    def set_rotation_cache_size(self, size: int):
+        earth.set_rotation_cache_size(self.__model, size)
+
+    """
+    Drops every cached epoch from the frame rotation cache and resets the hit and miss counters.
+    """
+    def clear_rotation_cache(self):
+        earth.clear_rotation_cache(self.__model)
+
+    """
+    Gets the number of epochs the frame rotation cache holds.
+
+    :return: The size of the cache.
+    :rtype: int
+    """
+    @property
+    def rotation_cache_size(self) -> int:
+        return earth.get_rotation_cache_statistics(self.__model)[0]
+
+    """
+    Gets the number of conversions whose frame rotation was served from the cache.
+
+    :return: The number of cache hits.
+    :rtype: int
+    """
+    @property
+    def rotation_cache_hits(self) -> int:
+        return earth.get_rotation_cache_statistics(self.__model)[1]
+
+    """
+    Gets the number of conversions whose frame rotation had to be computed.
+
+    :return: The number of cache misses.
+    :rtype: int
+    """
+    @property
+    def rotation_cache_misses(self) -> int:
+        return earth.get_rotation_cache_statistics(self.__model)[2]
 
     """
     Gets the model and returns it as a capsule.
@@ -90,3 +370,77 @@ class EarthModel:
     @property
     def capsule(self):
         return self.__model
+
+
+class EarthOrientationWatcher:
+    """
+    Reloads a model's Earth Orientation Parameters from a finals2000A file whenever the file changes on disk, checking
+    its size, modification time and inode from a daemon thread. Each reload parses the file into a new table and swaps
+    it into the model with :meth:`EarthModel.set_eop_table`, keeping the model's interpolation. Replace the file by
+    renaming a complete one over it, a file still being written may be read part way. A file that is missing or can not
+    be read is tried again at the next check, the model keeps the table it has.
+
+    :param model: The model to reload.
+    :type model: :class:`toluene.models.earth.model.EarthModel`
+    :param path: The path of the file.
+    :type path: str
+    :param interval: Seconds between checks of the file.
+    :type interval: float
+    """
+    def __init__(self, model: EarthModel, path: str, interval: float = 60.0):
+        self.__model = model
+        self.__path = os.fspath(path)
+        self.__interval = interval
+        self.__signature = self.__stat()
+        self.__stopping = threading.Event()
+        self.__lock = threading.Lock()
+        self.reloads = 0
+        self.last_error = None
+        self.__thread = threading.Thread(target=self.__run, name='toluene-eop-watcher', daemon=True)
+        self.__thread.start()
+
+    def __stat(self):
+        try:
+            status = os.stat(self.__path)
+        except OSError:
+            return None
+        return status.st_ino, status.st_size, status.st_mtime_ns
+
+    def __run(self):
+        while not self.__stopping.wait(self.__interval):
+            self.check()
+
+    """
+    Checks the file once and reloads it if it changed since the last reload.
+
+    :return: True if the table was reloaded.
+    :rtype: bool
+    """
+    def check(self) -> bool:
+        with self.__lock:
+            signature = self.__stat()
+            if signature is None or signature == self.__signature:
+                return False
+            try:
+                table = EarthOrientationTable(self.__path)
+            except (OSError, ValueError) as error:
+                self.last_error = error
+                return False
+            self.__model.set_eop_table(table, keep_interpolation=True)
+            self.__signature = signature
+            self.reloads += 1
+            return True
+
+    """
+    Stops checking the file, waiting for a reload in progress to finish.
+    """
+    def stop(self):
+        self.__stopping.set()
+        if self.__thread is not threading.current_thread():
+            self.__thread.join()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.stop()
@@ -23,9 +23,53 @@
 #   SOFTWARE.                                                                       #
 #                                                                                   #
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
+from array import array
+from enum import IntEnum
 from typing import List
 
-from toluene_extensions.models.earth.nutation import new_NutationSeries, add_record
+from toluene_extensions.models.earth import nutation
+from toluene_extensions.models.earth.nutation import new_NutationSeries, add_records, new_NutationEphemeris, \
+    nutation_ephemeris_info, get_nutation_values, nutation_series_size, truncate_NutationSeries, \
+    set_nutation_strategy
+
+# Extended sums the series term by term in long double. Vectorized sums a double precision structure of arrays copy
+# of the series with the widest SIMD kernel the CPU supports, agreeing with Extended to well under a microarcsecond.
+# Recurrence sums the long double terms but builds each term's sine and cosine from those of the fundamental arguments
+# by complex multiplication instead of calling sinl and cosl per term. New series start as Extended, or as Vectorized on
+# the fast build where the sums are in double anyway.
+NutationStrategy = IntEnum('NutationStrategy', [
+    'Extended',
+    'Vectorized',
+    'Recurrence',
+])
+
+NutationKernel = IntEnum('NutationKernel', [
+    'Scalar',
+    'AVX2',
+    'AVX512',
+])
+
+
+def get_nutation_kernel():
+    """
+    Gets the kernel the Vectorized strategy runs on and the best kernel the CPU supports.
+
+    :return: The kernel in use and the best supported kernel.
+    :rtype: tuple
+    """
+    kernel, supported = nutation.get_nutation_kernel()
+    return NutationKernel(kernel), NutationKernel(supported)
+
+
+def set_nutation_kernel(kernel: NutationKernel):
+    """
+    Forces the kernel the Vectorized strategy runs on for series evaluated directly through this module. Used to
+    compare the kernels against one another, conversions always use the best supported kernel.
+
+    :param kernel: The kernel to use, it must be supported by the CPU.
+    :type kernel: :class:`toluene.models.earth.nutation.NutationKernel`
+    """
+    nutation.set_nutation_kernel(int(kernel))
 
 
 class NutationSeries:
@@ -37,16 +81,153 @@ class NutationSeries:
             self.__nutation_series = new_NutationSeries()
         if series is not None:
             self.load_from_list(series)
+        self.__truncation_error = 0.0
+        self.__truncation_error_bound = 0.0
 
     def load_from_list(self, series: List[float]):
+        records = array('d')
         for idx in range(0, len(series), 21):
-            coefficients = series[idx:idx + 21]
-            add_record(self.__nutation_series, coefficients[1], coefficients[2], coefficients[3], coefficients[4],
-                       coefficients[5], coefficients[6], coefficients[7], coefficients[8], coefficients[9],
-                       coefficients[10], coefficients[11], coefficients[12], coefficients[13], coefficients[14],
-                       coefficients[15], coefficients[16], coefficients[17], coefficients[18], coefficients[19],
-                       coefficients[20])
+            records.extend(series[idx + 1:idx + 21])
+        self.add_records(records)
+
+    """
+    Appends a flat buffer of terms in one call, each term 20 doubles in the order of the series file less its index:
+    the 14 argument multipliers then S, S_dot, C_prime, C, C_dot and S_prime.
+
+    :return: The number of terms in the series.
+    :rtype: int
+    """
+    def add_records(self, records) -> int:
+        if not isinstance(records, (array, memoryview)):
+            records = array('d', records)
+        return add_records(self.__nutation_series, records)
+
+    """
+    Sets how the series is evaluated. Extended is the default, Vectorized on the fast build.
+
+    :param strategy: The evaluation strategy.
+    :type strategy: :class:`toluene.models.earth.nutation.NutationStrategy`
+    """
+    def set_strategy(self, strategy: NutationStrategy):
+        set_nutation_strategy(self.__nutation_series, int(strategy))
+
+    """
+    Builds a truncated copy of the series keeping only the largest terms, in the spirit of IAU 2000B. A term's
+    amplitude is the largest of its S, C, S' and C' coefficients. The truncated series reports how far it strays from
+    this series through its truncation_error and truncation_error_bound properties.
+
+    :param threshold: The smallest amplitude kept in arcseconds.
+    :type threshold: float
+    :param max_terms: The largest number of terms kept, 0 keeps every term above the threshold.
+    :type max_terms: int
+    :return: The truncated series.
+    :rtype: :class:`toluene.models.earth.NutationSeries`
+    """
+    def truncated(self, threshold: float = 0.0, max_terms: int = 0) -> 'NutationSeries':
+        capsule, bound, error = truncate_NutationSeries(self.__nutation_series, threshold, max_terms)
+        series = NutationSeries(capsule=capsule)
+        series.__truncation_error = error
+        series.__truncation_error_bound = bound
+        return series
+
+    """
+    Gets the number of terms in the series.
+    """
+    @property
+    def terms(self) -> int:
+        return nutation_series_size(self.__nutation_series)
+
+    """
+    Gets the largest error of the nutation in longitude and obliquity against the series this one was truncated from,
+    sampled between 1950 and 2050, in arcseconds.
+    """
+    @property
+    def truncation_error(self) -> float:
+        return self.__truncation_error
+
+    """
+    Gets the sum of the amplitudes dropped when truncating, a hard bound on the error of the nutation in longitude and
+    obliquity within a century of J2000, in arcseconds.
+    """
+    @property
+    def truncation_error_bound(self) -> float:
+        return self.__truncation_error_bound
+
+    """
+    Evaluates the full series at a time.
+
+    :param timestamp: The Unix time to evaluate the series at.
+    :type timestamp: float
+    :return: The nutation in longitude, nutation in obliquity, mean obliquity of date and equation of the equinoxes
+        in arcseconds.
+    :rtype: tuple
+    """
+    def values(self, timestamp: float):
+        return get_nutation_values(self.__nutation_series, timestamp)
 
     @property
     def capsule(self):
         return self.__nutation_series
+
+
+class NutationEphemeris:
+    """
+    Chebyshev fit of the nutation in longitude, nutation in obliquity and equation of the equinoxes over a span of
+    time. Evaluating the ephemeris costs a few dozen floating point operations instead of a pass over the full series,
+    so a model holding one converts states inside the span much faster. The span is split into equal segments which
+    are halved until the fit matches the series to within the tolerance.
+
+    :param source: The nutation series to fit, or an Earth Model whose series should be fit.
+    :type source: :class:`toluene.models.earth.NutationSeries` or :class:`toluene.models.earth.EarthModel`
+    :param start: The Unix time the ephemeris starts at.
+    :type start: float
+    :param end: The Unix time the ephemeris ends at.
+    :type end: float
+    :param tolerance: The largest acceptable error in arcseconds.
+    :type tolerance: float
+    :param degree: The degree of the Chebyshev polynomial of each segment.
+    :type degree: int
+    """
+    def __init__(self, source=None, start: float = None, end: float = None, tolerance: float = 1e-6, degree: int = 12,
+                 capsule=None):
+        if capsule is not None:
+            self.__ephemeris = capsule
+        else:
+            self.__ephemeris = new_NutationEphemeris(source.capsule, start, end, tolerance, degree)
+
+    """
+    Evaluates the ephemeris at a time inside its span.
+
+    :param timestamp: The Unix time to evaluate the ephemeris at.
+    :type timestamp: float
+    :return: The nutation in longitude, nutation in obliquity, mean obliquity of date and equation of the equinoxes
+        in arcseconds.
+    :rtype: tuple
+    """
+    def values(self, timestamp: float):
+        return get_nutation_values(self.__ephemeris, timestamp)
+
+    """
+    Gets the number of segments the span was split into.
+    """
+    @property
+    def segments(self) -> int:
+        return nutation_ephemeris_info(self.__ephemeris)[2]
+
+    """
+    Gets the degree of the Chebyshev polynomial of each segment.
+    """
+    @property
+    def degree(self) -> int:
+        return nutation_ephemeris_info(self.__ephemeris)[3]
+
+    """
+    Gets the largest error against the series seen while fitting in arcseconds.
+    """
+    @property
+    def max_error(self) -> float:
+        return nutation_ephemeris_info(self.__ephemeris)[4]
+
+    @property
+    def capsule(self):
+        return self.__ephemeris
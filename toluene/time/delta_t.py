@@ -25,7 +25,21 @@
 # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # # #
 from toluene_extensions.time import delta_t
 
-from datetime import datetime, timezone
+from array import array
+from enum import IntEnum
+
+# Step holds each monthly record until the next, Linear interpolates between the two records around the time.
+DeltaTInterpolation = IntEnum('DeltaTInterpolation', [
+    'Step',
+    'Linear',
+])
+
+# Clamp holds the first and last records before and after the table. Polynomial follows the Espenak and Meeus
+# polynomials, offset to meet the end record and fading back to the bare polynomials over a century.
+DeltaTExtrapolation = IntEnum('DeltaTExtrapolation', [
+    'Clamp',
+    'Polynomial',
+])
 
 
 class DeltaTTable:
@@ -38,15 +52,59 @@ class DeltaTTable:
         if path is not None:
             self.load_from_file(path)
 
-    def load_from_file(self, path: str):
-        with open(path, 'r') as file:
-            for line in file:
-                year = int(line[1:5])
-                month = int(line[6:8])
-                day = int(line[9:11])
-                deltaT = float(line[12:])
-                timestamp = datetime(year, month, day, 0, 0, 0, 0, tzinfo=timezone.utc).timestamp()
-                delta_t.add_record(self.__delta_t_table, timestamp, deltaT)
+    """
+    Loads the records of a deltat.data file, year month day and Delta T per line, parsed in one pass over the memory
+    mapped file in C. Each record is stamped with the UNIX time of its date at midnight UTC.
+
+    :param path: The path of the file.
+    :type path: str
+    :return: The number of records in the table.
+    :rtype: int
+    """
+    def load_from_file(self, path: str) -> int:
+        return delta_t.load_file(self.__delta_t_table, path)
+
+    """
+    Appends a flat buffer of N*2 doubles, timestamp then ΔT, in one call. Storage is reserved once and the table is
+    sorted once if the rows arrive out of order. Returns the number of records held.
+    """
+    def add_records(self, records) -> int:
+        if not isinstance(records, (array, memoryview)):
+            records = array('d', records)
+        return delta_t.add_records(self.__delta_t_table, records)
+
+    """
+    Sets how the table is interpolated between its records. Linear is the default.
+
+    :param interpolation: The interpolation.
+    :type interpolation: :class:`DeltaTInterpolation`
+    """
+    def set_interpolation(self, interpolation: DeltaTInterpolation):
+        delta_t.set_interpolation(self.__delta_t_table, int(interpolation))
+
+    """
+    Sets how the table is extrapolated before its first record and after its last. Polynomial is the default.
+
+    :param extrapolation: The extrapolation.
+    :type extrapolation: :class:`DeltaTExtrapolation`
+    """
+    def set_extrapolation(self, extrapolation: DeltaTExtrapolation):
+        delta_t.set_extrapolation(self.__delta_t_table, int(extrapolation))
+
+    """
+    Evaluates Delta T at many times in one call into C, fastest for times in order. An empty table gives 0.
+
+    :param times: A buffer of N doubles holding the times in seconds since the UNIX epoch.
+    :param out: A writable buffer of N doubles receiving Delta T in seconds, allocated if not given.
+    :return: The output buffer.
+    """
+    def lookup(self, times, out=None):
+        if not isinstance(times, (array, memoryview)):
+            times = array('d', times)
+        if out is None:
+            out = array('d', bytes(8 * len(times)))
+        delta_t.lookup(self.__delta_t_table, times, out)
+        return out
 
     @property
     def capsule(self):